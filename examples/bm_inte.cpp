@@ -0,0 +1,171 @@
+/*
+  -------------------------------------------------------------------
+  
+  Copyright (C) 2022, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+/*
+  Compare scalar and batch integrands for the Gauss-Kronrod
+  integrators using the fermion density and energy density
+  integrands
+*/
+
+#include <cmath>
+#include <ctime>
+#include <functional>
+
+#include <o2scl/test_mgr.h>
+#include <o2scl/funct.h>
+#include <o2scl/inte_qag_gsl.h>
+#include <o2scl/inte_kronrod_boost.h>
+
+using namespace std;
+using namespace o2scl;
+
+/* The integrand for the density of a relativistic fermion with 
+   mass m at temperature T and chemical potential mu (all in units
+   of m), as a function of the momentum k
+*/
+double density(double k, double T, double mu) {
+  double E=sqrt(k*k+1.0);
+  return k*k/(1.0+exp((E-mu)/T));
+}
+
+/* The integrand for the energy density
+ */
+double energy(double k, double T, double mu) {
+  double E=sqrt(k*k+1.0);
+  return k*k*E/(1.0+exp((E-mu)/T));
+}
+
+/* The same integrands in batch form, written as simple loops which
+   the compiler can vectorize
+*/
+void density_batch(size_t n, const double *k, double *y,
+                   double T, double mu) {
+  for(size_t i=0;i<n;i++) {
+    double E=sqrt(k[i]*k[i]+1.0);
+    y[i]=k[i]*k[i]/(1.0+exp((E-mu)/T));
+  }
+  return;
+}
+
+void energy_batch(size_t n, const double *k, double *y,
+                  double T, double mu) {
+  for(size_t i=0;i<n;i++) {
+    double E=sqrt(k[i]*k[i]+1.0);
+    y[i]=k[i]*k[i]*E/(1.0+exp((E-mu)/T));
+  }
+  return;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  // Number of points in the (T,mu) grid
+  const size_t N=200;
+  
+  inte_qag_gsl<> qag;
+  qag.err_nonconv=false;
+  inte_kronrod_boost<funct,61> ikb;
+  ikb.tol_rel=1.0e-8;
+
+  cout << "Integrator     Rule  Scalar (s)    Batch (s)     "
+       << "Speedup" << endl;
+  
+  for(int rule=1;rule<=7;rule++) {
+
+    double sum_s=0.0, sum_b=0.0;
+    clock_t time_s=0, time_b=0;
+    
+    if (rule<7) qag.set_rule(rule);
+    
+    for(size_t i=0;i<N;i++) {
+      
+      double T=0.01+0.04*((double)i)/((double)N);
+      double mu=1.0+0.2*((double)i)/((double)N);
+      double kmax=sqrt(pow(mu+40.0*T,2.0)-1.0);
+      
+      funct fd=std::bind(density,std::placeholders::_1,T,mu);
+      funct fe=std::bind(energy,std::placeholders::_1,T,mu);
+      funct_batch fdb=std::bind(density_batch,std::placeholders::_1,
+                                std::placeholders::_2,
+                                std::placeholders::_3,T,mu);
+      funct_batch feb=std::bind(energy_batch,std::placeholders::_1,
+                                std::placeholders::_2,
+                                std::placeholders::_3,T,mu);
+
+      double res, err;
+      
+      clock_t c1=clock();
+      if (rule<7) {
+        qag.integ_err(fd,0.0,kmax,res,err);
+        sum_s+=res;
+        qag.integ_err(fe,0.0,kmax,res,err);
+        sum_s+=res;
+      } else {
+        ikb.integ_err(fd,0.0,kmax,res,err);
+        sum_s+=res;
+        ikb.integ_err(fe,0.0,kmax,res,err);
+        sum_s+=res;
+      }
+      clock_t c2=clock();
+      if (rule<7) {
+        qag.integ_err_batch(fdb,0.0,kmax,res,err);
+        sum_b+=res;
+        qag.integ_err_batch(feb,0.0,kmax,res,err);
+        sum_b+=res;
+      } else {
+        ikb.integ_err_batch(fdb,0.0,kmax,res,err);
+        sum_b+=res;
+        ikb.integ_err_batch(feb,0.0,kmax,res,err);
+        sum_b+=res;
+      }
+      clock_t c3=clock();
+      
+      time_s+=c2-c1;
+      time_b+=c3-c2;
+    }
+    
+    t.test_rel(sum_s,sum_b,1.0e-12,"scalar vs. batch");
+    
+    double ts=((double)time_s)/CLOCKS_PER_SEC;
+    double tb=((double)time_b)/CLOCKS_PER_SEC;
+    if (rule<7) {
+      cout << "inte_qag_gsl   ";
+      cout.width(4);
+      cout << qag.get_rule() << "  ";
+    } else {
+      cout << "inte_kr_boost  ";
+      cout.width(4);
+      cout << 61 << "  ";
+    }
+    cout << ts << " " << tb << " ";
+    if (tb>0.0) cout << ts/tb;
+    cout << endl;
+  }
+
+  t.report();
+  
+  return 0;
+}
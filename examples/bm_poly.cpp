@@ -672,6 +672,73 @@ void test_quartic_complex(quartic_complex *po, string str,
   return;
 }
 
+/*
+  Compare the time required to solve a large number of cubics and
+  quartics one at a time with the time required by the batch solvers
+*/
+void test_batch(size_t n) {
+
+  std::vector<double> a(n), b(n), c(n), d(n), e(n);
+  std::vector<double> x1(n), x2(n), x3(n), x4(n);
+  std::vector<int> nr(n);
+  for(size_t i=0;i<n;i++) {
+    double fi=i;
+    a[i]=1.0+sin(fi*0.37)/2.0;
+    b[i]=2.0*sin(fi*1.1+0.3);
+    c[i]=2.0*sin(fi*2.3+1.7);
+    d[i]=2.0*sin(fi*0.7+2.9);
+    e[i]=2.0*sin(fi*1.9+0.1);
+  }
+
+  cubic_real_coeff_cern<> c1;
+  cubic_real_batch<> cb;
+  quartic_real_coeff_cern<> q1;
+  quartic_real_batch<> qb;
+  std::complex<double> z1, z2, z3, z4;
+  
+  clock_t lt1=clock();
+  for(size_t i=0;i<n;i++) {
+    c1.solve_rc(a[i],b[i],c[i],d[i],x1[i],z2,z3);
+  }
+  clock_t lt2=clock();
+  cb.solve_r(n,&a[0],&b[0],&c[0],&d[0],&x1[0],&x2[0],&x3[0],&nr[0]);
+  clock_t lt3=clock();
+  cb.polish=false;
+  cb.solve_r(n,&a[0],&b[0],&c[0],&d[0],&x1[0],&x2[0],&x3[0],&nr[0]);
+  clock_t lt4=clock();
+  
+  cout << "Cubics, n=" << n << endl;
+  cout << "   cubic_real_coeff_cern: " 
+       << ((double)(lt2-lt1))/CLOCKS_PER_SEC << endl;
+  cout << "   cubic_real_batch: " 
+       << ((double)(lt3-lt2))/CLOCKS_PER_SEC << endl;
+  cout << "   cubic_real_batch (no polish): " 
+       << ((double)(lt4-lt3))/CLOCKS_PER_SEC << endl;
+
+  lt1=clock();
+  for(size_t i=0;i<n;i++) {
+    q1.solve_rc(a[i],b[i],c[i],d[i],e[i],z1,z2,z3,z4);
+  }
+  lt2=clock();
+  qb.solve_r(n,&a[0],&b[0],&c[0],&d[0],&e[0],&x1[0],&x2[0],&x3[0],
+             &x4[0],&nr[0]);
+  lt3=clock();
+  qb.polish=false;
+  qb.solve_r(n,&a[0],&b[0],&c[0],&d[0],&e[0],&x1[0],&x2[0],&x3[0],
+             &x4[0],&nr[0]);
+  lt4=clock();
+  
+  cout << "Quartics, n=" << n << endl;
+  cout << "   quartic_real_coeff_cern: " 
+       << ((double)(lt2-lt1))/CLOCKS_PER_SEC << endl;
+  cout << "   quartic_real_batch: " 
+       << ((double)(lt3-lt2))/CLOCKS_PER_SEC << endl;
+  cout << "   quartic_real_batch (no polish): " 
+       << ((double)(lt4-lt3))/CLOCKS_PER_SEC << endl;
+  
+  return;
+}
+
 int main(void) {
   
   cout.setf(ios::left | ios::scientific);
@@ -830,6 +897,10 @@ int main(void) {
     (&q5,"quartic_complex_simple quartic (complex coeffs.)",slist[31]);
   slist[31].out();
 
+  cout << "----------------------------------------"
+       << "---------------------------------------" << endl;
+  test_batch(1000000);
+
   return 0;
 }
 
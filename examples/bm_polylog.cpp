@@ -20,6 +20,7 @@
 
   -------------------------------------------------------------------
 */
+#include <ctime>
 #include <o2scl/test_mgr.h>
 #include <o2scl/inte_adapt_cern.h>
 #include <o2scl/polylog.h>
@@ -235,6 +236,73 @@ int main(void) {
     }
   }
   cout << endl;
+
+  // Compare the time for the GSL functions with the fused
+  // approximations in fermi_dirac_integ_fast and
+  // bessel_K_exp_integ_fast, which compute all three orders
+  // for an array of arguments at once
+  {
+    fermi_dirac_integ_gsl fdg;
+    fermi_dirac_integ_fast fdf;
+    bessel_K_exp_integ_fast bkf;
+    
+    size_t n=100000, n_rep=10;
+    vector<double> y(n), x(n), r1(n), r2(n), r3(n);
+    for(size_t i=0;i<n;i++) {
+      y[i]=-30.0+100.0*((double)i)/((double)n);
+      x[i]=1.0e-2+50.0*((double)i)/((double)n);
+    }
+    
+    clock_t c1=clock();
+    for(size_t k=0;k<n_rep;k++) {
+      for(size_t i=0;i<n;i++) {
+        r1[i]=fdg.calc_m1o2(y[i]);
+        r2[i]=fdg.calc_1o2(y[i]);
+        r3[i]=fdg.calc_3o2(y[i]);
+      }
+    }
+    clock_t c2=clock();
+    double max_err=0.0;
+    for(size_t k=0;k<n_rep;k++) {
+      fdf.calc_all(n,&(y[0]),&(r1[0]),&(r2[0]),&(r3[0]));
+    }
+    clock_t c3=clock();
+    for(size_t i=0;i<n;i++) {
+      max_err=std::max(max_err,fabs(r2[i]/fdg.calc_1o2(y[i])-1.0));
+    }
+    double tg=((double)(c2-c1))/CLOCKS_PER_SEC;
+    double tf=((double)(c3-c2))/CLOCKS_PER_SEC;
+    cout << "Fermi-Dirac -1/2, 1/2, 3/2:" << endl;
+    cout << "  GSL: " << tg << " s, fused: " << tf << " s, speedup: "
+         << tg/tf << endl;
+    cout << "  Maximum relative deviation: " << max_err << endl;
+    t.test_abs(max_err,0.0,1.0e-14,"fermi_dirac_integ_fast");
+
+    c1=clock();
+    for(size_t k=0;k<n_rep;k++) {
+      for(size_t i=0;i<n;i++) {
+        r1[i]=bkeg.K1exp(x[i]);
+        r2[i]=bkeg.K2exp(x[i]);
+        r3[i]=bkeg.K3exp(x[i]);
+      }
+    }
+    c2=clock();
+    for(size_t k=0;k<n_rep;k++) {
+      bkf.K123exp(n,&(x[0]),&(r1[0]),&(r2[0]),&(r3[0]));
+    }
+    c3=clock();
+    max_err=0.0;
+    for(size_t i=0;i<n;i++) {
+      max_err=std::max(max_err,fabs(r3[i]/bkeg.K3exp(x[i])-1.0));
+    }
+    tg=((double)(c2-c1))/CLOCKS_PER_SEC;
+    tf=((double)(c3-c2))/CLOCKS_PER_SEC;
+    cout << "Bessel K1, K2, K3:" << endl;
+    cout << "  GSL: " << tg << " s, fused: " << tf << " s, speedup: "
+         << tg/tf << endl;
+    cout << "  Maximum relative deviation: " << max_err << endl;
+    t.test_abs(max_err,0.0,1.0e-14,"bessel_K_exp_integ_fast");
+  }
   
   t.report();
   return 0;
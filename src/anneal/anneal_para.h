@@ -159,7 +159,8 @@ namespace o2scl {
     // Seed the random number generators
     unsigned long int s=time(0);
     for(size_t it=1;it<n_threads;it++) {
-      vrng[it].set_seed(s+it);
+      vrng[it].set_seed(s);
+      vrng[it].set_stream(it);
     }
 
     // Setup initial temperature and step sizes
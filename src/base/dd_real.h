@@ -0,0 +1,832 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_DD_REAL_H
+#define O2SCL_DD_REAL_H
+
+/** \file dd_real.h
+    \brief File defining \ref o2scl::dd_real_backend and
+    \ref o2scl::dd_real
+*/
+
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <string>
+#include <functional>
+
+#include <boost/multiprecision/number.hpp>
+#include <boost/multiprecision/detail/float_string_cvt.hpp>
+
+namespace o2scl {
+
+  /** \brief A double-double floating point backend for
+      boost::multiprecision
+
+      This class represents a number as the unevaluated sum of two
+      double precision numbers, \f$ x = x_{\mathrm{hi}} +
+      x_{\mathrm{lo}} \f$ with \f$ |x_{\mathrm{lo}}| \leq
+      \mathrm{ulp}(x_{\mathrm{hi}})/2 \f$, giving 106 bits (about
+      32 decimal digits) of precision with the exponent range of a
+      double. Addition and multiplication use the error-free
+      transformations of Dekker and Knuth, with the products formed
+      using <tt>std::fma()</tt>, so all of the basic operations run
+      in hardware and are typically an order of magnitude or more
+      faster than <tt>cpp_dec_float</tt> at comparable precision.
+      The algorithms follow the QD library of Hida, Li, and Bailey.
+      The products are only fast if the compiler generates a
+      hardware fused multiply-add (e.g. with <tt>-mfma</tt> or
+      <tt>-march=native</tt> on x86-64).
+
+      Addition, multiplication, division, square roots, \c exp()
+      and \c log() are implemented directly; all other functions
+      (trigonometric, hyperbolic, \c pow(), \c log1p(), etc.) use
+      the generic boost::multiprecision implementations which are
+      built on these. Conversion to and from strings uses the
+      generic boost::multiprecision algorithms, which may be in
+      error in the last bit.
+
+      This class is not intended to be used directly; use \ref
+      o2scl::dd_real instead.
+  */
+  class dd_real_backend {
+
+  public:
+
+    /// \name Types required by boost::multiprecision
+    //@{
+    typedef boost::mpl::list<signed char, short, int, long,
+                             boost::long_long_type> signed_types;
+    typedef boost::mpl::list<unsigned char, unsigned short,
+                             unsigned int, unsigned long,
+                             boost::ulong_long_type> unsigned_types;
+    typedef boost::mpl::list<float, double, long double> float_types;
+    typedef int exponent_type;
+    //@}
+
+  protected:
+
+    /// The leading part
+    double v_hi;
+    /// The trailing part
+    double v_lo;
+
+    /// Set the value from an integer with up to 64 bits
+    template<class int_t> void set_int(int_t i) {
+      // The upper and lower 32 bits are each exactly representable
+      double a=static_cast<double>(i/static_cast<int_t>(4294967296LL));
+      double b=static_cast<double>(i%static_cast<int_t>(4294967296LL));
+      two_sum(a*4294967296.0,b,v_hi,v_lo);
+      return;
+    }
+
+  public:
+
+    /// \name Error-free transformations
+    //@{
+    /** \brief Compute \f$ s+e = a+b \f$ exactly, assuming
+        \f$ |a| \geq |b| \f$
+    */
+    static void quick_two_sum(double a, double b, double &s, double &e) {
+      s=a+b;
+      e=b-(s-a);
+      return;
+    }
+
+    /// Compute \f$ s+e = a+b \f$ exactly
+    static void two_sum(double a, double b, double &s, double &e) {
+      s=a+b;
+      double bb=s-a;
+      e=(a-(s-bb))+(b-bb);
+      return;
+    }
+
+    /// Compute \f$ p+e = a b \f$ exactly
+    static void two_prod(double a, double b, double &p, double &e) {
+      p=a*b;
+      e=std::fma(a,b,-p);
+      return;
+    }
+    //@}
+
+    dd_real_backend() : v_hi(0.0), v_lo(0.0) {
+    }
+
+    /// Create from the leading and trailing parts
+    dd_real_backend(double hi, double lo) : v_hi(hi), v_lo(lo) {
+    }
+
+    dd_real_backend(const dd_real_backend &o) : v_hi(o.v_hi), v_lo(o.v_lo) {
+    }
+
+    /// Create from a builtin arithmetic type
+    template<class T>
+    dd_real_backend(const T &x, typename boost::enable_if_c
+                    <boost::is_arithmetic<T>::value>::type* =0) {
+      *this=x;
+    }
+
+    dd_real_backend &operator=(const dd_real_backend &o) {
+      v_hi=o.v_hi;
+      v_lo=o.v_lo;
+      return *this;
+    }
+
+    /// \name Assignment from the builtin types
+    //@{
+    dd_real_backend &operator=(signed char i) {
+      v_hi=i; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(short i) {
+      v_hi=i; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(int i) {
+      v_hi=i; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(long i) {
+      set_int(static_cast<boost::long_long_type>(i)); return *this;
+    }
+    dd_real_backend &operator=(boost::long_long_type i) {
+      set_int(i); return *this;
+    }
+    dd_real_backend &operator=(unsigned char i) {
+      v_hi=i; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(unsigned short i) {
+      v_hi=i; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(unsigned int i) {
+      v_hi=i; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(unsigned long i) {
+      set_int(static_cast<boost::ulong_long_type>(i)); return *this;
+    }
+    dd_real_backend &operator=(boost::ulong_long_type i) {
+      set_int(i); return *this;
+    }
+    dd_real_backend &operator=(float d) {
+      v_hi=d; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(double d) {
+      v_hi=d; v_lo=0.0; return *this;
+    }
+    dd_real_backend &operator=(long double d) {
+      v_hi=static_cast<double>(d);
+      if (std::isfinite(v_hi)) {
+        v_lo=static_cast<double>(d-static_cast<long double>(v_hi));
+      } else {
+        v_lo=0.0;
+      }
+      return *this;
+    }
+    //@}
+
+    /// Assignment from a string
+    dd_real_backend &operator=(const char *s) {
+      boost::multiprecision::detail::convert_from_string(*this,s);
+      return *this;
+    }
+
+    /// Swap with \c o
+    void swap(dd_real_backend &o) {
+      std::swap(v_hi,o.v_hi);
+      std::swap(v_lo,o.v_lo);
+      return;
+    }
+
+    /** \brief Convert to a string with \c digits significant figures
+        (or the full precision if \c digits is zero)
+    */
+    std::string str(std::streamsize digits,
+                    std::ios_base::fmtflags f) const {
+      return boost::multiprecision::detail::convert_to_string
+        (*this,digits ? digits : 33,f);
+    }
+
+    /// Negate the value
+    void negate() {
+      v_hi=-v_hi;
+      v_lo=-v_lo;
+      return;
+    }
+
+    /// Compare with \c o, returning -1, 0, or 1
+    int compare(const dd_real_backend &o) const {
+      if (v_hi<o.v_hi) return -1;
+      if (v_hi>o.v_hi) return 1;
+      if (v_lo<o.v_lo) return -1;
+      if (v_lo>o.v_lo) return 1;
+      return 0;
+    }
+
+    /// Compare with a builtin type, returning -1, 0, or 1
+    template<class T> int compare(const T &i) const {
+      dd_real_backend t;
+      t=i;
+      return compare(t);
+    }
+
+    /// The leading part
+    double hi() const {
+      return v_hi;
+    }
+
+    /// The trailing part
+    double lo() const {
+      return v_lo;
+    }
+
+    /** \name Arithmetic in place
+
+        If the leading part of a result is infinite or not a
+        number, then the trailing part is set to zero.
+    */
+    //@{
+    /// Add \c b (the accurate algorithm with IEEE-style error bound)
+    void add(const dd_real_backend &b) {
+      double s, e, t, f;
+      two_sum(v_hi,b.v_hi,s,e);
+      if (!std::isfinite(s)) {
+        v_hi=s;
+        v_lo=0.0;
+        return;
+      }
+      two_sum(v_lo,b.v_lo,t,f);
+      e+=t;
+      quick_two_sum(s,e,s,e);
+      e+=f;
+      quick_two_sum(s,e,v_hi,v_lo);
+      return;
+    }
+
+    /// Add the double \c b
+    void add(double b) {
+      double s, e;
+      two_sum(v_hi,b,s,e);
+      if (!std::isfinite(s)) {
+        v_hi=s;
+        v_lo=0.0;
+        return;
+      }
+      e+=v_lo;
+      quick_two_sum(s,e,v_hi,v_lo);
+      return;
+    }
+
+    /// Multiply by \c b
+    void mul(const dd_real_backend &b) {
+      double p, e;
+      two_prod(v_hi,b.v_hi,p,e);
+      if (!std::isfinite(p)) {
+        v_hi=p;
+        v_lo=0.0;
+        return;
+      }
+      e+=v_hi*b.v_lo+v_lo*b.v_hi;
+      quick_two_sum(p,e,v_hi,v_lo);
+      return;
+    }
+
+    /// Multiply by the double \c b
+    void mul(double b) {
+      double p, e;
+      two_prod(v_hi,b,p,e);
+      if (!std::isfinite(p)) {
+        v_hi=p;
+        v_lo=0.0;
+        return;
+      }
+      e+=v_lo*b;
+      quick_two_sum(p,e,v_hi,v_lo);
+      return;
+    }
+
+    /// Divide by \c b
+    void div(const dd_real_backend &b) {
+      // Long division with three quotient digits
+      double q1=v_hi/b.v_hi;
+      if (!std::isfinite(q1) || q1==0.0) {
+        v_hi=q1;
+        v_lo=0.0;
+        return;
+      }
+      dd_real_backend r(*this), t(b);
+      t.mul(q1);
+      t.negate();
+      r.add(t);
+      double q2=r.v_hi/b.v_hi;
+      t=b;
+      t.mul(q2);
+      t.negate();
+      r.add(t);
+      double q3=r.v_hi/b.v_hi;
+      quick_two_sum(q1,q2,v_hi,v_lo);
+      add(q3);
+      return;
+    }
+
+    /// Divide by the double \c b
+    void div(double b) {
+      double q1=v_hi/b;
+      if (!std::isfinite(q1) || q1==0.0) {
+        v_hi=q1;
+        v_lo=0.0;
+        return;
+      }
+      // Compute the remainder this-q1*b
+      double p, e, s, f;
+      two_prod(q1,b,p,e);
+      two_sum(v_hi,-p,s,f);
+      f-=e;
+      f+=v_lo;
+      double q2=(s+f)/b;
+      quick_two_sum(q1,q2,v_hi,v_lo);
+      return;
+    }
+    //@}
+
+  };
+
+}
+
+namespace boost {
+  namespace multiprecision {
+
+    /// Specify that \ref o2scl::dd_real_backend is a floating point type
+    template<> struct number_category<o2scl::dd_real_backend> :
+      public std::integral_constant<int,number_kind_floating_point> {
+    };
+
+  }
+}
+
+namespace o2scl {
+
+  /// \name Functions required by boost::multiprecision
+  //@{
+  inline void eval_add(dd_real_backend &r, const dd_real_backend &a) {
+    r.add(a);
+  }
+  inline void eval_add(dd_real_backend &r, double a) {
+    r.add(a);
+  }
+  inline void eval_subtract(dd_real_backend &r, const dd_real_backend &a) {
+    dd_real_backend t(a);
+    t.negate();
+    r.add(t);
+  }
+  inline void eval_subtract(dd_real_backend &r, double a) {
+    r.add(-a);
+  }
+  inline void eval_multiply(dd_real_backend &r, const dd_real_backend &a) {
+    r.mul(a);
+  }
+  inline void eval_multiply(dd_real_backend &r, double a) {
+    r.mul(a);
+  }
+  inline void eval_divide(dd_real_backend &r, const dd_real_backend &a) {
+    r.div(a);
+  }
+  inline void eval_divide(dd_real_backend &r, double a) {
+    r.div(a);
+  }
+  inline void eval_add(dd_real_backend &r, const dd_real_backend &a,
+                       const dd_real_backend &b) {
+    r=a;
+    r.add(b);
+  }
+  inline void eval_subtract(dd_real_backend &r, const dd_real_backend &a,
+                            const dd_real_backend &b) {
+    dd_real_backend t(b);
+    t.negate();
+    r=a;
+    r.add(t);
+  }
+  inline void eval_multiply(dd_real_backend &r, const dd_real_backend &a,
+                            const dd_real_backend &b) {
+    r=a;
+    r.mul(b);
+  }
+  inline void eval_divide(dd_real_backend &r, const dd_real_backend &a,
+                          const dd_real_backend &b) {
+    r=a;
+    r.div(b);
+  }
+
+  inline bool eval_is_zero(const dd_real_backend &a) {
+    return a.hi()==0.0;
+  }
+
+  inline int eval_get_sign(const dd_real_backend &a) {
+    return a.hi()>0.0 ? 1 : (a.hi()<0.0 ? -1 : 0);
+  }
+
+  /// Convert to a builtin floating point type
+  template<class R>
+  inline typename boost::enable_if_c<boost::is_floating_point<R>::value>::type
+  eval_convert_to(R *res, const dd_real_backend &a) {
+    *res=static_cast<R>(a.hi())+static_cast<R>(a.lo());
+  }
+
+  /// Convert to a builtin integer type, truncating toward zero
+  template<class R>
+  inline typename boost::enable_if_c<boost::is_integral<R>::value>::type
+  eval_convert_to(R *res, const dd_real_backend &a) {
+    double h=std::trunc(a.hi()), l=0.0;
+    if (h==a.hi()) {
+      // The leading part is an integer, so truncate the sum
+      l=std::trunc(a.lo());
+      if (h>0.0 && a.lo()<0.0 && l!=a.lo()) l-=1.0;
+      if (h<0.0 && a.lo()>0.0 && l!=a.lo()) l+=1.0;
+    }
+    *res=static_cast<R>(h)+static_cast<R>(l);
+  }
+
+  inline void eval_frexp(dd_real_backend &r, const dd_real_backend &a,
+                         int *e) {
+    double h=std::frexp(a.hi(),e);
+    r=dd_real_backend(h,std::ldexp(a.lo(),-*e));
+  }
+
+  inline void eval_ldexp(dd_real_backend &r, const dd_real_backend &a,
+                         int e) {
+    r=dd_real_backend(std::ldexp(a.hi(),e),std::ldexp(a.lo(),e));
+  }
+
+  inline void eval_floor(dd_real_backend &r, const dd_real_backend &a) {
+    double h=std::floor(a.hi()), l=0.0;
+    if (h==a.hi()) {
+      l=std::floor(a.lo());
+      dd_real_backend::quick_two_sum(h,l,h,l);
+    }
+    r=dd_real_backend(h,l);
+  }
+
+  inline void eval_ceil(dd_real_backend &r, const dd_real_backend &a) {
+    double h=std::ceil(a.hi()), l=0.0;
+    if (h==a.hi()) {
+      l=std::ceil(a.lo());
+      dd_real_backend::quick_two_sum(h,l,h,l);
+    }
+    r=dd_real_backend(h,l);
+  }
+
+  inline int eval_fpclassify(const dd_real_backend &a) {
+    return std::fpclassify(a.hi());
+  }
+
+  inline void eval_abs(dd_real_backend &r, const dd_real_backend &a) {
+    r=a;
+    if (a.hi()<0.0) r.negate();
+  }
+
+  inline void eval_fabs(dd_real_backend &r, const dd_real_backend &a) {
+    r=a;
+    if (a.hi()<0.0) r.negate();
+  }
+
+  /// Square root using one Newton step from the double result
+  inline void eval_sqrt(dd_real_backend &r, const dd_real_backend &a) {
+    if (a.hi()<=0.0 || !std::isfinite(a.hi())) {
+      r=dd_real_backend(std::sqrt(a.hi()),0.0);
+      return;
+    }
+    double x=1.0/std::sqrt(a.hi());
+    double ax=a.hi()*x;
+    // Compute a-ax^2
+    double p, e;
+    dd_real_backend::two_prod(ax,ax,p,e);
+    dd_real_backend t(a);
+    t.add(dd_real_backend(-p,-e));
+    double s, f;
+    dd_real_backend::two_sum(ax,t.hi()*x*0.5,s,f);
+    r=dd_real_backend(s,f);
+  }
+
+  /** \brief Exponential function
+
+      This uses the argument reduction \f$ e^x = 2^k
+      (e^{r})^{512} \f$ with \f$ r = (x-k \ln 2)/512 \f$, followed
+      by a Taylor series for \f$ e^r-1 \f$.
+  */
+  inline void eval_exp(dd_real_backend &r, const dd_real_backend &a) {
+
+    // ln(2) as a double-double
+    static const dd_real_backend ln2(6.931471805599452862e-01,
+                                     2.319046813846299558e-17);
+
+    if (a.hi()>709.79) {
+      r=dd_real_backend(std::numeric_limits<double>::infinity(),0.0);
+      return;
+    }
+    if (a.hi()<-745.2) {
+      r=dd_real_backend(0.0,0.0);
+      return;
+    }
+    if (!std::isfinite(a.hi())) {
+      r=dd_real_backend(std::exp(a.hi()),0.0);
+      return;
+    }
+    if (a.hi()==0.0) {
+      r=dd_real_backend(1.0,0.0);
+      return;
+    }
+
+    // Argument reduction
+    double k=std::floor(a.hi()/ln2.hi()+0.5);
+    dd_real_backend x(ln2);
+    x.mul(-k);
+    x.add(a);
+    x.mul(1.0/512.0);
+
+    // Taylor series for exp(x)-1, with |x| < 0.00068
+    dd_real_backend s(x), p(x), t;
+    double thresh=std::fabs(x.hi())*1.0e-32;
+    for(int i=2;i<=12;i++) {
+      p.mul(x);
+      t=p;
+      t.div(static_cast<double>(i));
+      s.add(t);
+      if (std::fabs(t.hi())<thresh) break;
+      // Keep p as x^i/i! to avoid large factorials
+      p=t;
+    }
+
+    // Undo the reduction by 512 using (e^x-1)^2+2(e^x-1)
+    for(int i=0;i<9;i++) {
+      t=s;
+      t.mul(s);
+      s.mul(2.0);
+      s.add(t);
+    }
+    s.add(1.0);
+    eval_ldexp(r,s,static_cast<int>(k));
+    return;
+  }
+
+  /** \brief Natural logarithm
+
+      This uses Newton's method, \f$ x_{n+1} = x_n + a e^{-x_n} - 1
+      \f$, starting from the double precision result.
+  */
+  inline void eval_log(dd_real_backend &r, const dd_real_backend &a) {
+    if (a.hi()==1.0 && a.lo()==0.0) {
+      r=dd_real_backend(0.0,0.0);
+      return;
+    }
+    if (a.hi()<=0.0 || !std::isfinite(a.hi())) {
+      r=dd_real_backend(std::log(a.hi()),0.0);
+      return;
+    }
+    dd_real_backend x(std::log(a.hi()),0.0), t(x);
+    t.negate();
+    eval_exp(t,t);
+    t.mul(a);
+    t.add(-1.0);
+    x.add(t);
+    r=x;
+    return;
+  }
+
+  inline std::size_t hash_value(const dd_real_backend &a) {
+    return std::hash<double>()(a.hi())^std::hash<double>()(a.lo());
+  }
+  //@}
+
+  /** \brief Double-double floating point type with about 32 digits
+      of precision
+
+      This type can be used as the floating point type in templates
+      which support boost::multiprecision types, e.g. \ref
+      o2scl::inte_tanh_sinh_boost, \ref o2scl::root_brent_gsl and
+      \ref o2scl::fermion_rel_integ_multip. Expression templates
+      are disabled since the basic operations are cheap. See \ref
+      o2scl::dd_real_backend for details.
+  */
+  typedef boost::multiprecision::number<dd_real_backend,
+                                        boost::multiprecision::et_off>
+  dd_real;
+
+  /// \name Compatibility functions for dd_real (see src/base/misc.h)
+  //@{
+  /** \brief Absolute value for dd_real
+   */
+  inline dd_real o2abs(const dd_real x) {
+    return boost::multiprecision::abs(x);
+  }
+
+  /** \brief Exponential for dd_real
+   */
+  inline dd_real o2exp(const dd_real x) {
+    return boost::multiprecision::exp(x);
+  }
+
+  /** \brief Logarithm for dd_real
+   */
+  inline dd_real o2log(const dd_real x) {
+    return boost::multiprecision::log(x);
+  }
+
+  /** \brief Square root for dd_real
+   */
+  inline dd_real o2sqrt(const dd_real x) {
+    return boost::multiprecision::sqrt(x);
+  }
+
+  /** \brief Power function for dd_real
+   */
+  inline dd_real o2pow(const dd_real x, const dd_real y) {
+    return boost::multiprecision::pow(x,y);
+  }
+
+  /** \brief Compatbility function for isfinite()
+   */
+  inline bool o2isfinite(const dd_real x) {
+    return std::isfinite(x.backend().hi());
+  }
+
+  /** \brief Compatbility function for hypot()
+   */
+  inline dd_real o2hypot(const dd_real x, const dd_real y) {
+    dd_real ax=boost::multiprecision::abs(x);
+    dd_real ay=boost::multiprecision::abs(y);
+    if (ax<ay) std::swap(ax,ay);
+    if (ax==0) return ax;
+    dd_real r=ay/ax;
+    return ax*boost::multiprecision::sqrt(1+r*r);
+  }
+  //@}
+
+}
+
+namespace std {
+
+  /** \brief Numeric limits for \ref o2scl::dd_real
+   */
+  template<boost::multiprecision::expression_template_option ET>
+  class numeric_limits<boost::multiprecision::number
+                       <o2scl::dd_real_backend,ET> > {
+
+    typedef boost::multiprecision::number<o2scl::dd_real_backend,ET>
+    number_type;
+
+  public:
+
+    static const bool is_specialized=true;
+    /** \brief The smallest number for which the trailing part
+        is a normalized double
+    */
+    static number_type (min)() {
+      return number_type(o2scl::dd_real_backend
+                         (std::ldexp(1.0,-1022+53),0.0));
+    }
+    static number_type (max)() {
+      return number_type(o2scl::dd_real_backend
+                         ((std::numeric_limits<double>::max)(),
+                          std::ldexp(1.0,1023-54)));
+    }
+    static number_type lowest() {
+      return -(max)();
+    }
+    static const int digits=106;
+    static const int digits10=31;
+    static const int max_digits10=33;
+    static const bool is_signed=true;
+    static const bool is_integer=false;
+    static const bool is_exact=false;
+    static const int radix=2;
+    static number_type epsilon() {
+      return number_type(o2scl::dd_real_backend(std::ldexp(1.0,-105),0.0));
+    }
+    static number_type round_error() {
+      return number_type(o2scl::dd_real_backend(0.5,0.0));
+    }
+    static const int min_exponent=-1021+53;
+    static const int min_exponent10=-291;
+    static const int max_exponent=1024;
+    static const int max_exponent10=308;
+    static const bool has_infinity=true;
+    static const bool has_quiet_NaN=true;
+    static const bool has_signaling_NaN=false;
+    static const float_denorm_style has_denorm=denorm_absent;
+    static const bool has_denorm_loss=false;
+    static number_type infinity() {
+      return number_type(o2scl::dd_real_backend
+                         (std::numeric_limits<double>::infinity(),0.0));
+    }
+    static number_type quiet_NaN() {
+      return number_type(o2scl::dd_real_backend
+                         (std::numeric_limits<double>::quiet_NaN(),0.0));
+    }
+    static number_type signaling_NaN() {
+      return number_type(0);
+    }
+    static number_type denorm_min() {
+      return (min)();
+    }
+    static const bool is_iec559=false;
+    static const bool is_bounded=true;
+    static const bool is_modulo=false;
+    static const bool traps=false;
+    static const bool tinyness_before=false;
+    static const float_round_style round_style=round_to_nearest;
+  };
+
+#ifndef DOXYGEN_INTERNAL
+
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_specialized;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::digits;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::digits10;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::max_digits10;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_signed;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_integer;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_exact;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::radix;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::min_exponent;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::min_exponent10;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::max_exponent;
+  template<boost::multiprecision::expression_template_option ET>
+  const int numeric_limits<boost::multiprecision::number
+                           <o2scl::dd_real_backend,ET> >::max_exponent10;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::has_infinity;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::has_quiet_NaN;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::has_signaling_NaN;
+  template<boost::multiprecision::expression_template_option ET>
+  const float_denorm_style numeric_limits<boost::multiprecision::number
+                                          <o2scl::dd_real_backend,ET> >::
+  has_denorm;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::has_denorm_loss;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_iec559;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_bounded;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::is_modulo;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::traps;
+  template<boost::multiprecision::expression_template_option ET>
+  const bool numeric_limits<boost::multiprecision::number
+                            <o2scl::dd_real_backend,ET> >::tinyness_before;
+  template<boost::multiprecision::expression_template_option ET>
+  const float_round_style numeric_limits<boost::multiprecision::number
+                                         <o2scl::dd_real_backend,ET> >::
+  round_style;
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <o2scl/dd_real.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::multiprecision::cpp_dec_float_50 cpp_dec_float_50;
+
+/* Return the relative difference between a double-double value
+   and a 50-digit value
+ */
+double rel_diff(const dd_real &x, const cpp_dec_float_50 &y) {
+  cpp_dec_float_50 xc=static_cast<cpp_dec_float_50>(x.backend().hi())+
+    static_cast<cpp_dec_float_50>(x.backend().lo());
+  return static_cast<double>(abs((xc-y)/y));
+}
+
+int main(void) {
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  cout.setf(ios::scientific);
+
+  cout << "digits,digits10,max_digits10,epsilon: "
+       << numeric_limits<dd_real>::digits << " "
+       << numeric_limits<dd_real>::digits10 << " "
+       << numeric_limits<dd_real>::max_digits10 << " "
+       << static_cast<double>(numeric_limits<dd_real>::epsilon())
+       << endl;
+
+  // Basic arithmetic with values which are not exactly
+  // representable as doubles
+  dd_real one=1, three=3, seven=7;
+  dd_real x=one/three, y=seven/three;
+  cpp_dec_float_50 xc=cpp_dec_float_50(1)/3, yc=cpp_dec_float_50(7)/3;
+  t.test_abs(rel_diff(x,xc),0.0,1.0e-31,"division");
+  t.test_abs(rel_diff(x+y,xc+yc),0.0,1.0e-31,"addition");
+  t.test_abs(rel_diff(x-y,xc-yc),0.0,1.0e-31,"subtraction");
+  t.test_abs(rel_diff(x*y,xc*yc),0.0,1.0e-31,"multiplication");
+  t.test_abs(rel_diff(x*3-one+y,yc),0.0,1.0e-31,"mixed");
+
+  // Integers larger than 2^53
+  dd_real big=static_cast<long long>(1234567890123456789LL);
+  t.test_gen(big.convert_to<long long>()==1234567890123456789LL,
+             "large integer");
+
+  // Elementary functions
+  t.test_abs(rel_diff(sqrt(y),sqrt(yc)),0.0,1.0e-31,"sqrt");
+  t.test_abs(rel_diff(exp(y),exp(yc)),0.0,1.0e-31,"exp");
+  // The condition number of exp(x) is |x|
+  t.test_abs(rel_diff(exp(-y*100),exp(-yc*100)),0.0,233.0e-31,"exp 2");
+  t.test_abs(rel_diff(log(y),log(yc)),0.0,1.0e-31,"log");
+  t.test_abs(rel_diff(log(x/1000),log(xc/1000)),0.0,1.0e-31,"log 2");
+  t.test_abs(rel_diff(pow(y,x),pow(yc,xc)),0.0,1.0e-30,"pow");
+  t.test_abs(rel_diff(sin(y),sin(yc)),0.0,1.0e-30,"sin");
+  t.test_abs(rel_diff(tanh(x),tanh(xc)),0.0,1.0e-30,"tanh");
+  t.test_abs(rel_diff(log1p(x/1.0e10),log1p(xc/1.0e10)),0.0,1.0e-30,
+             "log1p");
+
+  // Constants and conversion from strings
+  dd_real pi=boost::math::constants::pi<dd_real>();
+  t.test_abs(rel_diff(pi,boost::math::constants::pi<cpp_dec_float_50>()),
+             0.0,1.0e-31,"pi");
+  dd_real s("2.718281828459045235360287471352662497757");
+  t.test_abs(rel_diff(s,exp(cpp_dec_float_50(1))),0.0,1.0e-31,
+             "from string");
+  cout << "e: " << std::setprecision(32) << exp(one) << endl;
+  cout << std::setprecision(6);
+
+  // Special values
+  t.test_gen(o2isfinite(x),"finite");
+  t.test_gen(!o2isfinite(one/0),"infinite");
+  t.test_gen(!o2isfinite(log(-one)),"nan");
+  t.test_gen(exp(dd_real(-800))==0,"exp underflow");
+
+  t.report();
+  return 0;
+}
@@ -0,0 +1,485 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_DUAL_H
+#define O2SCL_DUAL_H
+
+/** \file dual.h
+    \brief File defining \ref o2scl::dual_tl
+*/
+
+#include <cmath>
+#include <limits>
+#include <iostream>
+#include <type_traits>
+
+namespace o2scl {
+
+  /** \brief Return true if \c x is exactly zero
+   */
+  template<class fp_t> bool dual_is_zero(const fp_t &x) {
+    return x==0;
+  }
+
+  /** \brief A dual number for forward-mode automatic differentiation
+
+      A dual number \f$ x = v + d~\epsilon \f$ with \f$ \epsilon^2=0
+      \f$ carries a value, \ref val, and a derivative, \ref der,
+      through a computation. Setting the derivative of an input to
+      one and evaluating a function \f$ f \f$ gives \f$ f(v) +
+      f^{\prime}(v)~\epsilon \f$, so the derivative is exact to
+      within the floating point precision of \c fp_t and requires
+      only one evaluation.
+
+      Dual numbers may be nested to obtain higher derivatives. The
+      type <tt>dual_tl<dual_tl<double> ></tt> (see \ref
+      o2scl::hyper_dual) is a hyper-dual number with two independent
+      infinitesimals: seeding the value of the outer dual with
+      <tt>dual(x,1)</tt> and its derivative with <tt>dual(1,0)</tt>
+      gives \f$ f(x) \f$ in <tt>val.val</tt>, \f$ f^{\prime}(x) \f$
+      in both <tt>val.der</tt> and <tt>der.val</tt>, and \f$
+      f^{\prime\prime}(x) \f$ in <tt>der.der</tt>. Seeding the two
+      infinitesimals with different inputs gives mixed partial
+      derivatives instead.
+
+      Comparisons use only the value, so code which branches on the
+      value of a variable differentiates the branch which is taken.
+      The elementary functions skip the chain rule when the
+      derivative of the argument is exactly zero, so that (for
+      example) <tt>pow(x,a)</tt> at \f$ x=0 \f$ is finite when
+      \f$ x \f$ is constant.
+
+      This type is compatible with the classes which are templated
+      on a floating point type and use only arithmetic and the
+      elementary functions defined below, e.g. \ref
+      o2scl::fermion_zerot_tl and \ref
+      o2scl::eos_had_skyrme::calc_e_tl() .
+  */
+  template<class fp_t=double> class dual_tl {
+
+  public:
+
+    /// The value
+    fp_t val;
+
+    /// The derivative
+    fp_t der;
+
+    /// Create a dual number equal to zero
+    dual_tl() : val(0), der(0) {
+    }
+
+    /// Create a dual number with value \c x and derivative \c dx
+    dual_tl(const fp_t &x, const fp_t &dx=fp_t(0)) : val(x), der(dx) {
+    }
+
+    /// Create a constant from an arithmetic type
+    template<class arith_t, typename std::enable_if
+             <std::is_arithmetic<arith_t>::value,int>::type=0>
+    dual_tl(arith_t x) : val(x), der(0) {
+    }
+
+    /// Convert to \c double, discarding the derivative
+    explicit operator double() const {
+      return static_cast<double>(val);
+    }
+
+    /// \name Arithmetic
+    //@{
+    dual_tl &operator+=(const dual_tl &b) {
+      val+=b.val;
+      der+=b.der;
+      return *this;
+    }
+
+    dual_tl &operator-=(const dual_tl &b) {
+      val-=b.val;
+      der-=b.der;
+      return *this;
+    }
+
+    dual_tl &operator*=(const dual_tl &b) {
+      der=der*b.val+val*b.der;
+      val*=b.val;
+      return *this;
+    }
+
+    dual_tl &operator/=(const dual_tl &b) {
+      val/=b.val;
+      der=(der-val*b.der)/b.val;
+      return *this;
+    }
+
+    friend dual_tl operator-(const dual_tl &a) {
+      return dual_tl(-a.val,-a.der);
+    }
+
+    friend dual_tl operator+(const dual_tl &a) {
+      return a;
+    }
+
+    friend dual_tl operator+(const dual_tl &a, const dual_tl &b) {
+      return dual_tl(a.val+b.val,a.der+b.der);
+    }
+
+    friend dual_tl operator-(const dual_tl &a, const dual_tl &b) {
+      return dual_tl(a.val-b.val,a.der-b.der);
+    }
+
+    friend dual_tl operator*(const dual_tl &a, const dual_tl &b) {
+      return dual_tl(a.val*b.val,a.der*b.val+a.val*b.der);
+    }
+
+    friend dual_tl operator/(const dual_tl &a, const dual_tl &b) {
+      fp_t q=a.val/b.val;
+      return dual_tl(q,(a.der-q*b.der)/b.val);
+    }
+    //@}
+
+    /// \name Comparisons (using the value only)
+    //@{
+    friend bool operator==(const dual_tl &a, const dual_tl &b) {
+      return a.val==b.val;
+    }
+
+    friend bool operator!=(const dual_tl &a, const dual_tl &b) {
+      return a.val!=b.val;
+    }
+
+    friend bool operator<(const dual_tl &a, const dual_tl &b) {
+      return a.val<b.val;
+    }
+
+    friend bool operator>(const dual_tl &a, const dual_tl &b) {
+      return a.val>b.val;
+    }
+
+    friend bool operator<=(const dual_tl &a, const dual_tl &b) {
+      return a.val<=b.val;
+    }
+
+    friend bool operator>=(const dual_tl &a, const dual_tl &b) {
+      return a.val>=b.val;
+    }
+    //@}
+
+    /// \name Elementary functions
+    //@{
+    friend dual_tl abs(const dual_tl &a) {
+      if (a.val<0) return -a;
+      return a;
+    }
+
+    friend dual_tl fabs(const dual_tl &a) {
+      return abs(a);
+    }
+
+    friend dual_tl sqrt(const dual_tl &a) {
+      using std::sqrt;
+      fp_t s=sqrt(a.val);
+      return dual_tl(s,chain(a.der,1/(2*s)));
+    }
+
+    friend dual_tl cbrt(const dual_tl &a) {
+      using std::cbrt;
+      fp_t c=cbrt(a.val);
+      return dual_tl(c,chain(a.der,1/(3*c*c)));
+    }
+
+    friend dual_tl exp(const dual_tl &a) {
+      using std::exp;
+      fp_t e=exp(a.val);
+      return dual_tl(e,chain(a.der,e));
+    }
+
+    friend dual_tl log(const dual_tl &a) {
+      using std::log;
+      return dual_tl(log(a.val),chain(a.der,1/a.val));
+    }
+
+    friend dual_tl log1p(const dual_tl &a) {
+      using std::log1p;
+      return dual_tl(log1p(a.val),chain(a.der,1/(1+a.val)));
+    }
+
+    friend dual_tl pow(const dual_tl &a, const dual_tl &b) {
+      using std::pow;
+      using std::log;
+      fp_t p=pow(a.val,b.val);
+      fp_t d=chain(a.der,b.val*pow(a.val,b.val-1));
+      if (!dual_is_zero(b.der) && p!=0) d+=b.der*p*log(a.val);
+      return dual_tl(p,d);
+    }
+
+    friend dual_tl sin(const dual_tl &a) {
+      using std::sin;
+      using std::cos;
+      return dual_tl(sin(a.val),chain(a.der,cos(a.val)));
+    }
+
+    friend dual_tl cos(const dual_tl &a) {
+      using std::sin;
+      using std::cos;
+      return dual_tl(cos(a.val),chain(a.der,-sin(a.val)));
+    }
+
+    friend dual_tl sinh(const dual_tl &a) {
+      using std::sinh;
+      using std::cosh;
+      return dual_tl(sinh(a.val),chain(a.der,cosh(a.val)));
+    }
+
+    friend dual_tl cosh(const dual_tl &a) {
+      using std::sinh;
+      using std::cosh;
+      return dual_tl(cosh(a.val),chain(a.der,sinh(a.val)));
+    }
+
+    friend dual_tl tanh(const dual_tl &a) {
+      using std::tanh;
+      fp_t t=tanh(a.val);
+      return dual_tl(t,chain(a.der,1-t*t));
+    }
+
+    friend dual_tl atan(const dual_tl &a) {
+      using std::atan;
+      return dual_tl(atan(a.val),chain(a.der,1/(1+a.val*a.val)));
+    }
+
+    friend dual_tl asinh(const dual_tl &a) {
+      using std::asinh;
+      using std::sqrt;
+      return dual_tl(asinh(a.val),chain(a.der,1/sqrt(1+a.val*a.val)));
+    }
+
+    friend bool isfinite(const dual_tl &a) {
+      using std::isfinite;
+      return isfinite(a.val) && isfinite(a.der);
+    }
+    //@}
+
+    /// Output the value (but not the derivative) to a stream
+    friend std::ostream &operator<<(std::ostream &os, const dual_tl &a) {
+      os << a.val;
+      return os;
+    }
+
+  protected:
+
+    /** \brief Return the product of the derivative \c dx and the
+        factor \c fx, or zero if \c dx is exactly zero
+    */
+    static fp_t chain(const fp_t &dx, const fp_t &fx) {
+      if (dual_is_zero(dx)) return fp_t(0);
+      return dx*fx;
+    }
+
+  };
+
+  /** \brief Return true if both the value and all of the
+      derivatives of \c x are exactly zero
+  */
+  template<class fp_t> bool dual_is_zero(const dual_tl<fp_t> &x) {
+    return dual_is_zero(x.val) && dual_is_zero(x.der);
+  }
+
+  /** \brief Double precision dual number
+   */
+  typedef dual_tl<double> dual;
+
+  /** \brief Double precision hyper-dual number for second
+      derivatives
+  */
+  typedef dual_tl<dual_tl<double> > hyper_dual;
+
+  /// \name Compatibility functions for dual numbers (see src/base/misc.h)
+  //@{
+  /** \brief Absolute value for dual numbers
+   */
+  template<class fp_t> dual_tl<fp_t> o2abs(const dual_tl<fp_t> &x) {
+    return abs(x);
+  }
+
+  /** \brief Exponential for dual numbers
+   */
+  template<class fp_t> dual_tl<fp_t> o2exp(const dual_tl<fp_t> &x) {
+    return exp(x);
+  }
+
+  /** \brief Logarithm for dual numbers
+   */
+  template<class fp_t> dual_tl<fp_t> o2log(const dual_tl<fp_t> &x) {
+    return log(x);
+  }
+
+  /** \brief Square root for dual numbers
+   */
+  template<class fp_t> dual_tl<fp_t> o2sqrt(const dual_tl<fp_t> &x) {
+    return sqrt(x);
+  }
+
+  /** \brief Power function for dual numbers
+   */
+  template<class fp_t> dual_tl<fp_t> o2pow(const dual_tl<fp_t> &x,
+                                           const dual_tl<fp_t> &y) {
+    return pow(x,y);
+  }
+
+  /** \brief Compatbility function for isfinite()
+   */
+  template<class fp_t> bool o2isfinite(const dual_tl<fp_t> &x) {
+    return isfinite(x);
+  }
+
+  /** \brief Compatbility function for hypot()
+   */
+  template<class fp_t> dual_tl<fp_t> o2hypot(const dual_tl<fp_t> &x,
+                                             const dual_tl<fp_t> &y) {
+    dual_tl<fp_t> ax=abs(x), ay=abs(y);
+    if (ax<ay) std::swap(ax,ay);
+    if (ax==0) return ax;
+    dual_tl<fp_t> r=ay/ax;
+    return ax*sqrt(1+r*r);
+  }
+  //@}
+
+}
+
+namespace std {
+
+  /** \brief Numeric limits for \ref o2scl::dual_tl
+
+      These are the limits of the underlying floating point type.
+  */
+  template<class fp_t> class numeric_limits<o2scl::dual_tl<fp_t> > {
+
+    typedef o2scl::dual_tl<fp_t> dual_type;
+
+  public:
+
+    static const bool is_specialized=true;
+    static dual_type (min)() {
+      return dual_type((numeric_limits<fp_t>::min)());
+    }
+    static dual_type (max)() {
+      return dual_type((numeric_limits<fp_t>::max)());
+    }
+    static dual_type lowest() {
+      return dual_type(numeric_limits<fp_t>::lowest());
+    }
+    static const int digits=numeric_limits<fp_t>::digits;
+    static const int digits10=numeric_limits<fp_t>::digits10;
+    static const int max_digits10=numeric_limits<fp_t>::max_digits10;
+    static const bool is_signed=true;
+    static const bool is_integer=false;
+    static const bool is_exact=false;
+    static const int radix=numeric_limits<fp_t>::radix;
+    static dual_type epsilon() {
+      return dual_type(numeric_limits<fp_t>::epsilon());
+    }
+    static dual_type round_error() {
+      return dual_type(numeric_limits<fp_t>::round_error());
+    }
+    static const int min_exponent=numeric_limits<fp_t>::min_exponent;
+    static const int min_exponent10=numeric_limits<fp_t>::min_exponent10;
+    static const int max_exponent=numeric_limits<fp_t>::max_exponent;
+    static const int max_exponent10=numeric_limits<fp_t>::max_exponent10;
+    static const bool has_infinity=numeric_limits<fp_t>::has_infinity;
+    static const bool has_quiet_NaN=numeric_limits<fp_t>::has_quiet_NaN;
+    static const bool has_signaling_NaN=false;
+    static const float_denorm_style has_denorm=denorm_absent;
+    static const bool has_denorm_loss=false;
+    static dual_type infinity() {
+      return dual_type(numeric_limits<fp_t>::infinity());
+    }
+    static dual_type quiet_NaN() {
+      return dual_type(numeric_limits<fp_t>::quiet_NaN());
+    }
+    static dual_type signaling_NaN() {
+      return dual_type(numeric_limits<fp_t>::quiet_NaN());
+    }
+    static dual_type denorm_min() {
+      return (min)();
+    }
+    static const bool is_iec559=false;
+    static const bool is_bounded=numeric_limits<fp_t>::is_bounded;
+    static const bool is_modulo=false;
+    static const bool traps=false;
+    static const bool tinyness_before=false;
+    static const float_round_style round_style=
+      numeric_limits<fp_t>::round_style;
+  };
+
+#ifndef DOXYGEN_INTERNAL
+
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_specialized;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::digits;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::digits10;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::max_digits10;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_signed;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_integer;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_exact;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::radix;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::has_infinity;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::has_quiet_NaN;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::min_exponent;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::min_exponent10;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::max_exponent;
+  template<class fp_t>
+  const int numeric_limits<o2scl::dual_tl<fp_t> >::max_exponent10;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::has_signaling_NaN;
+  template<class fp_t>
+  const float_denorm_style numeric_limits<o2scl::dual_tl<fp_t> >::has_denorm;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::has_denorm_loss;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_iec559;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_bounded;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::is_modulo;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::traps;
+  template<class fp_t>
+  const bool numeric_limits<o2scl::dual_tl<fp_t> >::tinyness_before;
+  template<class fp_t>
+  const float_round_style numeric_limits<o2scl::dual_tl<fp_t> >::round_style;
+
+#endif
+
+}
+
+#endif
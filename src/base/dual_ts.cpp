@@ -0,0 +1,88 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <boost/math/constants/constants.hpp>
+
+#include <o2scl/dual.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+template<class fp_t> fp_t f(fp_t x) {
+  return pow(x,2.5)*exp(-x)+log(x)*sqrt(x)/cbrt(x)+tanh(x)*sin(x);
+}
+
+double dfdx(double x) {
+  return 2.5*pow(x,1.5)*exp(-x)-pow(x,2.5)*exp(-x)+
+    (1.0/x*pow(x,1.0/6.0)+log(x)*pow(x,-5.0/6.0)/6.0)+
+    (1.0-tanh(x)*tanh(x))*sin(x)+tanh(x)*cos(x);
+}
+
+template<class fp_t> fp_t g(fp_t x, fp_t y) {
+  return x*x*y+exp(x*y)/y;
+}
+
+int main(void) {
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  cout.setf(ios::scientific);
+
+  // First derivatives
+  dual x(1.3,1.0);
+  dual fx=f(x);
+  t.test_rel(fx.val,f(1.3),1.0e-15,"value");
+  t.test_rel(fx.der,dfdx(1.3),1.0e-14,"first derivative");
+
+  // Second derivatives with a hyper-dual number
+  hyper_dual hx(dual(1.3,1.0),dual(1.0,0.0));
+  hyper_dual hfx=f(hx);
+  double h=1.0e-4;
+  t.test_rel(hfx.val.val,f(1.3),1.0e-15,"hyper-dual value");
+  t.test_rel(hfx.val.der,dfdx(1.3),1.0e-14,"hyper-dual first 1");
+  t.test_rel(hfx.der.val,dfdx(1.3),1.0e-14,"hyper-dual first 2");
+  t.test_rel(hfx.der.der,(dfdx(1.3+h)-dfdx(1.3-h))/2.0/h,1.0e-7,
+             "second derivative");
+
+  // Mixed partial derivatives
+  double x0=0.7, y0=1.1;
+  hyper_dual hx2(dual(x0,1.0),0.0), hy2(y0,dual(1.0,0.0));
+  hyper_dual hg=g(hx2,hy2);
+  t.test_rel(hg.val.der,2.0*x0*y0+exp(x0*y0),1.0e-14,"dg/dx");
+  t.test_rel(hg.der.val,x0*x0+exp(x0*y0)*(x0/y0-1.0/y0/y0),
+             1.0e-14,"dg/dy");
+  t.test_rel(hg.der.der,2.0*x0+exp(x0*y0)*x0,1.0e-14,"d2g/dx/dy");
+
+  // Powers of zero with a constant base
+  dual z(0.0,0.0), a(0.5,1.0);
+  t.test_gen(o2isfinite(pow(z,a)),"pow of zero");
+  
+  // Constants and comparisons
+  dual pi=boost::math::constants::pi<dual>();
+  t.test_rel(pi.val,boost::math::constants::pi<double>(),1.0e-15,"pi");
+  t.test_gen(x>1.0 && 2.0*x<3.0 && x!=1.0,"comparisons");
+
+  t.report();
+  return 0;
+}
@@ -34,8 +34,7 @@
 using namespace std;
 using namespace o2scl;
 
-err_hnd_type *o2scl::err_hnd;
-err_hnd_gsl o2scl::alt_err_hnd;
+thread_local err_hnd_gsl o2scl::alt_err_hnd;
 
 err_hnd_gsl::err_hnd_gsl() {
   
@@ -128,10 +128,13 @@ namespace o2scl {
 
   /** \brief The global error handler pointer
 
-      This is set by the \ref def_err_hnd constructor to 
-      point to that object.
+      This pointer is thread-local: each thread has its own copy,
+      which initially points to that thread's \ref def_err_hnd
+      object. Setting the error handler in one thread does not
+      affect the other threads, and errors set in one thread are
+      not visible from the others.
    */      
-  extern err_hnd_type *err_hnd;
+  extern thread_local err_hnd_type *err_hnd;
 
   /** \brief Class defining an error handler [abstract base]
 
@@ -266,8 +269,10 @@ namespace o2scl {
   };
 
   /** \brief An alternate GSL-like error handler
+
+      Like \ref err_hnd, this object is thread-local.
    */      
-  extern err_hnd_gsl alt_err_hnd;
+  extern thread_local err_hnd_gsl alt_err_hnd;
 
   /** \brief Set an error with message \c d and code \c n
    */
@@ -36,17 +36,35 @@
 using namespace std;
 using namespace o2scl;
 
-err_hnd_cpp o2scl::def_err_hnd;
-
-err_hnd_cpp::err_hnd_cpp() {
+thread_local err_hnd_cpp o2scl::def_err_hnd;
 
 #ifdef O2SCL_USE_GSL_HANDLER
-  err_hnd=&alt_err_hnd;
+thread_local err_hnd_type *o2scl::err_hnd=&alt_err_hnd;
 #else
-  err_hnd=this;
+thread_local err_hnd_type *o2scl::err_hnd=&def_err_hnd;
 #endif
+
+namespace {
+
+  /* Thread-local objects are initialized on first use in each
+     thread, so ensure the handler for the main thread is set when
+     the library is loaded. The GSL error handler is global, so it
+     is set only here (and not in the err_hnd_cpp constructor,
+     which runs once for every thread) to avoid a data race and to
+     avoid overwriting a GSL handler set by the user.
+  */
+  class err_hnd_init {
+  public:
+    err_hnd_init() {
+      gsl_set_error_handler(err_hnd->gsl_hnd);
+    }
+  };
   
-  gsl_set_error_handler(err_hnd->gsl_hnd);
+  err_hnd_init main_err_hnd_init;
+  
+}
+
+err_hnd_cpp::err_hnd_cpp() {
 }
 
 void err_hnd_cpp::set(const char *reason, const char *file, 
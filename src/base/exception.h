@@ -276,8 +276,11 @@ namespace o2scl {
   };
 
   /** \brief The default error handler
+
+      This object is thread-local, so that each thread records
+      its own error information.
    */      
-  extern err_hnd_cpp def_err_hnd;
+  extern thread_local err_hnd_cpp def_err_hnd;
 
 }
 
@@ -24,6 +24,10 @@
 #include <o2scl/test_mgr.h>
 #include <o2scl/exception.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 
@@ -44,6 +48,31 @@ int main(void) {
   }
   cout << err_hnd->get_str() << endl;
 
+#ifdef O2SCL_OPENMP
+
+  // Each thread has its own error handler
+  int errnos[2]={0,0}, nthreads=1;
+  int codes[2]={exc_efailed,exc_einval};
+#pragma omp parallel num_threads(2)
+  {
+    int it=omp_get_thread_num();
+#pragma omp single
+    nthreads=omp_get_num_threads();
+    try {
+      O2SCL_ERR("Thread exception test",codes[it]);
+    } catch (std::exception &e) {
+    }
+#pragma omp barrier
+    errnos[it]=err_hnd->get_errno();
+    err_hnd->reset();
+  }
+  if (nthreads==2) {
+    t.test_gen(errnos[0]==exc_efailed,"thread 0 errno");
+    t.test_gen(errnos[1]==exc_einval,"thread 1 errno");
+  }
+  
+#endif
+  
   t.report();
   return 0;
 }
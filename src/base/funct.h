@@ -41,6 +41,7 @@
 #include <o2scl/err_hnd.h>
 #include <o2scl/calc_utf8.h>
 #include <o2scl/lib_settings.h>
+#include <o2scl/dd_real.h>
 
 #ifdef O2SCL_PYTHON
 #include <Python.h>
@@ -54,6 +55,14 @@ namespace o2scl {
   /// One-dimensional function typedef in src/base/funct.h
   typedef std::function<long double(long double)> funct_ld;
 
+  /** \brief Batch one-dimensional function typedef in src/base/funct.h
+
+      The first argument is the number of points, the second is a
+      pointer to the abscissas, and the third is a pointer to the
+      array in which the function values are to be stored.
+  */
+  typedef std::function<void(size_t,const double *,double *)> funct_batch;
+
   /** \brief One-dimensional function typedef in src/base/funct.h
    */
   typedef std::function<boost::multiprecision::number<
@@ -76,6 +85,11 @@ namespace o2scl {
 			(boost::multiprecision::cpp_dec_float_50)>
   funct_cdf50;
 
+  /** \brief One-dimensional function typedef in src/base/funct.h
+      for the double-double type \ref o2scl::dd_real
+   */
+  typedef std::function<dd_real(dd_real)> funct_dd;
+
 #ifdef O2SCL_MPFR
   
   /** \brief One-dimensional function typedef in src/base/funct.h
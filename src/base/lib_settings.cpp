@@ -495,6 +495,11 @@ void lib_settings_class::config_h_report() {
 #else
   cout << "HAVE_LIBHDF5_HL: <not defined>" << endl;
 #endif
+#ifdef HAVE_LIBZ
+  cout << "HAVE_LIBZ: " << HAVE_LIBZ << endl;
+#else
+  cout << "HAVE_LIBZ: <not defined>" << endl;
+#endif
 #ifdef HAVE_MALLOC
   cout << "HAVE_MALLOC: " << HAVE_MALLOC << endl;
 #else
@@ -47,6 +47,17 @@ namespace o2scl {
   typedef std::function<
     double(size_t,const boost::numeric::ublas::vector<double> &)>
   multi_funct;
+
+  /** \brief Batch multi-dimensional function typedef in
+      src/base/multi_funct.h
+
+      The function is called as <tt>func(n,nv,x,y)</tt> and must
+      compute the value of the function at \c n points in \c nv
+      dimensions, storing the value at the point
+      <tt>x[i*nv]</tt>, ..., <tt>x[i*nv+nv-1]</tt> in <tt>y[i]</tt>.
+  */
+  typedef std::function<void(size_t,size_t,const double *,double *)>
+  multi_funct_batch;
   
   /** \brief A multi-dimensional function from a string
    */
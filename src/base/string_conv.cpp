@@ -31,6 +31,13 @@
 #include <o2scl/find_constants.h>
 #include <o2scl/lib_settings.h>
 
+#include <cstdlib>
+#include <cctype>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 
@@ -204,6 +211,108 @@ int o2scl::stod_nothrow(string s, double &result) {
   return exc_einval;
 }
 
+int o2scl::parse_doubles(const std::string &s, std::vector<double> &data) {
+
+  data.clear();
+  size_t len=s.length();
+  if (len==0) return 0;
+  const char *str=s.c_str();
+
+  // Number of blocks to parse in parallel
+  size_t n_blocks=1;
+#ifdef O2SCL_OPENMP
+  if (len>=1048576) n_blocks=omp_get_max_threads();
+#endif
+
+  // Determine the block boundaries, moving each one forward to the
+  // next whitespace character so that no number is split between
+  // two blocks
+  std::vector<size_t> bounds(n_blocks+1);
+  bounds[0]=0;
+  bounds[n_blocks]=len;
+  for(size_t ib=1;ib<n_blocks;ib++) {
+    size_t j=len*ib/n_blocks;
+    if (j<bounds[ib-1]) j=bounds[ib-1];
+    while (j<len && !isspace((unsigned char)str[j])) j++;
+    bounds[ib]=j;
+  }
+
+  std::vector<std::vector<double> > bdata(n_blocks);
+  std::vector<int> bfail(n_blocks,0);
+  
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static) num_threads(n_blocks)
+#endif
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    const char *p=str+bounds[ib];
+    const char *end=str+bounds[ib+1];
+    std::vector<double> &bd=bdata[ib];
+    bd.reserve((bounds[ib+1]-bounds[ib])/8);
+    while (true) {
+      while (p<end && isspace((unsigned char)*p)) p++;
+      if (p>=end) break;
+      char *pend;
+      double x=strtod(p,&pend);
+      if (pend==p) {
+        bfail[ib]=1;
+        break;
+      }
+      bd.push_back(x);
+      p=pend;
+    }
+  }
+
+  // Collect the results, up to and including the first block
+  // which contains a non-numerical token
+  size_t n_used=n_blocks, ntot=0;
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    ntot+=bdata[ib].size();
+    if (bfail[ib]) {
+      n_used=ib+1;
+      break;
+    }
+  }
+  data.reserve(ntot);
+  for(size_t ib=0;ib<n_used;ib++) {
+    data.insert(data.end(),bdata[ib].begin(),bdata[ib].end());
+  }
+  
+  if (n_used<n_blocks || bfail[n_blocks-1]) return exc_efailed;
+  return 0;
+}
+
+int o2scl::read_doubles(std::istream &fin, std::vector<double> &data) {
+
+  std::string s;
+  
+  // Determine the number of remaining characters if possible
+  std::streampos start=fin.tellg();
+  bool seekable=false;
+  if (start!=std::streampos(-1)) {
+    fin.seekg(0,std::ios::end);
+    std::streampos stop=fin.tellg();
+    fin.seekg(start);
+    if (fin.good() && stop!=std::streampos(-1) && stop>=start) {
+      seekable=true;
+      s.resize((size_t)(stop-start));
+      if (s.length()>0) {
+        fin.read(&(s[0]),s.length());
+        s.resize((size_t)fin.gcount());
+      }
+    } else {
+      fin.clear();
+    }
+  }
+  
+  if (!seekable) {
+    std::ostringstream oss;
+    oss << fin.rdbuf();
+    s=oss.str();
+  }
+  
+  return parse_doubles(s,data);
+}
+
 int o2scl::s32tod_nothrow(u32string s, double &result) {
 
   string s2;
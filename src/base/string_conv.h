@@ -211,6 +211,34 @@ namespace o2scl {
     return 0;
   }
   
+  /** \brief Parse all of the whitespace-separated numbers in 
+      \c s and place them in \c data
+
+      This function is a faster replacement for repeatedly calling
+      <tt>operator>>()</tt> on a stream. The string is divided into
+      blocks which end on whitespace, and each block is converted
+      with <tt>strtod()</tt>, using multiple threads if OpenMP is
+      enabled and the string is larger than about 1 MB. Parsing
+      stops at the first token which does not begin with a number,
+      and in that case \c data contains all of the numbers before
+      it and the value \ref o2scl::exc_efailed is returned.
+      Otherwise, this function returns 0. Unlike
+      <tt>operator>>()</tt>, values like <tt>nan</tt> and
+      <tt>inf</tt> are accepted. The previous contents of \c data
+      are discarded.
+  */
+  int parse_doubles(const std::string &s, std::vector<double> &data);
+  
+  /** \brief Read the remainder of the stream \c fin into memory
+      and parse it with \ref parse_doubles()
+
+      If the stream supports seeking, the remainder of the stream is
+      read in a single block, otherwise it is read through the
+      stream buffer. The return value is that from \ref
+      parse_doubles().
+  */
+  int read_doubles(std::istream &fin, std::vector<double> &data);
+  
   /** \brief Find out if the number pointed to by \c x has a minus sign
       
       This function returns true if the number pointed to by \c x has
@@ -175,6 +175,32 @@ int main(void) {
     cpp_dec_float_50 pi=boost::math::constants::pi<cpp_dec_float_50>();
     cout << dtos(pi,-1) << endl;
   }
+
+  {
+    // Test parse_doubles() and read_doubles()
+    vector<double> vd;
+    int ret=parse_doubles("  1.5 -2\n3.0e2\t4 ",vd);
+    t.test_gen(ret==0 && vd.size()==4,"parse_doubles 1");
+    t.test_rel(vd[2],300.0,1.0e-15,"parse_doubles 2");
+    ret=parse_doubles("1 2 x 3",vd);
+    t.test_gen(ret!=0 && vd.size()==2,"parse_doubles 3");
+
+    // A string large enough to be parsed in parallel
+    ostringstream oss;
+    oss.precision(17);
+    for(size_t i=0;i<200000;i++) {
+      oss << ((double)i)/7.0 << " ";
+      if (i%5==4) oss << "\n";
+    }
+    istringstream iss(oss.str());
+    ret=read_doubles(iss,vd);
+    t.test_gen(ret==0 && vd.size()==200000,"read_doubles 1");
+    bool match=true;
+    for(size_t i=0;i<vd.size();i++) {
+      if (vd[i]!=((double)i)/7.0) match=false;
+    }
+    t.test_gen(match,"read_doubles 2");
+  }
   
   t.report();
   return 0;
@@ -2495,28 +2495,40 @@ namespace o2scl {
 
     /** \brief Sort the entire table by the column \c scol
 
-        \note This function works by allocating space for an entirely
-        new chunk of memory for the data in the table.
+        The sort is stable, so rows with equal values in column \c
+        scol keep their original relative order. The permutation is
+        computed with \ref vector_sort_index_radix() and then
+        applied to each column in turn, so only one column's worth
+        of temporary storage is required for each thread. If OpenMP
+        is enabled, the columns are permuted in parallel.
     */
     void sort_table(std::string scol) {
 
+      aiter it=atree.find(scol);
+      if (it==atree.end()) {
+        O2SCL_ERR((((std::string)"Column '")+scol+
+                   "' not found in table::sort_table().").c_str(),
+                  exc_enotfound);
+        return;
+      }
+      
       size_t ncols=get_ncolumns(), nlins=get_nlines();
+      if (nlins==0) return;
 
-      // Make a copy of the table
-      boost::numeric::ublas::matrix<double> data_copy(ncols,nlins);
+      std::vector<size_t> order(nlins);
+      vector_sort_index_radix(nlins,it->second.dat,order);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
       for(size_t i=0;i<ncols;i++) {
+        vec_t &col=alist[i]->second.dat;
+        std::vector<double> tmp(nlins);
         for(size_t j=0;j<nlins;j++) {
-          data_copy(i,j)=get(i,j);
+          tmp[j]=col[order[j]];
         }
-      }
-
-      permutation order(nlins);
-      aiter it=atree.find(scol);
-      vec_t &data=it->second.dat;
-      vector_sort_index(nlins,data,order);
-      for(size_t i=0;i<ncols;i++) {
         for(size_t j=0;j<nlins;j++) {
-          set(i,j,data_copy(i,order[j]));
+          col[j]=tmp[j];
         }
       }
   
@@ -2540,7 +2552,7 @@ namespace o2scl {
         return;
       }
 
-      vector_sort_double(nlines,it->second.dat);
+      vector_sort_radix(nlines,it->second.dat);
 
       if (intp_set && (scol==intp_colx || scol==intp_coly)) {
         intp_set=false;
@@ -2797,10 +2809,14 @@ namespace o2scl {
       return;
     }
   
-    /// Clear the current table and read from a generic data file
+    /** \brief Clear the current table and read from a generic data file
+
+        The data after the first line (which may contain column
+        names) is parsed with \ref o2scl::read_doubles() and moved
+        directly into the columns, as in \ref set_rows_flat().
+    */
     virtual int read_generic(std::istream &fin, int verbose=0) {
 
-      double data;
       std::string line;
       std::string cname;
 
@@ -2872,15 +2888,9 @@ namespace o2scl {
       }
 
       // Read remaining rows
-      while ((fin) >> data) {
-        set_nlines_auto(irow+1);
-        set(0,irow,data);
-        for(size_t i=1;i<get_ncolumns();i++) {
-          (fin) >> data;
-          set(i,irow,data);
-        }
-        irow++;
-      }
+      std::vector<double> vals;
+      read_doubles(fin,vals);
+      set_rows_flat(irow,vals);
 
       if (intp_set) {
         intp_set=false;
@@ -3075,6 +3085,9 @@ namespace o2scl {
     
       // Resize vector if necessary (outside the parallel region)
       if (vec.size()<nlines) vec.resize(nlines);
+
+      // The seed shared by all of the threads
+      unsigned int seed=time(0);
       
 #ifdef O2SCL_OPENMP
 #pragma omp parallel private(i_thread)
@@ -3086,10 +3099,10 @@ namespace o2scl {
         i_thread=omp_get_thread_num();
 #endif
         // Create a new random number generator for each thread,
-        // and ensure a different seed for each thread
+        // and use a different stream for each thread
         rng<> r;
-        unsigned int seed=time(0);
-        r.set_seed(seed*(i_thread+1));
+        r.set_seed(seed);
+        r.set_stream(i_thread);
 
         // Parse function, separate calculator for each thread
         calc_utf8<> calc;
@@ -3251,6 +3264,38 @@ namespace o2scl {
       return;
     }
 
+    /** \brief Set rows starting with \c row_start from a list of
+        values stored in row-major order
+
+        This function is used by \ref read_generic() to move the
+        values from \ref o2scl::read_doubles() directly into the
+        column storage. The number of lines is set to \c row_start
+        plus the number of rows in \c vals. If the last row in \c
+        vals is incomplete, the missing entries are set to zero.
+    */
+    void set_rows_flat(size_t row_start, const std::vector<double> &vals) {
+      
+      size_t ncols=get_ncolumns();
+      if (ncols==0 || vals.size()==0) return;
+      
+      size_t nrows=(vals.size()+ncols-1)/ncols;
+      set_nlines(row_start+nrows);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<ncols;i++) {
+        vec_t &col=alist[i]->second.dat;
+        for(size_t j=0;j<nrows;j++) {
+          size_t ix=j*ncols+i;
+          if (ix<vals.size()) col[row_start+j]=vals[ix];
+          else col[row_start+j]=0.0;
+        }
+      }
+      
+      return;
+    }
+
     /// Make sure a name is unique
     void make_unique_name(std::string &colx, std::vector<std::string> &cnames) {
       bool done;
@@ -24,9 +24,12 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <o2scl/table3d.h>
 #include <o2scl/hist_2d.h>
 #include <o2scl/vec_stats.h>
+#include <o2scl/interp2_seq.h>
 
 using namespace std;
 using namespace o2scl;
@@ -266,7 +269,6 @@ void table3d::set_xy(std::string x_name, uniform_grid<double> gx,
 
 int table3d::read_gen3_list(std::istream &fin, int verbose, double eps) {
       
-  double data;
   std::string line;
   std::string cname, xname="x", yname="y";
 
@@ -355,13 +357,13 @@ int table3d::read_gen3_list(std::istream &fin, int verbose, double eps) {
   }
 
   // Read remaining rows
-  while ((fin) >> data) {
-    if (verbose>2) {
-      std::cout << "data: " << 0 << " " << data << std::endl;
-    }
-    odata[0].push_back(data);
-    for(size_t i=1;i<onames.size();i++) {
-      (fin) >> data;
+  std::vector<double> vals;
+  read_doubles(fin,vals);
+  size_t ncols=onames.size();
+  for(size_t j=0;j<vals.size();j+=ncols) {
+    for(size_t i=0;i<ncols;i++) {
+      double data=0.0;
+      if (j+i<vals.size()) data=vals[j+i];
       if (verbose>2) {
 	std::cout << "data: " << i << " " << data << std::endl;
       }
@@ -370,50 +372,33 @@ int table3d::read_gen3_list(std::istream &fin, int verbose, double eps) {
     irow++;
   }
 
-  // Setup x and y grid vectors from data
+  // Setup x and y grid vectors from data. The values are sorted
+  // first, so each value need only be compared with the last grid
+  // point which was added.
   std::vector<double> xgrid, ygrid;
-  for(size_t i=0;i<odata[0].size();i++) {
-    bool found=false;
-    for(size_t j=0;j<xgrid.size();j++) {
-      if (xgrid[j]<eps) {
-	if (fabs(odata[0][i]-xgrid[j])<eps) {
-	  found=true;
-	}
-      } else {
-	if (fabs(odata[0][i]-xgrid[j])/fabs(xgrid[j])<eps) {
-	  found=true;
+  for(size_t k=0;k<2;k++) {
+    std::vector<double> sorted=odata[k];
+    std::vector<double> &grid=(k==0 ? xgrid : ygrid);
+    vector_sort_radix(sorted.size(),sorted);
+    for(size_t i=0;i<sorted.size();i++) {
+      bool found=false;
+      if (grid.size()>0) {
+	double last=grid[grid.size()-1];
+	if (last<eps) {
+	  if (fabs(sorted[i]-last)<eps) found=true;
+	} else {
+	  if (fabs(sorted[i]-last)/fabs(last)<eps) found=true;
 	}
       }
-    }
-    if (found==false) {
-      if (verbose>1) {
-	cout << "Adding " << odata[0][i] << " to xgrid." << endl;
-      }
-      xgrid.push_back(odata[0][i]);
-    }
-    found=false;
-    for(size_t j=0;j<ygrid.size();j++) {
-      if (ygrid[j]<eps) {
-	if (fabs(odata[1][i]-ygrid[j])<eps) {
-	  found=true;
-	}
-      } else {
-	if (fabs(odata[1][i]-ygrid[j])/fabs(ygrid[j])<eps) {
-	  found=true;
+      if (found==false) {
+	if (verbose>1) {
+	  cout << "Adding " << sorted[i] << " to " 
+	       << (k==0 ? "xgrid." : "ygrid.") << endl;
 	}
+	grid.push_back(sorted[i]);
       }
     }
-    if (found==false) {
-      if (verbose>1) {
-	cout << "Adding " << odata[1][i] << " to ygrid." << endl;
-      }
-      ygrid.push_back(odata[1][i]);
-    }
   }
-
-  // Sort grids
-  vector_sort_double(xgrid.size(),xgrid);
-  vector_sort_double(ygrid.size(),ygrid);
   
   if (verbose>1) {
     cout << "x grid (size " << xgrid.size() << "):" << endl;
@@ -438,13 +423,31 @@ int table3d::read_gen3_list(std::istream &fin, int verbose, double eps) {
     set_slice_all(nnames[i],0.0);
   }
 
+  // Find the grid indices for each row. The grids are sorted, so
+  // the closest grid point (as in lookup_x() and lookup_y()) can be
+  // found with a binary search.
+  std::vector<size_t> ix(odata[0].size()), iy(odata[0].size());
+  for(size_t k=0;k<2;k++) {
+    const std::vector<double> &grid=(k==0 ? xgrid : ygrid);
+    std::vector<size_t> &index=(k==0 ? ix : iy);
+    for(size_t i=0;i<odata[k].size();i++) {
+      double v=odata[k][i];
+      size_t p=std::lower_bound(grid.begin(),grid.end(),v)-grid.begin();
+      if (p==grid.size() || (p>0 && fabs(v-grid[p-1])<=fabs(v-grid[p]))) {
+	p--;
+      }
+      index[i]=p;
+    }
+  }
+
   // Set the data
   for(size_t j=2;j<odata.size();j++) {
+    size_t z=lookup_slice(nnames[j-2]);
     for(size_t i=0;i<odata[j].size();i++) {
       if (verbose>2) {
 	std::cout << "Set value: " << odata[j][i] << std::endl;
       }
-      set_val(odata[0][i],odata[1][i],nnames[j-2],odata[j][i]);
+      (list[z])(ix[i],iy[i])=odata[j][i];
     }
   }
 
@@ -517,13 +520,11 @@ void table3d::add_slice_from_table(table3d &source, std::string slice,
   }
   
   if (!is_slice(dest_slice,szt_tmp)) new_slice(dest_slice);
+  ubmatrix zo;
+  source.interp_grid(source.lookup_slice(slice),xval,yval,zo);
   for(size_t i=0;i<numx;i++) {
     for(size_t j=0;j<numy;j++) {
-      double val=source.interp(get_grid_x(i),get_grid_y(j),slice);
-      if (verbose>2) {
-        //std::cout << i << " " << j << " " << val << std::endl;
-      }
-      set(i,j,dest_slice,val);
+      set(i,j,dest_slice,zo(i,j));
     }
   }
   return;
@@ -916,6 +917,42 @@ size_t table3d::get_interp_type() const {
   return itype;
 }
 
+void table3d::interp_grid(size_t z, const ubvector &xo, const ubvector &yo,
+			  ubmatrix &zo) const {
+
+  size_t nxo=xo.size(), nyo=yo.size();
+  if (zo.size1()!=nxo || zo.size2()!=nyo) zo.resize(nxo,nyo);
+
+  // Use interp() directly for the degenerate cases
+  if (numx==1 || numy==1) {
+    std::string name=get_slice_name(z);
+    for(size_t i=0;i<nxo;i++) {
+      for(size_t j=0;j<nyo;j++) {
+	zo(i,j)=interp(xo[i],yo[j],name);
+      }
+    }
+    return;
+  }
+
+  // Interpolating the transpose with interp2_seq performs the
+  // interpolation in x first and then in y, as in interp()
+  ubvector xg=xval, yg=yval;
+  ubmatrix mt=boost::numeric::ublas::trans(list[z]);
+  interp2_seq<ubvector,ubmatrix,
+	      boost::numeric::ublas::matrix_row<ubmatrix> > is;
+  is.set_data(numy,numx,yg,xg,mt,itype);
+
+  ubmatrix zt(nyo,nxo);
+  is.eval_grid(nyo,yo,nxo,xo,zt);
+  for(size_t i=0;i<nxo;i++) {
+    for(size_t j=0;j<nyo;j++) {
+      zo(i,j)=zt(j,i);
+    }
+  }
+  
+  return;
+}
+
 double table3d::interp(double x, double y, std::string name) const {
   double result;
   
@@ -1355,12 +1392,8 @@ table3d table3d::slice_to_uniform_grid(std::string slice, size_t xpts,
   table3d t3d;
   t3d.set_xy(xname,ugx,yname,ugy);
   t3d.new_slice(slice);
-  for(size_t i=0;i<t3d.get_nx();i++) {
-    for(size_t j=0;j<t3d.get_ny();j++) {
-      t3d.set(i,j,slice,this->interp(t3d.get_grid_x(i),
-				     t3d.get_grid_y(j),slice));
-    }
-  }
+  interp_grid(lookup_slice(slice),t3d.get_x_data(),t3d.get_y_data(),
+	      t3d.get_slice(slice));
   return t3d;
 }
 
@@ -1384,12 +1417,8 @@ table3d table3d::table_to_uniform_grid(size_t xpts, bool log_x,
   for(size_t k=0;k<this->get_nslices();k++) {
     std::string sl_name=this->get_slice_name(k);
     t3d.new_slice(sl_name);
-    for(size_t i=0;i<t3d.get_nx();i++) {
-      for(size_t j=0;j<t3d.get_ny();j++) {
-	t3d.set(i,j,sl_name,this->interp(t3d.get_grid_x(i),
-					 t3d.get_grid_y(j),sl_name));
-      }
-    }
+    interp_grid(lookup_slice(sl_name),t3d.get_x_data(),t3d.get_y_data(),
+		t3d.get_slice(sl_name));
   }
   return t3d;
 }
@@ -660,15 +660,18 @@ namespace o2scl {
 
 	This uses \ref contour to compute contour lines (stored in \c
 	clines) from slice \c name given \c nlev contour levels in \c
-	levs .
+	levs . The value \c n_threads is used for \ref
+	contour::n_threads .
     */
     template<class vec_t> 
       void slice_contours(std::string name, size_t nlev, vec_t &levs,
-			  std::vector<contour_line> &clines) {
+			  std::vector<contour_line> &clines,
+			  size_t n_threads=1) {
 
       size_t z=lookup_slice(name);
       
       contour co;
+      co.n_threads=n_threads;
       co.set_data(numx,numy,xval,yval,list[z]);
       co.set_levels(nlev,levs);
       co.calc_contours(clines);
@@ -1282,6 +1285,16 @@ namespace o2scl {
   protected:
 
 #ifndef DOXYGEN_INTERNAL
+
+    /** \brief Interpolate slice with index \c z onto the grid
+	given by \c xo and \c yo, storing the result in \c zo
+
+	This gives the same results as calling interp() for each
+	point, but constructs the interpolation in the y direction
+	only once for each value in \c xo.
+    */
+    void interp_grid(size_t z, const ubvector &xo, const ubvector &yo,
+		     ubmatrix &zo) const;
     
     /// \name Iterator types
     //@{
@@ -212,6 +212,20 @@ int main(void) {
     cout << endl;
   }
 
+  {
+    // Test read_gen3_list() with an incomplete grid in
+    // unsorted order
+    table3d glt;
+    std::istringstream iss("x y z\n2 1 5.0\n1 1 3.0\n1 2 4.0\n"
+                           "2 3 6.0\n1 3 7.0\n");
+    glt.read_gen3_list(iss);
+    t.test_gen(glt.get_nx()==2,"read_gen3_list 1");
+    t.test_gen(glt.get_ny()==3,"read_gen3_list 2");
+    t.test_rel(glt.get(0,1,"z"),4.0,1.0e-15,"read_gen3_list 3");
+    t.test_rel(glt.get(1,2,"z"),6.0,1.0e-15,"read_gen3_list 4");
+    t.test_abs(glt.get(1,1,"z"),0.0,1.0e-15,"read_gen3_list 5");
+  }
+  
   /*
     12/4/15: This was old code for testing gen3_list. It just
     needs to be rewritten not to depend on separate text
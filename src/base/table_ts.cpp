@@ -211,6 +211,42 @@ int main(void) {
   for(size_t i=0;i<tabx.get_nlines();i++) {
     cout << tabx.get("x",i) << " " << tabx.get("y",i) << endl;
   }
+
+  {
+    // Test sort_table(), which should be stable
+    table<> tabs;
+    tabs.line_of_names("a b");
+    for(size_t i=0;i<1000;i++) {
+      double line[2]={((double)((i*7)%10)),((double)i)};
+      tabs.line_of_data(2,line);
+    }
+    tabs.sort_table("a");
+    bool sorted=true;
+    for(size_t i=1;i<tabs.get_nlines();i++) {
+      if (tabs.get("a",i)<tabs.get("a",i-1)) sorted=false;
+      if (tabs.get("a",i)==tabs.get("a",i-1) &&
+          tabs.get("b",i)<tabs.get("b",i-1)) sorted=false;
+      if (((size_t)tabs.get("b",i))*7%10!=((size_t)tabs.get("a",i))) {
+        sorted=false;
+      }
+    }
+    t.test_gen(sorted,"sort_table");
+  }
+
+  {
+    // Test read_generic()
+    table<> tabg;
+    std::istringstream iss("x y z\n1 2 3\n4 5 6\n7 8 9\n");
+    tabg.read_generic(iss);
+    t.test_gen(tabg.get_nlines()==3,"read_generic 1");
+    t.test_gen(tabg.get_ncolumns()==3,"read_generic 2");
+    t.test_rel(tabg.get("y",2),8.0,1.0e-15,"read_generic 3");
+    table<> tabg2;
+    std::istringstream iss2("1 2\n3 4\n");
+    tabg2.read_generic(iss2);
+    t.test_gen(tabg2.get_nlines()==2,"read_generic 4");
+    t.test_rel(tabg2.get("c2",1),4.0,1.0e-15,"read_generic 5");
+  }
   
   t.report();
 
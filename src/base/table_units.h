@@ -672,7 +672,6 @@ namespace o2scl {
     /// Clear the current table and read from a generic data file
     virtual int read_generic(std::istream &fin, int verbose=0) {
 	
-      double data;
       std::string line;
       std::string stemp;
       std::istringstream *is;
@@ -797,15 +796,9 @@ namespace o2scl {
       }
 
       // Read remaining rows
-      while ((fin) >> data) {
-	this->set_nlines_auto(irow+1);
-	this->set(0,irow,data);
-	for(size_t i=1;i<this->get_ncolumns();i++) {
-	  (fin) >> data;
-	  this->set(i,irow,data);
-	}
-	irow++;
-      }
+      std::vector<double> vals;
+      read_doubles(fin,vals);
+      this->set_rows_flat(irow,vals);
 
       return 0;
     }
@@ -28,6 +28,7 @@
 */
 #include <iostream>
 #include <cstdlib>
+#include <cstddef>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -360,6 +361,207 @@ namespace o2scl {
   };
 #endif
   
+  /** \brief A non-copying strided view of a rearranged tensor
+
+      Objects of this type are created by \ref
+      o2scl::tensor::rearrange_view() and refer to the data of the
+      parent tensor without copying it. An index specification is
+      compiled into a base offset, a signed stride for each index of
+      the view, and a stride for each index which is summed over
+      (traces are stored as a single summed index with the two
+      strides added together). The element of the view at
+      \f$ (j_0,j_1,\ldots) \f$ is then
+      \f[
+      \sum_{s_0,s_1,\ldots} d\left[ o + \sum_k j_k t_k + 
+      \sum_m s_m u_m \right]
+      \f]
+      where \f$ d \f$ is the data of the parent tensor, \f$ o \f$ is
+      the offset, \f$ t_k \f$ are the strides of the view, and \f$ u_m
+      \f$ are the strides of the summed indices.
+
+      The view is invalidated if the parent tensor is resized,
+      cleared, or destroyed, or if its data is swapped out 
+      with \ref o2scl::tensor::swap_data().
+  */
+  template<class data_t=double> class tensor_view {
+    
+  public:
+
+    /// Pointer to the data of the parent tensor
+    const data_t *base;
+
+    /// Offset of the first element of the view
+    std::ptrdiff_t offset;
+
+    /// Sizes of each index of the view
+    std::vector<size_t> size;
+
+    /// Strides of each index of the view
+    std::vector<std::ptrdiff_t> stride;
+
+    /// Sizes of the indices which are summed over
+    std::vector<size_t> sum_size;
+
+    /// Strides of the indices which are summed over
+    std::vector<std::ptrdiff_t> sum_stride;
+
+    /// Create an empty view
+    tensor_view() {
+      base=0;
+      offset=0;
+    }
+
+    /// Clear the view
+    void clear() {
+      base=0;
+      offset=0;
+      size.clear();
+      stride.clear();
+      sum_size.clear();
+      sum_stride.clear();
+      return;
+    }
+    
+    /// Return the rank of the view
+    size_t get_rank() const {
+      return size.size();
+    }
+
+    /// Return the size of index \c i
+    size_t get_size(size_t i) const {
+      if (i>=size.size()) {
+        O2SCL_ERR((((std::string)"Specified index ")+szttos(i)+
+                   " greater than or equal to rank "+szttos(size.size())+
+                   " in tensor_view::get_size()").c_str(),
+                  exc_einval);
+      }
+      return size[i];
+    }
+
+    /** \brief Returns the number of elements in the view (the
+        product of the sizes over every index)
+    */
+    size_t total_size() const {
+      if (size.size()==0) return 0;
+      size_t tot=1;
+      for(size_t i=0;i<size.size();i++) tot*=size[i];
+      return tot;
+    }
+
+    /** \brief Get the element indexed by \c index, performing
+        any sums as necessary
+    */
+    template<class size_vec_t> data_t get(const size_vec_t &index) const {
+      std::ptrdiff_t loc=offset;
+      for(size_t k=0;k<size.size();k++) {
+#if O2SCL_NO_RANGE_CHECK
+#else
+        if (index[k]>=size[k]) {
+          O2SCL_ERR((((std::string)"Value of index[")+szttos(k)+"]="+
+                     szttos(index[k])+" greater than or equal to size "+
+                     szttos(size[k])+" in tensor_view::get().").c_str(),
+                    exc_eindex);
+        }
+#endif
+        loc+=((std::ptrdiff_t)index[k])*stride[k];
+      }
+      return sum_at(loc);
+    }
+
+    /** \brief Copy the elements of the view, in row-major order,
+        to the vector \c v
+
+        The vector \c v is resized to hold \ref total_size()
+        elements. The loop nest is executed directly on the strides,
+        so no index vectors are packed or unpacked.
+    */
+    template<class vec_t> void copy_data(vec_t &v) const {
+      
+      size_t tot=total_size();
+      v.resize(tot);
+      if (tot==0) return;
+      
+      size_t rank=size.size();
+      size_t n_inner=size[rank-1];
+      std::ptrdiff_t inner_stride=stride[rank-1];
+      size_t n_outer=tot/n_inner;
+
+      // Counters for all indices except the last
+      std::vector<size_t> ix(rank,0);
+      
+      std::ptrdiff_t loc=offset;
+      size_t j=0;
+      for(size_t io=0;io<n_outer;io++) {
+
+        std::ptrdiff_t loc2=loc;
+        if (sum_size.size()==0) {
+          for(size_t i=0;i<n_inner;i++) {
+            v[j]=base[loc2];
+            j++;
+            loc2+=inner_stride;
+          }
+        } else {
+          for(size_t i=0;i<n_inner;i++) {
+            v[j]=sum_at(loc2);
+            j++;
+            loc2+=inner_stride;
+          }
+        }
+
+        // Increment the remaining indices
+        for(size_t k=rank-1;k>0;k--) {
+          ix[k-1]++;
+          loc+=stride[k-1];
+          if (ix[k-1]<size[k-1]) break;
+          loc-=stride[k-1]*((std::ptrdiff_t)size[k-1]);
+          ix[k-1]=0;
+        }
+      }
+      
+      return;
+    }
+    
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief Sum the parent data over the summed indices beginning
+        at location \c loc
+    */
+    data_t sum_at(std::ptrdiff_t loc) const {
+
+      size_t n_sums=sum_size.size();
+      if (n_sums==0) return base[loc];
+
+      size_t n_inner=sum_size[n_sums-1];
+      std::ptrdiff_t inner_stride=sum_stride[n_sums-1];
+      size_t n_outer=1;
+      for(size_t k=0;k+1<n_sums;k++) n_outer*=sum_size[k];
+      
+      std::vector<size_t> ix(n_sums,0);
+      data_t val=0;
+      for(size_t io=0;io<n_outer;io++) {
+        std::ptrdiff_t loc2=loc;
+        for(size_t i=0;i<n_inner;i++) {
+          val+=base[loc2];
+          loc2+=inner_stride;
+        }
+        for(size_t k=n_sums-1;k>0;k--) {
+          ix[k-1]++;
+          loc+=sum_stride[k-1];
+          if (ix[k-1]<sum_size[k-1]) break;
+          loc-=sum_stride[k-1]*((std::ptrdiff_t)sum_size[k-1]);
+          ix[k-1]=0;
+        }
+      }
+      
+      return val;
+    }
+    
+#endif
+    
+  };
+  
   /** \brief Tensor class with arbitrary dimensions
 
       The elements of a tensor are typically specified as a list of
@@ -1268,6 +1470,72 @@ namespace o2scl {
     */
     tensor<data_t> rearrange_and_copy(std::vector<index_spec> spec,
                                       int verbose=0, bool err_on_fail=true) {
+
+      tensor_view<data_t> tv;
+      if (compile_rearrange(spec,tv,verbose,err_on_fail)!=0) {
+        return tensor<data_t>();
+      }
+      
+      // Create the new tensor object and fill it by executing
+      // the strided loop nest
+      tensor<data_t> t_new(tv.get_rank(),tv.size);
+      std::vector<data_t> data_new;
+      tv.copy_data(data_new);
+      t_new.swap_data(data_new);
+    
+      return t_new;
+    }
+
+    /** \brief Create a non-copying view of the current tensor
+        rearranged according to \c spec
+
+        This function accepts the same index specifications as \ref
+        rearrange_and_copy(), but returns a \ref o2scl::tensor_view
+        object which refers to the data in the current tensor rather
+        than copying it. Sums and traces are performed each time an
+        element of the view is requested. If \c err_on_fail is false
+        and \c spec is invalid, an empty view is returned.
+    */
+    tensor_view<data_t> rearrange_view(std::vector<index_spec> spec,
+                                       int verbose=0,
+                                       bool err_on_fail=true) const {
+      tensor_view<data_t> tv;
+      compile_rearrange(spec,tv,verbose,err_on_fail);
+      return tv;
+    }
+
+    /** \brief Rearrange, sum and copy current tensor to a new tensor
+        (string input version)
+    */
+    tensor<data_t> rearrange_and_copy(std::string spec,
+                                      int verbose=0, bool err_on_fail=true) {
+
+      std::vector<std::string> sv2;
+      index_spec_preprocess(spec,sv2);
+      std::vector<o2scl::index_spec> vis;
+      strings_to_indexes(sv2,vis,verbose);
+      return rearrange_and_copy(vis,verbose,err_on_fail);
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief Compile the index specification \c spec into the
+        strided view \c tv of the current tensor
+
+        This function checks \c spec and then computes the offset, the
+        stride for each new index, and the strides for the indices
+        which are summed over. It returns 0 on success. If \c spec is
+        invalid and \c err_on_fail is false, it returns \ref
+        o2scl::exc_einval and leaves \c tv empty.
+    */
+    int compile_rearrange(const std::vector<index_spec> &spec,
+                          tensor_view<data_t> &tv, int verbose=0,
+                          bool err_on_fail=true) const {
+
+      tv.clear();
+      
     
       // Old rank and new rank (computed later)
       size_t rank_old=this->rk;
@@ -1281,12 +1549,6 @@ namespace o2scl {
       std::vector<index_spec> spec_old(rank_old);
       std::vector<index_spec> spec_new;
   
-      // Number of elements to sum over
-      size_t n_sum_loop=1;
-
-      // Size of sums
-      std::vector<size_t> sum_sizes;
-  
       // Collect the statistics on the transformation
       for(size_t i=0;i<spec.size();i++) {
         if (spec[i].type==index_spec::index ||
@@ -1302,7 +1564,7 @@ namespace o2scl {
                           << "tensor in tensor::rearrange_and_copy()."
                           << std::endl;
               }
-              return tensor<data_t>();
+              return o2scl::exc_einval;
             }
           }
           size_new.push_back(this->size[spec[i].ix1]);
@@ -1330,7 +1592,7 @@ namespace o2scl {
                           << "tensor in tensor::rearrange_and_copy()."
                           << std::endl;
               }
-              return tensor<data_t>();
+              return o2scl::exc_einval;
             }
           }
           if (spec[i].ix3>spec[i].ix2) {
@@ -1362,16 +1624,9 @@ namespace o2scl {
                           << "tensor in tensor::rearrange_and_copy()."
                           << std::endl;
               }
-              return tensor<data_t>();
+              return o2scl::exc_einval;
             }
           }
-          if (size[spec[i].ix1]<size[spec[i].ix2]) {
-            n_sum_loop*=size[spec[i].ix1];
-            sum_sizes.push_back(size[spec[i].ix1]);
-          } else {
-            n_sum_loop*=size[spec[i].ix2];
-            sum_sizes.push_back(size[spec[i].ix2]);
-          }
           // We set the values of ix1 and ix2 so that ix2
           // always refers to the other index being traced over
           spec_old[spec[i].ix1]=index_spec(spec[i].type,
@@ -1390,11 +1645,9 @@ namespace o2scl {
                           << "tensor in tensor::rearrange_and_copy()."
                           << std::endl;
               }
-              return tensor<data_t>();
+              return o2scl::exc_einval;
             }
           }
-          n_sum_loop*=size[spec[i].ix1];
-          sum_sizes.push_back(size[spec[i].ix1]);
           spec_old[spec[i].ix1]=index_spec(spec[i].type,
                                            spec[i].ix1,spec[i].ix2,0);
         } else if (spec[i].type==index_spec::fixed) {
@@ -1409,7 +1662,7 @@ namespace o2scl {
                           << "tensor in tensor::rearrange_and_copy()."
                           << std::endl;
               }
-              return tensor<data_t>();
+              return o2scl::exc_einval;
             }
           }
           // Use ix1 to store the destination index (which is
@@ -1425,11 +1678,10 @@ namespace o2scl {
               std::cout << "Index specification type not allowed in "
                         << "tensor::rearrange_and_copy()." << std::endl;
             }
-            return tensor<data_t>();
+            return o2scl::exc_einval;
           }
         }
       }
-      size_t n_sums=sum_sizes.size();
 
       // Call the error handler if the input is invalid
       if (rank_new==0) {
@@ -1441,7 +1693,7 @@ namespace o2scl {
             std::cout << "Zero new indices in "
                       << "tensor::rearrange_and_copy()." << std::endl;
           }
-          return tensor<data_t>();
+          return o2scl::exc_einval;
         }
       }
 
@@ -1455,7 +1707,7 @@ namespace o2scl {
               std::cout << "Index " << i << " not accounted for in "
                         << "tensor::rearrange_and_copy()." << std::endl;
             }
-            return tensor<data_t>();
+            return o2scl::exc_einval;
           }
         }
       }
@@ -1504,115 +1756,63 @@ namespace o2scl {
         }
       }
     
-      // Create the new tensor object
-      tensor<data_t> t_new(rank_new,size_new);
-    
-      // Index arrays
-      std::vector<size_t> ix_new(rank_new);
-      std::vector<size_t> ix_old(rank_old);
-      std::vector<size_t> sum_ix(n_sums);
-    
-      // Loop over the new tensor object
-      for(size_t i=0;i<t_new.total_size();i++) {
-      
-        // Find the location in the new tensor object
-        t_new.unpack_index(i,ix_new);
-
-        // Determine the location in the old tensor object
-        for(size_t j=0;j<rank_old;j++) {
-          if (spec_old[j].type==index_spec::index) {
-            ix_old[j]=ix_new[spec_old[j].ix1];
-          } else if (spec_old[j].type==index_spec::range) {
-            if (spec_old[j].ix2<spec_old[j].ix3) {
-              ix_old[j]=ix_new[spec_old[j].ix1]+spec_old[j].ix2;
-            } else {
-              ix_old[j]=spec_old[j].ix2-ix_new[spec_old[j].ix1];
-            }
-          } else if (spec_old[j].type==index_spec::reverse) {
-            ix_old[j]=get_size(j)-1-ix_new[spec_old[j].ix1];
-          } else if (spec_old[j].type==index_spec::fixed) {
-            ix_old[j]=spec_old[j].ix2;
-          }
-        }
-
-        data_t val=0;
-      
-        for(size_t j=0;j<n_sum_loop;j++) {
-
-          // This code is similar to tensor::unpack_index(), it unpacks
-          // the index j to the indices which we are summing over.
-          size_t j2=j, sub_size;
-          for(size_t k=0;k<n_sums;k++) {
-            if (k==n_sums-1) {
-              sum_ix[k]=j2;
-            } else {
-              sub_size=1;
-              for(size_t kk=k+1;kk<n_sums;kk++) sub_size*=sum_sizes[kk];
-              sum_ix[k]=j2/sub_size;
-              j2-=sub_size*(j2/sub_size);
-            }
-          }
-          if (verbose>2) {
-            std::cout << "n_sum_loop: " << n_sum_loop << " n_sums: "
-                      << n_sums << " sum_sizes: ";
-            vector_out(std::cout,sum_sizes,true);
-            std::cout << "j: " << j << " sum_ix: ";
-            vector_out(std::cout,sum_ix,true);
-          }
+      // Strides of the indices in the current tensor
+      std::vector<std::ptrdiff_t> stride_old(rank_old);
+      stride_old[rank_old-1]=1;
+      for(size_t j=rank_old-1;j>0;j--) {
+        stride_old[j-1]=stride_old[j]*((std::ptrdiff_t)size[j]);
+      }
 
-          // Remap from sum_ix to ix_old
-          size_t cnt=0;
-          for(size_t k=0;k<rank_old;k++) {
-            if (spec_old[k].type==index_spec::sum) {
-              if (cnt>=sum_ix.size()) {
-                std::cout << "X: " << cnt << " " << sum_ix.size() << std::endl;
-                O2SCL_ERR2("Bad sync 1 in sum_ix in ",
-                           "tensor::rearrange_and_copy()",o2scl::exc_esanity);
-              }
-              ix_old[k]=sum_ix[cnt];
-              cnt++;
-            } else if (spec_old[k].type==index_spec::trace &&
-                       spec_old[k].ix1<spec_old[k].ix2) {
-              if (cnt>=sum_ix.size()) {
-                std::cout << "X: " << cnt << " " << sum_ix.size() << std::endl;
-                O2SCL_ERR2("Bad sync 2 in sum_ix in ",
-                           "tensor::rearrange_and_copy()",o2scl::exc_esanity);
-              }
-              ix_old[spec_old[k].ix1]=sum_ix[cnt];
-              ix_old[spec_old[k].ix2]=sum_ix[cnt];
-              cnt++;
-            }
+      // Compute the offset and strides of the view. The summed
+      // indices are ordered by their location in the old tensor.
+      tv.base=&(data[0]);
+      tv.size=size_new;
+      tv.stride.resize(rank_new,0);
+      for(size_t j=0;j<rank_old;j++) {
+        if (spec_old[j].type==index_spec::index) {
+          tv.stride[spec_old[j].ix1]=stride_old[j];
+        } else if (spec_old[j].type==index_spec::range) {
+          tv.offset+=((std::ptrdiff_t)spec_old[j].ix2)*stride_old[j];
+          if (spec_old[j].ix2<spec_old[j].ix3) {
+            tv.stride[spec_old[j].ix1]=stride_old[j];
+          } else {
+            tv.stride[spec_old[j].ix1]=-stride_old[j];
           }
-
-          if (verbose>2) {
-            std::cout << "Here old: ";
-            vector_out(std::cout,ix_old,true);
-            std::cout << "Here new: ";
-            vector_out(std::cout,ix_new,true);
+        } else if (spec_old[j].type==index_spec::reverse) {
+          tv.offset+=((std::ptrdiff_t)(size[j]-1))*stride_old[j];
+          tv.stride[spec_old[j].ix1]=-stride_old[j];
+        } else if (spec_old[j].type==index_spec::fixed) {
+          tv.offset+=((std::ptrdiff_t)spec_old[j].ix2)*stride_old[j];
+        } else if (spec_old[j].type==index_spec::sum) {
+          tv.sum_size.push_back(size[j]);
+          tv.sum_stride.push_back(stride_old[j]);
+        } else if (spec_old[j].type==index_spec::trace &&
+                   spec_old[j].ix1<spec_old[j].ix2) {
+          size_t ix2=spec_old[j].ix2;
+          if (size[j]<size[ix2]) {
+            tv.sum_size.push_back(size[j]);
+          } else {
+            tv.sum_size.push_back(size[ix2]);
           }
-          val+=get(ix_old);
-      
+          tv.sum_stride.push_back(stride_old[j]+stride_old[ix2]);
         }
-      
-        // Set the new point by performing the linear interpolation
-        t_new.set(ix_new,val);
       }
-    
-      return t_new;
+
+      if (verbose>1) {
+        std::cout << "Offset: " << tv.offset << " strides: ";
+        vector_out(std::cout,tv.stride,true);
+        std::cout << "Sum sizes: ";
+        vector_out(std::cout,tv.sum_size,true);
+        std::cout << "Sum strides: ";
+        vector_out(std::cout,tv.sum_stride,true);
+      }
+      
+      return 0;
     }
 
-    /** \brief Rearrange, sum and copy current tensor to a new tensor
-        (string input version)
-    */
-    tensor<data_t> rearrange_and_copy(std::string spec,
-                                      int verbose=0, bool err_on_fail=true) {
+#endif
 
-      std::vector<std::string> sv2;
-      index_spec_preprocess(spec,sv2);
-      std::vector<o2scl::index_spec> vis;
-      strings_to_indexes(sv2,vis,verbose);
-      return rearrange_and_copy(vis,verbose,err_on_fail);
-    }
+  public:
   
   };
   
@@ -2162,6 +2162,19 @@ namespace o2scl {
         o2scl::vector_out(std::cout,ix_to_interp,true);
       }
     
+      // If there is no interpolation, then the data can be copied
+      // using the strided loop nest from the parent tensor class
+      if (n_interps==0) {
+        tensor_view<double> tv;
+        if (this->compile_rearrange(spec,tv,0,err_on_fail)!=0) {
+          return tensor_grid<>();
+        }
+        std::vector<double> data_new;
+        tv.copy_data(data_new);
+        t_new.swap_data(data_new);
+        return t_new;
+      }
+      
       // Index arrays. For indices in the old tensor which we are
       // interpolating, the value of ix_old is not used, so it
       // is not set.
@@ -162,6 +162,31 @@ int main(void) {
       }
     }
     t.test_gen(tx3==tx3b,"rearrange 2");
+
+    // Test rearrange_view() with the same specification
+    tensor_view<> tv=tx.rearrange_view({ix_index(1),ix_range(4,1,0),
+	  ix_fixed(3,2),ix_trace(0,2)});
+    t.test_gen(tv.get_rank()==2,"rearrange_view rank");
+    t.test_gen(tv.total_size()==6,"rearrange_view size");
+    for(size_t i1=0;i1<3;i1++) {
+      for(size_t i2=0;i2<2;i2++) {
+	ix_new={i1,i2};
+	t.test_rel(tv.get(ix_new),tx3b.get(ix_new),1.0e-12,
+		   "rearrange_view get");
+      }
+    }
+
+    // Test a permutation of all five indices
+    tensor<> tx4=tx.rearrange_and_copy({ix_index(4),ix_index(0),
+	  ix_reverse(2),ix_index(3),ix_index(1)});
+    bool perm_ok=true;
+    ix_new.resize(5);
+    for(size_t i=0;i<tx4.total_size();i++) {
+      tx4.unpack_index(i,ix_new);
+      ix_old={ix_new[1],ix_new[4],2-ix_new[2],ix_new[3],ix_new[0]};
+      if (tx4.get(ix_new)!=tx.get(ix_old)) perm_ok=false;
+    }
+    t.test_gen(perm_ok,"rearrange 3");
     
   }
   
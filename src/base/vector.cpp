@@ -20,8 +20,14 @@
 
   -------------------------------------------------------------------
 */
+#include <algorithm>
+
 #include <o2scl/vector.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 
@@ -29,6 +35,118 @@ void blank_func1() {
   return;
 }
 
+void o2scl::vector_sort_radix_keys(size_t n, uint64_t *keys,
+                                   size_t *index) {
+
+  // For small arrays, use a stable insertion sort
+  if (n<64) {
+    for(size_t i=1;i<n;i++) {
+      uint64_t k=keys[i];
+      size_t ix=0;
+      if (index!=0) ix=index[i];
+      size_t j=i;
+      while (j>0 && keys[j-1]>k) {
+        keys[j]=keys[j-1];
+        if (index!=0) index[j]=index[j-1];
+        j--;
+      }
+      keys[j]=k;
+      if (index!=0) index[j]=ix;
+    }
+    return;
+  }
+
+  const size_t n_bits=11;
+  const size_t n_buckets=((size_t)1)<<n_bits;
+  const uint64_t mask=n_buckets-1;
+  
+  // Number of threads. Use only one thread for smaller arrays,
+  // where the overhead of the parallel region is not worth it.
+  size_t n_threads=1;
+#ifdef O2SCL_OPENMP
+  if (n>=65536) n_threads=omp_get_max_threads();
+#endif
+  
+  // Temporary storage
+  std::vector<uint64_t> keys2(n);
+  std::vector<size_t> index2;
+  if (index!=0) index2.resize(n);
+  uint64_t *ksrc=keys, *kdst=&(keys2[0]);
+  size_t *isrc=index, *idst=0;
+  if (index!=0) idst=&(index2[0]);
+  
+  // Histograms, one for each thread
+  std::vector<size_t> hist(n_threads*n_buckets);
+
+  for(size_t shift=0;shift<64;shift+=n_bits) {
+
+    std::fill(hist.begin(),hist.end(),0);
+
+    // Count the digits in each thread's contiguous block
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+#endif
+    for(size_t it=0;it<n_threads;it++) {
+      size_t *h=&(hist[it*n_buckets]);
+      size_t start=n*it/n_threads, end=n*(it+1)/n_threads;
+      for(size_t i=start;i<end;i++) {
+        h[(ksrc[i]>>shift) & mask]++;
+      }
+    }
+
+    // If all keys have the same digit, then this pass can be skipped
+    uint64_t d0=(ksrc[0]>>shift) & mask;
+    size_t count=0;
+    for(size_t it=0;it<n_threads;it++) {
+      count+=hist[it*n_buckets+d0];
+    }
+    if (count==n) continue;
+
+    // Convert the counts into starting offsets. The offsets are
+    // ordered first by bucket and then by thread, which ensures
+    // that the sort is stable.
+    size_t sum=0;
+    for(size_t j=0;j<n_buckets;j++) {
+      for(size_t it=0;it<n_threads;it++) {
+        size_t c=hist[it*n_buckets+j];
+        hist[it*n_buckets+j]=sum;
+        sum+=c;
+      }
+    }
+
+    // Scatter the keys (and indices) to their new locations
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+#endif
+    for(size_t it=0;it<n_threads;it++) {
+      size_t *h=&(hist[it*n_buckets]);
+      size_t start=n*it/n_threads, end=n*(it+1)/n_threads;
+      if (isrc!=0) {
+        for(size_t i=start;i<end;i++) {
+          size_t loc=h[(ksrc[i]>>shift) & mask]++;
+          kdst[loc]=ksrc[i];
+          idst[loc]=isrc[i];
+        }
+      } else {
+        for(size_t i=start;i<end;i++) {
+          kdst[h[(ksrc[i]>>shift) & mask]++]=ksrc[i];
+        }
+      }
+    }
+
+    std::swap(ksrc,kdst);
+    std::swap(isrc,idst);
+  }
+
+  // If the sorted data is in the temporary storage, copy it back
+  if (ksrc!=keys) {
+    std::copy(ksrc,ksrc+n,keys);
+    if (index!=0) std::copy(isrc,isrc+n,index);
+  }
+  
+  return;
+}
+
 #ifdef O2SCL_ARMA
 
 template<> arma::subview_row<double> 
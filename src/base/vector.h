@@ -54,6 +54,9 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
 
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_sys.h>
@@ -975,6 +978,111 @@ namespace o2scl {
     void vector_sort_double(size_t n, vec_t &data) {
     return vector_sort<vec_t,double>(n,data);
   }
+
+  /** \brief Convert a double to an unsigned integer key with the
+      same ordering
+
+      The bits of non-negative numbers are offset by the sign bit
+      and the bits of negative numbers are inverted so that the
+      integer keys are ordered in the same way as the original
+      values. The key for \f$ -0 \f$ is smaller than the key for
+      \f$ +0 \f$, positive NaNs are larger than \f$ +\infty \f$
+      and negative NaNs are smaller than \f$ -\infty \f$.
+      This function is used by \ref vector_sort_radix() and \ref
+      vector_sort_index_radix().
+  */
+  inline uint64_t vector_radix_key(double x) {
+    uint64_t u;
+    std::memcpy(&u,&x,sizeof(double));
+    if (u>>63) return ~u;
+    return u | (((uint64_t)1)<<63);
+  }
+
+  /** \brief Convert a key created by \ref vector_radix_key() back
+      to a double
+  */
+  inline double vector_radix_key_inv(uint64_t u) {
+    if (u>>63) {
+      u&=~(((uint64_t)1)<<63);
+    } else {
+      u=~u;
+    }
+    double x;
+    std::memcpy(&x,&u,sizeof(double));
+    return x;
+  }
+
+  /** \brief Stable sort of an array of 64-bit keys, optionally
+      permuting an array of indices along with the keys
+
+      This function uses a least-significant digit radix sort with
+      11-bit digits, skipping the passes for which all of the keys
+      have the same digit. If OpenMP is enabled and \c n is larger
+      than about \f$ 2^{16} \f$, each pass is divided among the
+      threads, each of which counts and then scatters a contiguous
+      block of keys, so the sort remains stable. If \c index is
+      zero, only the keys are sorted. Arrays with fewer than 64
+      elements are sorted with an insertion sort.
+
+      This function is defined in <tt>src/base/vector.cpp</tt>.
+  */
+  void vector_sort_radix_keys(size_t n, uint64_t *keys, size_t *index);
+  
+  /** \brief Sort the first \c n elements of a vector of doubles
+      (in increasing order) using a parallel radix sort
+
+      This function gives the same results as \ref
+      vector_sort_double() except for the ordering of \f$ -0 \f$
+      and \f$ +0 \f$ and of NaNs (see \ref vector_radix_key()),
+      but it takes \f$ {\cal O}(n) \f$ time, is cache-friendly and
+      uses multiple threads if OpenMP is enabled (see \ref
+      vector_sort_radix_keys()). It requires temporary storage for
+      \f$ 2 n \f$ 64-bit keys. The generic template \ref
+      vector_sort() remains available for other types.
+  */
+  template<class vec_t>
+    void vector_sort_radix(size_t n, vec_t &data) {
+    
+    if (n==0) return;
+    
+    std::vector<uint64_t> keys(n);
+    for(size_t i=0;i<n;i++) keys[i]=vector_radix_key(data[i]);
+    vector_sort_radix_keys(n,&(keys[0]),0);
+    for(size_t i=0;i<n;i++) data[i]=vector_radix_key_inv(keys[i]);
+    
+    return;
+  }
+  
+  /** \brief Create a permutation which sorts the first \c n
+      elements of a vector of doubles using a stable parallel 
+      radix sort
+
+      This function works like \ref vector_sort_index(), but
+      elements which compare equal keep their original relative
+      order, the time required is \f$ {\cal O}(n) \f$, and multiple
+      threads are used if OpenMP is enabled (see \ref
+      vector_sort_radix_keys()). The values in \c data are
+      converted to \c double, so this function should not be used
+      for types with larger precision. Before calling this function,
+      \c order must already be allocated as a vector of size \c n.
+  */
+  template<class vec_t, class vec_size_t> 
+    void vector_sort_index_radix(size_t n, const vec_t &data,
+                                 vec_size_t &order) {
+    
+    if (n==0) return;
+    
+    std::vector<uint64_t> keys(n);
+    std::vector<size_t> index(n);
+    for(size_t i=0;i<n;i++) {
+      keys[i]=vector_radix_key(data[i]);
+      index[i]=i;
+    }
+    vector_sort_radix_keys(n,&(keys[0]),&(index[0]));
+    for(size_t i=0;i<n;i++) order[i]=index[i];
+    
+    return;
+  }
   //@}
   
   /// \name Smallest or largest subset functions in src/base/vector.h
@@ -450,6 +450,48 @@ int main(void) {
   permutation p2=p.inverse();
   vector_out(cout,5,p2,true);
 
+  // Test vector_sort_radix() and vector_sort_index_radix() against
+  // the heapsort. The array is large enough to use multiple threads
+  // with OpenMP and contains many duplicates to test stability.
+  {
+    size_t nr=200000;
+    std::vector<double> r1(nr), r2(nr), r3(nr);
+    unsigned long long seed=1;
+    for(size_t i=0;i<nr;i++) {
+      seed=seed*6364136223846793005ULL+1442695040888963407ULL;
+      r1[i]=((double)((seed>>33)%2001)-1000.0)/8.0;
+    }
+    r1[10]=-0.0;
+    r1[20]=0.0;
+    r1[30]=1.0e300;
+    r1[40]=-1.0e-300;
+    r2=r1;
+    r3=r1;
+    vector_sort_double(nr,r2);
+    vector_sort_radix(nr,r3);
+    t.test_gen(vector_is_monotonic(r3)==1,"radix sort monotonic");
+    bool match=true;
+    for(size_t i=0;i<nr;i++) if (r2[i]!=r3[i]) match=false;
+    t.test_gen(match,"radix sort vs. heapsort");
+    
+    std::vector<size_t> ord(nr);
+    vector_sort_index_radix(nr,r1,ord);
+    bool stable=true, sorted=true;
+    for(size_t i=1;i<nr;i++) {
+      if (r1[ord[i]]<r1[ord[i-1]]) sorted=false;
+      if (r1[ord[i]]==r1[ord[i-1]] && ord[i]<ord[i-1]) stable=false;
+    }
+    t.test_gen(sorted,"radix argsort sorted");
+    t.test_gen(stable,"radix argsort stable");
+
+    // A small array which uses the insertion sort
+    double st5[5]={3.1,-4.1,5.9,-4.1,0.0};
+    size_t ind5[5];
+    vector_sort_index_radix(5,st5,ind5);
+    t.test_gen(ind5[0]==1 && ind5[1]==3 && ind5[2]==4 &&
+               ind5[3]==0 && ind5[4]==2,"radix argsort small");
+  }
+
   // Test vector_grid and vector_swap
   ubvector ovg(3), ovg2(3);
   vector_grid(uniform_grid_end<>(0,1,2),ovg);
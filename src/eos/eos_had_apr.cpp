@@ -26,6 +26,10 @@
 
 #include <o2scl/eos_had_apr.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -687,3 +691,188 @@ int eos_had_apr::calc_temp_e(fermion &ne, fermion &pr, const double temper,
   return success;
 }
 
+int eos_had_apr::calc_temp_e_batch(size_t n_pts, const double *nn,
+				   const double *np, const double *T,
+				   double *ed, double *pr, double *en,
+				   double *mun, double *mup) {
+  return batch_thermo(n_pts,nn,np,T,ed,pr,en,mun,mup);
+}
+
+int eos_had_apr::calc_e_batch(size_t n_pts, const double *nn,
+			      const double *np, double *ed, double *pr,
+			      double *mun, double *mup) {
+  return batch_thermo(n_pts,nn,np,0,ed,pr,0,mun,mup);
+}
+
+int eos_had_apr::batch_thermo(size_t n_pts, const double *nn,
+			      const double *np, const double *T,
+			      double *ed, double *pr, double *en,
+			      double *mun, double *mup) {
+
+  // Check the input once, rather than for every point
+  for(size_t i=0;i<n_pts;i++) {
+    double Ti=0.0;
+    if (T!=0) Ti=T[i];
+    if (!std::isfinite(nn[i]) || !std::isfinite(np[i]) ||
+	!std::isfinite(Ti) || nn[i]<0.0 || np[i]<0.0 || Ti<0.0) {
+      string err=((string)"Invalid density or temperature (n_n=")+
+	o2scl::dtos(nn[i])+", n_p="+o2scl::dtos(np[i])+", T="+
+	o2scl::dtos(Ti)+") at index "+o2scl::szttos(i)+
+	" in eos_had_apr::batch_thermo().";
+      O2SCL_ERR(err.c_str(),exc_einval);
+    }
+  }
+  if (fabs(neutron->g-2.0)>1.0e-10 || fabs(proton->g-2.0)>1.0e-10) {
+    O2SCL_ERR2("Neutron or proton spin degeneracies wrong in ",
+	       "eos_had_apr::batch_thermo().",exc_einval);
+  }
+  if (fabs(neutron->m-4.5)>1.0 || fabs(proton->m-4.5)>1.0) {
+    O2SCL_ERR2("Neutron or proton masses wrong in ",
+	       "eos_had_apr::batch_thermo().",exc_einval);
+  }
+  if (pion!=best && pion!=ldp && pion!=hdp) {
+    O2SCL_ERR("Bad value for pion in eos_had_apr::batch_thermo().",
+	      exc_efailed);
+  }
+
+  const double mn=neutron->m, mp=proton->m;
+  const double gn=neutron->g, gp=proton->g;
+  const bool irmn=neutron->inc_rest_mass, irmp=proton->inc_rest_mass;
+  
+  const size_t block=256;
+  size_t n_blocks=(n_pts+block-1)/block;
+  std::vector<int> status(n_blocks,0);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    
+    size_t i0=ib*block;
+    size_t nb=n_pts-i0;
+    if (nb>block) nb=block;
+
+    double msn[block], msp[block], nun[block], nup[block];
+    double edn[block], edp[block], prk[block], enn[block], enp[block];
+    
+    // Landau effective masses
+    for(size_t j=0;j<nb;j++) {
+      size_t i=i0+j;
+      double barn=nn[i]+np[i];
+      double xp=np[i]/barn;
+      double t1=barn*exp(-par[4]*barn);
+      msn[j]=1.0/(1.0/mn+2.0*t1*(par[3]+par[5]*(1-xp)));
+      msp[j]=1.0/(1.0/mp+2.0*t1*(par[3]+xp*par[5]));
+      if (barn==0.0) {
+	msn[j]=mn;
+	msp[j]=mp;
+      }
+    }
+    
+    // Kinetic parts
+    const double *Tb=0;
+    if (T!=0) Tb=T+i0;
+    int r1=nrfb.calc_density(nb,nn+i0,msn,Tb,mn,gn,irmn,nun,edn,prk,enn);
+    int r2=nrfb.calc_density(nb,np+i0,msp,Tb,mp,gp,irmp,nup,edp,prk,enp);
+    if (r1!=0) status[ib]=r1;
+    if (r2!=0) status[ib]=r2;
+
+    for(size_t j=0;j<nb;j++) {
+      
+      size_t i=i0+j;
+      double n_n=nn[i], n_p=np[i];
+      double Ti=0.0;
+      if (T!=0) Ti=T[i];
+      
+      if (n_n==0.0 && n_p==0.0) {
+	ed[i]=0.0;
+	pr[i]=0.0;
+	if (en!=0) en[i]=0.0;
+	mun[i]=mn;
+	mup[i]=mp;
+	continue;
+      }
+
+      // At finite temperature, calc_temp_e() sets the chemical
+      // potential to zero for a species with zero density
+      if (Ti>0.0 && n_n==0.0) nun[j]=0.0;
+      if (Ti>0.0 && n_p==0.0) nup[j]=0.0;
+      
+      double barn=n_n+n_p;
+      double xp=n_p/barn;
+      double dxdnn=-xp/barn, dxdnp=(1.0-xp)/barn;
+      double t1=barn*exp(-par[4]*barn);
+      double t2=par[3]+par[5]*(1-xp);
+      double t3=par[3]+xp*par[5];
+
+      double kin=edn[j]+edp[j];
+      double dmsndnn=-2.0*msn[j]*msn[j]*(t2*t1*(1.0/barn-par[4])-
+					t1*par[5]*dxdnn);
+      double dmsndnp=-2.0*msn[j]*msn[j]*(t2*t1*(1.0/barn-par[4])-
+					t1*par[5]*dxdnp);
+      double dmspdnn=-2.0*msp[j]*msp[j]*(t3*t1*(1.0/barn-par[4])+
+					t1*par[5]*dxdnn);
+      double dmspdnp=-2.0*msp[j]*msp[j]*(t3*t1*(1.0/barn-par[4])+
+					t1*par[5]*dxdnp);
+      double dkindnn=nun[j]-(edn[j]-n_n*mn)/msn[j]*dmsndnn-
+	(edp[j]-n_p*mp)/msp[j]*dmspdnn;
+      double dkindnp=nup[j]-(edp[j]-n_p*mp)/msp[j]*dmspdnp-
+	(edn[j]-n_n*mn)/msn[j]*dmsndnp;
+    
+      double nb2=barn*barn;
+      double t4=exp(-par[9]*par[9]*nb2);
+      double dt4=-par[9]*par[9]*2.0*barn*t4;
+      double t5=barn-par[19];
+      double t6=barn-par[20];
+      double t9=(1.0-2.0*xp);
+      double t8=t9*t9;
+      double t7=1.0-t8;
+
+      double gl1=-nb2*(par[1]+par[2]*barn+par[6]*nb2+
+		       (par[10]+par[11]*barn)*t4);
+      double gl2=-nb2*(par[12]/barn+par[7]+par[8]*barn+par[13]*t4);
+      double e5=exp(par[18]*t5), e6=exp(par[16]*t6);
+      double gh1=gl1-nb2*(par[17]*t5+par[21]*t5*t5)*e5;
+      double gh2=gl2-nb2*(par[15]*t6+par[14]*t6*t6)*e6;
+
+      double low=gl1*t7+gl2*t8;
+      double high=gh1*t7+gh2*t8;
+
+      double dgl1=gl1*2.0/barn-nb2*(par[2]+2.0*par[6]*barn+t4*par[11]+
+				    (par[10]+par[11]*barn)*dt4);
+      double dgl2=gl2*2.0/barn-nb2*(-par[12]/nb2+par[8]+par[13]*dt4);
+
+      if ((low<=high && pion==best) || pion==ldp || barn<0.16) {
+	// low-density phase
+	ed[i]=kin+low;
+	mun[i]=dkindnn+dgl1*t7+dgl2*t8+dxdnn*4.0*t9*(gl1-gl2);
+	mup[i]=dkindnp+dgl1*t7+dgl2*t8+dxdnp*4.0*t9*(gl1-gl2);
+      } else {
+	// high-density phase
+	double dgh1=dgl1-barn*(par[17]*t5+par[21]*t5*t5)*e5*
+	  (2.0+par[18]*barn)-nb2*(par[17]+2.0*t5*par[21])*e5;
+	double dgh2=dgl2-barn*(par[15]*t6+par[14]*t6*t6)*e6*
+	  (2.0+par[16]*barn)-nb2*(par[15]+2.0*t6*par[14])*e6;
+	ed[i]=kin+high;
+	mun[i]=dkindnn+dgh1*t7+dgh2*t8+dxdnn*4.0*t9*(gh1-gh2);
+	mup[i]=dkindnp+dgh1*t7+dgh2*t8+dxdnp*4.0*t9*(gh1-gh2);
+      }
+
+      double ent=0.0;
+      if (Ti>0.0) ent=enn[j]+enp[j];
+      if (en!=0) en[i]=ent;
+      pr[i]=-ed[i]+mun[i]*n_n+mup[i]*n_p+Ti*ent;
+    }
+  }
+
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    if (status[ib]!=0) {
+      O2SCL_CONV2_RET("Kinetic part failed in ",
+		      "eos_had_apr::batch_thermo().",status[ib],
+		      this->err_nonconv);
+    }
+  }
+  
+  return success;
+}
+
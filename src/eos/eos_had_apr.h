@@ -131,6 +131,20 @@ namespace o2scl {
 
     /// Non-relativistic fermion thermodyanmics
     fermion_nonrel nrf;
+
+    /// Non-relativistic fermion thermodynamics for arrays of points
+    fermion_nonrel_batch nrfb;
+    
+    /** \brief Compute the thermodynamics for arrays of points
+
+        This function is used by \ref calc_temp_e_batch() and \ref
+        calc_e_batch(). If \c T is zero, all of the points are at
+        zero temperature, and if \c en is zero, the entropy is not
+        stored.
+    */
+    int batch_thermo(size_t n_pts, const double *nn, const double *np,
+                     const double *T, double *ed, double *pr,
+                     double *en, double *mun, double *mup);
     
     /// The variable indicating which parameter set is to be used
     int choice;
@@ -181,6 +195,32 @@ namespace o2scl {
     /// Equation of state as a function of densities
     virtual int calc_temp_e(fermion &n, fermion &pr, double temper, 
 			    thermo &th);
+
+    /** \brief Equation of state for arrays of densities and
+	temperatures
+
+	This gives the same results as calling \ref calc_temp_e()
+	for each point (up to the tolerance in \ref
+	fermion_nonrel_batch), but the points are processed in
+	blocks, and the blocks are divided among threads if OpenMP is
+	enabled. The value returned by \ref last_phase() is not
+	changed. See \ref eos_had_temp_base::calc_temp_e_batch() for
+	the meaning of the arguments.
+    */
+    virtual int calc_temp_e_batch(size_t n_pts, const double *nn,
+				  const double *np, const double *T,
+				  double *ed, double *pr, double *en,
+				  double *mun, double *mup);
+    
+    /** \brief Equation of state for arrays of densities at zero
+	temperature
+
+	This gives the same results as calling \ref calc_e() for
+	each point. See \ref calc_temp_e_batch().
+    */
+    virtual int calc_e_batch(size_t n_pts, const double *nn,
+			     const double *np, double *ed, double *pr,
+			     double *mun, double *mup);
     
     /** \brief Compute the compressibility in nuclear
 	(isospin-symmetric matter)
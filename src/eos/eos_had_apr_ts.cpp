@@ -477,7 +477,79 @@ int main(void) {
       cout << at.fesym_T(0.16,10.0/hc_mev_fm)*hc_mev_fm << endl;
     */
   }
-  
+
+  {
+    eos_had_apr at;
+
+    // Compare the batch interface with at.FUNC() across the
+    // transition to the pion-condensed phase
+    cout << "Test batch interface: " << endl;
+    const size_t nt=40;
+    std::vector<double> bnn(nt), bnp(nt), bT(nt), bed(nt), bpr(nt);
+    std::vector<double> ben(nt), bmun(nt), bmup(nt);
+    for(size_t i=0;i<nt;i++) {
+      bnn[i]=0.3*((double)i)/((double)nt);
+      bnp[i]=0.2*bnn[i];
+      bT[i]=((double)(i%2))*5.0/hc_mev_fm;
+    }
+    fermion bn(939.0/hc_mev_fm,2.0), bp(939.0/hc_mev_fm,2.0);
+    bn.non_interacting=false;
+    bp.non_interacting=false;
+    thermo bth;
+
+    int pions[3]={eos_had_apr::best,eos_had_apr::ldp,eos_had_apr::hdp};
+    for(size_t k=0;k<3;k++) {
+      at.pion=pions[k];
+      
+      at.calc_temp_e_batch(nt,&bnn[0],&bnp[0],&bT[0],&bed[0],&bpr[0],
+			   &ben[0],&bmun[0],&bmup[0]);
+      bool match=true;
+      for(size_t i=1;i<nt;i++) {
+	bn.n=bnn[i];
+	bp.n=bnp[i];
+	at.calc_temp_e(bn,bp,bT[i],bth);
+	if (fabs(bth.ed-bed[i])>1.0e-10*fabs(bth.ed) ||
+	    fabs(bth.pr-bpr[i])>1.0e-9*(fabs(bth.pr)+1.0e-8) ||
+	    fabs(bth.en-ben[i])>1.0e-9*(fabs(bth.en)+1.0e-8) ||
+	    fabs(bn.mu-bmun[i])>1.0e-10*fabs(bn.mu) ||
+	    fabs(bp.mu-bmup[i])>1.0e-10*fabs(bp.mu)) {
+	  cout << k << " " << i << " " << bnn[i] << " " << bT[i] << " "
+	       << bth.ed << " " << bed[i] << " " << bn.mu << " "
+	       << bmun[i] << endl;
+	  match=false;
+	}
+      }
+      t.test_gen(match,"calc_temp_e_batch()");
+      
+      at.calc_e_batch(nt,&bnn[0],&bnp[0],&bed[0],&bpr[0],&bmun[0],&bmup[0]);
+      match=true;
+      for(size_t i=1;i<nt;i++) {
+	bn.n=bnn[i];
+	bp.n=bnp[i];
+	at.calc_e(bn,bp,bth);
+	if (fabs(bth.ed-bed[i])>1.0e-12*fabs(bth.ed) ||
+	    fabs(bth.pr-bpr[i])>1.0e-12*(fabs(bth.pr)+1.0e-8) ||
+	    fabs(bn.mu-bmun[i])>1.0e-12*fabs(bn.mu) ||
+	    fabs(bp.mu-bmup[i])>1.0e-12*fabs(bp.mu)) {
+	  match=false;
+	}
+      }
+      t.test_gen(match,"calc_e_batch()");
+    }
+    at.pion=eos_had_apr::best;
+
+    // A negative temperature is rejected
+    bT[5]=-1.0/hc_mev_fm;
+    int err=0;
+    try {
+      at.calc_temp_e_batch(nt,&bnn[0],&bnp[0],&bT[0],&bed[0],&bpr[0],
+			   &ben[0],&bmun[0],&bmup[0]);
+    } catch (std::exception &e) {
+      err=err_hnd->get_errno();
+      err_hnd->reset();
+    }
+    t.test_gen(err==exc_einval,"calc_temp_e_batch() negative T");
+  }
 
   t.report();
   return 0;
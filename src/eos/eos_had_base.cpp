@@ -53,6 +53,28 @@ eos_had_base::eos_had_base() {
   err_nonconv=true;
 }
 
+int eos_had_base::calc_e_batch(size_t n_pts, const double *nn,
+                               const double *np, double *ed, double *pr,
+                               double *mun, double *mup) {
+  
+  fermion ne=*neutron, prot=*proton;
+  thermo th;
+  int ret=0;
+  
+  for(size_t i=0;i<n_pts;i++) {
+    ne.n=nn[i];
+    prot.n=np[i];
+    int r=calc_e(ne,prot,th);
+    if (r!=0) ret=r;
+    ed[i]=th.ed;
+    pr[i]=th.pr;
+    mun[i]=ne.mu;
+    mup[i]=prot.mu;
+  }
+  
+  return ret;
+}
+
 double eos_had_base::fcomp(double nb, double delta) {
   double lcomp, err;
   
@@ -425,6 +447,11 @@ double eos_had_base::calc_edensity_delta(double delta, double nb) {
 void eos_had_base::f_number_suscept(double mun, double mup, double &dPdnn, 
 				    double &dPdnp, double &dPdpp) {
 
+  // Store the chemical potentials and densities, which are
+  // modified by calc_nn_p() and calc_np_p()
+  double mun_old=neutron->mu, mup_old=proton->mu;
+  double nn_old=neutron->n, np_old=proton->n;
+  
   // For (d^2 P)/(d mun d mun)
   funct fnn=std::bind
     (std::mem_fn<double(double,double)>(&eos_had_base::calc_nn_p),
@@ -442,6 +469,11 @@ void eos_had_base::f_number_suscept(double mun, double mup, double &dPdnn,
     (std::mem_fn<double(double,double)>(&eos_had_base::calc_np_p),
      this,mun,std::placeholders::_1);
   dPdpp=sat_deriv->deriv(mup,fpp);
+
+  neutron->mu=mun_old;
+  proton->mu=mup_old;
+  neutron->n=nn_old;
+  proton->n=np_old;
   
   return;
 }
@@ -797,6 +829,30 @@ int eos_had_pres_base::calc_e(fermion &n, fermion &p, thermo &th) {
   return 0;
 }
 
+int eos_had_temp_base::calc_temp_e_batch(size_t n_pts, const double *nn,
+                                         const double *np, const double *T,
+                                         double *ed, double *pr, double *en,
+                                         double *mun, double *mup) {
+  
+  fermion ne=*neutron, prot=*proton;
+  thermo th;
+  int ret=0;
+  
+  for(size_t i=0;i<n_pts;i++) {
+    ne.n=nn[i];
+    prot.n=np[i];
+    int r=calc_temp_e(ne,prot,T[i],th);
+    if (r!=0) ret=r;
+    ed[i]=th.ed;
+    pr[i]=th.pr;
+    en[i]=th.en;
+    mun[i]=ne.mu;
+    mup[i]=prot.mu;
+  }
+  
+  return ret;
+}
+
 double eos_had_temp_base::calc_fr(double nn, double np, double T) {
   
   neutron->n=nn;  
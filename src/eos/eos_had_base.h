@@ -380,6 +380,25 @@ namespace o2scl {
     /** \brief Equation of state as a function of density
      */
     virtual int calc_e(fermion &n, fermion &p, thermo &th)=0;
+
+    /** \brief Equation of state for arrays of densities
+
+        Given the neutron and proton densities of \c n_pts points
+        in \c nn and \c np, this function stores the energy
+        density, pressure, and neutron and proton chemical
+        potentials in \c ed, \c pr, \c mun, and \c mup, which must
+        each have space for \c n_pts elements. The masses and other
+        settings are taken from \ref neutron and \ref proton, which
+        are not modified.
+
+        This default implementation calls \ref calc_e() for each
+        point with copies of \ref neutron and \ref proton. Children
+        may override it with a faster version. If any call fails,
+        the last nonzero return value is returned.
+    */
+    virtual int calc_e_batch(size_t n_pts, const double *nn,
+                             const double *np, double *ed, double *pr,
+                             double *mun, double *mup);
     //@}
 
     /// \name EOS properties
@@ -1112,6 +1131,20 @@ namespace o2scl {
     virtual int calc_temp_e(fermion &n, fermion &p, double T, 
                             thermo &th)=0;
 
+    /** \brief Equation of state for arrays of densities and
+        temperatures
+
+        This works like \ref eos_had_base::calc_e_batch(), except
+        that it takes the temperatures in \c T and also stores the
+        entropy densities in \c en. This default implementation calls
+        \ref calc_temp_e() for each point with copies of \ref
+        neutron and \ref proton.
+    */
+    virtual int calc_temp_e_batch(size_t n_pts, const double *nn,
+                                  const double *np, const double *T,
+                                  double *ed, double *pr, double *en,
+                                  double *mun, double *mup);
+
     /** \brief Equation of state as a function of the chemical potentials
      */
     virtual int calc_p(fermion &n, fermion &p, thermo &th)=0;
@@ -67,6 +67,13 @@ eos_had_rmf::eos_had_rmf() {
 int eos_had_rmf::calc_eq_temp_p
 (fermion &ne, fermion &pr, double temper, double sig, double ome, 
  double lrho, double &f1, double &f2, double &f3, thermo &lth) {
+  return calc_eq_temp_p(ne,pr,temper,sig,ome,lrho,f1,f2,f3,lth,*fet);
+}
+
+int eos_had_rmf::calc_eq_temp_p
+(fermion &ne, fermion &pr, double temper, double sig, double ome, 
+ double lrho, double &f1, double &f2, double &f3, thermo &lth,
+ fermion_thermo &ws) const {
 
   double gs2, gs, gr2, gr, gw2, gw, duds;
   double us, fun, dfdw, fnn=0.0, fnp=0.0, sig2, sig4, ome2, ome4, rho2;
@@ -95,7 +102,7 @@ int eos_had_rmf::calc_eq_temp_p
 #endif
 
   if (temper<=0.0) {
-    calc_eq_p(ne,pr,sig,ome,rho,f1,f2,f3,lth);
+    calc_eq_p(ne,pr,sig,ome,rho,f1,f2,f3,lth,ws);
   }
   
   gs=ms*cs;
@@ -127,8 +134,8 @@ int eos_had_rmf::calc_eq_temp_p
   ne.non_interacting=false;
   pr.non_interacting=false;
 
-  fet->pair_mu(ne,temper);
-  fet->pair_mu(pr,temper);
+  ws.pair_mu(ne,temper);
+  ws.pair_mu(pr,temper);
   
   sig2=sig*sig;
   sig4=sig2*sig2;
@@ -706,6 +713,12 @@ int eos_had_rmf::calc_temp_e(fermion &ne, fermion &pr, const double T,
 int eos_had_rmf::calc_eq_p(fermion &ne, fermion &pr, double sig, double ome, 
 			   double lrho, double &f1, double &f2, double &f3, 
 			   thermo &lth) {
+  return calc_eq_p(ne,pr,sig,ome,lrho,f1,f2,f3,lth,*fet);
+}
+
+int eos_had_rmf::calc_eq_p(fermion &ne, fermion &pr, double sig, double ome, 
+			   double lrho, double &f1, double &f2, double &f3, 
+			   thermo &lth, fermion_thermo &ws) const {
 
   ne.non_interacting=false;
   pr.non_interacting=false;
@@ -746,8 +759,8 @@ int eos_had_rmf::calc_eq_p(fermion &ne, fermion &pr, double sig, double ome,
 
   // We don't record error values, since these functions usually
   // always succeed
-  fet->calc_mu_zerot(ne);
-  fet->calc_mu_zerot(pr);
+  ws.calc_mu_zerot(ne);
+  ws.calc_mu_zerot(pr);
 
   sig2=sig*sig;
   sig4=sig2*sig2;
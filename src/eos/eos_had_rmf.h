@@ -472,6 +472,48 @@ namespace o2scl {
     virtual int calc_eq_temp_p(fermion &ne, fermion &pr, double temper, 
                                double sig, double ome, double rho, double &f1, 
                                double &f2, double &f3, thermo &th);
+
+    /** \name Reentrant versions
+
+        These functions compute the equation of state and the
+        field equations for fixed values of the fields. They do not
+        modify this object, so several threads may call them
+        simultaneously on the same object as long as each thread
+        provides its own fermion thermodynamics object \c ws (used
+        in place of the object specified in \ref
+        o2scl::eos_had_temp_base::set_fermion_thermo()). The
+        member versions above call these functions with the
+        default fermion thermodynamics object, so a child class
+        which modifies the field equations need only override
+        these two functions (with <tt>using eos_had_rmf::calc_eq_p</tt>
+        and <tt>using eos_had_rmf::calc_eq_temp_p</tt> so that the
+        other versions are not hidden).
+
+        The functions which solve the field equations, such as
+        calc_e(), calc_p(), and calc_temp_p(), store the fields
+        and use the solvers in this object and are not reentrant.
+        A parallel computation which uses these functions still
+        requires one \ref eos_had_rmf object for each thread.
+    */
+    //@{
+    /** \brief Equation of state and meson field equations as a 
+        function of chemical potentials using the fermion 
+        thermodynamics object \c ws
+    */
+    virtual int calc_eq_p(fermion &neu, fermion &p, double sig,
+                          double ome, double rho, double &f1,
+                          double &f2, double &f3, thermo &th,
+                          fermion_thermo &ws) const;
+
+    /** \brief Equation of state and meson field equations as a 
+        function of chemical potentials at finite temperature
+        using the fermion thermodynamics object \c ws
+    */
+    virtual int calc_eq_temp_p(fermion &ne, fermion &pr, double temper, 
+                               double sig, double ome, double rho,
+                               double &f1, double &f2, double &f3,
+                               thermo &th, fermion_thermo &ws) const;
+    //@}
     
     /** \brief Equation of state as a function of chemical potential
         
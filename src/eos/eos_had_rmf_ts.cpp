@@ -30,6 +30,10 @@
 #include <o2scl/eos_had_rmf.h>
 #include <o2scl/hdf_eos_io.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -513,6 +517,64 @@ public:
     cout << "  Field equations: " << f1 << " " << f2 << " " << f3 << endl;
     cout << endl;
 
+    // Compare with the reentrant versions using a separate
+    // fermion thermodynamics object
+    {
+      const eos_had_rmf &rec=re;
+      fermion_rel ws;
+      const fermion n_in=nferm, p_in=p;
+      fermion n2=nferm, p2=p;
+      thermo th2;
+      double g1, g2, g3;
+      rec.calc_eq_p(n2,p2,sig,ome,rho,g1,g2,g3,th2,ws);
+      t.test_rel(th2.ed,th.ed,1.0e-12,"reentrant calc_eq_p ed");
+      t.test_rel(th2.pr,th.pr,1.0e-12,"reentrant calc_eq_p pr");
+      t.test_rel(n2.n,nferm.n,1.0e-12,"reentrant calc_eq_p nn");
+      t.test_rel(p2.n,p.n,1.0e-12,"reentrant calc_eq_p np");
+
+      double T=1.0/hc_mev_fm;
+      fermion n3=nferm, p3=p;
+      thermo th3;
+      re.calc_eq_temp_p(nferm,p,T,sig,ome,rho,f1,f2,f3,th);
+      rec.calc_eq_temp_p(n3,p3,T,sig,ome,rho,g1,g2,g3,th3,ws);
+      t.test_rel(th3.ed,th.ed,1.0e-10,"reentrant calc_eq_temp_p ed");
+      t.test_rel(th3.en,th.en,1.0e-10,"reentrant calc_eq_temp_p en");
+      t.test_rel(n3.n,nferm.n,1.0e-10,"reentrant calc_eq_temp_p nn");
+      t.test_rel(g1,f1,1.0e-10,"reentrant calc_eq_temp_p f1");
+
+#ifdef O2SCL_OPENMP
+
+      // Several threads share the const object, each with its own
+      // fermion thermodynamics object
+      double ed_par[16];
+      fermion_rel ws_arr[4];
+#pragma omp parallel for num_threads(4) schedule(static,1)
+      for(int k=0;k<16;k++) {
+        int it=omp_get_thread_num();
+        fermion nk=n_in, pk=p_in;
+        thermo thk;
+        double h1, h2, h3;
+        if (k%2==0) {
+          rec.calc_eq_p(nk,pk,sig,ome,rho,h1,h2,h3,thk,ws_arr[it]);
+        } else {
+          rec.calc_eq_temp_p(nk,pk,T,sig,ome,rho,h1,h2,h3,thk,
+                             ws_arr[it]);
+        }
+        ed_par[k]=thk.ed;
+      }
+      for(size_t k=0;k<16;k++) {
+        if (k%2==0) {
+          t.test_rel(ed_par[k],th2.ed,1.0e-12,"parallel calc_eq_p ed");
+        } else {
+          t.test_rel(ed_par[k],th3.ed,1.0e-12,
+                     "parallel calc_eq_temp_p ed");
+        }
+      }
+      
+#endif
+      
+    }
+
     rmf.set_fields(0.1,0.07,-0.001);
     re.saturation();
     t.test_rel(re.n0,0.16,1.0e-4,"sat2 n0");
@@ -26,6 +26,10 @@
 
 #include <o2scl/eos_had_skyrme.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -169,6 +173,143 @@ int eos_had_skyrme::calc_e(fermion &ne, fermion &pr, thermo &locth) {
   return calc_temp_e(ne,pr,0.0,locth);
 }
 
+int eos_had_skyrme::calc_temp_e_batch(size_t n_pts, const double *nn,
+                                      const double *np, const double *T,
+                                      double *ed, double *pr, double *en,
+                                      double *mun, double *mup) {
+  return batch_thermo(n_pts,nn,np,T,ed,pr,en,mun,mup);
+}
+
+int eos_had_skyrme::calc_e_batch(size_t n_pts, const double *nn,
+                                 const double *np, double *ed, double *pr,
+                                 double *mun, double *mup) {
+  return batch_thermo(n_pts,nn,np,0,ed,pr,0,mun,mup);
+}
+
+int eos_had_skyrme::batch_thermo(size_t n_pts, const double *nn,
+                                 const double *np, const double *T,
+                                 double *ed, double *pr, double *en,
+                                 double *mun, double *mup) {
+
+  // Check the input once, rather than for every point
+  for(size_t i=0;i<n_pts;i++) {
+    double Ti=0.0;
+    if (T!=0) Ti=T[i];
+    if (!std::isfinite(nn[i]) || !std::isfinite(np[i]) ||
+        !std::isfinite(Ti) || nn[i]<0.0 || np[i]<0.0 || Ti<0.0) {
+      string err=((string)"Invalid density or temperature (n_n=")+
+        o2scl::dtos(nn[i])+", n_p="+o2scl::dtos(np[i])+", T="+
+        o2scl::dtos(Ti)+") at index "+o2scl::szttos(i)+
+        " in eos_had_skyrme::batch_thermo().";
+      O2SCL_ERR(err.c_str(),exc_einval);
+    }
+  }
+  fermion tn, tp;
+  tn.n=0.0;
+  tp.n=0.0;
+  init_np_tl(tn,tp);
+  check_input(tn,tp,0.0);
+
+  const double mn=neutron->m, mp=proton->m;
+  const double gn=neutron->g, gp=proton->g;
+  const bool irmn=neutron->inc_rest_mass, irmp=proton->inc_rest_mass;
+  
+  double term=0.25*(t1*(1.0+x1/2.0)+t2*(1.0+x2/2.0));
+  double term2=0.25*(t2*(0.5+x2)-t1*(0.5+x1));
+  double ham1, ham2, ham3, ham4, ham5, ham6;
+  hamiltonian_coeffs(ham1,ham2,ham3,ham4,ham5,ham6);
+
+  const size_t block=256;
+  size_t n_blocks=(n_pts+block-1)/block;
+  std::vector<int> status(n_blocks,0);
+  std::vector<int> ms_neg(n_blocks,0);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    
+    size_t i0=ib*block;
+    size_t nb=n_pts-i0;
+    if (nb>block) nb=block;
+
+    double msn[block], msp[block], nun[block], nup[block];
+    double edn[block], edp[block], prk[block], enn[block], enp[block];
+
+    // Landau effective masses
+    for(size_t j=0;j<nb;j++) {
+      size_t i=i0+j;
+      double nbar=nn[i]+np[i];
+      msn[j]=mn/(1.0+2.0*(nbar*term+nn[i]*term2)*mn);
+      msp[j]=mp/(1.0+2.0*(nbar*term+np[i]*term2)*mp);
+      if (msn[j]<0.0 || msp[j]<0.0) ms_neg[ib]=1;
+    }
+    if (ms_neg[ib]) continue;
+
+    // Kinetic parts
+    const double *Tb=0;
+    if (T!=0) Tb=T+i0;
+    int r1=nrfb.calc_density(nb,nn+i0,msn,Tb,mn,gn,irmn,nun,edn,prk,enn);
+    int r2=nrfb.calc_density(nb,np+i0,msp,Tb,mp,gp,irmp,nup,edp,prk,enp);
+    if (r1!=0) status[ib]=r1;
+    if (r2!=0) status[ib]=r2;
+
+    // Potential parts, as in base_thermo()
+    for(size_t j=0;j<nb;j++) {
+      size_t i=i0+j;
+      double n_n=nn[i], n_p=np[i];
+      double nbar=n_n+n_p;
+      double na=pow(nbar,alpha);
+      double npa=pow(n_p,alpha);
+      double nna=pow(n_n,alpha);
+      double nsq=n_n*n_n+n_p*n_p;
+      
+      double ham=edn[j]+edp[j]+ham1*nbar*nbar+ham2*nsq+
+        ham3*na*n_n*n_p+ham4*(nna*n_n*n_n+npa*n_p*n_p)+
+        ham5*nbar*nbar*na+ham6*nsq*na;
+
+      double gkn, gkp;
+      if (irmn) gkn=2.0*msn[j]*(edn[j]-n_n*mn);
+      else gkn=2.0*msn[j]*edn[j];
+      if (irmp) gkp=2.0*msp[j]*(edp[j]-n_p*mp);
+      else gkp=2.0*msp[j]*edp[j];
+      
+      double common=2.0*ham1*nbar+ham5*(2.0+alpha)*nbar*na;
+      double dhdnn=common+2.0*ham2*n_n+ham3*na*n_p*(alpha*n_n/nbar+1.0)+
+        ham4*(nna*n_n*(2.0+alpha))+
+        ham6*(2.0*n_n*na+nsq*alpha*na/nbar);
+      double dhdnp=common+2.0*ham2*n_p+ham3*na*n_n*(alpha*n_p/nbar+1.0)+
+        ham4*(npa*n_p*(2.0+alpha))+
+        ham6*(2.0*n_p*na+nsq*alpha*na/nbar);
+
+      mun[i]=nun[j]+dhdnn+(gkn+gkp)*term+gkn*term2;
+      mup[i]=nup[j]+dhdnp+(gkn+gkp)*term+gkp*term2;
+      ed[i]=ham;
+      double ent=enn[j]+enp[j];
+      if (en!=0) en[i]=ent;
+      if (T!=0) pr[i]=T[i]*ent+mun[i]*n_n+mup[i]*n_p-ham;
+      else pr[i]=mun[i]*n_n+mup[i]*n_p-ham;
+    }
+  }
+
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    if (ms_neg[ib]) {
+      O2SCL_CONV2_RET("Effective masses negative in ",
+                      "eos_had_skyrme::batch_thermo().",exc_einval,
+                      this->err_nonconv);
+    }
+  }
+  for(size_t ib=0;ib<n_blocks;ib++) {
+    if (status[ib]!=0) {
+      O2SCL_CONV2_RET("Kinetic part failed in ",
+                      "eos_had_skyrme::batch_thermo().",status[ib],
+                      this->err_nonconv);
+    }
+  }
+  
+  return success;
+}
+
 int eos_had_skyrme::calc_deriv_e(fermion_deriv &ne, fermion_deriv &pr,
 				 thermo &locth,
 				 thermo_np_deriv_helm &thd) {
@@ -225,9 +366,20 @@ double eos_had_skyrme::fcomp_nuc(double nb) {
 double eos_had_skyrme::fesym(double nb, double pf) {
   double ret, kr23;
 
-  if (pf!=0.5 || parent_method) {
+  if (parent_method) {
     return eos_had_base::fesym(nb,pf);
   }
+  if (pf!=0.5) {
+    // Differentiate mu_n-mu_p with respect to delta
+    fermion_tl<dual> ne, pr;
+    thermo_tl<dual> th;
+    init_np_tl(ne,pr);
+    dual delta(pf,1.0);
+    ne.n=(1.0+delta)*nb/2.0;
+    pr.n=(1.0-delta)*nb/2.0;
+    calc_e_tl(ne,pr,th);
+    return (ne.mu-pr.mu).der/4.0;
+  }
   kr23=0.6/(neutron->m+proton->m)*pow(1.5*pi2*nb,2.0/3.0);
   ret=5.0/9.0*kr23+10.0/6.0*(neutron->m+proton->m)*kr23*nb*
     (t2/6.0*(1.0+1.25*x2)-0.125*t1*x1)-
@@ -254,6 +406,143 @@ double eos_had_skyrme::fkprime_nuc(double nb) {
   return ret;
 }
 
+double eos_had_skyrme::fcomp(double nb, double delta) {
+
+  if (parent_method) {
+    return eos_had_base::fcomp(nb,delta);
+  }
+  
+  fermion_tl<dual> ne, pr;
+  thermo_tl<dual> th;
+  init_np_tl(ne,pr);
+  dual dnb(nb,1.0);
+  ne.n=(1.0+delta)*dnb/2.0;
+  pr.n=(1.0-delta)*dnb/2.0;
+  calc_e_tl(ne,pr,th);
+  
+  return 9.0*th.pr.der;
+}
+
+double eos_had_skyrme::fesym_slope(double nb, double delta) {
+
+  if (parent_method) {
+    return eos_had_base::fesym_slope(nb,delta);
+  }
+
+  // The first infinitesimal is used for delta and the second
+  // for the baryon density
+  fermion_tl<hyper_dual> ne, pr;
+  thermo_tl<hyper_dual> th;
+  init_np_tl(ne,pr);
+  hyper_dual hdelta(dual(delta,1.0),0.0);
+  hyper_dual hnb(nb,dual(1.0,0.0));
+  ne.n=(1.0+hdelta)*hnb/2.0;
+  pr.n=(1.0-hdelta)*hnb/2.0;
+  calc_e_tl(ne,pr,th);
+  
+  return 3.0*nb*(ne.mu-pr.mu).der.der/4.0;
+}
+
+double eos_had_skyrme::fesym_curve(double nb, double delta) {
+
+  if (parent_method) {
+    return eos_had_base::fesym_curve(nb,delta);
+  }
+
+  // The first infinitesimal is used for delta and the second
+  // and third for the baryon density
+  typedef dual_tl<hyper_dual> dual3;
+  fermion_tl<dual3> ne, pr;
+  thermo_tl<dual3> th;
+  init_np_tl(ne,pr);
+  dual3 tdelta(hyper_dual(dual(delta,1.0),0.0),0.0);
+  dual3 tnb(hyper_dual(nb,dual(1.0,0.0)),hyper_dual(1.0,0.0));
+  ne.n=(1.0+tdelta)*tnb/2.0;
+  pr.n=(1.0-tdelta)*tnb/2.0;
+  calc_e_tl(ne,pr,th);
+  
+  return 9.0*nb*nb*(ne.mu-pr.mu).der.der.der/4.0;
+}
+
+double eos_had_skyrme::fkprime(double nb, double delta) {
+
+  if (parent_method) {
+    return eos_had_base::fkprime(nb,delta);
+  }
+
+  fermion_tl<hyper_dual> ne, pr;
+  thermo_tl<hyper_dual> th;
+  init_np_tl(ne,pr);
+  hyper_dual hnb(dual(nb,1.0),dual(1.0,0.0));
+  ne.n=hnb/2.0;
+  pr.n=hnb/2.0;
+  calc_e_tl(ne,pr,th);
+  hyper_dual pon2=th.pr/hnb/hnb;
+  
+  return 27.0*nb*nb*nb*pon2.der.der;
+}
+
+void eos_had_skyrme::f_number_suscept(double mun, double mup, double &dPdnn, 
+				      double &dPdnp, double &dPdpp) {
+  
+  if (parent_method) {
+    eos_had_base::f_number_suscept(mun,mup,dPdnn,dPdnp,dPdpp);
+    return;
+  }
+
+  // Determine the densities, restoring the chemical potentials
+  // and densities of the neutron and proton afterwards
+  double mun_old=neutron->mu, mup_old=proton->mu;
+  double nn_old=neutron->n, np_old=proton->n;
+  neutron->mu=mun;
+  proton->mu=mup;
+  int ret=calc_p(*neutron,*proton,*eos_thermo);
+  double nn=neutron->n, np=proton->n;
+  neutron->mu=mun_old;
+  proton->mu=mup_old;
+  neutron->n=nn_old;
+  proton->n=np_old;
+  if (ret!=0) {
+    O2SCL_ERR2("Function calc_p() failed in ",
+               "eos_had_skyrme::f_number_suscept().",exc_efailed);
+    return;
+  }
+  
+  // Invert the matrix of second derivatives of the energy density
+  double dednn, dednp, dedpp;
+  f_inv_number_suscept(nn,np,dednn,dednp,dedpp);
+  double det=dednn*dedpp-dednp*dednp;
+  dPdnn=dedpp/det;
+  dPdnp=-dednp/det;
+  dPdpp=dednn/det;
+  
+  return;
+}
+
+void eos_had_skyrme::f_inv_number_suscept(double nn, double np,
+					  double &dednn, double &dednp,
+					  double &dedpp) {
+  
+  if (parent_method) {
+    eos_had_base::f_inv_number_suscept(nn,np,dednn,dednp,dedpp);
+    return;
+  }
+
+  // The first infinitesimal is used for the neutron density
+  // and the second for the proton density
+  fermion_tl<hyper_dual> ne, pr;
+  thermo_tl<hyper_dual> th;
+  init_np_tl(ne,pr);
+  ne.n=hyper_dual(dual(nn,1.0),0.0);
+  pr.n=hyper_dual(np,dual(1.0,0.0));
+  calc_e_tl(ne,pr,th);
+  dednn=ne.mu.val.der;
+  dednp=ne.mu.der.val;
+  dedpp=pr.mu.der.val;
+  
+  return;
+}
+
 int eos_had_skyrme::calpar(double gt0, double gt3, double galpha,
 			   double gt1, double gt2) {
 
@@ -31,6 +31,7 @@
 #include <cmath>
 
 #include <o2scl/constants.h>
+#include <o2scl/dual.h>
 #include <o2scl/mroot.h>
 #include <o2scl/eos_had_base.h>
 #include <o2scl/part.h>
@@ -257,22 +258,22 @@ namespace o2scl {
         This function computes the energy density, pressure,
         entropy, and chemical potentials.
      */
-    template<class fermion_t>
+    template<class fp_t>
       void base_thermo
-      (fermion_t &ne, fermion_t &pr, double ltemper, thermo &locth,
-       double term, double term2, double ham1, double ham2,
-       double ham3, double ham4, double ham5, double ham6) {
+      (fermion_tl<fp_t> &ne, fermion_tl<fp_t> &pr, double ltemper,
+       thermo_tl<fp_t> &locth, double term, double term2, double ham1,
+       double ham2, double ham3, double ham4, double ham5, double ham6) {
       
-      double nb=ne.n+pr.n;
-      double na=pow(nb,alpha);
-      double npa=pow(pr.n,alpha);
-      double nna=pow(ne.n,alpha);
+      fp_t nb=ne.n+pr.n;
+      fp_t na=pow(nb,alpha);
+      fp_t npa=pow(pr.n,alpha);
+      fp_t nna=pow(ne.n,alpha);
       
-      double ham=ne.ed+pr.ed+ham1*nb*nb+ham2*(ne.n*ne.n+pr.n*pr.n)+
+      fp_t ham=ne.ed+pr.ed+ham1*nb*nb+ham2*(ne.n*ne.n+pr.n*pr.n)+
         ham3*na*ne.n*pr.n+ham4*(nna*ne.n*ne.n+npa*pr.n*pr.n)+
         ham5*nb*nb*na+ham6*(ne.n*ne.n+pr.n*pr.n)*na;
       
-      double gn, gp;
+      fp_t gn, gp;
       if (ne.inc_rest_mass) {
         gn=2.0*ne.ms*(ne.ed-ne.n*ne.m);
       } else {
@@ -286,11 +287,11 @@ namespace o2scl {
       
       // Variables dhdn{n,p} are the partial derivatives of the
       // Hamiltonian wrt the neutron and proton densities
-      double common=2.0*ham1*nb+ham5*(2.0+alpha)*nb*na;
-      double dhdnn=common+2.0*ham2*ne.n+ham3*na*pr.n*(alpha*ne.n/nb+1.0)+
+      fp_t common=2.0*ham1*nb+ham5*(2.0+alpha)*nb*na;
+      fp_t dhdnn=common+2.0*ham2*ne.n+ham3*na*pr.n*(alpha*ne.n/nb+1.0)+
         ham4*(nna*ne.n*(2.0+alpha))+
         ham6*(2.0*ne.n*na+(ne.n*ne.n+pr.n*pr.n)*alpha*na/nb);
-      double dhdnp=common+2.0*ham2*pr.n+ham3*na*ne.n*(alpha*pr.n/nb+1.0)+
+      fp_t dhdnp=common+2.0*ham2*pr.n+ham3*na*ne.n*(alpha*pr.n/nb+1.0)+
         ham4*(npa*pr.n*(2.0+alpha))+
         ham6*(2.0*pr.n*na+(ne.n*ne.n+pr.n*pr.n)*alpha*na/nb);
 
@@ -306,6 +307,58 @@ namespace o2scl {
       return;
     }
     
+    /** \brief Compute the thermodynamics for arrays of points
+
+        This function is used by \ref calc_temp_e_batch() and \ref
+        calc_e_batch(). If \c T is zero, all of the points are at
+        zero temperature, and if \c en is zero, the entropy is not
+        stored.
+    */
+    int batch_thermo(size_t n_pts, const double *nn, const double *np,
+                     const double *T, double *ed, double *pr,
+                     double *en, double *mun, double *mup);
+    
+    /** \brief Compute the kinetic part of the thermodynamics of
+        a nonrelativistic fermion at zero temperature
+
+        This is the same as \ref
+        o2scl::fermion_nonrel_tl::calc_density_zerot(), but it uses
+        only \ref o2scl::fermion_zerot_tl so that it can be used
+        with types which do not support the finite temperature
+        integrals (e.g. \ref o2scl::dual_tl).
+    */
+    template<class fp_t> void kinetic_zerot(fermion_tl<fp_t> &f) {
+      if (f.non_interacting) { f.ms=f.m; }
+      fermion_zerot_tl<fp_t> fzt;
+      fzt.kf_from_density(f);
+      f.nu=f.kf*f.kf/2.0/f.ms;
+      f.ed=f.g*pow(f.kf,5.0)/20.0/o2scl_const::pi2/f.ms;
+      if (f.inc_rest_mass) {
+        f.ed+=f.n*f.m;
+        f.nu+=f.m;
+      }
+      f.pr=-f.ed+f.n*f.nu;
+      f.en=0.0;
+      if (f.non_interacting) { f.mu=f.nu; }
+      return;
+    }
+
+    /** \brief Copy the masses, degeneracies, and flags from the
+        neutron and proton objects to \c ne and \c pr
+    */
+    template<class fp_t> void init_np_tl(fermion_tl<fp_t> &ne,
+                                         fermion_tl<fp_t> &pr) {
+      ne.m=neutron->m;
+      ne.g=neutron->g;
+      ne.inc_rest_mass=neutron->inc_rest_mass;
+      ne.non_interacting=neutron->non_interacting;
+      pr.m=proton->m;
+      pr.g=proton->g;
+      pr.inc_rest_mass=proton->inc_rest_mass;
+      pr.non_interacting=proton->non_interacting;
+      return;
+    }
+    
     /** \brief Compute second derivatives of the free energy
      */
     template<class fermion_t>
@@ -476,6 +529,72 @@ namespace o2scl {
     */
     virtual int calc_deriv_e(fermion_deriv &ne, fermion_deriv &pr,
                              thermo &th, thermo_np_deriv_helm &thd);
+
+    /** \brief Equation of state for arrays of densities and
+        temperatures
+
+        This gives the same results as calling \ref calc_temp_e()
+        for each point (up to the tolerance in \ref
+        fermion_nonrel_batch), but the points are processed in
+        blocks, the kinetic part is computed with \ref nrfb, and the
+        blocks are divided among threads if OpenMP is enabled. See
+        \ref eos_had_temp_base::calc_temp_e_batch() for the meaning
+        of the arguments.
+    */
+    virtual int calc_temp_e_batch(size_t n_pts, const double *nn,
+                                  const double *np, const double *T,
+                                  double *ed, double *pr, double *en,
+                                  double *mun, double *mup);
+    
+    /** \brief Equation of state for arrays of densities at zero
+        temperature
+
+        This gives the same results as calling \ref calc_e() for
+        each point. See \ref calc_temp_e_batch().
+    */
+    virtual int calc_e_batch(size_t n_pts, const double *nn,
+                             const double *np, double *ed, double *pr,
+                             double *mun, double *mup);
+
+    /** \brief Equation of state as a function of the densities at
+        zero temperature for a generic floating point type
+
+        This function gives the same results as \ref calc_e(), but
+        can be used with any floating point type which supports
+        arithmetic and the elementary functions, in particular with
+        the dual numbers in \ref o2scl::dual_tl. This is how the
+        functions \ref fcomp(), \ref fesym(), \ref fesym_slope(),
+        \ref fesym_curve(), \ref fkprime(), \ref f_number_suscept(),
+        and \ref f_inv_number_suscept() obtain exact derivatives.
+    */
+    template<class fp_t>
+      int calc_e_tl(fermion_tl<fp_t> &ne, fermion_tl<fp_t> &pr,
+                    thermo_tl<fp_t> &th) {
+
+      if (ne.n<0.0 || pr.n<0.0) {
+        O2SCL_ERR2("Nucleon densities negative in ",
+                   "eos_had_skyrme::calc_e_tl().",exc_einval);
+      }
+      
+      double term, term2;
+      eff_mass(ne,pr,term,term2);
+      
+      if (ne.ms<0.0 || pr.ms<0.0) {
+        O2SCL_CONV2_RET("Effective masses negative in ",
+                        "eos_had_skyrme::calc_e_tl().",exc_einval,
+                        this->err_nonconv);
+      }
+
+      kinetic_zerot(ne);
+      kinetic_zerot(pr);
+      
+      double ham1, ham2, ham3, ham4, ham5, ham6;
+      hamiltonian_coeffs(ham1,ham2,ham3,ham4,ham5,ham6);
+      
+      base_thermo(ne,pr,0.0,th,term,term2,ham1,ham2,ham3,ham4,ham5,ham6);
+      
+      return success;
+    }
     
     /// Return string denoting type ("eos_had_skyrme")
     virtual const char *type() { return "eos_had_skyrme"; }
@@ -507,7 +626,8 @@ namespace o2scl {
     /** \brief Use eos_had_base methods for saturation properties
         
         This can be set to true to check the difference between
-        the exact expressions and the numerical values from
+        the exact expressions (or the derivatives computed with
+        automatic differentiation) and the numerical values from
         class eos_had_base.
     */
     bool parent_method;
@@ -552,7 +672,11 @@ namespace o2scl {
     /** \brief Calculate symmetry energy
 
         If pf=0.5, then the exact expression below is used.
-        Otherwise, the method from class eos_had_base is used.
+        Otherwise, the symmetry energy is computed from the
+        derivative of \f$ \mu_n - \mu_p \f$ with respect to
+        \f$ \delta \f$ using automatic differentiation (or with the
+        method from class eos_had_base if \ref parent_method is
+        true).
 
         \f[
         E_{sym} = \frac{5}{9} C n^{2/3} + \frac{10 C m}{3}
@@ -563,7 +687,7 @@ namespace o2scl {
         \frac{t_0}{4} \left( {\textstyle \frac{1}{2}} + x_0 \right) n 
         \f]
     */
-    virtual double fesym(double nb, double alpha=0.0);
+    virtual double fesym(double nb, double delta=0.0);
 
     /** \brief Skewness in nuclear (isospin-symetric) matter
 
@@ -576,6 +700,61 @@ namespace o2scl {
     virtual double fkprime_nuc(double nb);
     //@}
 
+    /** \name Derivatives from automatic differentiation
+
+        These functions compute the same quantities as the
+        corresponding functions in \ref eos_had_base, but they
+        evaluate \ref calc_e_tl() once with dual numbers (see \ref
+        o2scl::dual_tl) rather than calling \ref calc_e() repeatedly
+        for finite differences, so the derivatives are exact to
+        within rounding. The functions in \ref eos_had_base are used
+        instead if \ref parent_method is true.
+    */
+    //@{
+    /** \brief Compressibility, \f$ 9 (d P/d n_B) \f$ at 
+        fixed \f$ \delta \f$
+    */
+    virtual double fcomp(double nb, double delta=0.0);
+
+    /** \brief The slope of the symmetry energy, \f$ 3 n_B 
+        (d E_{sym}/d n_B) \f$
+    */
+    virtual double fesym_slope(double nb, double delta=0.0);
+
+    /** \brief The curvature of the symmetry energy, \f$ 9 n_B^2 
+        (d^2 E_{sym}/d n_B^2) \f$
+    */
+    virtual double fesym_curve(double nb, double delta=0.0);
+
+    /** \brief The skewness of nuclear matter, \f$ 27 n_B^3 
+        d^2/d n_B^2 (P/n_B^2) \f$
+
+        As in \ref eos_had_base::fkprime(), the value of \c delta
+        is ignored and the result is for isospin-symmetric matter.
+    */
+    virtual double fkprime(double nb, double delta=0.0);
+
+    /** \brief Compute the number susceptibilities, 
+        \f$ \partial^2 P/\partial \mu_i \partial \mu_j \f$
+
+        The densities are determined from the chemical potentials
+        with \ref calc_p() and the susceptibilities are then obtained
+        by inverting the matrix computed in \ref
+        f_inv_number_suscept(). The chemical potentials and
+        densities of the neutron and proton objects are restored
+        afterwards. If \ref calc_p() fails, the error handler is
+        called.
+    */
+    virtual void f_number_suscept(double mun, double mup, double &dPdnn, 
+                                  double &dPdnp, double &dPdpp);
+
+    /** \brief Compute the inverse number susceptibilities, 
+        \f$ \partial^2 \varepsilon/\partial n_i \partial n_j \f$
+    */
+    virtual void f_inv_number_suscept(double nn, double np, double &dednn, 
+                                      double &dednp, double &dedpp);
+    //@}
+
     /// \name Compute and test Landau parameters
     //@{
     /** \brief Check the Landau parameters for instabilities
@@ -628,12 +807,12 @@ namespace o2scl {
     /** \brief Evaluate the effective masses for neutrons and
         protons
     */
-    template<class fermion_t>
-      void eff_mass(fermion_t &ne, fermion_t &pr, double &term,
-                    double &term2) {
+    template<class fp_t>
+      void eff_mass(fermion_tl<fp_t> &ne, fermion_tl<fp_t> &pr,
+                    double &term, double &term2) {
       
       // Landau effective masses
-      double nb=ne.n+pr.n;
+      fp_t nb=ne.n+pr.n;
       term=0.25*(t1*(1.0+x1/2.0)+t2*(1.0+x2/2.0));
       term2=0.25*(t2*(0.5+x2)-t1*(0.5+x1));
       ne.ms=ne.m/(1.0+2.0*(nb*term+ne.n*term2)*ne.m);
@@ -801,6 +980,9 @@ namespace o2scl {
     
     /// Thermodynamics of non-relativistic fermions with derivatives
     fermion_deriv_nr nrfd;
+
+    /// Thermodynamics of non-relativistic fermions for arrays of points
+    fermion_nonrel_batch nrfb;
     //@}
     
   protected:
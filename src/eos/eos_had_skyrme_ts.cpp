@@ -181,6 +181,65 @@ int main(void) {
   t.test_rel(sk.fkprime(n0),sk.kprime,1.0e-3,"kprime pm");
   sk.parent_method=false;
   cout << endl;
+
+  cout << "Compare automatic differentiation with exact expressions "
+       << "and eos_had_base:" << endl;
+  t.test_rel(sk.fcomp(n0),sk.fcomp_nuc(n0),1.0e-12,"comp ad");
+  t.test_rel(sk.fkprime(n0),sk.fkprime_nuc(n0),1.0e-12,"kprime ad");
+  {
+    double comp_ad=sk.fcomp(n0,0.3);
+    double esym_ad=sk.fesym(n0,0.3);
+    double L_ad=sk.fesym_slope(n0);
+    double Ksym_ad=sk.fesym_curve(n0);
+    sk.parent_method=true;
+    t.test_rel(comp_ad,sk.fcomp(n0,0.3),1.0e-6,"comp ad delta=0.3");
+    t.test_rel(esym_ad,sk.fesym(n0,0.3),1.0e-6,"esym ad delta=0.3");
+    t.test_rel(L_ad,sk.fesym_slope(n0),1.0e-5,"L ad");
+    // K_sym from eos_had_base is a numerical second derivative of
+    // the numerical symmetry energy, so it is less accurate
+    t.test_rel(Ksym_ad,sk.fesym_curve(n0),1.0e-3,"Ksym ad");
+    sk.parent_method=false;
+
+    // Compare the inverse susceptibilities with finite differences
+    // of the chemical potentials
+    double dednn, dednp, dedpp, h=1.0e-5;
+    fermion n2(sk.def_neutron), p2(sk.def_proton);
+    thermo th2;
+    sk.set_n_and_p(n2,p2);
+    sk.f_inv_number_suscept(0.1,0.06,dednn,dednp,dedpp);
+    n2.n=0.1+h;
+    p2.n=0.06;
+    sk.calc_e(n2,p2,th2);
+    double mun1=n2.mu, mup1=p2.mu;
+    n2.n=0.1-h;
+    sk.calc_e(n2,p2,th2);
+    t.test_rel(dednn,(mun1-n2.mu)/2.0/h,1.0e-6,"dednn ad");
+    t.test_rel(dednp,(mup1-p2.mu)/2.0/h,1.0e-6,"dednp ad");
+    n2.n=0.1;
+    p2.n=0.06+h;
+    sk.calc_e(n2,p2,th2);
+    mup1=p2.mu;
+    p2.n=0.06-h;
+    sk.calc_e(n2,p2,th2);
+    t.test_rel(dedpp,(mup1-p2.mu)/2.0/h,1.0e-6,"dedpp ad");
+
+    // The susceptibilities are the inverse matrix
+    n2.n=0.1;
+    p2.n=0.06;
+    sk.calc_e(n2,p2,th2);
+    double dPdnn, dPdnp, dPdpp;
+    double mun2=n2.mu, mup2=p2.mu;
+    // The neutron and proton should be left unchanged
+    n2.mu=0.0;
+    sk.f_number_suscept(mun2,mup2,dPdnn,dPdnp,dPdpp);
+    t.test_abs(n2.mu,0.0,1.0e-15,"suscept mu restored");
+    t.test_rel(n2.n,0.1,1.0e-15,"suscept n restored");
+    t.test_rel(dPdnn*dednn+dPdnp*dednp,1.0,1.0e-6,"suscept 1");
+    t.test_abs(dPdnn*dednp+dPdnp*dedpp,0.0,1.0e-6,"suscept 2");
+    t.test_rel(dPdnp*dednp+dPdpp*dedpp,1.0,1.0e-6,"suscept 3");
+    sk.set_n_and_p(sk.def_neutron,sk.def_proton);
+  }
+  cout << endl;
   //exit(-1);
 
   cout << "See if the symmetry energy works at all densities:" << endl;
@@ -549,6 +608,67 @@ int main(void) {
   t.test_rel(tnfd.dmudn_mixed,(dmupdnn2-dmupdnn1)/eps,
 	     1.0e-4,"second deriv, dmupdnn");
 
+  {
+    // Compare the batch interface with sk.FUNC() at low densities,
+    // including points where one or both densities vanish
+    cout << "Test batch interface: " << endl;
+    const size_t nt=40;
+    std::vector<double> bnn(nt), bnp(nt), bT(nt), bed(nt), bpr(nt);
+    std::vector<double> ben(nt), bmun(nt), bmup(nt);
+    for(size_t i=0;i<nt;i++) {
+      bnn[i]=0.01*((double)(i%8));
+      bnp[i]=0.005*((double)(i%5));
+      bT[i]=((double)(i%4+1))*2.5/hc_mev_fm;
+    }
+    bnn[3]=1.0e-8;
+    // The batch functions take the masses and inc_rest_mass from
+    // the most recently specified neutron and proton, so use
+    // different masses to make sure they are not interchanged
+    fermion bn(939.565/hc_mev_fm,2.0), bp(938.272/hc_mev_fm,2.0);
+    bn.non_interacting=false;
+    bp.non_interacting=false;
+    sk.set_n_and_p(bn,bp);
+    sk.calc_temp_e_batch(nt,&bnn[0],&bnp[0],&bT[0],&bed[0],&bpr[0],
+                         &ben[0],&bmun[0],&bmup[0]);
+    bool match=true;
+    thermo bth;
+    for(size_t i=0;i<nt;i++) {
+      if (bnn[i]+bnp[i]==0.0) continue;
+      bn.n=bnn[i];
+      bp.n=bnp[i];
+      sk.calc_temp_e(bn,bp,bT[i],bth);
+      if (!std::isfinite(bed[i]) || !std::isfinite(bpr[i]) ||
+          fabs(bth.ed-bed[i])>1.0e-10*fabs(bth.ed) ||
+          fabs(bth.pr-bpr[i])>1.0e-9*(fabs(bth.pr)+1.0e-8) ||
+          fabs(bth.en-ben[i])>1.0e-9*(fabs(bth.en)+1.0e-8) ||
+          (bn.n>0.0 && fabs(bn.mu-bmun[i])>1.0e-10*fabs(bn.mu)) ||
+          (bp.n>0.0 && fabs(bp.mu-bmup[i])>1.0e-10*fabs(bp.mu))) {
+        cout << i << " " << bnn[i] << " " << bnp[i] << " " << bT[i] << " "
+             << bth.ed << " " << bed[i] << " " << bth.pr << " " << bpr[i]
+             << " " << bn.mu << " " << bmun[i] << endl;
+        match=false;
+      }
+    }
+    t.test_gen(match,"calc_temp_e_batch()");
+    
+    sk.calc_e_batch(nt,&bnn[0],&bnp[0],&bed[0],&bpr[0],&bmun[0],&bmup[0]);
+    match=true;
+    for(size_t i=0;i<nt;i++) {
+      if (bnn[i]+bnp[i]==0.0) continue;
+      bn.n=bnn[i];
+      bp.n=bnp[i];
+      sk.calc_e(bn,bp,bth);
+      if (!std::isfinite(bed[i]) || !std::isfinite(bpr[i]) ||
+          fabs(bth.ed-bed[i])>1.0e-12*(fabs(bth.ed)+1.0e-8) ||
+          fabs(bth.pr-bpr[i])>1.0e-12*(fabs(bth.pr)+1.0e-8) ||
+          (bn.n>0.0 && fabs(bn.mu-bmun[i])>1.0e-12*fabs(bn.mu)) ||
+          (bp.n>0.0 && fabs(bp.mu-bmup[i])>1.0e-12*fabs(bp.mu))) {
+        match=false;
+      }
+    }
+    t.test_gen(match,"calc_e_batch()");
+  }
+
   t.report();
 
   return 0;
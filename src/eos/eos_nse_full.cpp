@@ -20,6 +20,8 @@
 
   -------------------------------------------------------------------
 */
+#include <algorithm>
+
 #include <o2scl/eos_nse_full.h>
 #include <o2scl/hdf_nucmass_io.h>
 #include <o2scl/hdf_eos_io.h>
@@ -1110,101 +1112,120 @@ int eos_nse_full::calc_density_fixnp(dense_matter &dm, bool from_densities) {
   // -----------------------------------------------------------
   // Properties of nuclear distribution
 
-  // Vectors for derivatives of nuclear binding energy
-  ubvector vec_dEdnneg(dm.dist.size());
-
-  // Stepsize for verbose output
-  size_t i_out=0, out_step=dm.dist.size()/10;
-  if (out_step==0) out_step=1;
+  if (dm.T<0.0) {
+    O2SCL_ERR2("Temperature less than zero in ",
+	       "eos_nse_full::calc_density_fixnp().",exc_einval);
+  }
+  
+  size_t n_nuc=dm.dist.size();
+  if (!massp->is_soa_current(dm.dist,soa)) {
+    massp->set_soa(dm.dist,soa);
+  }
 
-  // Main loop
-  for(size_t i=0;i<dm.dist.size();i++) {
+  // Compute all of the binding energies at once. Those for
+  // the unphysical nuclei are not used below.
+  if (n_nuc>0) {
+    if (inc_prot_coul) {
+      massp->binding_energy_densmat_soa(soa,dm.p.n,dm.n.n,n_neg,dm.T);
+    } else {
+      massp->binding_energy_densmat_soa(soa,0.0,0.0,n_neg,dm.T);
+    }
+  }
 
-    // Create a reference for this nucleus
-    nucleus &nuc=dm.dist[i];
+  // Use NSE to compute the chemical potentials and then compute the
+  // translational contribution assuming classical statistics. The
+  // nuclei are not interacting and do not include their rest mass.
+  double T=dm.T;
+  double ed_nuc=0.0, en_nuc=0.0;
+  
+  for(size_t i=0;i<n_nuc;i++) {
 
     double condition;
     if (inc_prot_coul) {
-      condition=nuc.N*(n_neg-dm.p.n)/nuc.Z/(0.08-dm.n.n);
+      condition=soa.N[i]*(n_neg-dm.p.n)/soa.Z[i]/(0.08-dm.n.n);
     } else {
-      condition=nuc.N*(n_neg)/nuc.Z/(0.08);
+      condition=soa.N[i]*(n_neg)/soa.Z[i]/(0.08);
     }
 
+    // Create a reference for this nucleus
+    nucleus &nuc=dm.dist[i];
+    
     // If this nucleus is unphysical because R_n > R_{WS}, 
     // set it's density to zero and continue
     if (condition>=1.0) {
       
-      nuc.n=0.0;
-      nuc.ed=0.0;
-      nuc.en=0.0;
-      vec_dEdnneg[i]=0.0;
-
+      soa.n[i]=0.0;
+      soa.ed[i]=0.0;
+      soa.en[i]=0.0;
+      soa.dEdnneg[i]=0.0;
+      
     } else {
-    
-      // Compute nuclear binding energy and total mass
-      double dEdnp, dEdnn, dEdnneg, dEdT;
-      // Include protons in the Coulomb energy
-      if (inc_prot_coul) {
-	massp->binding_energy_densmat_derivs
-	  (nuc.Z,nuc.N,dm.p.n,dm.n.n,n_neg,dm.T,nuc.be,dEdnp,dEdnn,
-	   dEdnneg,dEdT);
-      } else {
-	massp->binding_energy_densmat_derivs
-	  (nuc.Z,nuc.N,0.0,0.0,n_neg,dm.T,nuc.be,dEdnp,dEdnn,dEdnneg,dEdT);
+
+      double be=soa.be[i]/hc_mev_fm;
+      double m=soa.Z[i]*dm.p.m+soa.N[i]*dm.n.m+be;
+      double mu=soa.Z[i]*dm.p.mu+soa.N[i]*dm.n.mu-be;
+      double n=0.0, ed=0.0, en=0.0;
+      if (T>0.0 && mu/T>=std::numeric_limits<double>::min_exponent10) {
+	n=exp(mu/T)*soa.g[i]*pow(m*T/o2scl_const::pi/2.0,1.5);
+	ed=1.5*T*n;
+	en=(ed+n*T-n*mu)/T;
       }
-      nuc.be/=hc_mev_fm;
-      nuc.m=nuc.Z*dm.p.m+nuc.N*dm.n.m+nuc.be;
-      vec_dEdnneg[i]=dEdnneg;
+      soa.be[i]=be;
+      soa.m[i]=m;
+      soa.mu[i]=mu;
+      soa.n[i]=n;
+      soa.ed[i]=ed;
+      soa.en[i]=en;
       
-      // Use NSE to compute the chemical potential
-      nuc.mu=nuc.Z*dm.p.mu+nuc.N*dm.n.mu-nuc.be;
-    
-      // Translational energy
-      cla.calc_mu(nuc,dm.T);
-
-      // Update thermo object with information from nucleus
-      dm.th.ed+=nuc.be*nuc.n+nuc.ed;
-      dm.th.en+=nuc.en;
-
+      ed_nuc+=be*n+ed;
+      en_nuc+=en;
+      
+      nuc.be=be;
+      nuc.m=m;
+      nuc.ms=m;
+      nuc.mu=mu;
+      nuc.nu=mu;
+      nuc.pr=n*T;
     }
+
+    nuc.n=soa.n[i];
+    nuc.ed=soa.ed[i];
+    nuc.en=soa.en[i];
   }
 
+  // Update thermo object with information from nuclei
+  dm.th.ed+=ed_nuc;
+  dm.th.en+=en_nuc;
+
   // -----------------------------------------------------------
   // Compute etas
 
   // Ensure the eta vector has the correct size
-  if (dm.eta_nuc.size()!=dm.dist.size()) {
-    dm.eta_nuc.resize(dm.dist.size());
+  if (dm.eta_nuc.size()!=n_nuc) {
+    dm.eta_nuc.resize(n_nuc);
   }
 
   dm.eta_n=dm.n.mu;
   dm.eta_p=dm.p.mu+dm.e.mu;
 
-  for(size_t i=0;i<dm.dist.size();i++) {
+  // The sum over the distribution from the dependence of the binding
+  // energy on the negative charge density is the same for all
+  // nuclei. In eta_p, we don't include dEdnp terms which are zero.
+  double sum_neg=0.0;
+  for(size_t j=0;j<n_nuc;j++) {
+    if (soa.n[j]>0.0) {
+      sum_neg+=soa.n[j]*(1.0-1.5*T/soa.m[j])*soa.dEdnneg[j];
+    }
+  }
+  sum_neg/=hc_mev_fm;
+  dm.eta_p+=sum_neg;
 
-    double dmudm_i=-1.5*dm.T/dm.dist[i].m;
-    double dfdm_i=dm.dist[i].n*dmudm_i;
-    if (dm.dist[i].n>0.0) {
-      dm.eta_nuc[i]=dm.dist[i].be+dm.dist[i].mu+dm.dist[i].Z*dm.e.mu;
+  for(size_t i=0;i<n_nuc;i++) {
+    if (soa.n[i]>0.0) {
+      dm.eta_nuc[i]=soa.be[i]+soa.mu[i]+soa.Z[i]*(dm.e.mu+sum_neg);
     } else {
       dm.eta_nuc[i]=0.0;
     }
-    // In eta_p, we don't include dEdnp terms which are zero
-    dm.eta_p+=(dm.dist[i].n+dfdm_i)*(vec_dEdnneg[i])/hc_mev_fm;
-    
-    for(size_t j=0;j<dm.dist.size();j++) {
-      
-      if (dm.dist[i].n>0.0) {
-	
-	double dmudm=-1.5*dm.T/dm.dist[j].m;
-	double dfdm=dm.dist[j].n*dmudm;
-	
-	dm.eta_nuc[i]+=dm.dist[i].Z*(dm.dist[j].n+dfdm)*
-	  vec_dEdnneg[j]/hc_mev_fm;
-
-      }
-
-    }
   }
       
   // -----------------------------------------------------------
@@ -1212,8 +1233,8 @@ int eos_nse_full::calc_density_fixnp(dense_matter &dm, bool from_densities) {
 
   dm.th.pr=-dm.th.ed+dm.n.n*dm.eta_n+dm.p.n*dm.eta_p+
     dm.T*dm.th.en;
-  for(size_t i=0;i<dm.dist.size();i++) {
-    dm.th.pr+=dm.dist[i].n*dm.eta_nuc[i];
+  for(size_t i=0;i<n_nuc;i++) {
+    dm.th.pr+=soa.n[i]*dm.eta_nuc[i];
   }
 
   // -----------------------------------------------------------
@@ -1368,118 +1389,142 @@ int eos_nse_full::calc_density_noneq(dense_matter &dm) {
   // -----------------------------------------------------------
   // Properties of nuclear distribution
 
-  // Vectors for derivatives of nuclear binding energy
-  ubvector vec_dEdnneg(dm.dist.size()), vec_dEdnp(dm.dist.size());
-
-  // Step size for verbose output
-  size_t i_out=0, out_step=dm.dist.size()/10;
-  if (out_step==0) out_step=1;
+  size_t n_nuc=dm.dist.size();
+  if (!massp->is_soa_current(dm.dist,soa)) {
+    massp->set_soa(dm.dist,soa);
+  }
+  
+  bool nuclei_present=false;
+  for(size_t i=0;i<n_nuc;i++) {
+    soa.n[i]=dm.dist[i].n;
+    if (soa.n[i]>0.0) nuclei_present=true;
+  }
 
-  // Main loop
-  for(size_t i=0;i<dm.dist.size();i++) {
-    
-    if (dm.dist[i].n>0.0) {
+  if (nuclei_present) {
 
-      // Check that the proton density isn't too large in
-      // the presence of nuclei
-      if (dm.p.n>0.08) {
-	if (verbose>0) {
-	  cout << "External proton density (" << dm.p.n 
-	       << ") too large." << endl;
-	}
-	return invalid_config;
-      }
-	
-      // Check that the electron density isn't too large
-      // in the presence of nuclei
-      double fac=(0.08-dm.p.n)/(n_neg-dm.p.n);
-      if (1.0>fac) {
-	if (verbose>0) {
-	  cout << "Proton radius negative or larger than cell size." << endl;
-	  cout << "fac: " << fac << endl;
-	}
-	return invalid_config;
+    // Check that the proton density isn't too large in
+    // the presence of nuclei
+    if (dm.p.n>0.08) {
+      if (verbose>0) {
+	cout << "External proton density (" << dm.p.n 
+	     << ") too large." << endl;
       }
-
-      // Create a reference for this nucleus
-      nucleus &nuc=dm.dist[i];
-      
-      // Compute nuclear binding energy and total mass
-      double dEdnp, dEdnn, dEdnneg, dEdT;
-      if (inc_prot_coul) {
-	// Include protons in the Coulomb energy
-	massp->binding_energy_densmat_derivs
-	  (nuc.Z,nuc.N,dm.p.n,dm.n.n,n_neg,dm.T,nuc.be,
-	   dEdnp,dEdnn,dEdnneg,dEdT);
-	nuc.be/=hc_mev_fm;
-	nuc.m=nuc.Z*dm.p.m+nuc.N*dm.n.m+nuc.be;
-	vec_dEdnp[i]=dEdnp;
-	vec_dEdnneg[i]=dEdnneg;
-      } else {
-	// Don't include protons in the Coulomb energy
-	massp->binding_energy_densmat_derivs
-	  (nuc.Z,nuc.N,0.0,0.0,n_neg,dm.T,nuc.be,
-	   dEdnp,dEdnn,dEdnneg,dEdT);
-	nuc.be/=hc_mev_fm;
-	nuc.m=nuc.Z*dm.p.m+nuc.N*dm.n.m+nuc.be;
-	vec_dEdnp[i]=0.0;
-	vec_dEdnneg[i]=dEdnneg;
+      return invalid_config;
+    }
+    
+    // Check that the electron density isn't too large
+    // in the presence of nuclei
+    double fac=(0.08-dm.p.n)/(n_neg-dm.p.n);
+    if (1.0>fac) {
+      if (verbose>0) {
+	cout << "Proton radius negative or larger than cell size." << endl;
+	cout << "fac: " << fac << endl;
       }
+      return invalid_config;
+    }
 
-      // Translational energy
-      cla.calc_density(nuc,dm.T);
+    if (dm.T<0.0) {
+      O2SCL_ERR2("Temperature less than zero in ",
+		 "eos_nse_full::calc_density_noneq().",exc_einval);
+    }
+    
+    // Compute all of the binding energies at once
+    if (inc_prot_coul) {
+      // Include protons in the Coulomb energy
+      massp->binding_energy_densmat_soa(soa,dm.p.n,dm.n.n,n_neg,dm.T);
+    } else {
+      // Don't include protons in the Coulomb energy
+      massp->binding_energy_densmat_soa(soa,0.0,0.0,n_neg,dm.T);
+    }
+  }
 
-      // Update thermo object with information from nucleus
-      dm.th.ed+=nuc.be*nuc.n+nuc.ed;
-      dm.th.en+=nuc.en;
+  // Compute the translational contribution assuming classical
+  // statistics. The nuclei are not interacting and do not include
+  // their rest mass.
+  double T=dm.T;
+  double ed_nuc=0.0, en_nuc=0.0;
+  
+  for(size_t i=0;i<n_nuc;i++) {
 
-    } else if (dm.dist[i].n<0.0) {
-      if (verbose>0) {
-	cout << "Density of nucleus: " << i << " negative." << endl;
+    // Create a reference for this nucleus
+    nucleus &nuc=dm.dist[i];
+    
+    double n=soa.n[i];
+    if (n>0.0) {
+
+      double be=soa.be[i]/hc_mev_fm;
+      double m=soa.Z[i]*dm.p.m+soa.N[i]*dm.n.m+be;
+      if (inc_prot_coul==false) soa.dEdnp[i]=0.0;
+
+      double mu=0.0, ed=0.0, en=0.0;
+      if (T>0.0) {
+	mu=T*log(n/soa.g[i]*pow(2.0*o2scl_const::pi/m/T,1.5));
+	ed=1.5*T*n;
+	en=(ed+n*T-n*mu)/T;
       }
-      return invalid_config;
+      soa.be[i]=be;
+      soa.m[i]=m;
+      soa.mu[i]=mu;
+      soa.ed[i]=ed;
+      soa.en[i]=en;
+      
+      ed_nuc+=be*n+ed;
+      en_nuc+=en;
+
+      nuc.be=be;
+      nuc.m=m;
+      nuc.ms=m;
+      nuc.mu=mu;
+      nuc.nu=mu;
+      nuc.ed=ed;
+      nuc.pr=n*T;
+      nuc.en=en;
+      
     } else {
-      dm.dist[i].ed=0.0;
-      dm.dist[i].pr=0.0;
-      dm.dist[i].en=0.0;
-      dm.dist[i].mu=0.0;
+      
+      nuc.ed=0.0;
+      nuc.pr=0.0;
+      nuc.en=0.0;
+      nuc.mu=0.0;
+      
     }
 
   }
 
+  // Update thermo object with information from nuclei
+  dm.th.ed+=ed_nuc;
+  dm.th.en+=en_nuc;
+
   // -----------------------------------------------------------
   // Compute etas
 
   // Ensure the eta vector has the correct size
-  if (dm.eta_nuc.size()!=dm.dist.size()) {
-    dm.eta_nuc.resize(dm.dist.size());
+  if (dm.eta_nuc.size()!=n_nuc) {
+    dm.eta_nuc.resize(n_nuc);
   }
 
   dm.eta_n=dm.n.mu;
   dm.eta_p=dm.p.mu+dm.e.mu;
 
-  for(size_t i=0;i<dm.dist.size();i++) {
-
-    if (dm.dist[i].n>0.0) {
-      
-      double dmudm_i=-1.5*dm.T/dm.dist[i].m;
-      double dfdm_i=dm.dist[i].n*dmudm_i;
-      dm.eta_nuc[i]=dm.dist[i].be+dm.dist[i].mu+dm.dist[i].Z*dm.e.mu;
-      dm.eta_p+=(dm.dist[i].n+dfdm_i)*(vec_dEdnp[i]+vec_dEdnneg[i])/hc_mev_fm;
-      
-      for(size_t j=0;j<dm.dist.size();j++) {
-	
-	double dmudm=-1.5*dm.T/dm.dist[j].m;
-	double dfdm=dm.dist[j].n*dmudm;
-	
-	dm.eta_nuc[i]+=dm.dist[i].Z*(dm.dist[j].n+dfdm)*
-	  vec_dEdnneg[j]/hc_mev_fm;
-      }
+  // The sum over the distribution from the dependence of the binding
+  // energy on the negative charge density is the same for all nuclei
+  double sum_neg=0.0, sum_p=0.0;
+  for(size_t j=0;j<n_nuc;j++) {
+    if (soa.n[j]>0.0) {
+      double nfac=soa.n[j]*(1.0-1.5*T/soa.m[j]);
+      sum_neg+=nfac*soa.dEdnneg[j];
+      sum_p+=nfac*(soa.dEdnp[j]+soa.dEdnneg[j]);
+    }
+  }
+  sum_neg/=hc_mev_fm;
+  dm.eta_p+=sum_p/hc_mev_fm;
 
+  for(size_t i=0;i<n_nuc;i++) {
+    if (soa.n[i]>0.0) {
+      dm.eta_nuc[i]=soa.be[i]+soa.mu[i]+soa.Z[i]*(dm.e.mu+sum_neg);
     } else {
       dm.eta_nuc[i]=0.0;
     }
-    
   }
 
   // -----------------------------------------------------------
@@ -1487,8 +1532,8 @@ int eos_nse_full::calc_density_noneq(dense_matter &dm) {
 
   dm.th.pr=-dm.th.ed+dm.n.n*dm.eta_n+dm.p.n*dm.eta_p+
     dm.T*dm.th.en;
-  for(size_t i=0;i<dm.dist.size();i++) {
-    dm.th.pr+=dm.dist[i].n*dm.eta_nuc[i];
+  for(size_t i=0;i<n_nuc;i++) {
+    dm.th.pr+=soa.n[i]*dm.eta_nuc[i];
   }
 
   // -----------------------------------------------------------
@@ -1507,12 +1552,9 @@ int eos_nse_full::density_match(dense_matter &dm) {
   // Fix negative densities
   if (dm.n.n<0.0) dm.n.n=0.0;
   if (dm.p.n<0.0) dm.p.n=0.0;
-  for(vector<nucleus>::iterator it=dm.dist.begin();it!=dm.dist.end();it++) {
-    if (it->n<0.0) {
-      dm.dist.erase(it);
-      it=dm.dist.begin();
-    }
-  }
+  dm.dist.erase(std::remove_if(dm.dist.begin(),dm.dist.end(),
+				[](const nucleus &nuc) { return nuc.n<0.0; }),
+		dm.dist.end());
 
   // Initial evaluation
   int ret=calc_density_noneq(dm);
@@ -69,6 +69,20 @@ namespace o2scl {
       by some functions if this is not the case (determined 
       by the values in <tt>o2scl::part::inc_rest_mass</tt>). 
 
+      Internally, the distribution is copied into a \ref
+      o2scl::nucdist_soa object so that the loops over nuclei in \ref
+      calc_density_fixnp() and \ref calc_density_noneq() operate on
+      contiguous arrays, and the sums in the nuclear chemical
+      potentials are computed once rather than once for each
+      nucleus. The results are still stored in the \ref
+      o2scl::dense_matter object. To compute different points in a
+      table in parallel, each thread should use its own \ref
+      eos_nse_full and \ref o2scl::dense_matter objects. The base
+      mass formula is only accessed when the structure-of-arrays copy
+      is created, i.e. when the distribution changes, and some mass
+      formulas (e.g. \ref o2scl::nucmass_ame) are not safe to call
+      from several threads at once.
+
       \verbatim embed:rst
       .. todo:: 
 
@@ -127,6 +141,14 @@ namespace o2scl {
     */
     std::vector<o2scl::nucleus> *ad;
 
+    /** \brief Structure-of-arrays copy of the distribution
+
+        This is refilled automatically by \ref calc_density_fixnp()
+        and \ref calc_density_noneq() whenever the distribution
+        or the mass formula changes.
+    */
+    o2scl::nucdist_soa soa;
+
     /** \brief Solve for charge neutrality assuming the specified
         electron chemical potential and proton number density. 
 
@@ -83,6 +83,25 @@ int main(void) {
   nuc.n=0.01/50.0;
   dm.dist.push_back(nuc);
 
+  // Compare the structure-of-arrays binding energies with
+  // binding_energy_densmat_derivs()
+
+  nucdist_soa soa;
+  nd.set_soa(dm.dist,soa);
+  t.test_gen(nd.is_soa_current(dm.dist,soa),"soa current");
+  nd.binding_energy_densmat_soa(soa,0.005,0.02,0.01,0.01);
+  for(size_t i=0;i<3;i++) {
+    double E, dEdnp, dEdnn, dEdnneg, dEdT;
+    nd.binding_energy_densmat_derivs(dm.dist[i].Z,dm.dist[i].N,0.005,0.02,
+				     0.01,0.01,E,dEdnp,dEdnn,dEdnneg,dEdT);
+    t.test_rel(soa.be[i],E,1.0e-12,"soa be");
+    t.test_rel(soa.dEdnp[i],dEdnp,1.0e-12,"soa dEdnp");
+    t.test_rel(soa.dEdnneg[i],dEdnneg,1.0e-12,"soa dEdnneg");
+  }
+  dm.dist[1].g=4.0;
+  t.test_gen(!nd.is_soa_current(dm.dist,soa),"soa not current");
+  dm.dist[1].g=2.0;
+
   // Set the temperature
   dm.T=1.0/hc_mev_fm;
 
@@ -59,6 +59,7 @@ eos_quark_cfl::eos_quark_cfl() {
   inte_epsabs=1.0e-4;
   inte_epsrel=1.0e-4;
   inte_npoints=0;
+  inte_fixed_nsub=0;
 }
 
 eos_quark_cfl::~eos_quark_cfl() {
@@ -109,40 +110,74 @@ int eos_quark_cfl::test_integration(test_mgr &t) {
   return 0;
 }
 
+int eos_quark_cfl::integrands_batch(size_t np, const double *p,
+				    size_t nr, double *res) {
+  for(size_t i=0;i<np;i++) {
+    integrands(p[i],res+i*nr);
+  }
+  return 0;
+}
+
+int eos_quark_cfl::integ_fixed(double a, double b, const size_t nr,
+			       ubvector &res, double &err2) {
+
+  // The 16-point Gauss-Legendre abscissas and weights are
+  // stored in the last 8 entries of the CERNLIB coefficients
+  inte_gauss_coeffs_double gc;
+  
+  size_t nsub=inte_fixed_nsub;
+  const double h=(b-a)/((double)nsub);
+  const size_t np=16*nsub;
+
+  std::vector<double> px(np), fx(np*nr);
+  for(size_t is=0;is<nsub;is++) {
+    const double center=a+h*(is+0.5);
+    for(size_t k=0;k<8;k++) {
+      px[is*16+2*k]=center+h/2.0*gc.x[k+4];
+      px[is*16+2*k+1]=center-h/2.0*gc.x[k+4];
+    }
+  }
+  
+  integrands_batch(np,&px[0],nr,&fx[0]);
+  
+  for(size_t j=0;j<nr;j++) {
+    res[j]=0.0;
+    for(size_t is=0;is<nsub;is++) {
+      double sum=0.0;
+      for(size_t k=0;k<8;k++) {
+	sum+=gc.w[k+4]*(fx[(is*16+2*k)*nr+j]+fx[(is*16+2*k+1)*nr+j]);
+      }
+      res[j]+=sum*h/2.0;
+    }
+  }
+  err2=0.0;
+  inte_npoints=np;
+  
+  return success;
+}
+
 int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
 			    ubvector &res, double &err2) {
 
-  //double fval1[nr], fval2[nr], fval[nr];
+  if (inte_fixed_nsub>0) {
+    return integ_fixed(a,b,nr,res,err2);
+  }
+  
   double fv1[5], fv2[5], fv3[5], fv4[5];
-  //double savfun[21][nr];  
-  //double res10[nr], res21[nr], res43[nr], res87[nr];    
-  //double result_kronrod[nr];
   double err;
   double resabs; 
   double resasc; 
 
-  double *fval1=new double[nr];
-  double *fval2=new double[nr];
-  double *fval=new double[nr];
-  double **savfun=new double *[21];
-  for(size_t i=0;i<21;i++) savfun[i]=new double[nr];
-  double *res10=new double[nr];
-  double *res21=new double[nr];
-  double *res43=new double[nr];
-  double *res87=new double[nr];
-  double *result_kronrod=new double[nr];
-  double *f_center=new double[nr];
+  std::vector<double> fval(nr), res10(nr), res21(nr), res43(nr);
+  std::vector<double> res87(nr), result_kronrod(nr);
+  std::vector<std::vector<double> > savfun(21);
+  for(size_t i=0;i<21;i++) savfun[i].resize(nr);
 
   const double half_length= 0.5*(b-a);
   const double abs_half_length=fabs (half_length);
   const double center=0.5*(b+a);
 
-  //double f_center[nr];
-  integrands(center,f_center);
-    
-  int k;
-  
-      double dbl_eps=std::numeric_limits<double>::epsilon();
+  double dbl_eps=std::numeric_limits<double>::epsilon();
 
   if (inte_epsabs<=0 && (inte_epsrel<50*dbl_eps || 
 			 inte_epsrel<0.5e-28)) {
@@ -152,6 +187,25 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
 		   " in eos_quark_cfl::integ_err().",exc_ebadtol);
   };
   
+  int k;
+
+  // All of the abscissas for each rule are computed in one batch.
+  // The abscissas center+x and center-x are stored in adjacent
+  // locations.
+  std::vector<double> px(44), fx(44*nr);
+
+  // The center and the remaining abscissas of the 21-point rule
+  px[0]=center;
+  for (k=0;k<5;k++) {
+    px[1+2*k]=center+half_length*o2scl_inte_qng_coeffs::x1[k];
+    px[2+2*k]=center-half_length*o2scl_inte_qng_coeffs::x1[k];
+    px[11+2*k]=center+half_length*o2scl_inte_qng_coeffs::x2[k];
+    px[12+2*k]=center-half_length*o2scl_inte_qng_coeffs::x2[k];
+  }
+  integrands_batch(21,&px[0],nr,&fx[0]);
+
+  std::vector<double> f_center(fx.begin(),fx.begin()+nr);
+  
   for (size_t j=0;j<nr;j++) {
     res10[j]=0;
     res21[j]=o2scl_inte_qng_coeffs::w21b[5]*f_center[j];
@@ -159,9 +213,8 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
   resabs=o2scl_inte_qng_coeffs::w21b[5]*fabs(f_center[0]);
     
   for (k=0;k<5;k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x1[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fx[(1+2*k)*nr];
+    const double *fval2=&fx[(2+2*k)*nr];
     for(size_t j=0;j<nr;j++) {
       fval[j]=fval1[j]+fval2[j];
       res10[j]+=o2scl_inte_qng_coeffs::w10[k]*fval[j];
@@ -174,9 +227,8 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
   }
     
   for (k=0;k<5;k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x2[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fx[(11+2*k)*nr];
+    const double *fval2=&fx[(12+2*k)*nr];
     for(size_t j=0;j<nr;j++) {
       fval[j]=fval1[j]+fval2[j];
       res21[j]+=o2scl_inte_qng_coeffs::w21b[k]*fval[j];
@@ -205,20 +257,6 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
     for(size_t j=0;j<nr;j++) res[j]=result_kronrod[j];
     err2=err;
     inte_npoints=21;
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
-    
     return success;
   }
       
@@ -228,11 +266,17 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
       res43[j]+=savfun[k][j]*o2scl_inte_qng_coeffs::w43a[k];
     }
   }
-      
+
+  // The additional abscissas for the 43-point rule
+  for (k=0;k<11;k++) {
+    px[2*k]=center+half_length*o2scl_inte_qng_coeffs::x3[k];
+    px[2*k+1]=center-half_length*o2scl_inte_qng_coeffs::x3[k];
+  }
+  integrands_batch(22,&px[0],nr,&fx[0]);
+  
   for (k=0; k < 11; k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x3[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fx[(2*k)*nr];
+    const double *fval2=&fx[(2*k+1)*nr];
     for(size_t j=0;j<nr;j++) {
       fval[j]=fval1[j]+fval2[j];
       res43[j]+=fval[j]*o2scl_inte_qng_coeffs::w43b[k];
@@ -249,20 +293,6 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
     for(size_t j=0;j<nr;j++) res[j]=result_kronrod[j];
     err2=err;
     inte_npoints=43;
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
-    
     return success;
   }
       
@@ -272,11 +302,17 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
       res87[j]+=savfun[k][j]*o2scl_inte_qng_coeffs::w87a[k];
     }
   }
+
+  // The additional abscissas for the 87-point rule
+  for (k=0;k<22;k++) {
+    px[2*k]=center+half_length*o2scl_inte_qng_coeffs::x4[k];
+    px[2*k+1]=center-half_length*o2scl_inte_qng_coeffs::x4[k];
+  }
+  integrands_batch(44,&px[0],nr,&fx[0]);
   
   for (k=0;k<22;k++) {
-    const double abscissa=half_length*o2scl_inte_qng_coeffs::x4[k];
-    integrands(center+abscissa,fval1);
-    integrands(center-abscissa,fval2);
+    const double *fval1=&fx[(2*k)*nr];
+    const double *fval2=&fx[(2*k+1)*nr];
     for(size_t j=0;j<nr;j++) {
       res87[j]+=o2scl_inte_qng_coeffs::w87b[k]*(fval1[j]+fval2[j]);
     }
@@ -290,36 +326,9 @@ int eos_quark_cfl::integ_err(double a, double b, const size_t nr,
 
   if (err < inte_epsabs || err < inte_epsrel*fabs (result_kronrod[0])) {
     inte_npoints=87;
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
-    
     return success;
   }
       
-  { 
-    for(size_t i=0;i<21;i++) delete[] savfun[i];
-    delete[] fval1;
-    delete[] fval2;
-    delete[] fval;
-    delete[] savfun;
-    delete[] res10;
-    delete[] res21;
-    delete[] res43;
-    delete[] res87;
-    delete[] result_kronrod;
-    delete[] f_center;
-  }
   inte_npoints=88;
   O2SCL_ERR("failed to reach tolerance with highest-order rule",
 	    exc_etol);
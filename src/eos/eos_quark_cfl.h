@@ -45,6 +45,7 @@
 #include <o2scl/err_hnd.h>
 #include <o2scl/mm_funct.h>
 #include <o2scl/inte_qng_gsl.h>
+#include <o2scl/inte_gauss_cern.h>
 #include <o2scl/poly.h>
 #include <o2scl/test_mgr.h>
 #include <o2scl/columnify.h>
@@ -389,6 +390,21 @@ namespace o2scl {
     */
     size_t inte_npoints;
 
+    /** \brief If greater than zero, use a fixed 16-point
+        Gauss-Legendre rule on this number of equal subintervals
+        for the momentum integrals (default 0)
+
+        If this is zero, then the momentum integrals use the 21-,
+        43- and 87-point rules from \ref o2scl::inte_qng_gsl until
+        the tolerances \ref inte_epsabs or \ref inte_epsrel are
+        reached. If this is greater than zero, then the integrand is
+        always evaluated at the same \f$ 16 n \f$ momenta, no error
+        estimate is computed, and \ref inte_npoints is set to
+        \f$ 16 n \f$. This is useful for mapping out a phase diagram
+        where the same accuracy is sufficient at every point.
+    */
+    size_t inte_fixed_nsub;
+
     /// Return string denoting type ("eos_quark_cfl")
     virtual const char *type() { return "eos_quark_cfl"; };
     
@@ -413,6 +429,16 @@ namespace o2scl {
         - res[12] is \f$ d \Omega / d \mu_8 \f$
     */
     virtual int integrands(double p, double res[]);
+
+    /** \brief Compute the integrands for the \c np momenta in \c p
+
+        The \c nr integrands for momentum <tt>p[i]</tt> are stored
+        in <tt>res[i*nr]</tt> through <tt>res[i*nr+nr-1]</tt>. This
+        version calls \ref integrands() for each momentum in turn.
+        Children may override this to compute the points in parallel.
+    */
+    virtual int integrands_batch(size_t np, const double *p,
+                                 size_t nr, double *res);
     
     /// Compute ungapped eigenvalues and the appropriate derivatives
     int normal_eigenvalues(double m, double lmom, double mu, 
@@ -502,6 +528,13 @@ namespace o2scl {
     */
     int integ_err(double a, double b, const size_t nr,
                   ubvector &res, double &err2);
+
+    /** \brief Integrate several functions with a fixed composite
+        Gauss-Legendre rule (used by \ref integ_err() when
+        \ref inte_fixed_nsub is greater than zero)
+    */
+    int integ_fixed(double a, double b, const size_t nr,
+                    ubvector &res, double &err2);
     //@}
 
   private:
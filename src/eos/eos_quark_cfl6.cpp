@@ -26,6 +26,10 @@
 
 #include <o2scl/eos_quark_cfl6.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -45,6 +49,10 @@ eos_quark_cfl6::eos_quark_cfl6() {
   w6=gsl_eigen_hermv_alloc(mat_size);
   
   kdlimit=1.0e-6;
+  n_threads=1;
+
+  eig_ws.resize(1);
+  eig_ws[0]=std::make_shared<eig_workspace>();
 }
 
 eos_quark_cfl6::~eos_quark_cfl6() {
@@ -55,6 +63,26 @@ eos_quark_cfl6::~eos_quark_cfl6() {
 
 }
 
+eos_quark_cfl6::eig_workspace::eig_workspace() {
+  iprop6=gsl_matrix_complex_alloc(mat_size,mat_size);
+  eivec6=gsl_matrix_complex_alloc(mat_size,mat_size);
+  eval6=gsl_vector_alloc(mat_size);
+  w6=gsl_eigen_hermv_alloc(mat_size);
+  dipdgapu.resize(mat_size,mat_size);
+  dipdgapd.resize(mat_size,mat_size);
+  dipdgaps.resize(mat_size,mat_size);
+  dipdqqu.resize(mat_size,mat_size);
+  dipdqqd.resize(mat_size,mat_size);
+  dipdqqs.resize(mat_size,mat_size);
+}
+
+eos_quark_cfl6::eig_workspace::~eig_workspace() {
+  gsl_matrix_complex_free(iprop6);
+  gsl_matrix_complex_free(eivec6);
+  gsl_vector_free(eval6);
+  gsl_eigen_hermv_free(w6);
+}
+
 int eos_quark_cfl6::set_masses() {
   if (fixed_mass) {
     up->ms=up->m+KD/4.0/GD/GD*up->del*up->del;
@@ -169,14 +197,85 @@ int eos_quark_cfl6::integrands(double p, double res[]) {
     return 0;
   }
 
+  return integrands_ws(*eig_ws[0],p,res);
+}
+
+int eos_quark_cfl6::integrands_batch(size_t np, const double *p,
+				     size_t nr, double *res) {
+
+  // The parent version of integrands() is not thread-safe
+  if (fabs(KD)<kdlimit || integ_test) {
+    return eos_quark_cfl::integrands_batch(np,p,nr,res);
+  }
+
+#ifdef O2SCL_OPENMP
+  size_t nthr=n_threads;
+  if (nthr<1) nthr=1;
+  if (nthr>np) nthr=np;
+  if (nthr>1) {
+    
+    // Make sure there is one workspace for each thread
+    if (eig_ws.size()<nthr) {
+      size_t n_old=eig_ws.size();
+      eig_ws.resize(nthr);
+      for(size_t it=n_old;it<nthr;it++) {
+	eig_ws[it]=std::make_shared<eig_workspace>();
+      }
+    }
+    
+    // Exceptions cannot leave the parallel region, so the first
+    // error is stored and the error handler is called after the loop
+    int err_ret=0;
+    string err_reason;
+    
+    // Use a static schedule so that each thread gets a contiguous
+    // block of momenta
+#pragma omp parallel for default(shared) schedule(static) num_threads(nthr)
+    for(size_t i=0;i<np;i++) {
+      size_t it=omp_get_thread_num();
+      try {
+	integrands_ws(*eig_ws[it],p[i],res+i*nr);
+      } catch (const std::exception &e) {
+#pragma omp critical (o2scl_eos_quark_cfl6_err)
+	{
+	  if (err_ret==0) {
+	    err_ret=err_hnd->get_errno();
+	    if (err_ret==0) err_ret=exc_efailed;
+	    err_reason=e.what();
+	  }
+	}
+      }
+    }
+
+    if (err_ret!=0) {
+      string str=((string)"Integrand failed in ")+
+	"eos_quark_cfl6::integrands_batch(): "+err_reason;
+      O2SCL_ERR(str.c_str(),err_ret);
+      return err_ret;
+    }
+    
+    return 0;
+  }
+#endif
+
+  for(size_t i=0;i<np;i++) {
+    integrands_ws(*eig_ws[0],p[i],res+i*nr);
+  }
+  
+  return 0;
+}
+
+int eos_quark_cfl6::integrands_ws(eig_workspace &ws, double p,
+				  double res[]) {
+
   int k;
   double egv[36];
   double dedmuu[36], dedmud[36], dedmus[36];
   double dedqqu[36], dedqqd[36], dedqqs[36], deds[36];
   double dedd[36], dedu[36], dedmu3[36], dedmu8[36];
   
-  eigenvalues6(p,smu3,smu8,egv,dedmuu,dedmud,dedmus,dedqqu,dedqqd,dedqqs,
-	       dedu,dedd,deds,dedmu3,dedmu8);
+  eigenvalues6_ws(ws,p,smu3,smu8,egv,dedmuu,dedmud,dedmus,dedqqu,dedqqd,
+		  dedqqs,dedu,dedd,deds,dedmu3,dedmu8);
   
   res[0]=0.0;
   res[1]=0.0;
@@ -710,6 +809,30 @@ int eos_quark_cfl6::eigenvalues6(double lmom, double mu3,
 			    double dedu[36], double dedd[36],
 			    double deds[36], double dedmu3[36],
 			    double dedmu8[36]) {
+  return eigenvalues6_ws(*eig_ws[0],lmom,mu3,mu8,egv,dedmuu,dedmud,dedmus,
+			 dedqqu,dedqqd,dedqqs,dedu,dedd,deds,dedmu3,dedmu8);
+}
+
+int eos_quark_cfl6::eigenvalues6_ws(eig_workspace &ws, double lmom,
+				    double mu3, double mu8, double egv[36],
+				    double dedmuu[36], double dedmud[36],
+				    double dedmus[36], double dedqqu[36], 
+				    double dedqqd[36], double dedqqs[36],
+				    double dedu[36], double dedd[36],
+				    double deds[36], double dedmu3[36],
+				    double dedmu8[36]) {
+  
+  // Use the storage in the workspace rather than the class members
+  gsl_matrix_complex *iprop6=ws.iprop6;
+  gsl_matrix_complex *eivec6=ws.eivec6;
+  gsl_vector *eval6=ws.eval6;
+  gsl_eigen_hermv_workspace *w6=ws.w6;
+  ubmatrix_complex &dipdgapu=ws.dipdgapu;
+  ubmatrix_complex &dipdgapd=ws.dipdgapd;
+  ubmatrix_complex &dipdgaps=ws.dipdgaps;
+  ubmatrix_complex &dipdqqu=ws.dipdqqu;
+  ubmatrix_complex &dipdqqd=ws.dipdqqd;
+  ubmatrix_complex &dipdqqs=ws.dipdqqs;
   
   int k;
   const double mu=up->ms, md=down->ms, ms=strange->ms;
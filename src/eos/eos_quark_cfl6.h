@@ -27,6 +27,8 @@
 #define CFL6_EOS_H
 
 #include <iostream>
+#include <memory>
+#include <vector>
 #include <o2scl/test_mgr.h>
 #include <o2scl/eos_quark_cfl.h>
 
@@ -180,6 +182,18 @@ namespace o2scl {
       If we make the definition \f$ {\tilde \Delta} =
       2 G_{DIQ} \Delta \f$
 
+      The momentum integrands at all of the abscissas of each
+      integration rule are computed together by \ref
+      integrands_batch(). If OpenMP support is enabled and \ref
+      n_threads is larger than one, these are divided into
+      contiguous blocks of momenta, one for each thread, and each
+      thread has its own storage for the inverse propagator and the
+      GSL eigenvalue workspace. The integrals are summed in the same
+      order, so the results do not depend on the number of threads.
+      Setting \ref o2scl::eos_quark_cfl::inte_fixed_nsub uses a
+      fixed Gauss-Legendre grid, so that all of the momenta are
+      computed in one batch.
+
       \hline
       <b>References:</b>
 
@@ -261,6 +275,11 @@ namespace o2scl {
     /// The color superconducting 't Hooft coupling (default 0)
     double KD;
 
+    /** \brief Number of OpenMP threads for the momentum integration
+        (default 1)
+    */
+    size_t n_threads;
+
     /// Return string denoting type ("eos_quark_cfl6")
     virtual const char *type() { return "eos_quark_cfl6"; };
 
@@ -280,11 +299,83 @@ namespace o2scl {
 
     /// Set the quark effective masses from the gaps and the condensates
     int set_masses();
+
+    /** \brief Storage for one computation of the eigenvalues
+    */
+    class eig_workspace {
+
+    public:
+
+      /// Storage for the inverse propagator
+      gsl_matrix_complex *iprop6;
+      /// The eigenvectors
+      gsl_matrix_complex *eivec6;
+      /// Storage for the eigenvalues
+      gsl_vector *eval6;
+      /// GSL workspace for the eigenvalue computation
+      gsl_eigen_hermv_workspace *w6;
+      /// The derivative wrt the ds gap
+      ubmatrix_complex dipdgapu;
+      /// The derivative wrt the us gap
+      ubmatrix_complex dipdgapd;
+      /// The derivative wrt the ud gap
+      ubmatrix_complex dipdgaps;
+      /// The derivative wrt the up quark condensate
+      ubmatrix_complex dipdqqu;
+      /// The derivative wrt the down quark condensate
+      ubmatrix_complex dipdqqd;
+      /// The derivative wrt the strange quark condensate
+      ubmatrix_complex dipdqqs;
+
+      eig_workspace();
+      
+      ~eig_workspace();
+      
+    private:
+
+      eig_workspace(const eig_workspace &);
+      eig_workspace& operator=(const eig_workspace&);
+      
+    };
+
+    /** \brief Workspaces for \ref eigenvalues6_ws(), one for
+        each thread
+    */
+    std::vector<std::shared_ptr<eig_workspace> > eig_ws;
+
+    /** \brief Compute the eigenvalues and their derivatives
+        using the storage in \c ws
+
+        This is the same as \ref eigenvalues6(), except that
+        it does not modify the class data, so it can be called
+        from several threads with different workspaces.
+    */
+    int eigenvalues6_ws(eig_workspace &ws, double lmom, double mu3,
+			double mu8, double egv[36], double dedmuu[36], 
+			double dedmud[36], double dedmus[36], 
+			double dedmu[36], double dedmd[36], 
+			double dedms[36], double dedu[36], 
+			double dedd[36], double deds[36], 
+			double dedmu3[36], double dedmu8[36]);
+
+    /** \brief The momentum integrands using the storage in \c ws
+     */
+    int integrands_ws(eig_workspace &ws, double p, double res[]);
+    
+    /** \brief Compute the integrands for the \c np momenta in \c p,
+	in parallel if \ref n_threads is larger than one
+    */
+    virtual int integrands_batch(size_t np, const double *p,
+				 size_t nr, double *res);
     
     /// The size of the matrix to be diagonalized
     static const int mat_size=36;
     
-    /// Storage for the inverse propagator
+    /** \brief Storage for the inverse propagator
+
+        This and the following matrices are used by 
+        \ref make_matrices() and \ref test_derivatives().
+    */
     gsl_matrix_complex *iprop6;
 
     /// The eigenvectors
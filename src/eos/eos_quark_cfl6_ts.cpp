@@ -182,6 +182,25 @@ int main(void) {
 
     cfl2.calc_eq_temp_p(u2,d2,s2,ss12,ss22,ss32,gap12,gap22,gap32,
 			0.0,0.0,n32,n82,th2,2.0/hc_mev_fm);
+
+    // The results should not depend on the number of threads
+    
+    pr1=th2.pr;
+    double ss1_1=ss12, gap1_1=gap12;
+    cfl2.n_threads=2;
+    cfl2.calc_eq_temp_p(u2,d2,s2,ss12,ss22,ss32,gap12,gap22,gap32,
+			0.0,0.0,n32,n82,th2,2.0/hc_mev_fm);
+    t.test_rel(th2.pr,pr1,1.0e-14,"threads pr");
+    t.test_rel(ss12,ss1_1,1.0e-14,"threads ss1");
+    t.test_rel(gap12,gap1_1,1.0e-14,"threads gap1");
+    cfl2.n_threads=1;
+
+    // Test the fixed Gauss-Legendre grid
+
+    cfl2.inte_fixed_nsub=2;
+    cfl2.test_integration(t);
+    t.test_gen(cfl2.inte_npoints==32,"fixed npoints");
+    cfl2.inte_fixed_nsub=0;
   }
 
   t.report();
@@ -812,6 +812,18 @@ void eos_sn_ls::load(std::string fname, size_t mode) {
     arr[i]->set_grid_packed(grid);
   }
 
+  // Read the remaining data into memory at once
+
+  std::vector<double> vals;
+  read_doubles(fin,vals);
+  if (vals.size()<ndat*n_Ye*n_T*n_nB) {
+    loaded=false;
+    O2SCL_ERR2("Not enough data in ",
+	       "eos_sn_ls::load().",exc_efailed);
+    return;
+  }
+  size_t ival=0;
+  
   // Read data into tensor objects
   
   for(size_t l=0;l<ndat;l++) {
@@ -824,7 +836,7 @@ void eos_sn_ls::load(std::string fname, size_t mode) {
     for(size_t k=0;k<n_Ye;k++) {
       for(size_t j=0;j<n_T;j++) {
 	for(size_t i=0;i<n_nB;i++) {
-	  fin >> dtemp;
+	  dtemp=vals[ival++];
 	  if (l==0) P.set(i,k,j,dtemp);
 	  else if (l==1) F.set(i,k,j,dtemp);
 	  else if (l==2) S.set(i,k,j,dtemp);
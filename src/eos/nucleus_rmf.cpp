@@ -23,10 +23,16 @@
 
 #include <o2scl/nucleus_rmf.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
 
+const double nucleus_rmf::grid_radius=12.0;
+
 nucleus_rmf::nucleus_rmf() : 
   profiles(new table_units<>),chden_table(new table_units<>)  {
 
@@ -34,26 +40,10 @@ nucleus_rmf::nucleus_rmf() :
   err_nonconv=true;
   generic_ode=false;
 
-  fields.resize(grid_size,4);
-  field0.resize(grid_size,3);
-  xrho.resize(grid_size,4);
-  xrhosp.resize(grid_size);
-  gin.resize(grid_size,4);
-  gout.resize(grid_size,4);
-  xrhos.resize(grid_size);
-  xrhov.resize(grid_size);
-  xrhor.resize(grid_size);
-  chden1.resize(grid_size);
-  chdenc.resize(grid_size);
-
   include_delta=false;
 
-  ode_y.resize(2);
-  ode_dydx.resize(2);
-  ode_yerr.resize(2);
-
-  energy.resize(grid_size+6);
-  arho.resize(grid_size+6);
+  init_called=false;
+  set_grid_size(300);
 
   shell pshells[n_internal_levels]=
     {
@@ -158,8 +148,6 @@ nucleus_rmf::nucleus_rmf() :
   dirac_itmax=100;
   meson_tol=1.0e-6;
 
-  step_size=0.04;
-
   dirac_tol=5.0e-3;
   dirac_tol2=5.0e-4;
 
@@ -177,8 +165,6 @@ nucleus_rmf::nucleus_rmf() :
   chden_table->set_unit("chden1","1/fm^3");
   chden_table->set_unit("chdenc","1/fm^3");
   
-  init_called=false;
-  
   initial_guess ig_tmp={310/hc_mev_fm,240/hc_mev_fm,
 			-6/hc_mev_fm,25.9/hc_mev_fm,6.85,0.6};
   ig=ig_tmp;
@@ -343,6 +329,37 @@ int nucleus_rmf::load_nl3(eos_had_rmf &r) {
   return 0;
 }
 
+void nucleus_rmf::set_grid_size(int n) {
+
+  if (n<60) {
+    O2SCL_ERR2("Grid size less than 60 in ",
+	       "nucleus_rmf::set_grid_size().",exc_einval);
+  }
+  
+  grid_size=n;
+  step_size=grid_radius/((double)grid_size);
+
+  fields.resize(grid_size,4);
+  field0.resize(grid_size,3);
+  xrho.resize(grid_size,4);
+  xrhosp.resize(grid_size);
+  gin.resize(grid_size,4);
+  gout.resize(grid_size,4);
+  xrhos.resize(grid_size);
+  xrhov.resize(grid_size);
+  xrhor.resize(grid_size);
+  chden1.resize(grid_size);
+  chdenc.resize(grid_size);
+
+  energy.resize(grid_size+6);
+  arho.resize(grid_size+6);
+
+  // The fields must be reinitialized on the new grid
+  init_called=false;
+
+  return;
+}
+
 nucleus_rmf::~nucleus_rmf() {
   fields.clear();
   xrho.clear();
@@ -541,9 +558,9 @@ int nucleus_rmf::iterate(int nucleus_Z, int nucleus_N,
   // Solve Dirac equations
     
   if (verbose>1) cout << "Solving Dirac equations. " << endl;
+  int dret=dirac_levels(nlevels);
+  if (dret!=0) dirac_converged=dret;
   for (int ilevel=0;ilevel<nlevels;ilevel++) {
-    int dret=dirac(ilevel);
-    if (dret!=0) dirac_converged=dret;
     (*levp)[ilevel].eigenc=(*levp)[ilevel].eigen-(*levp)[ilevel].energy;
   }
     
@@ -658,9 +675,9 @@ int nucleus_rmf::post_converge(int nucleus_Z, int nucleus_N, int unocc_Z,
     if (verbose>1) cout << "Solving Dirac equations for unoccupied levels. " 
 			<< endl;
     
+    int dret=dirac_levels(nuolevels);
+    if (dret!=0) return dret;
     for (int ilevel=0;ilevel<nuolevels;ilevel++) {
-      int dret=dirac(ilevel);
-      if (dret!=0) return dret;
       (*levp)[ilevel].eigenc=(*levp)[ilevel].eigen-(*levp)[ilevel].energy;
     }
 
@@ -679,7 +696,7 @@ int nucleus_rmf::post_converge(int nucleus_Z, int nucleus_N, int unocc_Z,
   fac[2]=23.0/24.0-7.0/6.0;
   fac[3]=1.0/24.0;
 
-  for(int i=4;i<295;i++) {
+  for(int i=4;i<grid_size-5;i++) {
     for(int j=0;j<4;j++) {
       stens+=step_size*(energy[i+j-1]-energy[2]*arho[i+j-1]/arho[2])*fac[j];
     }
@@ -966,12 +983,74 @@ double nucleus_rmf::rho_rhs(double sig, double ome, double rho) {
   return ret;
 }
 
-int nucleus_rmf::dirac(int ilevel) {
+int nucleus_rmf::dirac_levels(int nlev) {
+
+  // Allocate storage for each level
+  if (((int)dws.size())<nlev) dws.resize(nlev);
+  for (int il=0;il<nlev;il++) {
+    if (((int)dws[il].g.size())!=grid_size) {
+      dws[il].g.resize(grid_size);
+      dws[il].f.resize(grid_size);
+      dws[il].y.resize(2);
+      dws[il].dydx.resize(2);
+      dws[il].yerr.resize(2);
+    }
+  }
+
+  // A level with a positive energy obtains its initial guess from
+  // the previous level, so divide the levels into chains which
+  // begin with a level with a non-positive energy
+  std::vector<int> chain_start;
+  for (int il=0;il<nlev;il++) {
+    if (il==0 || (*levp)[il].energy<=0.0) chain_start.push_back(il);
+  }
+  int n_chains=chain_start.size();
+
+  // A user-specified stepper may not be safe to use in
+  // more than one thread
+  bool parallel=(generic_ode==false || ostep==&def_step);
+  
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) if(parallel)
+#endif
+  for (int ic=0;ic<n_chains;ic++) {
+    int il_end=nlev;
+    if (ic+1<n_chains) il_end=chain_start[ic+1];
+    for (int il=chain_start[ic];il<il_end;il++) {
+      dws[il].ret=dirac_solve(il,dws[il]);
+    }
+  }
+
+  // Sum up the densities in order, and report any failures
+  int first_fail=-1;
+  for (int il=0;il<nlev;il++) {
+    if (dws[il].ret==0) {
+      dirac_density(il,dws[il]);
+    } else {
+      if (verbose>0) {
+	cout << "No Dirac convergence (" << dirac_itmax << ") tries. "
+	     << endl;
+	cout << "\tLevel: " << (*levp)[il].state << ", deltae: " 
+	     << dws[il].deltae << endl;
+      }
+      if (first_fail<0) first_fail=il;
+    }
+  }
+  if (first_fail>=0) {
+    O2SCL_CONV2_RET("Dirac failed to converge in ",
+		    "nucleus_rmf::dirac_levels().",exc_efailed,err_nonconv);
+  }
+
+  return 0;
+}
+
+int nucleus_rmf::dirac_solve(int ilevel, dirac_workspace &w) {
   int iturn, i, j, jmatch, jtop, no=0;
   double deltae, x, yfs, ygs, alpha, xk, v0, e;
-  double scale, xnorm=0.0, factor, x1, x2, yf1, yf2, yg1, yg2;
+  double scale, xnorm=0.0, x1, x2, yf1, yf2, yg1, yg2;
   
-  ubvector g(grid_size), v(grid_size), f(grid_size), xz(6);
+  ubvector &g=w.g, &f=w.f, &y=w.y;
+  ubvector v(grid_size), xz(6);
   
   if ((*levp)[ilevel].energy>0) {
     (*levp)[ilevel].energy=(*levp)[ilevel-1].eigen;
@@ -999,30 +1078,29 @@ int nucleus_rmf::dirac(int ilevel) {
     f[0]=f[0]/(1.0-2.0*(*levp)[ilevel].kappa);
 
     if ((*levp)[ilevel].kappa>=0) {
-      g[0]=10.0*pow(0.04,1.0+(*levp)[ilevel].kappa);
-      f[0]=hc_mev_fm/0.04*g[0]*(2.0*(*levp)[ilevel].kappa+1.0);
+      g[0]=10.0*pow(step_size,1.0+(*levp)[ilevel].kappa);
+      f[0]=hc_mev_fm/step_size*g[0]*(2.0*(*levp)[ilevel].kappa+1.0);
       f[0]=f[0]/((*levp)[ilevel].eigen-v[0]-fields(0,0)*hc_mev_fm+
 		 2.0*mnuc*hc_mev_fm);
     }
 
-    jmatch=(int)(25.0*(*levp)[ilevel].match_point+0.5+1.0e-6);
-    ode_y[0]=f[0];
-    ode_y[1]=g[0];
+    jmatch=(int)((*levp)[ilevel].match_point/step_size+0.5+1.0e-6);
+    y[0]=f[0];
+    y[1]=g[0];
     x=step_size;
 
-    double dtmptmp=(*levp)[ilevel].kappa;
-    
     for (i=1;i<jmatch;i++) {
-      dirac_step(x,step_size,(*levp)[ilevel].eigen,(*levp)[ilevel].kappa,v);
-      f[i]=ode_y[0];
-      g[i]=ode_y[1];
+      dirac_step(x,step_size,(*levp)[ilevel].eigen,(*levp)[ilevel].kappa,
+		 v,w);
+      f[i]=y[0];
+      g[i]=y[1];
     }
     
     //--------------------------------------------------------------
     // store end values for latter matching
   
-    yfs=ode_y[0];
-    ygs=ode_y[1];
+    yfs=y[0];
+    ygs=y[1];
   
     //--------------------------------------------------------------
     // Large r solutions
@@ -1032,31 +1110,31 @@ int nucleus_rmf::dirac(int ilevel) {
   
     alpha=sqrt(-(*levp)[ilevel].eigen*((*levp)[ilevel].eigen+
 				       2.0*mnuc*hc_mev_fm))/hc_mev_fm;
-    g[grid_size-1]=exp(-12.0*alpha);
+    g[grid_size-1]=exp(-grid_radius*alpha);
     xz[1]=-sqrt(-(*levp)[ilevel].eigen/((*levp)[ilevel].eigen+
 					2.0*mnuc*hc_mev_fm));
     xk=(*levp)[ilevel].kappa;
-    x=12.0;
-    v0=12.0*v[grid_size-1]/hc_mev_fm;
+    x=grid_radius;
+    v0=grid_radius*v[grid_size-1]/hc_mev_fm;
     e=hc_mev_fm/2.0/((*levp)[ilevel].eigen+2.0*mnuc*hc_mev_fm);
     
     f[grid_size-1]=xz[1]*g[grid_size-1];
-    ode_y[0]=f[grid_size-1];
-    ode_y[1]=g[grid_size-1];
+    y[0]=f[grid_size-1];
+    y[1]=g[grid_size-1];
     jtop=grid_size-jmatch;
 
     for (j=1;j<=jtop;j++) {
       dirac_step(x,-step_size,(*levp)[ilevel].eigen,
-		 (*levp)[ilevel].kappa,v);
+		 (*levp)[ilevel].kappa,v,w);
       i=grid_size-j;
-      f[i-1]=ode_y[0];
-      g[i-1]=ode_y[1];
+      f[i-1]=y[0];
+      g[i-1]=y[1];
     }
   
     //--------------------------------------------------------------
     // Match solutions
   
-    scale=ode_y[1]/ygs;
+    scale=y[1]/ygs;
   
     jtop=jmatch-1;
     for (i=0;i<jtop;i++) {
@@ -1095,24 +1173,27 @@ int nucleus_rmf::dirac(int ilevel) {
     iturn++;
   }
 
+  w.xnorm=xnorm;
+  w.deltae=deltae;
+  (*levp)[ilevel].nodes=no;
+
   if (iturn>dirac_itmax) {
-    if (verbose>0) {
-      cout << "No Dirac convergence (" << dirac_itmax << ") tries. " << endl;
-      cout << "\tLevel: " << (*levp)[ilevel].state << ", deltae: " 
-	   << deltae << endl;
-    }
-    O2SCL_CONV2_RET("Dirac failed to converge in ",
-		    "nucleus_rmf::dirac().",exc_efailed,err_nonconv);
+    return exc_efailed;
   }
 
+  return 0;
+}
+
+void nucleus_rmf::dirac_density(int ilevel, dirac_workspace &w) {
+  
+  ubvector &g=w.g, &f=w.f;
+  
   //--------------------------------------------------------------
   // sum up the densities
   // rho = (2j+1)/norm(f*f+g*g)/(4pi*x*x)
   
-  (*levp)[ilevel].nodes=no;
-
-  factor=(*levp)[ilevel].twojp1/xnorm/4.0/pi;
-  for (i=0;i<grid_size;i++) {
+  double factor=(*levp)[ilevel].twojp1/w.xnorm/4.0/pi;
+  for (int i=0;i<grid_size;i++) {
     
     xrhosp[i]=xrhosp[i]+factor*((*levp)[ilevel].isospin+0.5)*
       (g[i]*g[i]-f[i]*f[i]);
@@ -1125,7 +1206,7 @@ int nucleus_rmf::dirac(int ilevel) {
 
   }
 
-  return 0;
+  return;
 }
 
 double nucleus_rmf::dirac_rk4(double x, double g1, double f1, double &funt, 
@@ -1138,12 +1219,15 @@ double nucleus_rmf::dirac_rk4(double x, double g1, double f1, double &funt,
 }
 
 void nucleus_rmf::dirac_step(double &x, double ht, 
-			     double eigent, double kappat, ubvector &varr) {
+			     double eigent, double kappat, ubvector &varr,
+			     dirac_workspace &w) {
+
+  ubvector &ode_y=w.y;
 
   if (generic_ode) {
     
     odparms op={eigent,kappat,&fields,&varr};
-    odefun(x,2,ode_y,ode_dydx,op);
+    odefun(x,2,ode_y,w.dydx,op);
 
     ode_funct ofm=std::bind
       (std::mem_fn<int(double,size_t,const ubvector &,ubvector &,odparms &)>
@@ -1153,7 +1237,13 @@ void nucleus_rmf::dirac_step(double &x, double ht,
 
     //ode_funct_mfptr_param<nucleus_rmf,odparms,ubvector> 
     //ofm(this,&nucleus_rmf::odefun,op);
-    ostep->step(x,ht,2,ode_y,ode_dydx,ode_y,ode_yerr,ode_dydx,ofm);
+    // Use the stepper for this level unless a different stepper
+    // was specified with set_step()
+    if (ostep==&def_step) {
+      w.step.step(x,ht,2,ode_y,w.dydx,ode_y,w.yerr,w.dydx,ofm);
+    } else {
+      ostep->step(x,ht,2,ode_y,w.dydx,ode_y,w.yerr,w.dydx,ofm);
+    }
 
     x+=ht;
 
@@ -1199,10 +1289,10 @@ int nucleus_rmf::odefun(double x, size_t nv, const ubvector &y,
 
 void nucleus_rmf::field(double x, double &s, double &v1, ubvector &v) {
 
-  int i=(int)(x*25.0+0.1+1.0e-6);
+  int i=(int)(x/step_size+0.1+1.0e-6);
   s=fields(i-1,0)*hc_mev_fm;
   v1=v[i-1];
-  if (x*25.0-((double)(i))<0.3) return;
+  if (x/step_size-((double)(i))<0.3) return;
   s=(s+fields(i,0)*hc_mev_fm)*0.5;
   v1=(v1+v[i])*0.5;
   return;
@@ -1396,7 +1486,7 @@ double nucleus_rmf::xrhop(double x1) {
   double xrhopret;
   
   xrhopret=gi->eval(x1);
-  if (x1>12.0) xrhopret=0.0;
+  if (x1>grid_radius) xrhopret=0.0;
   xrhopret=xrhopret*x1*x1;
 
   return xrhopret;
@@ -53,6 +53,19 @@ namespace o2scl {
       Steiner afterwards.
       \endverbatim
 
+      The Dirac equations for the individual levels are independent
+      given the meson fields, so they are solved in parallel if
+      OpenMP support is enabled. Each level has its own ODE stepper
+      and storage in a \ref dirac_workspace object. The only
+      exception is a level which has a positive initial energy, as
+      its initial guess is taken from the eigenvalue of the previous
+      level, so such levels are solved in sequence after the level
+      before them. If \ref generic_ode is true and the stepper has
+      been changed with \ref set_step(), then the levels are solved
+      serially. The contributions to the densities are always summed
+      in the same order, so the results do not depend on the number
+      of threads.
+
       The standard usage is something like:
       \code
       nucleus_rmf rn;
@@ -295,6 +308,18 @@ namespace o2scl {
 
     /// Set output level
     void set_verbose(int v) { verbose=v; };
+
+    /** \brief Set the number of radial grid points (default 300)
+
+        The grid always extends out to 12 fm, so this also sets the
+        grid step size to \f$ 12/n \f$ fm. Coarse grids are faster
+        but less accurate. The value of \c n must be at least 60.
+        This function must be called before \ref init_run().
+    */
+    void set_grid_size(int n);
+
+    /// Get the number of radial grid points
+    int get_grid_size() { return grid_size; }
     //@}
     
     /** \name Lower-level interface 
@@ -564,12 +589,15 @@ namespace o2scl {
     /// The starting proton levels
     shell proton_shells[n_internal_levels];
 
-    /// The grid size
-    static const int grid_size=300;
+    /// The grid size (default 300)
+    int grid_size;
     
     /// The grid step size (default 0.04)
     double step_size;
 
+    /// The outer radius of the grid (12 fm)
+    static const double grid_radius;
+
     /// The nucleon mass (automatically set in init_fun())
     double mnuc;
 
@@ -742,20 +770,67 @@ namespace o2scl {
     /** \name Solving the Dirac equations (protected)
      */
     //@{
-    /** \brief Solve the Dirac equations
+    /// Storage for the solution of the Dirac equation for one level
+    typedef struct {
+      /// ODE functions
+      ubvector y;
+      /// ODE derivatives
+      ubvector dydx;
+      /// ODE errors
+      ubvector yerr;
+      /// The upper component of the wave function
+      ubvector g;
+      /// The lower component of the wave function
+      ubvector f;
+      /// The normalization integral
+      double xnorm;
+      /// The last correction to the eigenvalue
+      double deltae;
+      /// The return value from \ref dirac_solve()
+      int ret;
+      /// The ODE stepper
+      ode_rkck_gsl<ubvector,ubvector,ubvector,ode_funct> step;
+    } dirac_workspace;
+
+    /// One workspace for each level
+    std::vector<dirac_workspace> dws;
+
+    /** \brief Solve the Dirac equations for the first \c nlev 
+        levels in \ref levp and add their contributions to
+        the densities
+
+        This function never calls the error handler from inside a
+        parallel region. If any of the levels fail to converge, the
+        contributions from the other levels are still added to the
+        densities, and then the error handler is called (if \ref
+        err_nonconv is true) or \ref o2scl::exc_efailed is returned.
+    */
+    int dirac_levels(int nlev);
+
+    /** \brief Solve the Dirac equations for one level
 	
 	Solves the Dirac equation in from 12 fm to the match point and
-	then out from .04 fm and adjusts eigenvalue with
+	then out from the first grid point and adjusts eigenvalue with
 	\f[
 	\Delta \varepsilon = -g(r=\mathrm{match\_point}) 
 	\times (f^{+}-f^{-})
 	\f]
+        The wave functions are stored in \c w. This function
+        does not modify any of the class data except for the entry
+        in \ref levp for level \c ilevel, and it returns 
+        \ref o2scl::exc_efailed rather than calling the error 
+        handler when the eigenvalue does not converge.
+    */
+    int dirac_solve(int ilevel, dirac_workspace &w);
+
+    /** \brief Add the contribution of level \c ilevel to the 
+        densities
     */
-    int dirac(int ilevel);
+    void dirac_density(int ilevel, dirac_workspace &w);
     
     /// Take a step in the Dirac equations
     void dirac_step(double &x, double h, double eigen,
-		    double kappa, ubvector &varr);
+		    double kappa, ubvector &varr, dirac_workspace &w);
     
     /// The form of the Dirac equations for the ODE stepper
     int odefun(double x, size_t nv, const ubvector &y,
@@ -781,15 +856,6 @@ namespace o2scl {
     
     /// True if init() has been called
     bool init_called;
-    
-    /// ODE functions
-    ubvector ode_y;
-
-    /// ODE derivatives
-    ubvector ode_dydx;
-
-    /// ODE errors
-    ubvector ode_yerr;
 
     /// \name Gauss-Legendre integration points and weights
     //@{
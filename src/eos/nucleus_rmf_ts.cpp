@@ -234,6 +234,15 @@ int main(void) {
   
   el.post_converge(82,126,2,2);
 
+  // Compare with a finer grid
+  nucleus_rmf el2;
+  el2.set_eos(rmf);
+  el2.set_grid_size(600);
+  t.test_gen(el2.get_grid_size()==600,"grid size");
+  el2.run_nucleus(82,126,2,2);
+  t.test_rel(el2.etot,el.etot,1.0e-2,"total energy, fine grid");
+  t.test_rel(el2.rprms,el.rprms,1.0e-2,"proton radius, fine grid");
+
   t.report();
 
   return 0;
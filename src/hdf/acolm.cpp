@@ -66,6 +66,7 @@ acol_manager::acol_manager() : cset(this,&acol_manager::comm_set),
 
   env_var_name="ACOL_DEFAULTS";
   interp_type=1;
+  stream_chunk=100000;
 
 #ifdef O2SCL_HDF5_COMP
   compress=1;
@@ -1181,7 +1182,7 @@ int acol_manager::setup_options() {
   const int cl_param=cli::comm_option_cl_param;
   const int both=cli::comm_option_both;
 
-  static const int narr=21;
+  static const int narr=22;
 
   string type_list_str;
   for(size_t i=0;i<type_list.size()-1;i++) {
@@ -1248,6 +1249,9 @@ int acol_manager::setup_options() {
      {0,"slack","",0,6,"","",
       new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_slack),
       both},
+     {0,"stream","",0,-1,"","",
+      new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_stream),
+      both},
      {0,"type","",0,0,"","",
       new comm_option_mfptr<acol_manager>(this,&acol_manager::comm_type),
       both},
@@ -1417,6 +1421,7 @@ int acol_manager::setup_parameters() {
   p_precision.i=&precision;
   p_ncols.i=&ncols;
   p_interp_type.i=&interp_type;
+  p_stream_chunk.i=&stream_chunk;
   p_scientific.b=&scientific;
   p_pretty.b=&pretty;
   p_names_out.b=&names_out;
@@ -1433,6 +1438,8 @@ int acol_manager::setup_parameters() {
   p_interp_type.help=((std::string)"The interpolation type ")+
     "(1=linear, 2=cubic spline, 3=periodic cubic spline, 4=Akima, "+
     "5=periodic Akima, 6=monotonic, 7=Steffen's monotonic).";
+  p_stream_chunk.help=((std::string)"The number of rows read at ")+
+    "a time by the 'stream' command (default 100000).";
   p_names_out.help="If true, output column names at top.";
   p_use_regex.help="If true, use regex.";
   p_pretty.help="If true, make the output more readable.";
@@ -1445,6 +1452,7 @@ int acol_manager::setup_parameters() {
   cl->par_list.insert(make_pair("compress",&p_compress));
   cl->par_list.insert(make_pair("ncols",&p_ncols));
   cl->par_list.insert(make_pair("interp_type",&p_interp_type));
+  cl->par_list.insert(make_pair("stream_chunk",&p_stream_chunk));
   cl->par_list.insert(make_pair("names_out",&p_names_out));
   cl->par_list.insert(make_pair("use_regex",&p_use_regex));
   cl->par_list.insert(make_pair("pretty",&p_pretty));
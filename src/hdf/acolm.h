@@ -176,6 +176,9 @@ namespace o2scl_acol {
 
     /// If set, try to compress
     int compress;
+
+    /// The number of rows per block for the 'stream' command
+    int stream_chunk;
     
     /// True for scientific output mode
     bool scientific;
@@ -190,6 +193,7 @@ namespace o2scl_acol {
     o2scl::cli::parameter_int p_precision;
     o2scl::cli::parameter_int p_ncols;
     o2scl::cli::parameter_int p_interp_type;
+    o2scl::cli::parameter_int p_stream_chunk;
     o2scl::cli::parameter_bool p_scientific;
     o2scl::cli::parameter_bool p_pretty;
     o2scl::cli::parameter_bool p_names_out;
@@ -1761,6 +1765,29 @@ namespace o2scl_acol {
     virtual int comm_h5_copy(std::vector<std::string> &sv, 
                              bool itive_com);
 
+    /** \brief Process a large table in blocks of rows
+
+        <input file> <table name> <command> [args]
+
+        Apply a command to a table in an HDF5 file without reading the
+        full table into memory. The table is read in blocks with
+        'stream_chunk' rows each. The commands 'stats', 'sum', 'min',
+        and 'max' take a column name and output the associated
+        statistics, reading only that column from the file. The
+        command 'to-hist' takes a column name, a number of bins, and
+        an optional column of weights, and creates a histogram using
+        two passes through the file. The commands 'function',
+        'select', 'select-rows', and 'delete-col' take an output
+        filename followed by the usual arguments for that command.
+        They are applied to each block separately and the resulting
+        rows are appended to a table with the same name in the output
+        file, so the output table need not fit in memory either.
+        For example, 'stream in.o2 tab select out.o2 x y2=y*y'.
+        The current object is not modified, except for 'to-hist'
+        which replaces it with the new histogram.
+     */
+    virtual int comm_stream(std::vector<std::string> &sv, bool itive_com);
+
     /** \brief Get a physical or numerical constant.
 
         <name, pattern, "add", "del", or "list"> [unit]
@@ -22,6 +22,10 @@
 */
 #include "acolm.h"
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 #include <o2scl/cloud_file.h>
 #include <o2scl/vector_derint.h>
 
@@ -1290,6 +1294,12 @@ int acol_manager::comm_contours(std::vector<std::string> &sv, bool itive_com) {
     cerr << "Not implemented for type " << type << " ." << endl;
     return exc_efailed;
   }
+
+  // Use all of the available threads for the contour calculation
+  size_t n_threads=1;
+#ifdef O2SCL_OPENMP
+  n_threads=omp_get_max_threads();
+#endif
   
   /*
     if (sv.size()>=2 && sv[1]=="frac") {
@@ -1492,7 +1502,7 @@ int acol_manager::comm_contours(std::vector<std::string> &sv, bool itive_com) {
     
     if (file.length()>0) {
       std::vector<contour_line> clines;
-      table3d_obj.slice_contours(slice,1,levs,clines);
+      table3d_obj.slice_contours(slice,1,levs,clines,n_threads);
       if (clines.size()>0) {
 	hdf_file hf;
 	hf.open_or_create(file);
@@ -1500,7 +1510,7 @@ int acol_manager::comm_contours(std::vector<std::string> &sv, bool itive_com) {
 	hf.close();
       }
     } else {
-      table3d_obj.slice_contours(slice,1,levs,cont_obj);
+      table3d_obj.slice_contours(slice,1,levs,cont_obj,n_threads);
       if (cont_obj.size()>0) {
 	command_del(type);
 	clear_obj();
@@ -1671,6 +1681,7 @@ int acol_manager::comm_contours(std::vector<std::string> &sv, bool itive_com) {
     }
     
     contour co;
+    co.n_threads=n_threads;
     co.set_levels(nlev,levs);
     
     ubvector xreps(hist_2d_obj.size_x());
@@ -482,17 +482,9 @@ int acol_manager::comm_generic(std::vector<std::string> &sv, bool itive_com) {
   } else if (ctype=="double[]") {
 
     if (fname!=((std::string)"cin")) {
-      double dtmp;
-      doublev_obj.clear();
-      while (ifs >> dtmp) {
-	doublev_obj.push_back(dtmp);
-      }
+      read_doubles(ifs,doublev_obj);
     } else {
-      double dtmp;
-      doublev_obj.clear();
-      while (cin >> dtmp) {
-	doublev_obj.push_back(dtmp);
-      }
+      read_doubles(cin,doublev_obj);
     }
     
   } else if (ctype=="size_t[]") {
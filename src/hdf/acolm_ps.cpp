@@ -1430,7 +1430,7 @@ int acol_manager::comm_sort(std::vector<std::string> &sv, bool itive_com) {
 
   } else if (type=="double[]") {
 
-    vector_sort<vector<double>,double>(doublev_obj.size(),doublev_obj);
+    vector_sort_radix(doublev_obj.size(),doublev_obj);
     if (verbose>0) {
       cout << "Object of type double[] sorted." << endl;
     }
@@ -1705,6 +1705,332 @@ int acol_manager::comm_stats(std::vector<std::string> &sv, bool itive_com) {
   return 0;
 }
 
+int acol_manager::comm_stream(std::vector<std::string> &sv, bool itive_com) {
+
+  vector<string> in, pr;
+  pr.push_back("Enter input filename");
+  pr.push_back("Enter table name");
+  pr.push_back("Enter command");
+  int ret=get_input(sv,pr,in,"stream",itive_com);
+  if (ret!=0) return ret;
+
+  std::string tname=in[1], scomm=in[2];
+  std::vector<std::string> args;
+  for(size_t i=3;i<in.size();i++) {
+    args.push_back(in[i]);
+  }
+
+  if (stream_chunk<=0) {
+    cerr << "Parameter 'stream_chunk' must be positive." << endl;
+    return exc_efailed;
+  }
+  size_t chunk=((size_t)stream_chunk);
+
+  bool reduce=(scomm=="stats" || scomm=="sum" || scomm=="min" ||
+               scomm=="max" || scomm=="to-hist");
+  bool transform=(scomm=="function" || scomm=="select" ||
+                  scomm=="select-rows" || scomm=="delete-col");
+  if (reduce==false && transform==false) {
+    cerr << "Command '" << scomm << "' not supported by 'stream'." << endl;
+    return exc_efailed;
+  }
+  if (args.size()<1 || (transform && args.size()<2) ||
+      (scomm=="to-hist" && args.size()<2)) {
+    cerr << "Not enough arguments for 'stream " << scomm << "'." << endl;
+    return exc_efailed;
+  }
+
+  hdf_file hf;
+  ret=hf.open(in[0],false,false);
+  if (ret!=0) {
+    cerr << "Could not find file named '" << in[0] << "'. Wrong file name?"
+	 << endl;
+    return exc_efailed;
+  }
+
+  // Read only the header, so the number of rows is known before
+  // any data is read
+  table_units<> head;
+  size_t nlines;
+  hdf_input_table_header(hf,head,nlines,tname);
+  if (verbose>1) {
+    cout << "Streaming table '" << tname << "' with " << nlines
+         << " rows in chunks of " << chunk << " rows." << endl;
+  }
+
+  if (reduce) {
+
+    // The reductions only need one column (and possibly a column of
+    // weights), which are read directly from the data group
+    if (head.is_column(args[0])==false) {
+      cerr << "Could not find column named '" << args[0] << "'." << endl;
+      return exc_efailed;
+    }
+
+    size_t nbins=0;
+    std::string wcol;
+    if (scomm=="to-hist") {
+      int sret=o2scl::stoszt_nothrow(args[1],nbins);
+      if (sret!=0 || nbins==0) {
+        cerr << "Failed to interpret " << args[1]
+             << " as a positive number of bins." << endl;
+        return exc_einval;
+      }
+      if (args.size()>=3) {
+        wcol=args[2];
+        if (head.is_column(wcol)==false) {
+          cerr << "Could not find column named '" << wcol << "'." << endl;
+          return exc_efailed;
+        }
+      }
+    }
+
+    if (nlines==0) {
+      cerr << "No rows to analyze." << endl;
+      return exc_efailed;
+    }
+
+    hid_t top=hf.get_current_id();
+    hid_t group=hf.open_group(tname);
+    hf.set_current_id(group);
+    hid_t group2=hf.open_group("data");
+    hf.set_current_id(group2);
+
+    std::vector<double> col(chunk), wgt;
+    if (wcol.length()>0) wgt.resize(chunk);
+
+    // Running sums, with the mean and variance accumulated
+    // using Welford's method
+    size_t ntot=0, ix_min=0, ix_max=0;
+    double sum=0.0, mean=0.0, m2=0.0, vmin=0.0, vmax=0.0, last=0.0;
+    size_t dup=0, inc=0, dec=0, ninf=0, nnan=0;
+
+    // The histogram requires the range of the data first, so it
+    // takes two passes through the file
+    size_t npass=1;
+    if (scomm=="to-hist") npass=2;
+    hist h;
+
+    for(size_t ip=0;ip<npass;ip++) {
+
+      if (ip==1) {
+        uniform_grid<double> ug=uniform_grid_end<double>(vmin,vmax,nbins);
+        h.set_bin_edges(ug);
+        h.extend_lhs=true;
+        h.extend_rhs=true;
+      }
+
+      for(size_t row=0;row<nlines;row+=chunk) {
+
+        size_t n=nlines-row;
+        if (n>chunk) n=chunk;
+        hf.getd_arr_hyperslab(args[0],row,n,&(col[0]));
+
+        if (ip==1) {
+          if (wcol.length()>0) {
+            hf.getd_arr_hyperslab(wcol,row,n,&(wgt[0]));
+            for(size_t i=0;i<n;i++) h.update(col[i],wgt[i]);
+          } else {
+            for(size_t i=0;i<n;i++) h.update(col[i]);
+          }
+          continue;
+        }
+
+        for(size_t i=0;i<n;i++) {
+          double x=col[i];
+          if (row+i==0) {
+            vmin=x;
+            vmax=x;
+          } else {
+            if (x<vmin) {
+              vmin=x;
+              ix_min=row+i;
+            }
+            if (x>vmax) {
+              vmax=x;
+              ix_max=row+i;
+            }
+            if (x==last) dup++;
+            if (last<x) inc++;
+            if (last>x) dec++;
+          }
+          if (std::isinf(x)) ninf++;
+          if (std::isnan(x)) nnan++;
+          ntot++;
+          sum+=x;
+          double delta=x-mean;
+          mean+=delta/ntot;
+          m2+=delta*(x-mean);
+          last=x;
+        }
+      }
+    }
+
+    hf.close_group(group2);
+    hf.close_group(group);
+    hf.set_current_id(top);
+    hf.close();
+
+    if (scomm=="to-hist") {
+      
+      command_del(type);
+      clear_obj();
+      hist_obj=h;
+      command_add("hist");
+      type="hist";
+      
+    } else if (scomm=="sum") {
+      
+      cout << "Sum of column " << args[0] << " is " << sum << endl;
+      
+    } else if (scomm=="min") {
+      
+      cout << "Minimum of column " << args[0] << " is " << vmin
+           << " at index: " << ix_min << endl;
+      
+    } else if (scomm=="max") {
+      
+      cout << "Maximum of column " << args[0] << " is " << vmax
+           << " at index: " << ix_max << endl;
+      
+    } else {
+      
+      cout << "N        : " << ntot << endl;
+      cout << "Sum      : " << sum << endl;
+      cout << "Mean     : " << mean << endl;
+      if (ntot>1) {
+        cout << "Std. dev.: " << sqrt(m2/((double)(ntot-1))) << endl;
+      }
+      cout << "Min      : " << vmin << " at index: " << ix_min << endl;
+      cout << "Max      : " << vmax << " at index: " << ix_max << endl;
+      
+      if (inc>0 && dec==0) {
+        if (dup>0) {
+          cout << "Increasing (" << dup << " duplicates)." << endl;
+        } else {
+          cout << "Strictly increasing. No duplicates." << endl;
+        }
+      } else if (dec>0 && inc==0) {
+        if (dup>0) {
+          cout << "Decreasing (" << dup << " duplicates)." << endl;
+        } else {
+          cout << "Strictly decreasing. No duplicates." << endl;
+        }
+      } else if (dec==0 && inc==0) {
+        cout << "Constant (" << dup << " duplicates)." << endl;
+      } else {
+        cout << "Non-monotonic (" << inc << " increasing, " << dec
+             << " decreasing, and " << dup << " duplicates)." << endl;
+      }
+      if (ninf>0) {
+        cout << ninf << " infinite values." << endl;
+      }
+      if (nnan>0) {
+        cout << nnan << " NaN values." << endl;
+      }
+      if ((dup+inc+dec)!=(ntot-1)) {
+        cout << "Counting mismatch from non-finite values or signed zeros."
+             << endl;
+      }
+    }
+
+    return 0;
+  }
+
+  // ----------------------------------------------------------------
+  // Transformations: each block of rows is read into the current
+  // table, the associated acol command is applied, and the result
+  // is appended to the output file
+
+  std::string fout=args[0];
+  if (fout==in[0]) {
+    cerr << "Input and output filenames must be different." << endl;
+    return exc_efailed;
+  }
+
+  std::vector<std::string> sv2;
+  sv2.push_back(scomm);
+  for(size_t i=1;i<args.size();i++) {
+    sv2.push_back(args[i]);
+  }
+
+  hdf_file hf2;
+  hf2.compr_type=compress;
+  hf2.open_or_create(fout);
+  std::string type_out;
+  if (hf2.find_object_by_name(tname,type_out)==0) {
+    cerr << "Object named '" << tname << "' already present in file '"
+         << fout << "'." << endl;
+    hf2.close();
+    return exc_efailed;
+  }
+
+  // Store the current object and make the blocks of rows the
+  // current table while the command is applied
+  table_units<> table_save;
+  std::swap(table_save,table_obj);
+  std::string type_save=type;
+  int verbose_save=verbose;
+  type="table";
+  verbose=0;
+
+  // If the error handler throws while the blocks are processed, the
+  // current object is restored before the exception is passed on
+  try {
+    
+    for(size_t row=0;row<nlines && ret==0;row+=chunk) {
+      
+      size_t n=nlines-row;
+      if (n>chunk) n=chunk;
+      
+      table_obj=head;
+      hdf_input_table_rows(hf,table_obj,tname,row,n);
+      
+      if (scomm=="function") {
+        ret=comm_function(sv2,false);
+      } else if (scomm=="select") {
+        ret=comm_select(sv2,false);
+      } else if (scomm=="select-rows") {
+        ret=comm_select_rows(sv2,false);
+      } else {
+        ret=comm_delete_col(sv2,false);
+      }
+      
+      if (ret==0) {
+        if (row==0) {
+          hdf_output_table_header(hf2,table_obj,tname);
+        }
+        hdf_output_table_rows(hf2,table_obj,tname,chunk);
+        if (verbose_save>1) {
+          cout << "Wrote " << table_obj.get_nlines() << " rows from block "
+               << "starting at row " << row << "." << endl;
+        }
+      }
+    }
+    
+  } catch (...) {
+    std::swap(table_save,table_obj);
+    type=type_save;
+    verbose=verbose_save;
+    hf2.close();
+    hf.close();
+    throw;
+  }
+
+  std::swap(table_save,table_obj);
+  type=type_save;
+  verbose=verbose_save;
+
+  hf2.close();
+  hf.close();
+
+  if (ret!=0) {
+    cerr << "Command 'stream " << scomm << "' failed." << endl;
+  }
+  
+  return ret;
+}
+
 int acol_manager::comm_set(std::vector<std::string> &sv, bool itive_com) {
 
   // Make sure the object interpolation types coincide with the
@@ -30,17 +30,93 @@
 #include <fnmatch.h>
 #endif
 
+#include <algorithm>
+
 #include <o2scl/err_hnd.h>
 #include <o2scl/hdf_file.h>
 #include <o2scl/table.h>
 #include <o2scl/hdf_io.h>
 
+// Direct chunk I/O requires zlib and HDF5 1.10.3 or later
+#if defined(O2SCL_HDF5_COMP) && defined(HAVE_LIBZ)
+#if H5_VERSION_GE(1,10,3)
+#define O2SCL_HDF5_DIRECT_CHUNK
+#include <zlib.h>
+#endif
+#endif
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_hdf;
 
 typedef unsigned long long o2_u64_t;
 
+#ifdef O2SCL_HDF5_DIRECT_CHUNK
+
+/* Compute the offset of chunk \c ic in a dataset of rank \c ndims
+   which has \c nch chunks in each dimension
+*/
+static void chunk_offset(int ndims, const hsize_t *nch,
+			 const hsize_t *chunk, size_t ic, hsize_t *off) {
+  for(int k=ndims-1;k>=0;k--) {
+    off[k]=(ic%nch[k])*chunk[k];
+    ic/=nch[k];
+  }
+  return;
+}
+
+/* Copy the part of the chunk with offset \c off which lies inside a
+   row-major array of size \c dims. If \c to_chunk is true, \c src
+   is the array and \c dst is the chunk buffer, otherwise \c src is
+   the chunk buffer and \c dst is the array.
+*/
+static void chunk_copy(int ndims, const hsize_t *dims,
+		       const hsize_t *chunk, const hsize_t *off,
+		       bool to_chunk, const double *src, double *dst) {
+
+  // The number of elements in each row which are inside the array
+  hsize_t last=chunk[ndims-1];
+  if (off[ndims-1]+last>dims[ndims-1]) last=dims[ndims-1]-off[ndims-1];
+
+  // Iterate over the rows of the chunk
+  std::vector<hsize_t> ix(ndims,0);
+  while (true) {
+
+    bool inside=true;
+    size_t i_arr=0, i_chunk=0;
+    for(int k=0;k<ndims;k++) {
+      if (off[k]+ix[k]>=dims[k]) inside=false;
+      i_arr=i_arr*dims[k]+off[k]+ix[k];
+      i_chunk=i_chunk*chunk[k]+ix[k];
+    }
+    if (inside) {
+      if (to_chunk) {
+	std::copy(src+i_arr,src+i_arr+last,dst+i_chunk);
+      } else {
+	std::copy(src+i_chunk,src+i_chunk+last,dst+i_arr);
+      }
+    }
+
+    // Move to the next row
+    int k=ndims-2;
+    while (k>=0) {
+      ix[k]++;
+      if (ix[k]<chunk[k]) break;
+      ix[k]=0;
+      k--;
+    }
+    if (k<0) return;
+  }
+  
+  return;
+}
+
+#endif
+
 hdf_file::hdf_file() {
   file=0;
   current=0;
@@ -52,6 +128,9 @@ hdf_file::hdf_file() {
 #endif
   write_access=false;
   min_compr_size=40;
+  compr_level=6;
+  compr_shuffle=false;
+  compr_threads=1;
 }
 
 hdf_file::~hdf_file() {
@@ -1548,24 +1627,8 @@ int hdf_file::setd_arr(std::string name, size_t n, const double *d) {
     hsize_t max=H5S_UNLIMITED;
     space=H5Screate_simple(1,&dims,&max);
 
-    // Set chunk with size determined by def_chunk()
-    dcpl=H5Pcreate(H5P_DATASET_CREATE);
-    hsize_t chunk=def_chunk(n);
-    int status2=H5Pset_chunk(dcpl,1,&chunk);
-
-#ifdef O2SCL_HDF5_COMP    
-    if (n>=min_compr_size) {
-      // Compression part
-      if (compr_type==1) {
-	int status3=H5Pset_deflate(dcpl,6);
-      } else if (compr_type==2) {
-	int status3=H5Pset_szip(dcpl,H5_SZIP_NN_OPTION_MASK,16);
-      } else if (compr_type!=0) {
-	O2SCL_ERR2("Invalid compression type in ",
-		   "hdf_file::setd_arr().",exc_einval);
-      }
-    }
-#endif
+    // Set chunk and compression
+    dcpl=make_dcpl(1,&dims,n>=min_compr_size,"setd_arr");
 
     // Create the dataset
     dset=H5Dcreate(current,name.c_str(),H5T_IEEE_F64LE,space,H5P_DEFAULT,
@@ -1600,8 +1663,12 @@ int hdf_file::setd_arr(std::string name, size_t n, const double *d) {
     status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,H5S_ALL,
 		    H5S_ALL,H5P_DEFAULT,d2);
   } else {
-    status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,H5S_ALL,
-		    H5S_ALL,H5P_DEFAULT,d);
+    // Compress in parallel if possible
+    hsize_t dims=n;
+    if (compr_threads<=1 || write_chunks_par(dset,1,&dims,d)!=success) {
+      status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,H5S_ALL,
+		      H5S_ALL,H5P_DEFAULT,d);
+    }
   }
   
   status=H5Dclose(dset);
@@ -1970,9 +2037,12 @@ int hdf_file::getd_arr_compr(std::string name, size_t n, double *d,
     O2SCL_ERR(str.c_str(),exc_einval);
   }
 
-  // Read the data
-  herr_t status=H5Dread(dset,H5T_NATIVE_DOUBLE,H5S_ALL,H5S_ALL,
-			H5P_DEFAULT,d);
+  // Read the data, decompressing in parallel if possible
+  herr_t status;
+  if (n==0 || compr_threads<=1 || read_chunks_par(dset,1,dims,d)!=success) {
+    status=H5Dread(dset,H5T_NATIVE_DOUBLE,H5S_ALL,H5S_ALL,
+		   H5P_DEFAULT,d);
+  }
 
   status=H5Dclose(dset);
 
@@ -2221,12 +2291,15 @@ int hdf_file::getd_vec(std::string name, std::vector<double> &v) {
     // Resize the vector
     v.resize(dims[0]);
     
-    // Read the data directly into the pointer
-    status=H5Dread(dset,H5T_NATIVE_DOUBLE,H5S_ALL,H5S_ALL,
-		   H5P_DEFAULT,&v[0]);
-    if (status<0) {
-      O2SCL_ERR("Could not read dataspace in hdf_file::getd_vec().",
-		exc_einval);
+    // Read the data directly into the pointer, decompressing in
+    // parallel if possible
+    if (compr_threads<=1 || read_chunks_par(dset,1,dims,&v[0])!=success) {
+      status=H5Dread(dset,H5T_NATIVE_DOUBLE,H5S_ALL,H5S_ALL,
+		     H5P_DEFAULT,&v[0]);
+      if (status<0) {
+	O2SCL_ERR("Could not read dataspace in hdf_file::getd_vec().",
+		  exc_einval);
+      }
     }
     
   }
@@ -2843,40 +2916,22 @@ int hdf_file::setd_ten(std::string name,
   // If it doesn't exist, create it
   if (dset<0) {
 
-    // Create dims, chunk, and max arrays
-    hsize_t *chunk=new hsize_t[ndims];
+    // Create max array
     hsize_t *max=new hsize_t[ndims];
     for(size_t k=0;k<ndims;k++) {
       max[k]=H5S_UNLIMITED;
-      chunk[k]=def_chunk(t.get_size(k));
     }
     // Create the dataspace
     space=H5Screate_simple(ndims,dims,max);
     
-    // Set chunk with size determined by def_chunk()
-    dcpl=H5Pcreate(H5P_DATASET_CREATE);
-    int status2=H5Pset_chunk(dcpl,ndims,chunk);
-    
-#ifdef O2SCL_HDF5_COMP    
-    if (t.total_size()>=min_compr_size) {
-      // Compression part
-      if (compr_type==1) {
-	int status3=H5Pset_deflate(dcpl,6);
-      } else if (compr_type==2) {
-	int status3=H5Pset_szip(dcpl,H5_SZIP_NN_OPTION_MASK,16);
-      } else if (compr_type!=0) {
-	O2SCL_ERR2("Invalid compression type in ",
-		   "hdf_file::setd_ten().",exc_einval);
-      }
-    }
-#endif
+    // Set chunk and compression
+    dcpl=make_dcpl(ndims,dims,t.total_size()>=min_compr_size,"setd_ten");
 
     // Create the dataset
     dset=H5Dcreate(current,name.c_str(),H5T_IEEE_F64LE,space,H5P_DEFAULT,
 		   dcpl,H5P_DEFAULT);
     chunk_alloc=true;
 
-    delete[] chunk;
     delete[] max;
 
   } else {
@@ -2900,8 +2955,11 @@ int hdf_file::setd_ten(std::string name,
   for(size_t k=0;k<ndims;k++) zero[k]=0;
   const double *ptr=&t.get(zero);
   int status;
-  status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,H5S_ALL,
-		  H5S_ALL,H5P_DEFAULT,ptr);
+  // Compress in parallel if possible
+  if (compr_threads<=1 || write_chunks_par(dset,ndims,dims,ptr)!=success) {
+    status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,H5S_ALL,
+		    H5S_ALL,H5P_DEFAULT,ptr);
+  }
   
   status=H5Dclose(dset);
   status=H5Sclose(space);
@@ -3153,12 +3211,15 @@ int hdf_file::getd_ten(std::string name,
   for(int k=0;k<ndims;k++) zero[k]=0;
   double *start=&t.get(zero);
 
-  // Read the data
-  herr_t status=H5Dread(dset,H5T_NATIVE_DOUBLE,H5S_ALL,H5S_ALL,
-			H5P_DEFAULT,start);
-  if (status<0) {
-    O2SCL_ERR("Could not read dataspace in hdf_file::getd_ten().",
-	      exc_einval);
+  // Read the data, decompressing in parallel if possible
+  herr_t status;
+  if (compr_threads<=1 || read_chunks_par(dset,ndims,dims,start)!=success) {
+    status=H5Dread(dset,H5T_NATIVE_DOUBLE,H5S_ALL,H5S_ALL,
+		   H5P_DEFAULT,start);
+    if (status<0) {
+      O2SCL_ERR("Could not read dataspace in hdf_file::getd_ten().",
+		exc_einval);
+    }
   }
   
   status=H5Dclose(dset);
@@ -3282,6 +3343,480 @@ int hdf_file::getd_vec_prealloc(std::string name, size_t n, double *d) {
   return 0;
 }
 
+hid_t hdf_file::make_dcpl(int ndims, const hsize_t *dims, bool compress,
+			  std::string func_name) {
+
+  hid_t dcpl=H5Pcreate(H5P_DATASET_CREATE);
+
+  // Set chunk with size determined by chunk_dims or def_chunk()
+  std::vector<hsize_t> chunk(ndims);
+  for(int k=0;k<ndims;k++) {
+    if (chunk_dims.size()==((size_t)ndims) && chunk_dims[k]>0) {
+      chunk[k]=chunk_dims[k];
+    } else {
+      chunk[k]=def_chunk(dims[k]);
+    }
+  }
+  int status2=H5Pset_chunk(dcpl,ndims,&(chunk[0]));
+
+#ifdef O2SCL_HDF5_COMP
+  if (compress) {
+    // Compression part
+    if (compr_type==1) {
+      if (compr_level<0 || compr_level>9) {
+	std::string str="Invalid compression level "+itos(compr_level)+
+	  " in hdf_file::"+func_name+"().";
+	O2SCL_ERR(str.c_str(),exc_einval);
+      }
+      if (compr_shuffle) H5Pset_shuffle(dcpl);
+      int status3=H5Pset_deflate(dcpl,compr_level);
+    } else if (compr_type==2) {
+      if (compr_shuffle) H5Pset_shuffle(dcpl);
+      int status3=H5Pset_szip(dcpl,H5_SZIP_NN_OPTION_MASK,16);
+    } else if (compr_type!=0) {
+      std::string str="Invalid compression type in hdf_file::"+
+	func_name+"().";
+      O2SCL_ERR(str.c_str(),exc_einval);
+    }
+  }
+#endif
+
+  return dcpl;
+}
+
+bool hdf_file::chunk_pipeline(hid_t dset, int ndims, hsize_t *chunk,
+			      int &ishuf, int &idefl, int &level) {
+
+  // Direct chunk I/O skips the type conversion, so the dataset and
+  // the native type must both be little-endian doubles
+  hid_t dtype=H5Dget_type(dset);
+  bool ok=(H5Tequal(dtype,H5T_IEEE_F64LE)>0 &&
+	   H5Tequal(H5T_NATIVE_DOUBLE,H5T_IEEE_F64LE)>0);
+  H5Tclose(dtype);
+  if (!ok) return false;
+
+  hid_t dcpl=H5Dget_create_plist(dset);
+  ok=(H5Pget_layout(dcpl)==H5D_CHUNKED &&
+      H5Pget_chunk(dcpl,ndims,chunk)==ndims);
+
+  // Only a deflate filter, optionally preceded by the shuffle
+  // filter, is supported
+  ishuf=-1;
+  idefl=-1;
+  level=6;
+  int num_filters=H5Pget_nfilters(dcpl);
+  for(int i=0;ok && i<num_filters;i++) {
+    unsigned flags, filter_info, cd_values[8];
+    size_t cd_nelmts=8;
+    H5Z_filter_t filter_type=H5Pget_filter2
+      (dcpl,i,&flags,&cd_nelmts,cd_values,0,0,&filter_info);
+    if (filter_type==H5Z_FILTER_SHUFFLE && i==0) {
+      ishuf=i;
+    } else if (filter_type==H5Z_FILTER_DEFLATE && idefl<0) {
+      idefl=i;
+      if (cd_nelmts>0) level=cd_values[0];
+    } else {
+      ok=false;
+    }
+  }
+  H5Pclose(dcpl);
+  
+  return ok && idefl>=0;
+}
+
+int hdf_file::write_chunks_par(hid_t dset, int ndims, const hsize_t *dims,
+			       const double *d) {
+  
+#ifdef O2SCL_HDF5_DIRECT_CHUNK
+
+  std::vector<hsize_t> chunk(ndims);
+  int ishuf, idefl, level;
+  if (!chunk_pipeline(dset,ndims,&(chunk[0]),ishuf,idefl,level)) {
+    return exc_eunimpl;
+  }
+
+  // Count the chunks
+  std::vector<hsize_t> nch(ndims);
+  size_t n_chunks=1, chunk_size=1;
+  for(int k=0;k<ndims;k++) {
+    nch[k]=(dims[k]+chunk[k]-1)/chunk[k];
+    n_chunks*=nch[k];
+    chunk_size*=chunk[k];
+  }
+  if (n_chunks==0) return exc_eunimpl;
+  size_t n_bytes=chunk_size*sizeof(double);
+
+  // Compress a few chunks per thread at a time, so that the
+  // compressed data is never much larger than a few chunks
+  size_t nthr=compr_threads;
+  if (nthr<1) nthr=1;
+  size_t n_batch=nthr*4;
+  std::vector<std::vector<unsigned char> > out(n_batch);
+  std::vector<hsize_t> offs(n_batch*ndims);
+  int zret=Z_OK;
+  
+  for(size_t i0=0;i0<n_chunks;i0+=n_batch) {
+    
+    size_t i1=std::min(i0+n_batch,n_chunks);
+    
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic) num_threads(nthr)
+#endif
+    for(size_t ic=i0;ic<i1;ic++) {
+
+      hsize_t *off=&(offs[(ic-i0)*ndims]);
+      chunk_offset(ndims,&(nch[0]),&(chunk[0]),ic,off);
+
+      // Copy the chunk into a buffer, padding edge chunks with zeros
+      std::vector<double> buf(chunk_size,0.0);
+      chunk_copy(ndims,dims,&(chunk[0]),off,true,d,&(buf[0]));
+      const unsigned char *raw=(const unsigned char *)&(buf[0]);
+
+      // Apply the shuffle filter
+      std::vector<unsigned char> sh;
+      if (ishuf>=0) {
+	sh.resize(n_bytes);
+	for(size_t i=0;i<chunk_size;i++) {
+	  for(size_t j=0;j<sizeof(double);j++) {
+	    sh[j*chunk_size+i]=raw[i*sizeof(double)+j];
+	  }
+	}
+	raw=&(sh[0]);
+      }
+
+      // Apply the deflate filter
+      std::vector<unsigned char> &o=out[ic-i0];
+      uLongf len=compressBound(n_bytes);
+      o.resize(len);
+      int ret=compress2(&(o[0]),&len,raw,n_bytes,level);
+      if (ret!=Z_OK) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (hdf_file_write_chunks_par)
+#endif
+	zret=ret;
+      }
+      o.resize(len);
+    }
+
+    if (zret!=Z_OK) {
+      O2SCL_ERR2("Compression failed in ",
+		 "hdf_file::write_chunks_par().",exc_efailed);
+    }
+
+    // Write the compressed chunks
+    for(size_t ic=i0;ic<i1;ic++) {
+      herr_t status=H5Dwrite_chunk(dset,H5P_DEFAULT,0,
+				   &(offs[(ic-i0)*ndims]),
+				   out[ic-i0].size(),&(out[ic-i0][0]));
+      if (status<0) {
+	O2SCL_ERR2("Could not write chunk in ",
+		   "hdf_file::write_chunks_par().",exc_efailed);
+      }
+    }
+  }
+  
+  return success;
+
+#else
+
+  return exc_eunimpl;
+
+#endif
+  
+}
+
+int hdf_file::read_chunks_par(hid_t dset, int ndims, const hsize_t *dims,
+			      double *d) {
+  
+#ifdef O2SCL_HDF5_DIRECT_CHUNK
+
+  std::vector<hsize_t> chunk(ndims);
+  int ishuf, idefl, level;
+  if (!chunk_pipeline(dset,ndims,&(chunk[0]),ishuf,idefl,level)) {
+    return exc_eunimpl;
+  }
+
+  // Count the chunks
+  std::vector<hsize_t> nch(ndims);
+  size_t n_chunks=1, chunk_size=1;
+  for(int k=0;k<ndims;k++) {
+    nch[k]=(dims[k]+chunk[k]-1)/chunk[k];
+    n_chunks*=nch[k];
+    chunk_size*=chunk[k];
+  }
+  if (n_chunks==0) return exc_eunimpl;
+  size_t n_bytes=chunk_size*sizeof(double);
+
+  size_t nthr=compr_threads;
+  if (nthr<1) nthr=1;
+  size_t n_batch=nthr*4;
+  std::vector<std::vector<unsigned char> > in(n_batch);
+  std::vector<uint32_t> masks(n_batch);
+  std::vector<hsize_t> offs(n_batch*ndims);
+  int zret=Z_OK;
+  
+  for(size_t i0=0;i0<n_chunks;i0+=n_batch) {
+    
+    size_t i1=std::min(i0+n_batch,n_chunks);
+
+    // Read the compressed chunks
+    for(size_t ic=i0;ic<i1;ic++) {
+      
+      hsize_t *off=&(offs[(ic-i0)*ndims]);
+      chunk_offset(ndims,&(nch[0]),&(chunk[0]),ic,off);
+
+      // Chunks which have not been allocated have no storage
+      hsize_t c_bytes=0;
+      herr_t status;
+      H5E_BEGIN_TRY
+	{
+	  status=H5Dget_chunk_storage_size(dset,off,&c_bytes);
+	} 
+      H5E_END_TRY 
+#ifdef O2SCL_NEVER_DEFINED
+	{
+	}
+#endif
+      if (status<0) c_bytes=0;
+      
+      in[ic-i0].resize(c_bytes);
+      masks[ic-i0]=0;
+      if (c_bytes>0) {
+	status=H5Dread_chunk(dset,H5P_DEFAULT,off,&(masks[ic-i0]),
+			     &(in[ic-i0][0]));
+	if (status<0) {
+	  O2SCL_ERR2("Could not read chunk in ",
+		     "hdf_file::read_chunks_par().",exc_efailed);
+	}
+      }
+    }
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic) num_threads(nthr)
+#endif
+    for(size_t ic=i0;ic<i1;ic++) {
+
+      const std::vector<unsigned char> &c=in[ic-i0];
+      std::vector<double> buf(chunk_size,0.0);
+      
+      if (c.size()>0) {
+	
+	// A set bit in the mask indicates a filter was skipped
+	bool shuffled=(ishuf>=0 && (masks[ic-i0] & (1u << ishuf))==0);
+	bool deflated=((masks[ic-i0] & (1u << idefl))==0);
+	
+	std::vector<unsigned char> sh;
+	unsigned char *raw=(unsigned char *)&(buf[0]);
+	if (shuffled) {
+	  sh.resize(n_bytes);
+	  raw=&(sh[0]);
+	}
+
+	// Undo the deflate filter
+	int ret=Z_OK;
+	if (deflated) {
+	  uLongf len=n_bytes;
+	  ret=uncompress(raw,&len,&(c[0]),c.size());
+	  if (ret==Z_OK && len!=n_bytes) ret=Z_DATA_ERROR;
+	} else if (c.size()==n_bytes) {
+	  std::copy(c.begin(),c.end(),raw);
+	} else {
+	  ret=Z_DATA_ERROR;
+	}
+	if (ret!=Z_OK) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (hdf_file_read_chunks_par)
+#endif
+	  zret=ret;
+	}
+
+	// Undo the shuffle filter
+	if (shuffled && ret==Z_OK) {
+	  unsigned char *ub=(unsigned char *)&(buf[0]);
+	  for(size_t i=0;i<chunk_size;i++) {
+	    for(size_t j=0;j<sizeof(double);j++) {
+	      ub[i*sizeof(double)+j]=sh[j*chunk_size+i];
+	    }
+	  }
+	}
+      }
+
+      chunk_copy(ndims,dims,&(chunk[0]),&(offs[(ic-i0)*ndims]),false,
+		 &(buf[0]),d);
+    }
+    
+    if (zret!=Z_OK) {
+      O2SCL_ERR2("Decompression failed in ",
+		 "hdf_file::read_chunks_par().",exc_efailed);
+    }
+  }
+  
+  return success;
+
+#else
+
+  return exc_eunimpl;
+
+#endif
+  
+}
+
+int hdf_file::get_arr_size(std::string name, size_t &n) {
+
+  hid_t dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+  if (dset<0) {
+    O2SCL_ERR((((std::string)"Could not find dataset '")+name+
+               "' in hdf_file::get_arr_size().").c_str(),exc_enotfound);
+  }
+  
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims[1];
+  int ndims=H5Sget_simple_extent_ndims(space);
+  if (ndims!=1) {
+    O2SCL_ERR2("Dataset is not one-dimensional in ",
+               "hdf_file::get_arr_size().",exc_einval);
+  }
+  H5Sget_simple_extent_dims(space,dims,0);
+  n=dims[0];
+  
+  H5Sclose(space);
+  H5Dclose(dset);
+  
+  return 0;
+}
+
+int hdf_file::getd_arr_hyperslab(std::string name, size_t offset,
+                                 size_t n, double *d) {
+
+  hid_t dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+  if (dset<0) {
+    O2SCL_ERR((((std::string)"Could not find dataset '")+name+
+               "' in hdf_file::getd_arr_hyperslab().").c_str(),
+              exc_enotfound);
+  }
+  
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims[1];
+  int ndims=H5Sget_simple_extent_dims(space,dims,0);
+  if (ndims!=1) {
+    O2SCL_ERR2("Dataset is not one-dimensional in ",
+               "hdf_file::getd_arr_hyperslab().",exc_einval);
+  }
+  if (offset+n>dims[0]) {
+    std::string str="Asked for elements "+szttos(offset)+" to "+
+      szttos(offset+n)+" but dataset has size "+szttos((size_t)dims[0])+
+      " in hdf_file::getd_arr_hyperslab().";
+    O2SCL_ERR(str.c_str(),exc_einval);
+  }
+
+  if (n>0) {
+    
+    // Select the requested elements in the file
+    hsize_t start=offset, count=n;
+    H5Sselect_hyperslab(space,H5S_SELECT_SET,&start,0,&count,0);
+    hid_t mem_space=H5Screate_simple(1,&count,0);
+    
+    herr_t status=H5Dread(dset,H5T_NATIVE_DOUBLE,mem_space,space,
+                          H5P_DEFAULT,d);
+    if (status<0) {
+      O2SCL_ERR2("Could not read dataspace in ",
+                 "hdf_file::getd_arr_hyperslab().",exc_einval);
+    }
+    
+    H5Sclose(mem_space);
+  }
+  
+  H5Sclose(space);
+  H5Dclose(dset);
+  
+  return 0;
+}
+
+int hdf_file::setd_arr_append(std::string name, size_t n, const double *d,
+                              size_t chunk) {
+  
+  if (write_access==false) {
+    O2SCL_ERR2("File not opened with write access in ",
+	       "hdf_file::setd_arr_append().",exc_efailed);
+  }
+
+  hid_t dset;
+  hsize_t old_size=0;
+
+  H5E_BEGIN_TRY
+    {
+      // See if the dataspace already exists first
+      dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+    } 
+  H5E_END_TRY 
+#ifdef O2SCL_NEVER_DEFINED
+    {
+    }
+#endif
+
+  if (dset<0) {
+
+    // Create an empty extendible dataset
+    hsize_t dims=0;
+    hsize_t max=H5S_UNLIMITED;
+    hid_t space=H5Screate_simple(1,&dims,&max);
+    
+    // Use the chunk size from the size of the first block
+    hsize_t first=n;
+    hid_t dcpl=make_dcpl(1,&first,true,"setd_arr_append");
+    if (chunk>0) {
+      hsize_t ch=chunk;
+      H5Pset_chunk(dcpl,1,&ch);
+    }
+
+    dset=H5Dcreate(current,name.c_str(),H5T_IEEE_F64LE,space,H5P_DEFAULT,
+		   dcpl,H5P_DEFAULT);
+    H5Pclose(dcpl);
+    H5Sclose(space);
+    
+  } else {
+    
+    hid_t space=H5Dget_space(dset);  
+    int ndims=H5Sget_simple_extent_dims(space,&old_size,0);
+    H5Sclose(space);
+    if (ndims!=1) {
+      O2SCL_ERR2("Tried to append to a multidimensional dataset in ",
+                 "hdf_file::setd_arr_append().",exc_einval);
+    }
+  }
+
+  if (n>0) {
+    
+    // Extend the dataset and select the new elements
+    hsize_t new_size=old_size+n;
+    herr_t status=H5Dset_extent(dset,&new_size);
+    if (status<0) {
+      H5Dclose(dset);
+      O2SCL_ERR2("Could not extend dataset in ",
+                 "hdf_file::setd_arr_append().",exc_efailed);
+      return exc_efailed;
+    }
+    hid_t space=H5Dget_space(dset);
+    hsize_t start=old_size, count=n;
+    H5Sselect_hyperslab(space,H5S_SELECT_SET,&start,0,&count,0);
+    hid_t mem_space=H5Screate_simple(1,&count,0);
+    
+    status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,mem_space,space,
+                    H5P_DEFAULT,d);
+    if (status<0) {
+      O2SCL_ERR2("Could not write data in ",
+                 "hdf_file::setd_arr_append().",exc_efailed);
+    }
+    
+    H5Sclose(mem_space);
+    H5Sclose(space);
+  }
+  
+  H5Dclose(dset);
+  
+  return 0;
+}
+
 int hdf_file::geti_vec_prealloc(std::string name, size_t n, int *i) {
       
   // See if the dataspace already exists first
@@ -64,7 +64,23 @@ namespace o2scl_hdf {
       By default, vectors and matrices are written to HDF files in a
       chunked format, so their length can be changed later as
       necessary. The chunk size is chosen in \ref def_chunk() to be
-      the closest power of 10 to the current vector size. 
+      the closest power of 10 to the current vector size, unless a
+      chunk shape is specified in \ref chunk_dims. 
+
+      When compression is enabled, the deflate level and the shuffle
+      filter are controlled by \ref compr_level and \ref
+      compr_shuffle. These settings (and \ref chunk_dims) are applied
+      to each new dataset at the time it is created, so they can be
+      changed between calls to the <tt>set</tt> functions to give
+      different datasets different layouts. If \ref compr_threads is
+      larger than one, then double-precision arrays and tensors which
+      use deflate compression are compressed (or decompressed) one
+      chunk at a time by a pool of OpenMP threads and written with
+      HDF5 direct chunk I/O. The resulting files are ordinary HDF5
+      files which can be read with any number of threads. This
+      requires that \o2 is compiled with <tt>O2SCL_HDF5_COMP</tt>,
+      zlib, and HDF5 version 1.10.3 or later, otherwise the usual
+      serial HDF5 filters are used.
 
       All files not closed by the user are closed in the destructor,
       but the destructor does not automatically close groups.
@@ -142,6 +158,55 @@ namespace o2scl_hdf {
     /// If true, then the file has read and write access 
     bool write_access;
     
+    /** \brief Create a dataset creation property list for a new
+	chunked dataset of rank \c ndims and size \c dims
+
+	The chunk shape is taken from \ref chunk_dims if it has rank
+	\c ndims and from \ref def_chunk() otherwise. If \c compress
+	is true, then the filters specified in \ref compr_type, \ref
+	compr_shuffle, and \ref compr_level are added. The string \c
+	func_name is used in error messages.
+    */
+    hid_t make_dcpl(int ndims, const hsize_t *dims, bool compress,
+		    std::string func_name);
+
+    /** \brief Determine if dataset \c dset can be written and read
+	with direct chunk I/O
+
+	If the dataset is a chunked dataset of little-endian doubles
+	with a deflate filter, optionally preceded by a shuffle
+	filter, then this function sets \c chunk to the chunk shape,
+	\c ishuf and \c idefl to the index of the shuffle (or -1 if
+	not present) and deflate filters in the pipeline, \c level to
+	the deflate level, and returns true. Otherwise it returns
+	false.
+    */
+    bool chunk_pipeline(hid_t dset, int ndims, hsize_t *chunk,
+			int &ishuf, int &idefl, int &level);
+    
+    /** \brief Compress the \c ndims dimensional array \c d with
+	size \c dims using \ref compr_threads threads and write it to
+	the dataset \c dset with direct chunk I/O
+
+	If the dataset does not support direct chunk I/O (see \ref
+	chunk_pipeline()), then nothing is written and the value \ref
+	o2scl::exc_eunimpl is returned.
+    */
+    int write_chunks_par(hid_t dset, int ndims, const hsize_t *dims,
+			 const double *d);
+
+    /** \brief Read the dataset \c dset with direct chunk I/O and
+	decompress it into the \c ndims dimensional array \c d with
+	size \c dims using \ref compr_threads threads
+
+	If the dataset does not support direct chunk I/O (see \ref
+	chunk_pipeline()), then nothing is read and the value \ref
+	o2scl::exc_eunimpl is returned. Chunks which were never
+	written are filled with zeros.
+    */
+    int read_chunks_par(hid_t dset, int ndims, const hsize_t *dims,
+			double *d);
+    
 #endif
     
   public:
@@ -161,6 +226,36 @@ namespace o2scl_hdf {
     /// Minimum size to compress by default
     size_t min_compr_size;
 
+    /** \brief Deflate compression level from 0 to 9 (default 6)
+     */
+    int compr_level;
+
+    /** \brief If true, apply the HDF5 shuffle filter before
+	compression (default false)
+
+	The shuffle filter groups the bytes of each element by
+	significance, which often improves the compression of
+	smooth floating-point data at little cost.
+    */
+    bool compr_shuffle;
+    
+    /** \brief Number of threads used to compress and decompress
+	chunks of double-precision datasets (default 1)
+     */
+    size_t compr_threads;
+
+    /** \brief Chunk shape for new datasets (default empty)
+
+	If this vector has the same size as the rank of a new
+	dataset, then its nonzero entries specify the chunk size in
+	each dimension, and the remaining dimensions use \ref
+	def_chunk(). If the rank does not match, this vector is
+	ignored. Note that \ref o2scl::table and \ref
+	o2scl::tensor_grid objects are written as a set of
+	one-dimensional datasets.
+    */
+    std::vector<size_t> chunk_dims;
+
     /// \name Open and close files
     //@{
     /** \brief Open a file named \c fname
@@ -1068,6 +1163,38 @@ namespace o2scl_hdf {
     /// Get an integer matrix \c i pre-allocated to have size <tt>(n,m)</tt>
     int geti_mat_prealloc(std::string name, size_t n, size_t m, int *i);
     //@}
+
+    /** \name Partial I/O for one-dimensional datasets
+
+        These functions read or write part of a one-dimensional
+        double dataset using an HDF5 hyperslab, so that datasets
+        larger than the available memory can be processed in pieces.
+     */
+    //@{
+    /** \brief Get the number of elements in the one-dimensional
+        dataset named \c name
+    */
+    int get_arr_size(std::string name, size_t &n);
+    
+    /** \brief Get \c n elements beginning at index \c offset from
+        the double dataset named \c name, storing them in the
+        pre-allocated array \c d
+    */
+    int getd_arr_hyperslab(std::string name, size_t offset, size_t n,
+                           double *d);
+
+    /** \brief Append the \c n elements in \c d to the end of the
+        double dataset named \c name
+
+        If the dataset does not exist, it is created as an extendible
+        dataset with chunk size \c chunk (or a size chosen from
+        \ref chunk_dims or \ref def_chunk() if \c chunk is zero),
+        and compressed if \ref compr_type is nonzero. Otherwise, the dataset is extended
+        by \c n elements. 
+    */
+    int setd_arr_append(std::string name, size_t n, const double *d,
+                        size_t chunk=0);
+    //@}
     
     /// \name Find a group
     //@{
@@ -837,6 +837,52 @@ int main(void) {
     }
     cout << endl;
 
+    cout << "Test parallel chunk compression: " << endl;
+    {
+      // A tensor with partial chunks at the edges
+      tensor<> ta;
+      size_t sz[3]={7,5,9};
+      ta.resize(3,sz);
+      for(size_t i=0;i<7;i++) {
+	for(size_t j=0;j<5;j++) {
+	  for(size_t k=0;k<9;k++) {
+	    size_t ix[3]={i,j,k};
+	    ta.get(ix)=sin((double)(i*45+j*9+k));
+	  }
+	}
+      }
+      std::vector<double> va(1000);
+      for(size_t i=0;i<1000;i++) va[i]=exp(-((double)i)/300.0);
+
+      hdf_file hf;
+      hf.compr_type=1;
+      hf.compr_level=4;
+      hf.compr_shuffle=true;
+      hf.compr_threads=2;
+      hf.open_or_create("hdf_file_pchunk.o2");
+      hf.chunk_dims={3,2,4};
+      hf.setd_ten("ten",ta);
+      hf.chunk_dims={64};
+      hf.setd_vec("vec",va);
+      hf.close();
+
+      // Read with the parallel and the serial HDF5 filters
+      
+      for(size_t nt=1;nt<=2;nt++) {
+	tensor<> tb;
+	std::vector<double> vb;
+	hf.compr_threads=nt;
+	hf.open("hdf_file_pchunk.o2");
+	hf.getd_ten("ten",tb);
+	hf.getd_vec("vec",vb);
+	hf.close();
+	t.test_rel_vec(ta.total_size(),ta.get_data(),tb.get_data(),
+		       1.0e-15,"parallel compression tensor");
+	t.test_rel_vec(1000,va,vb,1.0e-15,"parallel compression vector");
+      }
+    }
+    cout << endl;
+
   }
 
 #endif
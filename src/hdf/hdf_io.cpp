@@ -474,6 +474,185 @@ void o2scl_hdf::hdf_output_data(hdf_file &hf, o2scl::table<> &t) {
   return;
 }
 
+void o2scl_hdf::hdf_input_table_header(hdf_file &hf, table_units<> &t,
+                                       size_t &nlines, std::string &name) {
+  
+  // If no name specified, find name of first group of specified type
+  if (name.length()==0) {
+    hf.find_object_by_type("table",name);
+    if (name.length()==0) {
+      O2SCL_ERR2("No object of type table found in ",
+                 "o2scl_hdf::hdf_input_table_header().",
+                 o2scl::exc_efailed);
+    }
+  }
+  
+  t.clear_table();
+  t.clear_constants();
+  
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+
+  std::string type2;
+  hf.gets_fixed("o2scl_type",type2);
+  if (type2!="table") {
+    O2SCL_ERR2("Typename in HDF group does not match ",
+               "class in o2scl_hdf::hdf_input_table_header().",
+               o2scl::exc_einval);
+  }
+  
+  std::vector<std::string> cnames, cols;
+  std::vector<double> cvalues;
+  hf.gets_vec("con_names",cnames);
+  hf.getd_vec("con_values",cvalues);
+  if (cnames.size()!=cvalues.size()) {
+    O2SCL_ERR2("Size mismatch between constant names and values ",
+               "in o2scl_hdf::hdf_input_table_header().",o2scl::exc_einval);
+  }
+  for(size_t i=0;i<cnames.size();i++) {
+    t.add_constant(cnames[i],cvalues[i]);
+  }
+
+  hf.gets_vec("col_names",cols);
+  for(size_t i=0;i<cols.size();i++) {
+    t.new_column(cols[i]);
+  }
+
+  int nlines2;
+  hf.geti("nlines",nlines2);
+  nlines=nlines2;
+  
+  size_t itype;
+  hf.get_szt_def("itype",o2scl::itp_cspline,itype);
+  t.set_interp_type(itype);
+
+  int uf;
+  hf.geti_def("unit_flag",0,uf);
+  if (uf>0) {
+    std::vector<std::string> units;
+    hf.gets_vec("units",units);
+    for(size_t i=0;i<units.size() && i<cols.size();i++) {
+      t.set_unit(cols[i],units[i]);
+    }
+  }
+  
+  hf.close_group(group);
+  hf.set_current_id(top);
+  
+  return;
+}
+
+void o2scl_hdf::hdf_input_table_rows(hdf_file &hf, table_units<> &t,
+                                     std::string name, size_t row,
+                                     size_t n) {
+  
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+  hid_t group2=hf.open_group("data");
+  hf.set_current_id(group2);
+
+  t.set_nlines(n);
+  
+  // Read each column directly into a vector of the right size and
+  // then swap it into the table
+  std::vector<double> col;
+  for(size_t i=0;i<t.get_ncolumns();i++) {
+    col.resize(t.get_maxlines());
+    if (n>0) {
+      hf.getd_arr_hyperslab(t.get_column_name(i),row,n,&(col[0]));
+    }
+    t.swap_column_data(t.get_column_name(i),col);
+  }
+  
+  hf.close_group(group2);
+  hf.close_group(group);
+  hf.set_current_id(top);
+  
+  return;
+}
+
+void o2scl_hdf::hdf_output_table_header(hdf_file &hf, table_units<> &t,
+                                        std::string name) {
+
+  if (hf.has_write_access()==false) {
+    O2SCL_ERR2("File not opened with write access in ",
+               "hdf_output_table_header().",exc_efailed);
+  }
+  
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+  
+  hf.sets_fixed("o2scl_type","table");
+  
+  std::vector<std::string> cnames, cols, units;
+  std::vector<double> cvalues;
+  for(size_t i=0;i<t.get_nconsts();i++) {
+    std::string cname;
+    double val;
+    t.get_constant(i,cname,val);
+    cnames.push_back(cname);
+    cvalues.push_back(val);
+  }
+  hf.sets_vec("con_names",cnames);
+  hf.setd_vec("con_values",cvalues);
+  
+  for(size_t i=0;i<t.get_ncolumns();i++) {
+    cols.push_back(t.get_column_name(i));
+    units.push_back(t.get_unit(t.get_column_name(i)));
+  }
+  hf.sets_vec("col_names",cols);
+  
+  hf.seti("nlines",0);
+  hf.set_szt("itype",t.get_interp_type());
+  
+  hf.seti("unit_flag",1);
+  hf.sets_vec("units",units);
+
+  // Create the empty data group
+  hid_t group2=hf.open_group("data");
+  hf.close_group(group2);
+  
+  hf.close_group(group);
+  hf.set_current_id(top);
+  
+  return;
+}
+
+void o2scl_hdf::hdf_output_table_rows(hdf_file &hf, table_units<> &t,
+                                      std::string name, size_t chunk) {
+  
+  hid_t top=hf.get_current_id();
+  hid_t group=hf.open_group(name);
+  hf.set_current_id(group);
+
+  int nlines_old;
+  hf.geti("nlines",nlines_old);
+  
+  hid_t group2=hf.open_group("data");
+  hf.set_current_id(group2);
+
+  if (t.get_nlines()>0) {
+    for(size_t i=0;i<t.get_ncolumns();i++) {
+      const std::vector<double> &col=t.get_column(t.get_column_name(i));
+      hf.setd_arr_append(t.get_column_name(i),t.get_nlines(),&(col[0]),
+                         chunk);
+    }
+  }
+  
+  hf.close_group(group2);
+  hf.set_current_id(group);
+  
+  hf.seti("nlines",nlines_old+((int)t.get_nlines()));
+  
+  hf.close_group(group);
+  hf.set_current_id(top);
+  
+  return;
+}
+
 void o2scl_hdf::hdf_output(hdf_file &hf, hist &h, std::string name) {
   
   if (hf.has_write_access()==false) {
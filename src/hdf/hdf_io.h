@@ -372,6 +372,53 @@ namespace o2scl_hdf {
 
     return;
   }
+
+  /** \name Row-by-row I/O for large tables
+
+      These functions allow a table stored in a \ref hdf_file to be
+      read or written a block of rows at a time, so that the full
+      table never needs to be in memory. 
+  */
+  //@{
+  /** \brief Input the constants, column names, and units of a
+      table named \c name without reading the data, and set \c
+      nlines to the number of rows in the file
+
+      If \c name is empty, it is set to the name of the first table
+      in the file. The table \c t is left with zero rows.
+  */
+  void hdf_input_table_header(hdf_file &hf, o2scl::table_units<> &t,
+                              size_t &nlines, std::string &name);
+  
+  /** \brief Input \c n rows beginning with row \c row from all 
+      of the columns of the table named \c name
+
+      The table \c t must already contain the columns from the
+      file, e.g. from \ref hdf_input_table_header(). After this
+      function returns, \c t has \c n rows.
+  */
+  void hdf_input_table_rows(hdf_file &hf, o2scl::table_units<> &t,
+                            std::string name, size_t row, size_t n);
+
+  /** \brief Output the constants, column names, and units of
+      table \c t to an empty table named \c name
+
+      Rows are then added with \ref hdf_output_table_rows().
+  */
+  void hdf_output_table_header(hdf_file &hf, o2scl::table_units<> &t,
+                               std::string name);
+  
+  /** \brief Append the rows of table \c t to the end of the table
+      named \c name
+
+      The columns of \c t must be the same as those given to 
+      \ref hdf_output_table_header(). The column datasets are
+      created with chunk size \c chunk, or with a size chosen by
+      \ref hdf_file::def_chunk() if \c chunk is zero.
+  */
+  void hdf_output_table_rows(hdf_file &hf, o2scl::table_units<> &t,
+                             std::string name, size_t chunk=0);
+  //@}
   
   /// Output a \ref o2scl::hist object to a \ref hdf_file
   void hdf_output(hdf_file &hf, o2scl::hist &h, std::string name);
@@ -24,12 +24,16 @@
 #include <config.h>
 #endif
 
+#include <cstdio>
+
 #include <o2scl/hdf_io.h>
+#include <o2scl/acolm.h>
 #include <o2scl/test_mgr.h>
 
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_hdf;
+using namespace o2scl_acol;
 
 int main(void) {
 
@@ -97,6 +101,112 @@ int main(void) {
     t.test_gen(tab.get_unit("a")==tab2.get_unit("a"),"unit");
   }
 
+  // Test of table I/O in blocks of rows
+  {
+    table_units<> tab, tab2, head, rows;
+    tab.add_constant("pi",acos(-1.0));
+    tab.line_of_names("a b c");
+    tab.set_unit("b","cm");
+    for(size_t i2=0;i2<25;i2++) {
+      double d=((double)i2);
+      double line[3]={d,sin(d),cos(d)};
+      tab.line_of_data(3,line);
+    }
+
+    // Write the table in blocks of 10 rows to a new file, since
+    // the rows would otherwise be appended to those from a
+    // previous run
+    std::remove("table_rows.o2");
+    hdf_file hf;
+    hf.open_or_create("table_rows.o2");
+    hdf_output_table_header(hf,tab,"table_test");
+    for(size_t j=0;j<tab.get_nlines();j+=10) {
+      size_t n=tab.get_nlines()-j;
+      if (n>10) n=10;
+      rows=tab;
+      if (j+n<tab.get_nlines()) {
+        rows.delete_rows_ends(j+n,tab.get_nlines()-1);
+      }
+      if (j>0) rows.delete_rows_ends(0,j-1);
+      hdf_output_table_rows(hf,rows,"table_test",4);
+    }
+    hf.close();
+
+    // Read it back all at once
+    hf.open("table_rows.o2");
+    std::string name_temp="table_test";
+    hdf_input(hf,tab2,name_temp);
+    t.test_gen(tab2.get_nlines()==25,"rows lines");
+    t.test_gen(tab2.get_nconsts()==1,"rows consts");
+    t.test_gen(tab2.get_unit("b")=="cm","rows unit");
+    t.test_rel(tab2.get("c",23),cos(23.0),1.0e-14,"rows data");
+
+    // Read it back in blocks of rows
+    size_t nlines;
+    name_temp="";
+    hdf_input_table_header(hf,head,nlines,name_temp);
+    t.test_gen(name_temp=="table_test","rows name");
+    t.test_gen(nlines==25,"rows header lines");
+    t.test_gen(head.get_ncolumns()==3,"rows header cols");
+    hdf_input_table_rows(hf,head,name_temp,20,5);
+    t.test_gen(head.get_nlines()==5,"rows block");
+    t.test_rel(head.get("b",2),sin(22.0),1.0e-14,"rows block data");
+    hf.close();
+  }
+
+  // Test of the acol 'stream' command
+  {
+    table_units<> tab, tab2;
+    tab.line_of_names("x");
+    for(size_t i2=0;i2<25;i2++) {
+      double line[1]={((double)i2)};
+      tab.line_of_data(1,line);
+    }
+
+    // Remove the files from a previous run
+    std::remove("stream_in.o2");
+    std::remove("stream_out.o2");
+    std::remove("stream_out2.o2");
+    
+    hdf_file hf;
+    hf.open_or_create("stream_in.o2");
+    hdf_output(hf,tab,"stream_test");
+    hf.close();
+
+    acol_manager am;
+    am.run(0,0,false);
+
+    // The current table should be unchanged by 'stream'
+    am.table_obj.line_of_names("current");
+    am.type="table";
+    
+    vector<string> sv={"stream","stream_in.o2","stream_test","function",
+                       "stream_out.o2","2*x","y"};
+    int ret=am.comm_stream(sv,false);
+    t.test_gen(ret==0,"stream function");
+    t.test_gen(am.type=="table","stream type");
+    t.test_gen(am.table_obj.is_column("current"),"stream table");
+
+    hf.open("stream_out.o2");
+    std::string name_temp="stream_test";
+    hdf_input(hf,tab2,name_temp);
+    hf.close();
+    t.test_gen(tab2.get_nlines()==25,"stream lines");
+    t.test_rel(tab2.get("y",24),48.0,1.0e-14,"stream data");
+
+    // The current table should also be restored when the command
+    // applied to the blocks fails
+    vector<string> sv2={"stream","stream_in.o2","stream_test","function",
+                        "stream_out2.o2","*x","y"};
+    try {
+      am.comm_stream(sv2,false);
+    } catch (std::exception &e) {
+      err_hnd->reset();
+    }
+    t.test_gen(am.type=="table","stream fail type");
+    t.test_gen(am.table_obj.is_column("current"),"stream fail table");
+  }
+
   // Tests for vector_spec()
   std::vector<double> v=vector_spec("list:1,2,3,4");
   t.test_gen(v.size()==4,"vector_spec().");
@@ -58,6 +58,12 @@ cpp_dec_float_50 test_func_2_cdf(cpp_dec_float_50 x) {
   return exp(-x*x);
 }
 
+dd_real test_func_1_dd(dd_real x) {
+  dd_real one=1;
+  dd_real hundred=100;
+  return -sin(one/(x+one/hundred))/(x+one/hundred)/(x+one/hundred);
+}
+
 int main(void) {
 
   cout.setf(ios::scientific);
@@ -176,6 +182,20 @@ int main(void) {
   t.test_rel_boost<cpp_dec_float_50>(ans_cdf,exact_cdf,1.0e-40,
 				     "tanh_sinh test cdf");
   cout << endl;
+
+  // Finite integral, moderately difficult integrand
+  cout << "tanh-sinh, finite interval, dd_real:" << endl;
+  funct_dd tf1_dd=test_func_1_dd;
+  inte_tanh_sinh_boost<funct_dd,61,dd_real> itsb_dd;
+  dd_real one_dd=1;
+  dd_real hundred_dd=100;
+  dd_real exact_dd=cos(hundred_dd)-cos(one_dd/(one_dd+one_dd/hundred_dd));
+  dd_real ans_dd, err_dd;
+  itsb_dd.integ_err(tf1_dd,0.0,1.0,ans_dd,err_dd);
+  std::cout << ans_dd << " " << err_dd << " " << exact_dd << " "
+	    << itsb_dd.L1norm << std::endl;
+  t.test_rel_boost<dd_real>(ans_dd,exact_dd,1.0e-28,"tanh_sinh test dd");
+  cout << endl;
   
   t.report();
   return 0;
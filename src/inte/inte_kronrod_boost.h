@@ -28,6 +28,8 @@
 */
 
 #include <cmath>
+#include <vector>
+#include <limits>
 
 #include <boost/math/quadrature/gauss_kronrod.hpp>
 
@@ -91,8 +93,157 @@ namespace o2scl {
     return 0;
   }
   
+  /** \brief Integrate the batch function \c func from \c a to \c b
+      and place the result in \c res and the error in \c err
+
+      This function uses the same recursive bisection algorithm as
+      <tt>boost::math::quadrature::gauss_kronrod::integrate()</tt>,
+      but calls \c func only once for each panel, with all \c rule
+      abscissae, in the form <tt>func(n,x,y)</tt>. The value \c n is
+      the number of abscissae, \c x is a pointer to the abscissae, and
+      \c y is a pointer to the array in which the function values
+      should be stored. The limits \c a and \c b must be finite.
+  */
+  template<class bfunc_t>
+  int integ_err_batch(bfunc_t &func, fp_t a, fp_t b, 
+                      fp_t &res, fp_t &err) {
+    
+    if (!(boost::math::isfinite)(a) || !(boost::math::isfinite)(b)) {
+      O2SCL_ERR2("Infinite limits not supported in ",
+                 "inte_kronrod_boost::integ_err_batch().",
+                 o2scl::exc_einval);
+    }
+    
+    x_batch.resize(rule);
+    f_batch.resize(rule);
+    
+    err=0;
+    L1norm=0;
+    if (a==b) {
+      res=0;
+    } else if (b<a) {
+      res=-batch_recursive(func,b,a,max_depth,0,&err,&L1norm);
+    } else {
+      res=batch_recursive(func,a,b,max_depth,0,&err,&L1norm);
+    }
+    
+    if (err>this->tol_rel) {
+      O2SCL_ERR2("Failed to achieve tolerance in ",
+		 "inte_kronrod_boost::integ_err_batch().",
+                 o2scl::exc_efailed);
+    }
+    return 0;
+  }
+  
   /// L1 norm
   fp_t L1norm;
+
+#ifndef DOXYGEN_INTERNAL
+  
+  protected:
+  
+  /// Abscissae for the batch integrand
+  std::vector<fp_t> x_batch;
+  
+  /// Function values from the batch integrand
+  std::vector<fp_t> f_batch;
+
+  /** \brief Apply the Gauss-Kronrod rule to the interval
+      \f$ [a,b] \f$ with a single call to the batch function
+  */
+  template<class bfunc_t>
+  fp_t batch_panel(bfunc_t &func, fp_t a, fp_t b,
+                   fp_t &error, fp_t &L1) {
+
+    using std::abs;
+    
+    typedef boost::math::quadrature::gauss_kronrod<fp_t,rule> gk_t;
+    typedef boost::math::quadrature::gauss<fp_t,(rule-1)/2> g_t;
+    
+    const auto &abscissa=gk_t::abscissa();
+    const auto &weights=gk_t::weights();
+    const auto &gauss_weights=g_t::weights();
+    size_t n_abs=abscissa.size();
+    
+    fp_t mean=(b+a)/2;
+    fp_t scale=(b-a)/2;
+
+    // Evaluate the function at the center and at the pairs
+    // of points on either side of the center
+    x_batch[0]=mean;
+    for(size_t i=1;i<n_abs;i++) {
+      x_batch[2*i-1]=scale*abscissa[i]+mean;
+      x_batch[2*i]=-scale*abscissa[i]+mean;
+    }
+    func(rule,(const fp_t *)&(x_batch[0]),&(f_batch[0]));
+
+    // Combine the function values as in boost
+    size_t gauss_start=2;
+    size_t kronrod_start=1;
+    size_t gauss_order=(rule-1)/2;
+    fp_t kronrod_result=f_batch[0]*weights[0];
+    fp_t gauss_result=0;
+    if (gauss_order & 1) {
+      gauss_result+=f_batch[0]*gauss_weights[0];
+    } else {
+      gauss_start=1;
+      kronrod_start=2;
+    }
+    L1=abs(kronrod_result);
+    for(size_t i=gauss_start;i<n_abs;i+=2) {
+      fp_t fp=f_batch[2*i-1];
+      fp_t fm=f_batch[2*i];
+      kronrod_result+=(fp+fm)*weights[i];
+      L1+=(abs(fp)+abs(fm))*weights[i];
+      gauss_result+=(fp+fm)*gauss_weights[i/2];
+    }
+    for(size_t i=kronrod_start;i<n_abs;i+=2) {
+      fp_t fp=f_batch[2*i-1];
+      fp_t fm=f_batch[2*i];
+      kronrod_result+=(fp+fm)*weights[i];
+      L1+=(abs(fp)+abs(fm))*weights[i];
+    }
+    
+    error=abs(kronrod_result-gauss_result);
+    fp_t err_min=abs(kronrod_result*
+                     std::numeric_limits<fp_t>::epsilon()*2);
+    if (error<err_min) error=err_min;
+    
+    return kronrod_result;
+  }
+  
+  /** \brief Recursive adaptive integration for a batch function
+   */
+  template<class bfunc_t>
+  fp_t batch_recursive(bfunc_t &func, fp_t a, fp_t b, size_t levels,
+                       fp_t abs_tol, fp_t *error, fp_t *L1) {
+    
+    using std::abs;
+    
+    fp_t error_local;
+    fp_t scale=(b-a)/2;
+    fp_t estimate=scale*batch_panel(func,a,b,error_local,*L1);
+    
+    fp_t abs_tol1=abs(estimate*this->tol_rel);
+    if (abs_tol==0) abs_tol=abs_tol1;
+    
+    if (levels>0 && abs_tol1<error_local && abs_tol<error_local) {
+      fp_t mid=(a+b)/2;
+      fp_t L1_local;
+      estimate=batch_recursive(func,a,mid,levels-1,abs_tol/2,error,L1);
+      estimate+=batch_recursive(func,mid,b,levels-1,abs_tol/2,
+                                &error_local,&L1_local);
+      *error+=error_local;
+      *L1+=L1_local;
+      return estimate;
+    }
+    
+    *L1*=scale;
+    *error=error_local;
+    return estimate;
+  }
+
+#endif
   
   };
   
@@ -66,6 +66,25 @@ int main(void) {
     t.test_rel(ans,exact,1.0e-8,"qag test");
   }
 
+  {
+    inte_kronrod_boost<funct,61> ikb;
+    
+    double ans, ans2, err, err2;
+    
+    funct tf=test_func;
+    funct_batch tfb=[](size_t n, const double *x, double *y) {
+      for(size_t i=0;i<n;i++) y[i]=test_func(x[i]);
+    };
+    
+    // Compare the batch integrand with the scalar integrand
+    ikb.integ_err(tf,0.0,1.0,ans,err);
+    ikb.integ_err_batch(tfb,0.0,1.0,ans2,err2);
+    t.test_rel(ans,ans2,1.0e-14,"batch");
+    t.test_rel(err,err2,1.0e-10,"batch err");
+    ikb.integ_err_batch(tfb,1.0,0.0,ans2,err2);
+    t.test_rel(-ans,ans2,1.0e-14,"batch reversed");
+  }
+
   {
     inte_kronrod_boost<funct_ld,61,long double> ikb;
     
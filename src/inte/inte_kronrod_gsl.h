@@ -642,6 +642,12 @@ namespace o2scl {
     /// Scratch space
     double *f_v2;
 
+    /// Abscissas for the batch integrand
+    double *x_batch;
+
+    /// Function values from the batch integrand
+    double *f_batch;
+
   public:
 
     inte_kronrod_gsl() {
@@ -657,6 +663,8 @@ namespace o2scl {
       if (n_gk>0) {
         delete[] f_v1;
         delete[] f_v2;
+        delete[] x_batch;
+        delete[] f_batch;
       }
     }
 
@@ -697,6 +705,8 @@ namespace o2scl {
       if (n_gk > 0) {
         delete[] f_v1;
         delete[] f_v2;
+        delete[] x_batch;
+        delete[] f_batch;
       }
 
       switch (rule) {
@@ -743,6 +753,8 @@ namespace o2scl {
 
       f_v1=new double[n_gk];
       f_v2=new double[n_gk];
+      x_batch=new double[2*n_gk-1];
+      f_batch=new double[2*n_gk-1];
 
       return;
     }
@@ -886,6 +898,99 @@ namespace o2scl {
       return;
     }
 
+    /** \brief The Gauss-Kronrod integration function for a batch
+        integrand
+        
+        This function performs the same computation as \ref
+        gauss_kronrod_base(), except that the integrand is evaluated
+        at all \f$ 2m+1 \f$ abscissae of the rule with a single call
+        of the form <tt>func(n,x,y)</tt>, where \c n is the number of
+        abscissae, \c x is a pointer to the abscissae and \c y is a
+        pointer to the array in which the function values are to be
+        stored. The abscissae are ordered with the center of the
+        interval first, followed by pairs of points to the left and
+        right of the center. The sums are performed in the same order
+        as in \ref gauss_kronrod_base(), so the results are identical.
+
+        This function never calls the error handler.
+    */
+    template<class bfunc_t> void gauss_kronrod_batch
+    (bfunc_t &func, double a, double b, double *result, 
+     double *abserr, double *resabs, double *resasc) {
+	
+      const double center=0.5*(a+b);
+      const double half_length=0.5*(b-a);
+      const double abs_half_length=fabs (half_length);
+
+      // Construct all of the abscissae and evaluate the function
+      const size_t n_batch=2*this->n_gk-1;
+      this->x_batch[0]=center;
+      for (int j=0; j < this->n_gk-1; j++) {
+        const double abscissa=half_length*this->x_gk[j];
+        this->x_batch[2*j+1]=center-abscissa;
+        this->x_batch[2*j+2]=center+abscissa;
+      }
+      func(n_batch,(const double *)this->x_batch,this->f_batch);
+      
+      const double f_center=this->f_batch[0];
+      for (int j=0; j < this->n_gk-1; j++) {
+        this->f_v1[j]=this->f_batch[2*j+1];
+        this->f_v2[j]=this->f_batch[2*j+2];
+      }
+	  
+      double result_gauss=0.0;
+      double result_kronrod=f_center*this->w_gk[this->n_gk-1];
+ 
+      double result_abs=fabs (result_kronrod);
+      double result_asc=0.0;
+      double mean=0.0, err=0.0;
+      
+      if (this->n_gk % 2 == 0) {
+        result_gauss=f_center*this->w_g[this->n_gk / 2-1];
+      }
+      
+      for (int j=0; j < (this->n_gk-1) / 2; j++) {
+        const int jtw=j*2+1;        
+        const double fsum=this->f_v1[jtw]+this->f_v2[jtw];
+        result_gauss+=this->w_g[j]*fsum;
+        result_kronrod+=this->w_gk[jtw]*fsum;
+        result_abs+=this->w_gk[jtw]*(fabs(this->f_v1[jtw])+
+                                     fabs(this->f_v2[jtw]));
+      }
+      
+      for (int j=0; j < this->n_gk / 2; j++) {
+        int jtwm1=j*2;
+        result_kronrod+=this->w_gk[jtwm1]*(this->f_v1[jtwm1]+
+                                           this->f_v2[jtwm1]);
+        result_abs+=this->w_gk[jtwm1]*(fabs(this->f_v1[jtwm1])+
+                                       fabs(this->f_v2[jtwm1]));
+      }
+      
+      mean=result_kronrod*0.5;
+      
+      result_asc=this->w_gk[this->n_gk-1]*fabs(f_center-mean);
+	
+      for (int j=0;j<this->n_gk-1;j++) {
+        result_asc+=this->w_gk[j]*(fabs(this->f_v1[j]-mean)+
+                                   fabs(this->f_v2[j]-mean));
+      }
+      
+      /* Scale by the width of the integration region */
+      
+      err=(result_kronrod-result_gauss)*half_length;
+      
+      result_kronrod*=half_length;
+      result_abs*=abs_half_length;
+      result_asc*=abs_half_length;
+      
+      *result=result_kronrod;
+      *resabs=result_abs;
+      *resasc=result_asc;
+      *abserr=rescale_error(err,result_abs,result_asc);
+
+      return;
+    }
+
     /** \brief Integration wrapper for user-specified function type
      */
     virtual void gauss_kronrod
@@ -98,6 +98,29 @@ namespace o2scl {
     return qag(func,a,b,this->tol_abs,this->tol_rel,&res,&err);
   }
 
+  /** \brief Integrate the batch function \c func from \c a to \c b
+      and place the result in \c res and the error in \c err
+
+      The function \c func is called once for each Gauss-Kronrod
+      panel with all of the abscissae of the rule, in the form
+      <tt>func(n,x,y)</tt> described in \ref
+      o2scl::inte_kronrod_gsl::gauss_kronrod_batch(). Any type with
+      this calling convention, for example \ref o2scl::funct_batch,
+      can be used. Integrands which are cheap to evaluate can
+      then be vectorized over the abscissae of each panel. Apart from
+      the function calls, the adaptive algorithm is identical to that
+      used by \ref integ_err().
+  */
+  template<class bfunc_t>
+  int integ_err_batch(bfunc_t &func, double a, double b, 
+                      double &res, double &err) {
+    auto gk=[this,&func](double a1, double b1, double *r, double *e,
+                         double *rabs, double *rasc) {
+      this->gauss_kronrod_batch(func,a1,b1,r,e,rabs,rasc);
+    };
+    return qag_base(gk,a,b,this->tol_abs,this->tol_rel,&res,&err);
+  }
+
 #ifndef DOXYGEN_INTERNAL
 
   protected:
@@ -110,6 +133,24 @@ namespace o2scl {
   int qag(func_t &func, const double a, const double b, 
 	  const double l_epsabs, const double l_epsrel, 
 	  double *result, double *abserr) {
+    auto gk=[this,&func](double a1, double b1, double *r, double *e,
+                         double *rabs, double *rasc) {
+      this->gauss_kronrod(func,a1,b1,r,e,rabs,rasc);
+    };
+    return qag_base(gk,a,b,l_epsabs,l_epsrel,result,abserr);
+  }
+  
+  /** \brief Perform an adaptive integration using the 
+      Gauss-Kronrod rule evaluator \c gk
+
+      The object \c gk is called as <tt>gk(a,b,&result,&abserr,
+      &resabs,&resasc)</tt> to apply the Gauss-Kronrod rule to 
+      the interval \f$ [a,b] \f$ .
+  */
+  template<class rule_t>
+  int qag_base(rule_t &gk, const double a, const double b, 
+               const double l_epsabs, const double l_epsrel, 
+               double *result, double *abserr) {
     
     double area, errsum;
     double result0, abserr0, resabs0, resasc0;
@@ -139,7 +180,7 @@ namespace o2scl {
 	
     /* perform the first integration */
     
-    this->gauss_kronrod(func,a,b,&result0,&abserr0,&resabs0,&resasc0);
+    gk(a,b,&result0,&abserr0,&resabs0,&resasc0);
     
     this->w->set_initial_result(result0,abserr0);
       
@@ -210,8 +251,8 @@ namespace o2scl {
       a2 = b1;
       b2 = b_i;
       
-      this->gauss_kronrod(func,a1,b1,&area1,&error1,&resabs1,&resasc1);
-      this->gauss_kronrod(func,a2,b2,&area2,&error2,&resabs2,&resasc2);
+      gk(a1,b1,&area1,&error1,&resabs1,&resasc1);
+      gk(a2,b2,&area2,&error2,&resabs2,&resasc2);
       
       area12 = area1 + area2;
       error12 = error1 + error2;
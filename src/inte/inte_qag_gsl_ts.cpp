@@ -77,6 +77,24 @@ int main(void) {
   exact=cos(100.0)-cos(1/1.01);
   t.test_rel(ans,exact,1.0e-8,"qag test");
 
+  // Compare the batch integrand with the scalar integrand
+  {
+    funct_batch tf2b=[](size_t n, const double *x, double *y) {
+      for(size_t i=0;i<n;i++) y[i]=test_func_1(x[i]);
+    };
+    double res_s, err_s, res_b, err_b;
+    for(int rule=1;rule<=6;rule++) {
+      it1.set_rule(rule);
+      it1.integ_err(tf2,0.0,1.0,res_s,err_s);
+      size_t iter_s=it1.last_iter;
+      it1.integ_err_batch(tf2b,0.0,1.0,res_b,err_b);
+      t.test_gen(res_s==res_b,"batch result");
+      t.test_gen(err_s==err_b,"batch error");
+      t.test_gen(iter_s==it1.last_iter,"batch iterations");
+    }
+    it1.set_rule(1);
+  }
+  
   // Compare with the GSL result for the same integral
   {
     double result, error;
@@ -161,6 +161,92 @@ namespace o2scl_linalg {
     return 0;
   }
 
+  /** \brief Extend a Cholesky decomposition with additional rows
+      and columns
+
+      On input, the first \c M rows and columns of \c A should
+      contain the result of \ref cholesky_decomp() for a symmetric
+      positive-definite matrix, and the lower triangular part and
+      diagonal of the next \c K rows should contain the new rows of
+      that matrix. On output, the first <tt>M+K</tt> rows and columns
+      of \c A contain the Cholesky decomposition of the full matrix in
+      the same form as \ref cholesky_decomp(). This requires \f$
+      {\cal O}(K M^2) \f$ operations rather than the \f$ {\cal
+      O}((M+K)^3) \f$ operations required to decompose the full
+      matrix.
+
+      If the new matrix is not positive-definite, the error handler
+      will be called, unless \c err_on_fail is false, in which case a
+      non-zero value will be returned.
+  */
+  template<class mat_t> int cholesky_decomp_append
+    (const size_t M, const size_t K, mat_t &A, bool err_on_fail=true) {
+
+    for(size_t k=M;k<M+K;k++) {
+      
+      double A_kk=O2SCL_IX2(A,k,k);
+      
+      for(size_t i=0;i<k;i++) {
+	double sum=0.0;
+	for(size_t j=0;j<i;j++) {
+	  sum+=O2SCL_IX2(A,i,j)*O2SCL_IX2(A,k,j);
+	}
+	O2SCL_IX2(A,k,i)=(O2SCL_IX2(A,k,i)-sum)/O2SCL_IX2(A,i,i);
+      }
+      
+      double sum=dnrm2_subrow(A,k,0,k);
+      double diag=A_kk-sum*sum;
+      
+      if (diag<=0.0) {
+	if (err_on_fail) {
+	  O2SCL_ERR2("Matrix not positive definite (diag<=0) in ",
+		     "cholesky_decomp_append().",o2scl::exc_einval);
+	} else {
+	  return 1;
+	}
+      }
+      
+      O2SCL_IX2(A,k,k)=sqrt(diag);
+      
+      for(size_t i=0;i<k;i++) {
+	O2SCL_IX2(A,i,k)=O2SCL_IX2(A,k,i);
+      }
+    }
+    
+    return 0;
+  }
+
+  /** \brief Update a Cholesky decomposition after a rank-one
+      update of the original matrix
+
+      Given the Cholesky decomposition of a matrix \f$ A \f$ in \c
+      LLT, in the form produced by \ref cholesky_decomp(), this
+      function computes the decomposition of \f$ A + v v^{T} \f$
+      using a sequence of Givens rotations in \f$ {\cal O}(N^2) \f$
+      operations. The vector \c v is destroyed.
+  */
+  template<class mat_t, class vec_t>
+    void cholesky_update_rank1(const size_t N, mat_t &LLT, vec_t &v) {
+
+    for(size_t j=0;j<N;j++) {
+      
+      double L_jj=O2SCL_IX2(LLT,j,j);
+      double r=hypot(L_jj,O2SCL_IX(v,j));
+      double c=r/L_jj;
+      double s=O2SCL_IX(v,j)/L_jj;
+      O2SCL_IX2(LLT,j,j)=r;
+      
+      for(size_t i=j+1;i<N;i++) {
+	double L_ij=(O2SCL_IX2(LLT,i,j)+s*O2SCL_IX(v,i))/c;
+	O2SCL_IX(v,i)=c*O2SCL_IX(v,i)-s*L_ij;
+	O2SCL_IX2(LLT,i,j)=L_ij;
+	O2SCL_IX2(LLT,j,i)=L_ij;
+      }
+    }
+    
+    return;
+  }
+
   /** \brief Compute the determinant of a matrix from its Cholesky decomposition
       
   */
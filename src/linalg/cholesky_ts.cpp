@@ -152,6 +152,41 @@ int main(void) {
 
   }
 
+  {
+    using namespace o2scl_linalg;
+
+    // A symmetric positive-definite matrix
+    ubmatrix am(6,6), om1(6,6), om2(6,6);
+    for(size_t i=0;i<6;i++) {
+      for(size_t j=0;j<6;j++) {
+        am(i,j)=1.0/(1.0+i+j);
+        if (i==j) am(i,j)+=1.0;
+      }
+    }
+    om1=am;
+    cholesky_decomp(6,om1);
+
+    // Decompose the leading 4x4 block and then append two rows
+    om2=am;
+    cholesky_decomp(4,om2);
+    cholesky_decomp_append(4,2,om2);
+    t.test_rel_mat(6,6,om2,om1,1.0e-13,"cholesky append");
+
+    // Rank-one update
+    ubvector v(6);
+    for(size_t i=0;i<6;i++) {
+      v[i]=sin(1.0+i);
+    }
+    for(size_t i=0;i<6;i++) {
+      for(size_t j=0;j<6;j++) {
+        om2(i,j)=am(i,j)+v[i]*v[j];
+      }
+    }
+    cholesky_decomp(6,om2);
+    cholesky_update_rank1(6,om1,v);
+    t.test_rel_mat(6,6,om1,om2,1.0e-13,"cholesky rank-one update");
+  }
+
   t.report();
   return 0;
 }
@@ -334,8 +334,10 @@ namespace o2scl {
     /** \brief If non-zero, use as the seed for the random number 
         generator (default 0)
 
-        The random number generator is modified so that each thread and
-        each rank has a different set of random numbers.
+        Each thread and each rank uses a different stream of the
+        random number generator (see \ref o2scl::rng::split()), so
+        that the results are reproducible for a fixed seed, number
+        of threads and number of ranks.
 
         If this value is zero, then the random number generators are
         seeded by the clock time in seconds, so that if two separate
@@ -581,15 +583,16 @@ namespace o2scl {
         }
       }
     
-      // Set RNGs with a different seed for each thread and rank. 
+      // Set RNGs with the same seed and a different stream for
+      // each thread and rank
       rg.resize(n_threads);
       unsigned long int seed=time(0);
       if (this->user_seed!=0) {
         seed=this->user_seed;
       }
       for(size_t it=0;it<n_threads;it++) {
-        seed*=(mpi_rank*n_threads+it+1);
         rg[it].set_seed(seed);
+        rg[it].set_stream(mpi_rank*n_threads+it);
       }
     
       // Keep track of successful and failed MH moves in each
@@ -28,13 +28,239 @@
 
 #include <random>
 #include <ctime>
+#include <cmath>
+#include <cstdint>
+
+#include <boost/math/constants/constants.hpp>
+
 #include <o2scl/err_hnd.h>
 
 namespace o2scl {
 
+  /** \brief Counter-based Philox4x32-10 random number engine
+
+      Each block of four 32-bit outputs is a keyed bijection of a
+      128-bit counter (Salmon et al., 2011), so any position in any
+      stream can be reached without generating the preceding numbers.
+      The first key word is the seed and the second is the lower 32
+      bits of the stream index. The counter holds the 64-bit block
+      index in its first two words and the upper 32 bits of the
+      stream index in the third.
+
+      This class satisfies the requirements of a C++11 uniform
+      random bit generator and can be used as the engine for
+      \ref o2scl::rng .
+  */
+  class philox4x32 {
+
+  public:
+
+    typedef uint32_t result_type;
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The key
+    uint32_t key[2];
+
+    /// The counter for the current block
+    uint32_t ctr[4];
+
+    /// The outputs for the current block
+    uint32_t out[4];
+
+    /// The next output in \ref out to return
+    size_t ix;
+
+    /// Compute the outputs for the current counter
+    void refill() {
+      block(ctr,key,out);
+      ix=0;
+      return;
+    }
+
+    /// Increment the block index
+    void next_block() {
+      ctr[0]++;
+      if (ctr[0]==0) ctr[1]++;
+      return;
+    }
+
+#endif
+
+  public:
+
+    /// Create an engine with seed \c s and stream 0
+    philox4x32(result_type s=0) {
+      key[1]=0;
+      ctr[2]=0;
+      ctr[3]=0;
+      seed(s);
+    }
+
+    /// Smallest output
+    static constexpr result_type min() { return 0; }
+
+    /// Largest output
+    static constexpr result_type max() { return 0xffffffffUL; }
+
+    /** \brief Compute the Philox4x32-10 block for counter \c c and
+        key \c k
+    */
+    static void block(const uint32_t c[4], const uint32_t k[2],
+                      uint32_t r[4]) {
+      uint32_t x0=c[0], x1=c[1], x2=c[2], x3=c[3];
+      uint32_t k0=k[0], k1=k[1];
+      for(size_t i=0;i<10;i++) {
+        uint64_t p0=((uint64_t)0xD2511F53UL)*x0;
+        uint64_t p1=((uint64_t)0xCD9E8D57UL)*x2;
+        uint32_t hi0=(uint32_t)(p0>>32), lo0=(uint32_t)p0;
+        uint32_t hi1=(uint32_t)(p1>>32), lo1=(uint32_t)p1;
+        x0=hi1^x1^k0;
+        x1=lo1;
+        x2=hi0^x3^k1;
+        x3=lo0;
+        k0+=0x9E3779B9UL;
+        k1+=0xBB67AE85UL;
+      }
+      r[0]=x0;
+      r[1]=x1;
+      r[2]=x2;
+      r[3]=x3;
+      return;
+    }
+
+    /// Set the seed and return to the beginning of the stream
+    void seed(result_type s=0) {
+      key[0]=s;
+      ctr[0]=0;
+      ctr[1]=0;
+      refill();
+      return;
+    }
+
+    /** \brief Select the stream \c id and return to its beginning
+     */
+    void set_stream(uint64_t id) {
+      key[1]=(uint32_t)id;
+      ctr[2]=(uint32_t)(id>>32);
+      ctr[0]=0;
+      ctr[1]=0;
+      refill();
+      return;
+    }
+
+    /// Get the current stream index
+    uint64_t get_stream() const {
+      return (((uint64_t)ctr[2])<<32)+key[1];
+    }
+
+    /** \brief Move to position \c n (measured in 32-bit outputs) in
+        the current stream
+    */
+    void set_position(uint64_t n) {
+      uint64_t b=n/4;
+      ctr[0]=(uint32_t)b;
+      ctr[1]=(uint32_t)(b>>32);
+      refill();
+      ix=n%4;
+      return;
+    }
+
+    /// Get the position (in 32-bit outputs) in the current stream
+    uint64_t get_position() const {
+      return ((((uint64_t)ctr[1])<<32)+ctr[0])*4+ix;
+    }
+
+    /// Skip the next \c z outputs
+    void discard(uint64_t z) {
+      set_position(get_position()+z);
+      return;
+    }
+
+    /// Return the next 32-bit output
+    result_type operator()() {
+      if (ix==4) {
+        next_block();
+        refill();
+      }
+      return out[ix++];
+    }
+
+    /** \brief Fill \c x with the next \c n 32-bit outputs
+     */
+    void generate(size_t n, uint32_t *x) {
+      size_t i=0;
+      // Finish the current block
+      while (i<n && ix<4) x[i++]=out[ix++];
+      // Complete blocks are written directly
+      while (i+4<=n) {
+        next_block();
+        block(ctr,key,x+i);
+        i+=4;
+      }
+      if (i<n) {
+        next_block();
+        refill();
+        while (i<n) x[i++]=out[ix++];
+      }
+      return;
+    }
+
+    /// Return true if the engines have the same state
+    bool operator==(const philox4x32 &p) const {
+      return (key[0]==p.key[0] && key[1]==p.key[1] &&
+              ctr[0]==p.ctr[0] && ctr[1]==p.ctr[1] &&
+              ctr[2]==p.ctr[2] && ix==p.ix);
+    }
+
+  };
+
+  /** \brief Seed engine \c e for stream \c stream 
+
+      Stream 0 is seeded directly with \c seed, as in earlier
+      versions, and the other streams are seeded with a
+      <tt>std::seed_seq</tt> formed from the seed and the stream
+      index.
+  */
+  template<class engine_t>
+  void rng_seed_engine(engine_t &e, unsigned int seed, uint64_t stream) {
+    if (stream==0) {
+      e.seed(seed);
+    } else {
+      std::seed_seq sq{(uint32_t)seed,(uint32_t)stream,
+          (uint32_t)(stream>>32)};
+      e.seed(sq);
+    }
+    return;
+  }
+
+  /** \brief Seed a Philox engine for stream \c stream 
+   */
+  inline void rng_seed_engine(philox4x32 &e, unsigned int seed,
+                              uint64_t stream) {
+    e.seed(seed);
+    e.set_stream(stream);
+    return;
+  }
+
   /** \brief Simple C++11 random number generator class
+
+      The generator is specified by a seed and a stream index. The
+      default stream, 0, gives the same sequence as the bare engine
+      seeded with the seed. Independent generators for threads or
+      MPI ranks are obtained with \ref split() using a different
+      stream index for each, so that the results are reproducible
+      and do not depend on the clock.
+
+      The default engine is <tt>std::mt19937</tt>, for which the
+      streams are created by reseeding. Using the counter-based
+      engine \ref o2scl::philox4x32 (see \ref o2scl::rng_philox)
+      instead makes creating streams and skipping ahead in a stream
+      inexpensive.
    */
-  template<class fp_t=double> class rng {
+  template<class fp_t=double, class engine_t=std::mt19937> class rng {
     
   protected:
 
@@ -44,20 +270,24 @@ namespace o2scl {
     /// Seed for the random number generator
     unsigned int seed;
 
+    /// Stream index
+    uint64_t stream;
+
   public:
     
     /// Random number engine
-    std::mt19937 def_engine;
+    engine_t def_engine;
 
     rng() {
       seed=time(0);
+      stream=0;
       def_engine.seed(seed);
     }
 
     /// Set the seed using <tt>time(0)</tt>
     void clock_seed() {
       seed=time(0);
-      def_engine.seed(seed);
+      rng_seed_engine(def_engine,seed,stream);
       return;
     }
 
@@ -74,10 +304,34 @@ namespace o2scl {
     /// Set the seed
     void set_seed(unsigned int s) { 
       seed=s;
-      def_engine.seed(seed);
+      rng_seed_engine(def_engine,seed,stream);
       return;
     }
 
+    /** \brief Select stream \c id for the current seed and restart
+        the stream
+    */
+    void set_stream(uint64_t id) {
+      stream=id;
+      rng_seed_engine(def_engine,seed,stream);
+      dist.reset();
+      return;
+    }
+
+    /// Get the stream index
+    uint64_t get_stream() {
+      return stream;
+    }
+
+    /** \brief Return a new generator with the same seed using
+        stream \c id
+    */
+    rng<fp_t,engine_t> split(uint64_t id) const {
+      rng<fp_t,engine_t> r(*this);
+      r.set_stream(id);
+      return r;
+    }
+
     /// Return random integer in \f$[0,\mathrm{max}-1]\f$.
     unsigned long int random_int(unsigned long int max=1) {
       if (max<1) {
@@ -87,10 +341,41 @@ namespace o2scl {
       return uid(def_engine);
     }
 
+    /** \brief Fill \c x with \c n random numbers in \f$ [0,1) \f$
+
+        This gives the same numbers as \c n calls to \ref random().
+    */
+    void fill_uniform(size_t n, fp_t *x) {
+      for(size_t i=0;i<n;i++) x[i]=dist(def_engine);
+      return;
+    }
+
+    /** \brief Fill \c x with \c n normally-distributed random
+        numbers with mean \c mu and standard deviation \c sigma
+
+        The numbers are generated in pairs with the Box-Muller
+        method so that the sequence does not depend on the
+        implementation of the standard library. If \c n is odd, the
+        second member of the last pair is discarded.
+    */
+    void fill_normal(size_t n, fp_t *x, fp_t mu=0, fp_t sigma=1) {
+      const fp_t two_pi=2*boost::math::constants::pi<fp_t>();
+      for(size_t i=0;i<n;i+=2) {
+        // Use 1-u to avoid taking the logarithm of zero
+        fp_t u1=1-dist(def_engine);
+        fp_t u2=dist(def_engine);
+        fp_t rad=sigma*sqrt(-2*log(u1));
+        x[i]=mu+rad*cos(two_pi*u2);
+        if (i+1<n) x[i+1]=mu+rad*sin(two_pi*u2);
+      }
+      return;
+    }
+
     /// Copy constructor with equals operator
     rng& operator=(const rng &rg) {
       if (this!=&rg) {
 	seed=rg.seed;
+	stream=rg.stream;
 	dist=rg.dist;
 	def_engine=rg.def_engine;
       }
@@ -100,6 +385,7 @@ namespace o2scl {
     /// Copy constructor
     rng(const rng &rg) {
       seed=rg.seed;
+      stream=rg.stream;
       dist=rg.dist;
       def_engine=rg.def_engine;
     }
@@ -107,6 +393,11 @@ namespace o2scl {
     
   };
 
+  /** \brief Random number generator using the counter-based
+      engine \ref o2scl::philox4x32
+  */
+  template<class fp_t=double> using rng_philox=rng<fp_t,philox4x32>;
+
   /** \brief Swap function for vector_shuffle()
       
       \note This function is based on the static GSL swap function in
@@ -161,8 +452,8 @@ namespace o2scl {
       
       \note If \c n is 0, this function silently does nothing.
    */
-  template<class vec_t, class data_t>
-  void vector_shuffle(rng<> &r, size_t n, vec_t &data) {
+  template<class vec_t, class data_t, class rng_t>
+  void vector_shuffle(rng_t &r, size_t n, vec_t &data) {
     if (n==0) return;
     
     for (size_t i = n - 1; i > 0; i--) {
@@ -45,6 +45,7 @@
 
 // For time(0)
 #include <ctime> 
+#include <cmath>
 
 #include <o2scl/rng_gsl.h>
 #include <o2scl/err_hnd.h>
@@ -93,3 +94,27 @@ unsigned long int rng_gsl::random_int(unsigned long int n) {
   
   return k;
 }
+
+rng_gsl rng_gsl::split(unsigned long int id) const {
+  if (id==0) return rng_gsl(seed,rng);
+  // Mix the seed and the stream index with the SplitMix64 finalizer
+  unsigned long long z=((unsigned long long)seed)+
+    0x9E3779B97F4A7C15ULL*(((unsigned long long)id)+1);
+  z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+  z=(z^(z>>27))*0x94D049BB133111EBULL;
+  z=z^(z>>31);
+  rng_gsl r((unsigned long int)z,rng);
+  return r;
+}
+
+void rng_gsl::fill_normal(size_t n, double *x, double mu, double sigma) {
+  for(size_t i=0;i<n;i+=2) {
+    // Use 1-u to avoid taking the logarithm of zero
+    double u1=1.0-(this->type->get_double)(this->state);
+    double u2=(this->type->get_double)(this->state);
+    double rad=sigma*sqrt(-2.0*log(u1));
+    x[i]=mu+rad*cos(2.0*M_PI*u2);
+    if (i+1<n) x[i+1]=mu+rad*sin(2.0*M_PI*u2);
+  }
+  return;
+}
@@ -115,6 +115,30 @@ namespace o2scl {
       gsl_rng_set(this,seed);
     }
     
+    /** \brief Return a new generator of the same type with the
+        same seed using stream \c id
+
+        Since the GSL generators do not support multiple streams,
+        stream \c id is formed by reseeding with a hash of the seed
+        and \c id. Stream 0 is equivalent to a generator seeded with
+        the original seed.
+    */
+    rng_gsl split(unsigned long int id) const;
+
+    /** \brief Fill \c x with \c n random numbers in \f$ [0,1) \f$
+     */
+    void fill_uniform(size_t n, double *x) {
+      for(size_t i=0;i<n;i++) x[i]=(this->type->get_double)(this->state);
+      return;
+    }
+
+    /** \brief Fill \c x with \c n normally-distributed random
+        numbers with mean \c mu and standard deviation \c sigma
+        using the Box-Muller method
+    */
+    void fill_normal(size_t n, double *x, double mu=0.0,
+                     double sigma=1.0);
+
     /// Copy constructor with equals operator
     rng_gsl& operator=(const rng_gsl &rg) {
       if (this!=&rg) {
@@ -29,6 +29,7 @@
 
 #include <o2scl/rng_gsl.h>
 #include <o2scl/rng.h>
+#include <o2scl/vec_stats.h>
 #include <o2scl/test_mgr.h>
 
 using namespace std;
@@ -45,6 +46,95 @@ int main(void) {
   vector_shuffle<vector<double>,double>(nr,arr.size(),arr);
   vector_out(cout,arr,true);
 
+  // Known-answer tests for Philox4x32-10 from Random123
+  {
+    uint32_t c1[4]={0,0,0,0}, k1[2]={0,0}, r[4];
+    philox4x32::block(c1,k1,r);
+    t.test_gen(r[0]==0x6627e8d5UL && r[1]==0xe169c58dUL &&
+               r[2]==0xbc57ac4cUL && r[3]==0x9b00dbd8UL,"philox kat 1");
+    uint32_t c2[4]={0xffffffffUL,0xffffffffUL,0xffffffffUL,0xffffffffUL};
+    uint32_t k2[2]={0xffffffffUL,0xffffffffUL};
+    philox4x32::block(c2,k2,r);
+    t.test_gen(r[0]==0x408f276dUL && r[1]==0x41c83b0eUL &&
+               r[2]==0xa20bc7c6UL && r[3]==0x6d5451fdUL,"philox kat 2");
+    uint32_t c3[4]={0x243f6a88UL,0x85a308d3UL,0x13198a2eUL,0x03707344UL};
+    uint32_t k3[2]={0xa4093822UL,0x299f31d0UL};
+    philox4x32::block(c3,k3,r);
+    t.test_gen(r[0]==0xd16cfe09UL && r[1]==0x94fdccebUL &&
+               r[2]==0x5001e420UL && r[3]==0x24126ea1UL,"philox kat 3");
+  }
+
+  // Skipping ahead and bulk generation agree with sequential
+  // generation
+  {
+    philox4x32 p1(5), p2(5), p3(5);
+    p1.set_stream(7);
+    p2.set_stream(7);
+    p3.set_stream(7);
+    vector<uint32_t> v(103), w(103);
+    for(size_t i=0;i<103;i++) v[i]=p1();
+    p2();
+    w[0]=v[0];
+    p2.generate(102,&w[1]);
+    t.test_gen(v==w,"philox generate");
+    p3.discard(41);
+    t.test_gen(p3()==v[41],"philox discard");
+    t.test_gen(p1.get_position()==103,"philox position");
+  }
+
+  // Streams are reproducible and distinct, for both engines
+  for(size_t k=0;k<2;k++) {
+    rng<> r1;
+    rng_philox<> r2;
+    r1.set_seed(10);
+    r2.set_seed(10);
+    vector<double> a(100), b(100), c(100);
+    if (k==0) {
+      r1.split(3).fill_uniform(100,&a[0]);
+      r1.split(3).fill_uniform(100,&b[0]);
+      r1.split(4).fill_uniform(100,&c[0]);
+    } else {
+      r2.split(3).fill_uniform(100,&a[0]);
+      r2.split(3).fill_uniform(100,&b[0]);
+      r2.split(4).fill_uniform(100,&c[0]);
+    }
+    t.test_gen(a==b,"split reproducible");
+    t.test_gen(a!=c,"split distinct");
+  }
+
+  // Stream 0 of the default engine is unchanged
+  {
+    rng<> r1;
+    r1.set_seed(10);
+    std::mt19937 mt(10);
+    std::uniform_real_distribution<double> urd;
+    double x=urd(mt);
+    t.test_gen(r1.split(0).random()==x,"stream 0");
+  }
+
+  // Moments of the bulk uniform and normal distributions
+  {
+    rng_philox<> r2;
+    r2.set_seed(10);
+    size_t N=100000;
+    vector<double> u(N), g(N+1);
+    r2.fill_uniform(N,&u[0]);
+    r2.fill_normal(N+1,&g[0],1.0,2.0);
+    t.test_abs(vector_mean(N,u),0.5,0.01,"uniform mean");
+    t.test_abs(vector_variance(N,u),1.0/12.0,0.002,"uniform variance");
+    t.test_abs(vector_mean(N+1,g),1.0,0.03,"normal mean");
+    t.test_rel(vector_stddev(N+1,g),2.0,0.01,"normal stddev");
+    
+    rng_gsl rg(10);
+    rg.fill_uniform(N,&u[0]);
+    rg.fill_normal(N,&g[0]);
+    t.test_abs(vector_mean(N,u),0.5,0.01,"gsl uniform mean");
+    t.test_abs(vector_mean(N,g),0.0,0.02,"gsl normal mean");
+    t.test_rel(vector_stddev(N,g),1.0,0.01,"gsl normal stddev");
+    rng_gsl rg2=rg.split(2), rg3=rg.split(2);
+    t.test_gen(rg2.random()==rg3.random(),"gsl split");
+  }
+
   t.report();
   return 0;
 }
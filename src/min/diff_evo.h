@@ -29,10 +29,16 @@
 
 #include <vector>
 #include <algorithm>
+#include <string>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
 
 #include <o2scl/rng.h>
 #include <o2scl/mmin.h>
 #include <o2scl/mm_funct.h>
+#include <o2scl/multi_funct.h>
 
 namespace o2scl {
 
@@ -63,15 +69,39 @@ namespace o2scl {
       \note The constructor sets \ref o2scl::mmin_base::ntrial to 1000 .
 
       If the population converges prematurely, then \ref diff_evo::f
-      and \ref pop_size should be increased.
+      and \ref pop_size should be increased. Alternatively, setting
+      \ref n_restarts to a non-zero value re-initializes the
+      population around the best point found so far (which is kept
+      in the population) each time \ref nconv generations go by
+      without a better fit.
+
+      <b>Parallel evaluation</b>
+
+      By default, each agent's trial vector is evaluated immediately
+      after it is created, and an improved agent can be used to build
+      the trial vectors of the agents which follow it in the same
+      generation. If \ref n_threads is larger than one or if a batch
+      function has been specified with \ref set_batch_function(),
+      then the trial vectors for the entire generation are created
+      from the population at the beginning of the generation, all of
+      them are evaluated at once, and the selection is performed
+      afterwards. In this mode, if OpenMP support is enabled, the
+      trial vectors are created and the function is evaluated using
+      \ref n_threads threads, each with its own random number
+      generator seeded from the main generator. The function must
+      then be safe to call from several threads at once. If the
+      error handler is called during the evaluations, it is called
+      again with the same error value after all of the threads have
+      finished, and the minimization stops. If a batch
+      function is given, it is called once for the initial population
+      and once for each generation, and the function object given to
+      mmin() is not used. For a fixed number of threads, the results
+      do not depend on the order in which the threads finish.
 
       \future AWS, 7/25/19, The code stops early if \ref nconv
       generations go by without a better fit, but we could also
       consider some code which terminates early if the minimum is
       found to within a particular tolerance.
-
-      \future This class probably has a simple parallelization like 
-      \ref o2scl::anneal_para ?
   */
   template<class func_t=multi_funct, 
 	   class vec_t=boost::numeric::ublas::vector<double> , 
@@ -110,13 +140,25 @@ namespace o2scl {
     */
     double cr;
 
+    /** \brief Number of threads for parallel evaluation (default 1)
+     */
+    size_t n_threads;
+
+    /** \brief The number of times the population is re-initialized
+	after convergence (default 0)
+    */
+    size_t n_restarts;
+
     diff_evo() {
       this->ntrial=1000;
       f = 0.75;
       cr = 0.8;
       rand_init_funct = 0;
+      batch_funct = 0;
       pop_size = 0;
       nconv = 25;
+      n_threads = 1;
+      n_restarts = 0;
       step.resize(1);
       step[0]=1.0e-2;
     }
@@ -142,6 +184,24 @@ namespace o2scl {
       rand_init_funct = &function;
     }
 
+    /** \brief Set a function which evaluates a set of agents at
+	once (see \ref multi_funct_batch)
+
+	Note that this function stores a pointer to the user-specified
+	function so care must be taken to ensure the pointer is still
+	valid when the minimization is run.
+    */
+    virtual void set_batch_function(multi_funct_batch &function) {
+      batch_funct = &function;
+    }
+
+    /** \brief Go back to calling the function given to mmin()
+	for each agent
+    */
+    virtual void unset_batch_function() {
+      batch_funct = 0;
+    }
+
     /** \brief Calculate the minimum \c fmin of \c func w.r.t the 
 	array \c x of size \c nvar.
 
@@ -165,119 +225,7 @@ namespace o2scl {
 	and return it as the best found candidate solution.
     */
     virtual int mmin(size_t nvar, vec_t &x0, double &fmin, func_t &func) {
-
-      // Keep track of number of generation without better solutions
-      size_t nconverged = 0;
-
-      if (pop_size==0) {
-	// Automatically select pop_size based on on dimensionality.
-	pop_size = 10*nvar;
-      }
-
-      initialize_population( nvar, x0 );
-      
-      fmins.resize(pop_size);
-
-      // Set initial fmin
-      for (size_t x = 0; x < pop_size; ++x) {
-	vec_t agent_x;
-	agent_x.resize(nvar);
-	for (size_t i = 0; i < nvar; ++i) {
-	  agent_x[i] = population[x*nvar+i];
-	}
-	double fmin_x = 0;
-	fmin_x=func(nvar,agent_x);
-	fmins[x]=fmin_x;
-	if (x==0) {
-	  fmin = fmin_x;
-	  for (size_t i = 0; i<nvar; ++i) {
-	    x0[i] = agent_x[i];
-	  }
-	} else if (fmin_x<fmin) {
-	  fmin = fmin_x;
-	  for (size_t i = 0; i<nvar; ++i) {
-	    x0[i] = agent_x[i];
-	  }
-	}
-      }
-
-      int gen = 0;
-      while (gen < this->ntrial && nconverged <= nconv) {
-	     
-	++nconverged;
-	++gen;
-
-	// For each agent x in the population do: 
-	for (size_t x = 0; x < pop_size; ++x) {
-
-	  std::vector<int> others;
-
-	  // Create a copy agent_x and agent_y of the current agent
-	  // vector
-	  vec_t agent_x, agent_y;
-	  agent_x.resize(nvar);
-	  agent_y.resize(nvar);
-	  for (size_t i = 0; i < nvar; ++i) {
-	    agent_x[i] = population[x*nvar+i];
-	    agent_y[i] = population[x*nvar+i];
-	  }
-                            
-	  // Pick three agents a, b, and c from the population at 
-	  // random, they must be distinct from each other as well as
-	  // from agent x
-	  others = pick_unique_agents( 3, x );
-
-	  // Pick a random index R in {1, ..., n}, where the highest 
-	  // possible value n is the dimensionality of the problem 
-	  // to be optimized.
-	  size_t r = floor(gr.random()*nvar);
-
-	  for (size_t i = 0; i < nvar; ++i) {
-	    // Pick ri~U(0,1) uniformly from the open range (0,1)
-	    double ri = gr.random();
-	    // If (i=R) or (ri<CR) let yi = ai + F(bi - ci), otherwise 
-	    // let yi = xi
-	    if (i == r || ri < cr) {
-	      agent_y[i] = population[others[0]*nvar+i] + 
-		f*(population[others[1]*nvar+i]-
-		   population[others[2]*nvar+i]);
-	    }
-	  }
-	  // If (f(y) < f(x)) then replace the agent in the population 
-	  // with the improved candidate solution, that is, set x = y 
-	  // in the population
-	  double fmin_y;
-                            
-	  fmin_y=func(nvar,agent_y);
-	  if (fmin_y<fmins[x]) {
-	    for (size_t i = 0; i < nvar; ++i) {
-	      population[x*nvar+i] = agent_y[i];
-	      fmins[x] = fmin_y;
-	    }
-	    if (fmin_y<fmin) {
-	      fmin = fmin_y;
-	      for (size_t i = 0; i<nvar; ++i) {  
-		x0[i] = agent_y[i];
-	      }
-	      nconverged = 0;
-	    }
-	  }
-
-	}
-	if (this->verbose > 0) {
-	  this->print_iter( nvar, fmin, gen, x0 );
-	}
-      }
-
-      this->last_ntrial=gen;
-      
-      if (gen>=this->ntrial) {
-	std::string str="Exceeded maximum number of iterations ("+
-	  itos(this->ntrial)+") in diff_evo::mmin().";
-	O2SCL_CONV_RET(str.c_str(),exc_emaxiter,this->err_nonconv);
-      }
-
-      return 0;
+      return evolve(nvar,x0,fmin,func,"diff_evo::mmin()");
     };
 
     /** \brief Print out iteration information.
@@ -348,6 +296,339 @@ namespace o2scl {
 
     /// Step size for initialization
     std::vector<double> step;
+
+    /// Function which evaluates several agents at once
+    multi_funct_batch *batch_funct;
+
+    /// \name Storage for parallel evaluation
+    //@{
+    /// The trial vectors for one generation
+    vec_t trials;
+    /// The function values at the trial vectors
+    ubvector ftrials;
+    /// Random number generators for each thread
+    std::vector<rng<> > thread_rngs;
+    /// Temporary agent for each thread
+    std::vector<vec_t> thread_agents;
+    //@}
+
+    /// Return the number of threads to use
+    size_t get_n_threads() {
+#ifdef O2SCL_OPENMP
+      if (n_threads>1) return n_threads;
+#endif
+      return 1;
+    }
+
+    /** \brief The main loop for mmin(), where \c fname is the
+	function name used in error messages
+    */
+    int evolve(size_t nvar, vec_t &x0, double &fmin, func_t &func,
+	       std::string fname) {
+
+      // Keep track of number of generation without better solutions
+      size_t nconverged = 0;
+
+      if (pop_size==0) {
+	// Automatically select pop_size based on on dimensionality.
+	pop_size = 10*nvar;
+      }
+
+      // Determine whether or not to evaluate entire generations
+      // at once and set up the random number generators
+      bool para=(n_threads>1 || batch_funct!=0);
+      if (para) {
+#ifndef O2SCL_OPENMP
+	if (n_threads>1 && this->verbose>0) {
+	  std::cout << fname << ": " << n_threads << " threads were "
+		    << "requested but the -DO2SCL_OPENMP flag was not "
+		    << "used during compilation." << std::endl;
+	}
+#endif
+	size_t nthr=get_n_threads();
+	thread_rngs.resize(nthr);
+	thread_agents.resize(nthr);
+	// One seed for this call, with a separate stream for each
+	// thread
+	unsigned int seed=(unsigned int)gr.random_int(4294967295UL);
+	for(size_t it=0;it<nthr;it++) {
+	  thread_rngs[it].set_seed(seed);
+	  thread_rngs[it].set_stream(it+1);
+	}
+	trials.resize(pop_size*nvar);
+	ftrials.resize(pop_size);
+      } else {
+	thread_agents.resize(1);
+      }
+
+      initialize_population( nvar, x0 );
+      
+      fmins.resize(pop_size);
+
+      // Set initial fmin
+      int ret=eval_agents(nvar,population,fmins,func);
+      if (ret!=0) return ret;
+      for (size_t x = 0; x < pop_size; ++x) {
+	if (x==0 || fmins[x]<fmin) {
+	  fmin = fmins[x];
+	  for (size_t i = 0; i<nvar; ++i) {
+	    x0[i] = population[x*nvar+i];
+	  }
+	}
+      }
+
+      size_t restarts = 0;
+      int gen = 0;
+      while (gen < this->ntrial) {
+
+	if (nconverged > nconv) {
+	  if (restarts >= n_restarts) break;
+	  restarts++;
+	  ret=restart_population(nvar,x0,fmin,func);
+	  if (ret!=0) return ret;
+	  nconverged = 0;
+	}
+	     
+	++nconverged;
+	++gen;
+
+	if (para) {
+
+	  // Create the trial vectors for the entire generation
+	  size_t nthr=get_n_threads();
+	  int err_ret=0;
+	  std::string err_reason;
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(static) num_threads(nthr)
+#endif
+	  for (size_t x = 0; x < pop_size; ++x) {
+	    size_t it=0;
+#ifdef O2SCL_OPENMP
+	    it=omp_get_thread_num();
+#endif
+	    try {
+	      make_trial(nvar,x,thread_rngs[it],&trials[x*nvar]);
+	    } catch (const std::exception &e) {
+	      store_error(err_ret,err_reason,e);
+	    }
+	  }
+	  if (err_ret!=0) {
+	    std::string str="Creating trial vectors failed in "+
+	      fname+": "+err_reason;
+	    O2SCL_ERR(str.c_str(),err_ret);
+	    return err_ret;
+	  }
+
+	  ret=eval_agents(nvar,trials,ftrials,func);
+	  if (ret!=0) return ret;
+
+	  // Selection
+	  for (size_t x = 0; x < pop_size; ++x) {
+	    if (ftrials[x]<fmins[x]) {
+	      for (size_t i = 0; i < nvar; ++i) {
+		population[x*nvar+i] = trials[x*nvar+i];
+	      }
+	      fmins[x] = ftrials[x];
+	      accept_trial(x);
+	      if (ftrials[x]<fmin) {
+		fmin = ftrials[x];
+		for (size_t i = 0; i<nvar; ++i) {  
+		  x0[i] = trials[x*nvar+i];
+		}
+		nconverged = 0;
+	      }
+	    }
+	  }
+
+	} else {
+
+	  vec_t &agent_y=thread_agents[0];
+	  agent_y.resize(nvar);
+	  
+	  // For each agent x in the population do: 
+	  for (size_t x = 0; x < pop_size; ++x) {
+
+	    // Create the trial vector for this agent
+	    make_trial(nvar,x,gr,&agent_y[0]);
+	    
+	    // If (f(y) < f(x)) then replace the agent in the population 
+	    // with the improved candidate solution, that is, set x = y 
+	    // in the population
+	    double fmin_y=func(nvar,agent_y);
+	    if (fmin_y<fmins[x]) {
+	      for (size_t i = 0; i < nvar; ++i) {
+		population[x*nvar+i] = agent_y[i];
+	      }
+	      fmins[x] = fmin_y;
+	      accept_trial(x);
+	      if (fmin_y<fmin) {
+		fmin = fmin_y;
+		for (size_t i = 0; i<nvar; ++i) {  
+		  x0[i] = agent_y[i];
+		}
+		nconverged = 0;
+	      }
+	    }
+	    
+	  }
+	  
+	}
+	
+	if (this->verbose > 0) {
+	  this->print_iter( nvar, fmin, gen, x0 );
+	}
+      }
+
+      this->last_ntrial=gen;
+      
+      if (gen>=this->ntrial) {
+	std::string str="Exceeded maximum number of iterations ("+
+	  itos(this->ntrial)+") in "+fname+".";
+	O2SCL_CONV_RET(str.c_str(),exc_emaxiter,this->err_nonconv);
+      }
+
+      return 0;
+    }
+
+    /** \brief Store the error value and the message from \c e in
+	\c err_ret and \c err_reason, unless an error was already
+	stored
+    */
+    void store_error(int &err_ret, std::string &err_reason,
+		     const std::exception &e) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_diff_evo_err)
+#endif
+      {
+	if (err_ret==0) {
+	  err_ret=err_hnd->get_errno();
+	  if (err_ret==0) err_ret=exc_efailed;
+	  err_reason=e.what();
+	}
+      }
+      return;
+    }
+    
+    /** \brief Evaluate the function for all of the agents stored
+	in \c agents and place the results in \c vals
+
+	Exceptions cannot leave the parallel region, so if the error
+	handler is called by the function, the first error is stored
+	and the error handler is called again after the loop.
+    */
+    int eval_agents(size_t nvar, const vec_t &agents, ubvector &vals,
+		    func_t &func) {
+      
+      if (batch_funct!=0) {
+	(*batch_funct)(pop_size,nvar,&agents[0],&vals[0]);
+	return 0;
+      }
+      
+      int err_ret=0;
+      std::string err_reason;
+      
+      size_t nthr=get_n_threads();
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic) num_threads(nthr)
+#endif
+      for (size_t x = 0; x < pop_size; ++x) {
+	size_t it=0;
+#ifdef O2SCL_OPENMP
+	it=omp_get_thread_num();
+#endif
+	vec_t &agent=thread_agents[it];
+	agent.resize(nvar);
+	for (size_t i = 0; i < nvar; ++i) {
+	  agent[i] = agents[x*nvar+i];
+	}
+	try {
+	  vals[x]=func(nvar,agent);
+	} catch (const std::exception &e) {
+	  store_error(err_ret,err_reason,e);
+	}
+      }
+
+      if (err_ret!=0) {
+	std::string str=((std::string)"Function evaluation failed ")+
+	  "in diff_evo::eval_agents(): "+err_reason;
+	O2SCL_ERR(str.c_str(),err_ret);
+	return err_ret;
+      }
+      
+      return 0;
+    }
+
+    /** \brief Re-initialize the population around the best point
+	\c x0, keeping the best point as the first agent
+    */
+    virtual int restart_population(size_t nvar, vec_t &x0,
+				   double &fmin, func_t &func) {
+      initialize_population(nvar,x0);
+      for (size_t i = 0; i < nvar; ++i) {
+	population[i] = x0[i];
+      }
+      int ret=eval_agents(nvar,population,fmins,func);
+      if (ret!=0) return ret;
+      fmins[0] = fmin;
+      for (size_t x = 1; x < pop_size; ++x) {
+	if (fmins[x]<fmin) {
+	  fmin = fmins[x];
+	  for (size_t i = 0; i<nvar; ++i) {
+	    x0[i] = population[x*nvar+i];
+	  }
+	}
+      }
+      return 0;
+    }
+
+    /** \brief Create the trial vector \c y for agent \c x using
+	the random number generator \c r
+
+	Pick three agents a, b, and c from the population at
+	random, they must be distinct from each other as well as
+	from agent x. Pick a random index R in {1, ..., n}, where
+	n is the dimensionality of the problem to be optimized.
+	For each i, pick ri~U(0,1), and if (i=R) or (ri<CR) let
+	yi = ai + F(bi - ci), otherwise let yi = xi.
+    */
+    virtual void make_trial(size_t nvar, size_t x, rng<> &r, double *y) {
+      build_trial(nvar,x,r,f,cr,y);
+      return;
+    }
+
+    /** \brief Create the trial vector \c y for agent \c x using
+	the differential weight \c f_x and crossover probability 
+	\c cr_x
+    */
+    void build_trial(size_t nvar, size_t x, rng<> &r, double f_x,
+		     double cr_x, double *y) {
+      
+      for (size_t i = 0; i < nvar; ++i) {
+	y[i] = population[x*nvar+i];
+      }
+      
+      std::vector<int> others = pick_unique_agents( 3, x, r );
+
+      size_t rx = floor(r.random()*nvar);
+
+      for (size_t i = 0; i < nvar; ++i) {
+	double ri = r.random();
+	if (i == rx || ri < cr_x) {
+	  y[i] = population[others[0]*nvar+i] + 
+	    f_x*(population[others[1]*nvar+i]-
+		 population[others[2]*nvar+i]);
+	}
+      }
+      
+      return;
+    }
+
+    /** \brief Called after the trial vector for agent \c x has
+	replaced the agent in the population
+    */
+    virtual void accept_trial(size_t x) {
+      return;
+    }
     
     /** \brief Initialize a population of random agents
      */
@@ -384,6 +665,14 @@ namespace o2scl {
 	\ref o2scl::permutation class?
     */
     virtual std::vector<int> pick_unique_agents(int nr, size_t x) {
+      return pick_unique_agents(nr,x,gr);
+    }
+
+    /** \brief Pick number of unique agent id's using the random
+	number generator \c r
+    */
+    virtual std::vector<int> pick_unique_agents(int nr, size_t x,
+						rng<> &r) {
       std::vector<int> ids;
       std::vector<int> agents;
       // Fill array with ids
@@ -396,7 +685,7 @@ namespace o2scl {
       }
       // Shuffle according to Fisher-Yates
       for (size_t i=ids.size()-1; i>ids.size()-nr-1; --i) {
-	int j = round(gr.random()*i);
+	int j = round(r.random()*i);
 	std::swap( ids[i], ids[j] );
       }
       for (size_t i=ids.size()-1; i>ids.size()-nr-1; --i) {
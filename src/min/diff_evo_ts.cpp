@@ -44,6 +44,24 @@ double func(size_t nvar, const ubvector &x) {
   return -gsl_sf_bessel_J0(a)*gsl_sf_bessel_J0(b);
 }
 
+// The same function, but calling the error handler for part of the
+// parameter space
+double func_err(size_t nvar, const ubvector &x) {
+  if (x[0]>5.0) {
+    O2SCL_ERR("Out of range in func_err().",exc_efailed);
+  }
+  return func(nvar,x);
+}
+
+// The same function, evaluated at several points at once
+void func_batch(size_t n, size_t nvar, const double *x, double *y) {
+  for(size_t i=0;i<n;i++) {
+    y[i]=-gsl_sf_bessel_J0(x[i*nvar]-2.0)*
+      gsl_sf_bessel_J0(x[i*nvar+1]+3.0);
+  }
+  return;
+}
+
 rng<> gr;
 
 int init_function( size_t dim, const ubvector &x, ubvector &y ) {
@@ -81,6 +99,56 @@ int main(int argc, char *argv[]) {
   t.test_rel(init[1],-3.0,1.0e-2,"another test - value 2");
   t.test_rel(result,-1.0,1.0e-2,"another test - min");
 
+  // Evaluate entire generations with a batch function
+  
+  multi_funct_batch fb=func_batch;
+  diff_evo<multi_funct> de2;
+  de2.set_init_function(init_f);
+  de2.set_batch_function(fb);
+  de2.n_restarts=1;
+  init[0]=0.0;
+  init[1]=0.0;
+  de2.mmin(2,init,result,fx);
+  cout << "x: " << init[0] << " " << init[1] 
+       << ", minimum function value: " << result << endl;
+  cout << endl;
+  
+  t.test_rel(init[0],2.0,1.0e-2,"batch - value");
+  t.test_rel(init[1],-3.0,1.0e-2,"batch - value 2");
+  t.test_rel(result,-1.0,1.0e-2,"batch - min");
+
+  // Evaluate entire generations with two threads
+  
+  diff_evo<multi_funct> de3;
+  de3.set_init_function(init_f);
+  de3.n_threads=2;
+  init[0]=0.0;
+  init[1]=0.0;
+  de3.mmin(2,init,result,fx);
+  cout << "x: " << init[0] << " " << init[1] 
+       << ", minimum function value: " << result << endl;
+  cout << endl;
+  
+  t.test_rel(init[0],2.0,1.0e-2,"threads - value");
+  t.test_rel(init[1],-3.0,1.0e-2,"threads - value 2");
+  t.test_rel(result,-1.0,1.0e-2,"threads - min");
+
+  // An error in the function should reach the calling thread
+  
+  multi_funct fx_err=func_err;
+  diff_evo<multi_funct> de4;
+  de4.set_init_function(init_f);
+  de4.n_threads=2;
+  init[0]=0.0;
+  init[1]=0.0;
+  bool caught=false;
+  try {
+    de4.mmin(2,init,result,fx_err);
+  } catch (std::exception &e) {
+    caught=true;
+  }
+  t.test_gen(caught,"threads - error");
+
   t.report();
   
   return 0;
@@ -0,0 +1,490 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_MMIN_MULTI_H
+#define O2SCL_MMIN_MULTI_H
+
+/** \file mmin_multi.h
+    \brief File defining \ref o2scl::mmin_multi
+*/
+
+#include <vector>
+#include <cmath>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+#include <gsl/gsl_qrng.h>
+
+#include <o2scl/rng.h>
+#include <o2scl/mmin.h>
+#include <o2scl/mmin_simp2.h>
+
+namespace o2scl {
+
+  /** \brief Multidimensional minimization from several starting
+      points (OpenMP version)
+
+      This class runs an independent local minimization, using a
+      minimizer of type \c mmin_t, from each of \ref n_starts
+      starting points and returns the best minimum found. The
+      starting points are chosen inside a box which is either
+      specified with \ref set_limits() or, if no limits are given,
+      centered on the initial point with widths specified by \ref
+      set_step() (default 1). The points are chosen according to
+      \ref start_method, either uniformly at random, with a Latin
+      hypercube, or from a Sobol sequence (the latter is limited to
+      40 dimensions). The initial point itself is always used as the
+      first start.
+
+      If OpenMP support is enabled, the local minimizations are
+      distributed over \ref n_threads threads. Each thread has its own
+      minimizer object, and the function to be minimized can be
+      specified either as one function object (which must then be
+      safe to call from several threads at once) or as a vector of
+      function objects, one for each thread, as in \ref anneal_para.
+      If fewer function objects than threads are given, then the
+      function objects are shared between threads.
+
+      The values of \ref o2scl::mmin_base::ntrial, \ref
+      o2scl::mmin_base::tol_rel, and \ref o2scl::mmin_base::tol_abs
+      are passed on to the local minimizers. Local minimizations which
+      do not converge are not treated as an error, and their final
+      point is used like any other.
+
+      The best point found so far is shared between the threads. Two
+      minima are said to agree if their function values differ by
+      less than \f$ \mathrm{tol\_agree} (1+|f_{\mathrm{best}}|) \f$.
+      If \ref n_agree is larger than zero, then no more local
+      minimizations are started once \ref n_agree of them agree with
+      the best minimum. With more than one thread, which starting
+      points have been used when this happens depends on the timing
+      of the threads.
+
+      The function values and return values of the local
+      minimizations are stored in \ref start_fmin and \ref start_ret,
+      and the number of local minimizations performed is stored in
+      \ref o2scl::mmin_base::last_ntrial.
+
+      If the error handler is called during one of the local
+      minimizations (for example by the function to be minimized),
+      then no more local minimizations are started and the error
+      handler is called again with the same error value once all
+      threads have finished.
+  */
+  template<class func_t=multi_funct,
+	   class vec_t=boost::numeric::ublas::vector<double>,
+	   class mmin_t=mmin_simp2<func_t,vec_t> > class mmin_multi :
+    public mmin_base<func_t,func_t,vec_t> {
+
+  public:
+
+    typedef boost::numeric::ublas::vector<double> ubvector;
+
+    /// \name Methods for choosing the starting points
+    //@{
+    /// Uniformly distributed random points
+    static const size_t start_random=0;
+    /// Latin hypercube
+    static const size_t start_lhs=1;
+    /// Sobol sequence
+    static const size_t start_sobol=2;
+    //@}
+
+    /// Method for choosing the starting points (default \ref start_lhs)
+    size_t start_method;
+
+    /// The number of starting points (default 20)
+    size_t n_starts;
+
+    /// The number of OpenMP threads (default 1)
+    size_t n_threads;
+
+    /** \brief The number of agreeing minima required to stop early
+	(default 0, which means never stop early)
+    */
+    size_t n_agree;
+
+    /** \brief The tolerance for two minima to agree (default
+	\f$ 10^{-6} \f$)
+    */
+    double tol_agree;
+
+    /// The function values at the end of each local minimization
+    std::vector<double> start_fmin;
+
+    /** \brief The return values of each local minimization (or -1
+	if the minimization was not performed)
+    */
+    std::vector<int> start_ret;
+
+    /// Random number generator for the starting points
+    rng<> r;
+
+    mmin_multi() {
+      start_method=start_lhs;
+      n_starts=20;
+      n_threads=1;
+      n_agree=0;
+      tol_agree=1.0e-6;
+      step.resize(1);
+      step[0]=1.0;
+    }
+
+    virtual ~mmin_multi() {
+      free();
+    }
+
+    /** \brief Set the lower and upper limits of the box for the
+	starting points
+    */
+    template<class vec2_t>
+    int set_limits(size_t nv, const vec2_t &low, const vec2_t &high) {
+      low_lim.resize(nv);
+      high_lim.resize(nv);
+      for(size_t i=0;i<nv;i++) {
+	low_lim[i]=low[i];
+	high_lim[i]=high[i];
+      }
+      return 0;
+    }
+
+    /// Remove the limits set with \ref set_limits()
+    void unset_limits() {
+      low_lim.clear();
+      high_lim.clear();
+      return;
+    }
+
+    /** \brief Set the widths of the box for the starting points
+	(used only when no limits are specified)
+    */
+    template<class vec2_t> int set_step(size_t nv, const vec2_t &stepv) {
+      if (nv>0) {
+	step.resize(nv);
+	for(size_t i=0;i<nv;i++) step[i]=stepv[i];
+      }
+      return 0;
+    }
+
+    /** \brief Calculate the minimum \c fmin of \c func w.r.t. the
+	array \c x0 of size \c nv.
+
+	If more than one thread is used, the function \c func must
+	be safe to call from several threads at once.
+    */
+    virtual int mmin(size_t nv, vec_t &x0, double &fmin, func_t &func) {
+      std::vector<func_t *> fptrs(1,&func);
+      return mmin_base_multi(nv,x0,fmin,fptrs);
+    }
+
+    /** \brief Calculate the minimum \c fmin of \c func w.r.t. the
+	array \c x0 of size \c nv using a separate function object
+	for each thread
+    */
+    virtual int mmin(size_t nv, vec_t &x0, double &fmin,
+		     std::vector<func_t> &func) {
+      if (func.size()==0) {
+	O2SCL_ERR2("No functions specified in ",
+		   "mmin_multi::mmin().",exc_einval);
+      }
+      std::vector<func_t *> fptrs(func.size());
+      for(size_t i=0;i<func.size();i++) fptrs[i]=&func[i];
+      return mmin_base_multi(nv,x0,fmin,fptrs);
+    }
+
+    /// Return string denoting type ("mmin_multi")
+    virtual const char *type() { return "mmin_multi"; }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The minimizers, one for each thread
+    std::vector<mmin_t *> mins;
+
+    /// The lower limits for the starting points
+    std::vector<double> low_lim;
+
+    /// The upper limits for the starting points
+    std::vector<double> high_lim;
+
+    /// The widths for the starting points
+    std::vector<double> step;
+
+    /// The starting points, stored as <tt>starts[i*nv+j]</tt>
+    std::vector<double> starts;
+
+    /// Free the minimizers
+    void free() {
+      for(size_t i=0;i<mins.size();i++) {
+	delete mins[i];
+      }
+      mins.clear();
+      return;
+    }
+
+    /** \brief Create the starting points in the unit hypercube
+     */
+    void make_unit_starts(size_t nv) {
+
+      starts.resize(n_starts*nv);
+
+      if (start_method==start_sobol) {
+
+	gsl_qrng *gq=gsl_qrng_alloc(gsl_qrng_sobol,nv);
+	if (gq==0) {
+	  O2SCL_ERR2("Failed to allocate Sobol sequence (too many ",
+		     "dimensions?) in mmin_multi::mmin().",exc_einval);
+	}
+	for(size_t i=0;i<n_starts;i++) {
+	  gsl_qrng_get(gq,&starts[i*nv]);
+	}
+	gsl_qrng_free(gq);
+
+      } else if (start_method==start_lhs) {
+
+	// For each dimension, place one point in each of the
+	// n_starts intervals, in a random order
+	std::vector<size_t> perm(n_starts);
+	for(size_t j=0;j<nv;j++) {
+	  for(size_t i=0;i<n_starts;i++) perm[i]=i;
+	  vector_shuffle<std::vector<size_t>,size_t>(r,n_starts,perm);
+	  for(size_t i=0;i<n_starts;i++) {
+	    starts[i*nv+j]=(((double)perm[i])+r.random())/
+	      ((double)n_starts);
+	  }
+	}
+
+      } else {
+
+	for(size_t i=0;i<n_starts*nv;i++) {
+	  starts[i]=r.random();
+	}
+
+      }
+
+      return;
+    }
+
+    /** \brief Perform the minimizations using the function
+	objects in \c func
+    */
+    int mmin_base_multi(size_t nv, vec_t &x0, double &fmin,
+			std::vector<func_t *> &func) {
+
+      if (nv==0) {
+	O2SCL_ERR2("Tried to minimize over zero variables ",
+		   "in mmin_multi::mmin().",exc_einval);
+      }
+      if (n_starts==0) {
+	O2SCL_ERR2("Number of starting points is zero in ",
+		   "mmin_multi::mmin().",exc_einval);
+      }
+      if (start_method>start_sobol) {
+	O2SCL_ERR2("Invalid value of start_method in ",
+		   "mmin_multi::mmin().",exc_einval);
+      }
+      if (low_lim.size()>0 && low_lim.size()<nv) {
+	O2SCL_ERR2("Limits specified for too few variables in ",
+		   "mmin_multi::mmin().",exc_einval);
+      }
+
+      // Set the number of threads
+      size_t nthr=1;
+#ifdef O2SCL_OPENMP
+      if (n_threads>1) nthr=n_threads;
+#else
+      if (n_threads>1 && this->verbose>0) {
+	std::cout << "mmin_multi::mmin(): " << n_threads
+		  << " threads were requested but the "
+		  << "-DO2SCL_OPENMP flag was not used during "
+		  << "compilation." << std::endl;
+      }
+#endif
+
+      // Allocate the minimizers and pass on the settings
+      if (mins.size()!=nthr) {
+	free();
+	mins.resize(nthr);
+	for(size_t it=0;it<nthr;it++) {
+	  mins[it]=new mmin_t;
+	}
+      }
+      for(size_t it=0;it<nthr;it++) {
+	mins[it]->ntrial=this->ntrial;
+	mins[it]->tol_rel=this->tol_rel;
+	mins[it]->tol_abs=this->tol_abs;
+	mins[it]->err_nonconv=false;
+      }
+
+      // Create the starting points, using the initial point first
+      make_unit_starts(nv);
+      for(size_t i=0;i<n_starts;i++) {
+	for(size_t j=0;j<nv;j++) {
+	  double &s=starts[i*nv+j];
+	  if (i==0) {
+	    s=x0[j];
+	  } else if (low_lim.size()>0) {
+	    s=low_lim[j]+s*(high_lim[j]-low_lim[j]);
+	  } else {
+	    double stepj=step[j%step.size()];
+	    s=x0[j]-stepj/2.0+stepj*s;
+	  }
+	}
+      }
+
+      start_fmin.resize(n_starts);
+      start_ret.resize(n_starts);
+      for(size_t i=0;i<n_starts;i++) {
+	start_fmin[i]=0.0;
+	start_ret[i]=-1;
+      }
+
+      // The shared best point
+      bool found=false, done=false;
+      size_t count=0, n_done=0;
+      vec_t x_best(nv);
+      double f_best=0.0;
+
+      // The first error from a local minimization
+      int err_ret=0;
+      size_t err_start=0;
+      std::string err_reason;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic,1) num_threads(nthr)
+#endif
+      for(size_t i=0;i<n_starts;i++) {
+
+	size_t it=0;
+#ifdef O2SCL_OPENMP
+	it=omp_get_thread_num();
+#endif
+
+	bool skip;
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_multi_best)
+#endif
+	{
+	  skip=done;
+	}
+
+	if (!skip) {
+
+	  vec_t x(nv);
+	  for(size_t j=0;j<nv;j++) x[j]=starts[i*nv+j];
+	  double f=0.0;
+	  int ret;
+	  bool failed=false;
+	  std::string reason;
+
+	  // Exceptions cannot leave the parallel region, so an error
+	  // is stored here and the error handler is called after the
+	  // loop
+	  try {
+	    ret=mins[it]->mmin(nv,x,f,*func[it%func.size()]);
+	  } catch (const std::exception &e) {
+	    failed=true;
+	    ret=err_hnd->get_errno();
+	    if (ret==0) ret=exc_efailed;
+	    reason=e.what();
+	  }
+
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_multi_best)
+#endif
+	  {
+	    start_fmin[i]=f;
+	    start_ret[i]=ret;
+	    n_done++;
+
+	    if (failed) {
+
+	      if (err_ret==0) {
+		err_ret=ret;
+		err_start=i;
+		err_reason=reason;
+	      }
+	      done=true;
+	      
+	    } else {
+	      
+	      double tol=tol_agree*(1.0+fabs(f_best));
+	      if (!found || f<f_best-tol) {
+		found=true;
+		count=1;
+		f_best=f;
+		for(size_t j=0;j<nv;j++) x_best[j]=x[j];
+	      } else if (f<=f_best+tol) {
+		count++;
+		if (f<f_best) {
+		  f_best=f;
+		  for(size_t j=0;j<nv;j++) x_best[j]=x[j];
+		}
+	      }
+	      if (n_agree>0 && count>=n_agree) done=true;
+
+	      if (this->verbose>0) {
+		std::cout << "mmin_multi::mmin(): start " << i
+			  << " f: " << f << " ret: " << ret
+			  << " best: " << f_best << " agree: "
+			  << count << std::endl;
+	      }
+	    }
+	  }
+
+	}
+
+      }
+
+      this->last_ntrial=n_done;
+
+      if (err_ret!=0) {
+	std::string str="Local minimization from start "+
+	  o2scl::szttos(err_start)+" failed in mmin_multi::mmin(): "+
+	  err_reason;
+	O2SCL_ERR(str.c_str(),err_ret);
+	return err_ret;
+      }
+
+      fmin=f_best;
+      for(size_t j=0;j<nv;j++) x0[j]=x_best[j];
+
+      return 0;
+    }
+
+  private:
+
+    mmin_multi<func_t,vec_t,mmin_t>
+    (const mmin_multi<func_t,vec_t,mmin_t> &);
+    mmin_multi<func_t,vec_t,mmin_t>& operator=
+    (const mmin_multi<func_t,vec_t,mmin_t>&);
+
+#endif
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <cmath>
+
+#include <o2scl/multi_funct.h>
+#include <o2scl/mmin_multi.h>
+#include <o2scl/mmin_bfgs2.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+
+// A function with many local minima and a global minimum of
+// zero at (1,-1)
+double minfun(size_t n, const ubvector &x) {
+  double ret=0.0;
+  for(size_t i=0;i<2;i++) {
+    double y=x[i]-(i==0 ? 1.0 : -1.0);
+    ret+=y*y+2.0*(1.0-cos(2.0*M_PI*y));
+  }
+  return ret;
+}
+
+// The same function, but the error handler is called when x[0] is
+// larger than 2
+double errfun(size_t n, const ubvector &x) {
+  if (x[0]>2.0) {
+    O2SCL_ERR("Outside of region in errfun().",exc_edom);
+  }
+  return minfun(n,x);
+}
+
+int main(void) {
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  multi_funct mf=minfun;
+  ubvector x(2), low(2), high(2);
+  double fmin;
+
+  low[0]=-5.0;
+  low[1]=-5.0;
+  high[0]=5.0;
+  high[1]=5.0;
+
+  // Each of the methods for choosing the starting points
+
+  for(size_t k=0;k<3;k++) {
+    mmin_multi<> mm;
+    mm.r.set_seed(10);
+    mm.start_method=k;
+    mm.n_starts=40;
+    mm.set_limits(2,low,high);
+    mm.tol_abs=1.0e-8;
+    mm.tol_rel=1.0e-8;
+    x[0]=4.0;
+    x[1]=4.0;
+    mm.mmin(2,x,fmin,mf);
+    cout << k << " " << fmin << " " << x[0] << " " << x[1] << " "
+	 << mm.last_ntrial << endl;
+    t.test_abs(fmin,0.0,1.0e-6,"fmin");
+    t.test_abs(x[0],1.0,1.0e-3,"x[0]");
+    t.test_abs(x[1],-1.0,1.0e-3,"x[1]");
+    t.test_gen(mm.last_ntrial==40,"all starts");
+  }
+
+  // Stop early when enough minima agree, using one function
+  // object for each thread
+  {
+    mmin_multi<> mm;
+    mm.r.set_seed(10);
+    mm.n_starts=200;
+    mm.n_agree=3;
+    mm.n_threads=2;
+    mm.set_limits(2,low,high);
+    mm.tol_abs=1.0e-8;
+    mm.tol_rel=1.0e-8;
+    std::vector<multi_funct> vmf(2,mf);
+    x[0]=4.0;
+    x[1]=4.0;
+    mm.mmin(2,x,fmin,vmf);
+    cout << fmin << " " << x[0] << " " << x[1] << " "
+	 << mm.last_ntrial << endl;
+    t.test_abs(fmin,0.0,1.0e-6,"early fmin");
+    t.test_gen(mm.last_ntrial<200,"early stop");
+  }
+
+  // A gradient-based local minimizer
+  {
+    mmin_multi<multi_funct,ubvector,mmin_bfgs2<multi_funct> > mm;
+    mm.r.set_seed(10);
+    mm.n_starts=40;
+    mm.set_limits(2,low,high);
+    x[0]=4.0;
+    x[1]=4.0;
+    mm.mmin(2,x,fmin,mf);
+    cout << fmin << " " << x[0] << " " << x[1] << " "
+	 << mm.last_ntrial << endl;
+    // The gradient-based method often stalls on this function,
+    // but the result should still be the best of all the starts
+    double fbest=mm.start_fmin[0];
+    for(size_t i=1;i<mm.start_fmin.size();i++) {
+      if (mm.start_fmin[i]<fbest) fbest=mm.start_fmin[i];
+    }
+    t.test_gen(fmin==fbest,"bfgs2 best");
+    t.test_gen(fmin<mm.start_fmin[0],"bfgs2 improved");
+  }
+
+  // An error in one of the local minimizations is passed on after
+  // the threads have finished
+  {
+    mmin_multi<> mm;
+    mm.r.set_seed(10);
+    mm.n_starts=40;
+    mm.n_threads=2;
+    mm.set_limits(2,low,high);
+    multi_funct mf2=errfun;
+    x[0]=0.0;
+    x[1]=0.0;
+    int err=0;
+    try {
+      mm.mmin(2,x,fmin,mf2);
+    } catch (std::exception &e) {
+      err=err_hnd->get_errno();
+      err_hnd->reset();
+    }
+    t.test_gen(err==exc_edom,"error passed on");
+    t.test_gen(mm.last_ntrial<40,"error stops starts");
+  }
+
+  t.report();
+  return 0;
+}
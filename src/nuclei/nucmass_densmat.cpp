@@ -557,3 +557,114 @@ void nucmass_densmat::binding_energy_densmat_derivs
 
   return;
 }
+
+void nucmass_densmat::set_soa(const std::vector<nucleus> &dist,
+			      nucdist_soa &soa) {
+
+  if (massp==0) {
+    O2SCL_ERR("Masses not specified in nucmass_densmat::set_soa().",
+	      exc_efailed);
+  }
+
+  size_t n=dist.size();
+  soa.Z.resize(n);
+  soa.N.resize(n);
+  soa.g.resize(n);
+  soa.be_vac.resize(n);
+  soa.coul_fac.resize(n);
+  soa.be.resize(n);
+  soa.dEdnp.resize(n);
+  soa.dEdnneg.resize(n);
+  soa.m.resize(n);
+  soa.n.resize(n);
+  soa.mu.resize(n);
+  soa.ed.resize(n);
+  soa.en.resize(n);
+  
+  for(size_t i=0;i<n;i++) {
+    double Z=dist[i].Z, N=dist[i].N;
+    if (!massp->is_included(dist[i].Z,dist[i].N)) {
+      O2SCL_ERR((((string)"Mass with Z=")+o2scl::dtos(Z)+" and N="+
+		 o2scl::dtos(N)+" not included in nucmass_densmat"+
+		 "::set_soa().").c_str(),exc_einval);
+    }
+    soa.Z[i]=Z;
+    soa.N[i]=N;
+    soa.g[i]=dist[i].g;
+    soa.be_vac[i]=massp->mass_excess_d(Z,N)+(Z+N)*massp->m_amu-
+      Z*massp->m_elec-N*massp->m_neut-Z*massp->m_prot;
+    double cbZ=cbrt(Z);
+    soa.coul_fac[i]=(Z+N)*cbZ*cbZ;
+  }
+  soa.massp=massp;
+  
+  return;
+}
+
+bool nucmass_densmat::is_soa_current(const std::vector<nucleus> &dist,
+				     const nucdist_soa &soa) {
+  if (soa.massp!=massp || soa.size()!=dist.size()) return false;
+  for(size_t i=0;i<dist.size();i++) {
+    if (soa.Z[i]!=dist[i].Z || soa.N[i]!=dist[i].N ||
+	soa.g[i]!=dist[i].g) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void nucmass_densmat::binding_energy_densmat_soa
+(nucdist_soa &soa, double npout, double nnout, double nneg, double T) {
+
+  // Half saturation density
+  double n0o2=0.08;
+
+  if (nneg<npout) {
+    O2SCL_ERR2("Not enough negative charges in nucmass_densmat::",
+	       "binding_energy_densmat_soa().",exc_einval);
+  }
+  if (npout>n0o2) {
+    O2SCL_ERR2("Too many protons in nucmass_densmat::",
+	       "binding_energy_densmat_soa().",exc_einval);
+  }
+
+  // The proton volume fraction, R_p^3/R_WS^3, and the factor 
+  // R_p^2/Z^{2/3} are the same for all nuclei
+  double chi_p=(nneg-npout)/(n0o2-npout);
+  double rfac=cbrt(3.0/4.0/o2scl_const::pi/(n0o2-npout));
+  double R_p_2_fac=rfac*rfac;
+
+  // Allow a small error from finite precision, as in
+  // binding_energy_densmat_derivs()
+  if (chi_p>1.0) {
+    double cchi=cbrt(chi_p);
+    R_p_2_fac*=(1.0-1.0e-8)*(1.0-1.0e-8)/cchi/cchi;
+    chi_p=pow(1.0-1.0e-8,3.0);
+  }
+
+  double fdu=0.2*chi_p-0.6*cbrt(chi_p);
+  double coul_all=2.0*o2scl_const::pi*o2scl_const::hc_mev_fm*
+    o2scl_const::fine_structure*R_p_2_fac*
+    pow(fabs(n0o2-npout),2.0)/0.16*fdu;
+  
+  // Derivatives
+  double dfof=(0.2-0.2*pow(chi_p,-2.0/3.0))/fdu;
+  double dchi_dnp=-(n0o2-nneg)/pow(n0o2-npout,2.0);
+  double dchi_dnneg=1.0/(n0o2-npout);
+  double fac_np=-4.0/3.0/(n0o2-npout)+dfof*dchi_dnp;
+  double fac_nneg=dfof*dchi_dnneg;
+
+  size_t n=soa.size();
+  if (n==0) return;
+  const double *coul_fac=&soa.coul_fac[0];
+  const double *be_vac=&soa.be_vac[0];
+  double *be=&soa.be[0], *dEdnp=&soa.dEdnp[0], *dEdnneg=&soa.dEdnneg[0];
+  for(size_t i=0;i<n;i++) {
+    double coul=coul_all*coul_fac[i];
+    be[i]=be_vac[i]+coul;
+    dEdnp[i]=coul*fac_np;
+    dEdnneg[i]=coul*fac_nneg;
+  }
+  
+  return;
+}
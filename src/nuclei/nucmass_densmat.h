@@ -267,8 +267,79 @@ namespace o2scl {
     
   };
 
+  /** \brief A structure-of-arrays copy of a distribution of nuclei
+
+      This class is experimental.
+
+      This class stores the properties of a distribution of nuclei
+      in contiguous arrays so that the loops over a large distribution
+      in \ref o2scl::eos_nse_full are simple and can be vectorized.
+      The vectors \ref Z, \ref N, \ref g, \ref be_vac and \ref
+      coul_fac depend only on the distribution and the mass formula,
+      and are set by \ref nucmass_densmat::set_soa(). The remaining
+      vectors are workspace which is recomputed at every point.
+
+      The contents of a \ref o2scl::nucleus object are not modified
+      by this class.
+  */
+  class nucdist_soa {
+
+  public:
+
+    /// \name Properties of the distribution
+    //@{
+    /// Proton number
+    std::vector<double> Z;
+    /// Neutron number
+    std::vector<double> N;
+    /// Degeneracy
+    std::vector<double> g;
+    /// Binding energy in vacuum (in MeV)
+    std::vector<double> be_vac;
+    /** \brief The factor \f$ (Z+N) Z^{2/3} \f$ for the Coulomb
+	energy
+    */
+    std::vector<double> coul_fac;
+    //@}
+
+    /// \name Workspace
+    //@{
+    /// Binding energy in dense matter
+    std::vector<double> be;
+    /// Derivative of the binding energy wrt the external proton density
+    std::vector<double> dEdnp;
+    /** \brief Derivative of the binding energy wrt the density of
+	negative charges
+    */
+    std::vector<double> dEdnneg;
+    /// Mass
+    std::vector<double> m;
+    /// Number density
+    std::vector<double> n;
+    /// Chemical potential
+    std::vector<double> mu;
+    /// Energy density
+    std::vector<double> ed;
+    /// Entropy density
+    std::vector<double> en;
+    //@}
+
+    /// The base mass formula used to compute \ref be_vac
+    const nucmass *massp;
+
+    nucdist_soa() {
+      massp=0;
+    }
+
+    /// Return the number of nuclei
+    size_t size() const {
+      return Z.size();
+    }
+
+  };
+
   /** \brief A nuclear mass formula for dense matter
-      
+
       This class is experimental.
 
       The default set of nuclear masses is from the AME 2012
@@ -334,6 +405,42 @@ namespace o2scl {
       (double Z, double N, double npout, double nnout, 
        double nneg, double T, double &E);
 
+    /// \name Distributions of nuclei
+    //@{
+    /** \brief Fill \c soa from the distribution \c dist
+
+	This computes the vacuum binding energies from the current
+	base mass formula, so it must be called again if the mass
+	formula is changed with \ref set_mass(). The error handler
+	is called if one of the nuclei is not included in the
+	mass formula.
+    */
+    void set_soa(const std::vector<nucleus> &dist, nucdist_soa &soa);
+
+    /** \brief Return true if \c soa was created from the distribution
+	\c dist and the current mass formula
+    */
+    bool is_soa_current(const std::vector<nucleus> &dist,
+			const nucdist_soa &soa);
+
+    /** \brief Compute the binding energies and their derivatives
+	for all of the nuclei in \c soa
+
+	This stores the same quantities as \ref
+	binding_energy_densmat_derivs() in <tt>soa.be</tt> (in MeV),
+	<tt>soa.dEdnp</tt>, and <tt>soa.dEdnneg</tt>. The Coulomb
+	correction factors into a part which depends only on the
+	densities and the factor in <tt>soa.coul_fac</tt>, so the loop
+	over the distribution only requires a few multiplications for
+	each nucleus. Children which modify \ref
+	binding_energy_densmat_derivs() should also modify this
+	function.
+    */
+    virtual void binding_energy_densmat_soa
+      (nucdist_soa &soa, double npout, double nnout,
+       double nneg, double T);
+    //@}
+
   };
 
 #ifndef DOXYGEN_NO_O2NS
@@ -43,7 +43,21 @@ namespace o2scl {
 			    const boost::numeric::ublas::vector<double> &,
 			    boost::numeric::ublas::vector<double> &)> 
     ode_funct;
-  
+
+  /** \brief Ensemble of ordinary differential equations in
+      src/ode/ode_funct.h
+
+      The function is called as <tt>func(nt,x,nv,y,dydx)</tt> and
+      must compute the derivatives of \c nt independent trajectories
+      of an \c nv-dimensional system. The independent variable of
+      trajectory \c j is <tt>x[j]</tt>. The function values and
+      derivatives are stored structure-of-arrays, so that variable \c
+      i of trajectory \c j is <tt>y[i*nt+j]</tt>.
+   */
+  typedef std::function<int(size_t,const double *,size_t,
+			    const double *,double *)>
+    ode_ensemble_funct;
+
   /** \brief One-dimensional function from strings
       \nothing
   */
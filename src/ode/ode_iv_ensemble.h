@@ -0,0 +1,883 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_ODE_IV_ENSEMBLE_H
+#define O2SCL_ODE_IV_ENSEMBLE_H
+
+/** \file ode_iv_ensemble.h
+    \brief File defining \ref o2scl::ode_iv_ensemble
+*/
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <iostream>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+#include <o2scl/err_hnd.h>
+#include <o2scl/string_conv.h>
+#include <o2scl/ode_funct.h>
+
+namespace o2scl {
+
+  /** \brief Embedded Runge-Kutta stepper for an ensemble of
+      trajectories
+
+      This class stores the Butcher tableau of an explicit embedded
+      Runge-Kutta method and takes one step for a set of independent
+      trajectories stored structure-of-arrays, each with its own
+      value of the independent variable and its own stepsize. Each
+      stage is a simple loop over all variables and trajectories,
+      which the compiler can vectorize.
+
+      The Cash-Karp tableau (the method used in \ref ode_rkck_gsl) is
+      the default, and the Prince-Dormand tableau (the method used in
+      \ref ode_rk8pd_gsl) can be selected with \ref set_rk8pd().
+
+      The function step() is const and all temporary storage is
+      provided by the caller, so one object can be shared between
+      several threads.
+  */
+  class ode_ensemble_rk {
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The number of stages
+    size_t n_stages;
+
+    /// The order of the method
+    size_t order;
+
+    /// \name The tableau
+    //@{
+    /// The nodes
+    std::vector<double> c;
+    /// The Runge-Kutta matrix, stored as <tt>a[s*n_stages+k]</tt>
+    std::vector<double> a;
+    /// The weights for the solution
+    std::vector<double> b;
+    /// The weights for the error estimate
+    std::vector<double> e;
+    //@}
+
+    /// Allocate space for a tableau with \c ns stages
+    void allocate(size_t ns) {
+      n_stages=ns;
+      c.assign(ns,0.0);
+      a.assign(ns*ns,0.0);
+      b.assign(ns,0.0);
+      e.assign(ns,0.0);
+      return;
+    }
+
+#endif
+
+  public:
+
+    ode_ensemble_rk() {
+      set_rkck();
+    }
+
+    /// Use the Cash-Karp method
+    void set_rkck() {
+
+      allocate(6);
+      order=5;
+
+      c[1]=1.0/5.0;
+      c[2]=3.0/10.0;
+      c[3]=3.0/5.0;
+      c[4]=1.0;
+      c[5]=7.0/8.0;
+
+      a[1*6+0]=1.0/5.0;
+
+      a[2*6+0]=3.0/40.0;
+      a[2*6+1]=9.0/40.0;
+
+      a[3*6+0]=3.0/10.0;
+      a[3*6+1]=-9.0/10.0;
+      a[3*6+2]=12.0/10.0;
+
+      a[4*6+0]=-11.0/54.0;
+      a[4*6+1]=5.0/2.0;
+      a[4*6+2]=-70.0/27.0;
+      a[4*6+3]=35.0/27.0;
+
+      a[5*6+0]=1631.0/55296.0;
+      a[5*6+1]=175.0/512.0;
+      a[5*6+2]=575.0/13824.0;
+      a[5*6+3]=44275.0/110592.0;
+      a[5*6+4]=253.0/4096.0;
+
+      b[0]=37.0/378.0;
+      b[2]=250.0/621.0;
+      b[3]=125.0/594.0;
+      b[5]=512.0/1771.0;
+
+      e[0]=37.0/378.0-2825.0/27648.0;
+      e[2]=250.0/621.0-18575.0/48384.0;
+      e[3]=125.0/594.0-13525.0/55296.0;
+      e[4]=-277.0/14336.0;
+      e[5]=512.0/1771.0-1.0/4.0;
+
+      return;
+    }
+
+    /// Use the Prince-Dormand method
+    void set_rk8pd() {
+
+      allocate(13);
+      order=8;
+
+      c[1]=1.0/18.0;
+      c[2]=1.0/12.0;
+      c[3]=1.0/8.0;
+      c[4]=5.0/16.0;
+      c[5]=3.0/8.0;
+      c[6]=59.0/400.0;
+      c[7]=93.0/200.0;
+      c[8]=5490023248.0/9719169821.0;
+      c[9]=13.0/20.0;
+      c[10]=1201146811.0/1299019798.0;
+      c[11]=1.0;
+      c[12]=1.0;
+
+      a[1*13+0]=1.0/18.0;
+
+      a[2*13+0]=1.0/48.0;
+      a[2*13+1]=1.0/16.0;
+
+      a[3*13+0]=1.0/32.0;
+      a[3*13+2]=3.0/32.0;
+
+      a[4*13+0]=5.0/16.0;
+      a[4*13+2]=-75.0/64.0;
+      a[4*13+3]=75.0/64.0;
+
+      a[5*13+0]=3.0/80.0;
+      a[5*13+3]=3.0/16.0;
+      a[5*13+4]=3.0/20.0;
+
+      a[6*13+0]=29443841.0/614563906.0;
+      a[6*13+3]=77736538.0/692538347.0;
+      a[6*13+4]=-28693883.0/1125000000.0;
+      a[6*13+5]=23124283.0/1800000000.0;
+
+      a[7*13+0]=16016141.0/946692911.0;
+      a[7*13+3]=61564180.0/158732637.0;
+      a[7*13+4]=22789713.0/633445777.0;
+      a[7*13+5]=545815736.0/2771057229.0;
+      a[7*13+6]=-180193667.0/1043307555.0;
+
+      a[8*13+0]=39632708.0/573591083.0;
+      a[8*13+3]=-433636366.0/683701615.0;
+      a[8*13+4]=-421739975.0/2616292301.0;
+      a[8*13+5]=100302831.0/723423059.0;
+      a[8*13+6]=790204164.0/839813087.0;
+      a[8*13+7]=800635310.0/3783071287.0;
+
+      a[9*13+0]=246121993.0/1340847787.0;
+      a[9*13+3]=-37695042795.0/15268766246.0;
+      a[9*13+4]=-309121744.0/1061227803.0;
+      a[9*13+5]=-12992083.0/490766935.0;
+      a[9*13+6]=6005943493.0/2108947869.0;
+      a[9*13+7]=393006217.0/1396673457.0;
+      a[9*13+8]=123872331.0/1001029789.0;
+
+      a[10*13+0]=-1028468189.0/846180014.0;
+      a[10*13+3]=8478235783.0/508512852.0;
+      a[10*13+4]=1311729495.0/1432422823.0;
+      a[10*13+5]=-10304129995.0/1701304382.0;
+      a[10*13+6]=-48777925059.0/3047939560.0;
+      a[10*13+7]=15336726248.0/1032824649.0;
+      a[10*13+8]=-45442868181.0/3398467696.0;
+      a[10*13+9]=3065993473.0/597172653.0;
+
+      a[11*13+0]=185892177.0/718116043.0;
+      a[11*13+3]=-3185094517.0/667107341.0;
+      a[11*13+4]=-477755414.0/1098053517.0;
+      a[11*13+5]=-703635378.0/230739211.0;
+      a[11*13+6]=5731566787.0/1027545527.0;
+      a[11*13+7]=5232866602.0/850066563.0;
+      a[11*13+8]=-4093664535.0/808688257.0;
+      a[11*13+9]=3962137247.0/1805957418.0;
+      a[11*13+10]=65686358.0/487910083.0;
+
+      a[12*13+0]=403863854.0/491063109.0;
+      a[12*13+3]=-5068492393.0/434740067.0;
+      a[12*13+4]=-411421997.0/543043805.0;
+      a[12*13+5]=652783627.0/914296604.0;
+      a[12*13+6]=11173962825.0/925320556.0;
+      a[12*13+7]=-13158990841.0/6184727034.0;
+      a[12*13+8]=3936647629.0/1978049680.0;
+      a[12*13+9]=-160528059.0/685178525.0;
+      a[12*13+10]=248638103.0/1413531060.0;
+
+      // The eighth-order weights
+      b[0]=14005451.0/335480064.0;
+      b[5]=-59238493.0/1068277825.0;
+      b[6]=181606767.0/758867731.0;
+      b[7]=561292985.0/797845732.0;
+      b[8]=-1041891430.0/1371343529.0;
+      b[9]=760417239.0/1151165299.0;
+      b[10]=118820643.0/751138087.0;
+      b[11]=-528747749.0/2220607170.0;
+      b[12]=1.0/4.0;
+
+      // The error weights are the seventh-order weights minus the
+      // eighth-order weights
+      e[0]=13451932.0/455176623.0-b[0];
+      e[5]=-808719846.0/976000145.0-b[5];
+      e[6]=1757004468.0/5645159321.0-b[6];
+      e[7]=656045339.0/265891186.0-b[7];
+      e[8]=-3867574721.0/1518517206.0-b[8];
+      e[9]=465885868.0/322736535.0-b[9];
+      e[10]=53011238.0/667516719.0-b[10];
+      e[11]=2.0/45.0-b[11];
+      e[12]=-b[12];
+
+      return;
+    }
+
+    /// Return the order of the method
+    size_t get_order() const {
+      return order;
+    }
+
+    /// Return the number of stages (derivative evaluations per step)
+    size_t get_stages() const {
+      return n_stages;
+    }
+
+    /** \brief Perform an integration step for \c nt trajectories
+
+        Given the initial values of the \c nv functions of \c nt
+        trajectories in \c y and the derivatives in \c dydx (which
+        must be computed beforehand) at the points \c x, take a step
+        of size <tt>h[j]</tt> for each trajectory \c j giving the
+        result in \c yout, the uncertainty in \c yerr, and the new
+        derivatives in \c dydx_out. All of the arrays of function
+        values and derivatives are structure-of-arrays with variable
+        \c i of trajectory \c j in element <tt>i*nt+j</tt>. The
+        arrays \c yout and \c dydx_out must not refer to the same
+        memory as \c y or \c dydx. The vector \c work is used as
+        temporary storage and is resized if necessary.
+
+        If \c derivs always returns zero, then this function will
+        also return zero. If not, step() will return the first
+        non-zero value which was obtained in a call to \c derivs.
+        The error handler is never called.
+    */
+    template<class func_t>
+    int step(size_t nt, size_t nv, const double *x, const double *h,
+             const double *y, const double *dydx, double *yout,
+             double *yerr, double *dydx_out, std::vector<double> &work,
+             func_t &derivs) const {
+
+      size_t nn=nv*nt;
+      if (work.size()<n_stages*nn+nt) work.resize(n_stages*nn+nt);
+
+      // Temporary function values, then the temporary values of the
+      // independent variable, then the stages 1 through n_stages-1
+      double *ytmp=&work[0];
+      double *xtmp=ytmp+nn;
+      double *k1=xtmp+nt;
+
+      int ret=0;
+
+      for(size_t s=1;s<n_stages;s++) {
+
+        const double *as=&a[s*n_stages];
+
+        for(size_t ix=0;ix<nn;ix++) {
+          ytmp[ix]=as[0]*dydx[ix];
+        }
+        for(size_t k=1;k<s;k++) {
+          if (as[k]!=0.0) {
+            const double *kk=k1+(k-1)*nn;
+            for(size_t ix=0;ix<nn;ix++) {
+              ytmp[ix]+=as[k]*kk[ix];
+            }
+          }
+        }
+        for(size_t i=0;i<nv;i++) {
+          for(size_t j=0;j<nt;j++) {
+            ytmp[i*nt+j]=y[i*nt+j]+h[j]*ytmp[i*nt+j];
+          }
+        }
+        for(size_t j=0;j<nt;j++) {
+          xtmp[j]=x[j]+c[s]*h[j];
+        }
+
+        error_update(ret,derivs(nt,xtmp,nv,ytmp,k1+(s-1)*nn));
+      }
+
+      // Final sums for the solution and the error
+      for(size_t ix=0;ix<nn;ix++) {
+        yout[ix]=b[0]*dydx[ix];
+        yerr[ix]=e[0]*dydx[ix];
+      }
+      for(size_t k=1;k<n_stages;k++) {
+        const double *kk=k1+(k-1)*nn;
+        if (b[k]!=0.0) {
+          for(size_t ix=0;ix<nn;ix++) {
+            yout[ix]+=b[k]*kk[ix];
+          }
+        }
+        if (e[k]!=0.0) {
+          for(size_t ix=0;ix<nn;ix++) {
+            yerr[ix]+=e[k]*kk[ix];
+          }
+        }
+      }
+      for(size_t i=0;i<nv;i++) {
+        for(size_t j=0;j<nt;j++) {
+          yout[i*nt+j]=y[i*nt+j]+h[j]*yout[i*nt+j];
+          yerr[i*nt+j]*=h[j];
+        }
+      }
+
+      for(size_t j=0;j<nt;j++) {
+        xtmp[j]=x[j]+h[j];
+      }
+      error_update(ret,derivs(nt,xtmp,nv,yout,dydx_out));
+
+      return ret;
+    }
+
+  };
+
+  /** \brief Solve an initial-value ODE problem for an ensemble of
+      independent trajectories
+
+      This class integrates the same system of \c nv ODEs for \c nt
+      different initial conditions (and possibly different
+      integration intervals). The trajectories are divided into
+      blocks of \ref block_size trajectories. Within each block, all
+      of the trajectories which have not yet finished are advanced
+      together by one adaptive step of \ref stepper, with a separate
+      stepsize for each trajectory, so that the user-specified
+      derivative function is called with many trajectories at once.
+      When a trajectory reaches its endpoint, it is removed from the
+      block. If OpenMP support is enabled, the blocks are distributed
+      over \ref n_threads threads, in which case the derivative
+      function must be safe to call from several threads at once.
+
+      The function values are stored structure-of-arrays: variable \c
+      i of trajectory \c j is element <tt>i*nt+j</tt> of the vectors
+      given to solve_final_value(). The derivative function is called
+      with the same layout (see \ref ode_ensemble_funct), but with the
+      number of trajectories in the current block in place of \c nt.
+
+      The stepsize of each trajectory is adjusted using the same
+      standard control method as \ref ode_control_gsl, controlled
+      by \ref eps_abs, \ref eps_rel, \ref a_y, and \ref a_dydt, and
+      the steps are accepted or rejected in the same way as in \ref
+      astep_gsl. Because each trajectory is independent, the results
+      do not depend on \ref block_size or the number of threads. The
+      only exception is that if the derivative function returns a
+      non-zero value, the stepsizes of all of the trajectories in
+      that call are halved and the step is attempted again.
+
+      The number of steps for each trajectory is limited by \ref
+      ntrial. If more steps are required, the corresponding element
+      of \ref status is set to \ref o2scl::exc_emaxiter and the
+      error handler is called at the end if \ref err_nonconv is true.
+      If the stepper fails for a trajectory, the corresponding element
+      of \ref status is set to the failure value and the error handler
+      is called at the end if \ref exit_on_fail is true. In both
+      cases, the final values for that trajectory are the values from
+      the last successful step. Errors are never thrown from inside a
+      parallel region. If the error handler is called by the
+      derivative function, then the elements of \ref status for the
+      trajectories in that block are set to the error value, their
+      final values are not specified, and the error handler is called
+      again with the same error value once all of the blocks are
+      finished.
+  */
+  template<class func_t=ode_ensemble_funct,
+           class vec_t=std::vector<double> >
+  class ode_iv_ensemble {
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// Temporary storage for one block of trajectories
+    class block_workspace {
+
+    public:
+
+      /// \name Independent variable, endpoint and stepsizes
+      //@{
+      std::vector<double> x, xend, h, htry;
+      //@}
+      /// \name Function values and derivatives
+      //@{
+      std::vector<double> y, dydx, yout, yerr, dydx_out;
+      //@}
+      /// Workspace for the stepper
+      std::vector<double> work;
+      /// The index of each trajectory in the full ensemble
+      std::vector<size_t> index;
+      /// True for the final step of a trajectory
+      std::vector<char> final_step;
+      /// True if the trajectory is finished
+      std::vector<char> done;
+
+      /// Allocate for \c nb trajectories with \c nv variables
+      void allocate(size_t nb, size_t nv) {
+        if (x.size()<nb) {
+          x.resize(nb);
+          xend.resize(nb);
+          h.resize(nb);
+          htry.resize(nb);
+          index.resize(nb);
+          final_step.resize(nb);
+          done.resize(nb);
+        }
+        if (y.size()<nb*nv) {
+          y.resize(nb*nv);
+          dydx.resize(nb*nv);
+          yout.resize(nb*nv);
+          yerr.resize(nb*nv);
+          dydx_out.resize(nb*nv);
+        }
+        return;
+      }
+
+    };
+
+    /// Workspaces, one for each thread
+    std::vector<block_workspace> ws;
+
+    /** \brief Integrate the trajectories from \c jstart to
+        <tt>jend-1</tt>
+    */
+    void solve_block(size_t nt, size_t nv, size_t jstart, size_t jend,
+                     const vec_t &x0, const vec_t &x1, vec_t &h,
+                     const vec_t &ystart, vec_t &yend, func_t &derivs,
+                     block_workspace &w) {
+
+      const double S=0.9;
+
+      w.allocate(jend-jstart,nv);
+
+      // Collect the trajectories which need to be integrated
+      size_t na=0;
+      for(size_t j=jstart;j<jend;j++) {
+        status[j]=success;
+        nsteps[j]=0;
+        nfailed[j]=0;
+        if (x0[j]==x1[j]) {
+          for(size_t i=0;i<nv;i++) yend[i*nt+j]=ystart[i*nt+j];
+        } else {
+          w.index[na]=j;
+          w.x[na]=x0[j];
+          w.xend[na]=x1[j];
+          w.h[na]=h[j];
+          na++;
+        }
+      }
+      if (na==0) return;
+
+      for(size_t i=0;i<nv;i++) {
+        for(size_t m=0;m<na;m++) {
+          w.y[i*na+m]=ystart[i*nt+w.index[m]];
+        }
+      }
+
+      // Compute the initial derivatives
+      int ret=derivs(na,&w.x[0],nv,&w.y[0],&w.dydx[0]);
+      if (ret!=0) {
+        for(size_t m=0;m<na;m++) {
+          size_t j=w.index[m];
+          status[j]=ret;
+          for(size_t i=0;i<nv;i++) yend[i*nt+j]=ystart[i*nt+j];
+        }
+        return;
+      }
+
+      while (na>0) {
+
+        // Shorten the steps which would go past the endpoint
+        for(size_t m=0;m<na;m++) {
+          double dt=w.xend[m]-w.x[m];
+          w.htry[m]=w.h[m];
+          w.final_step[m]=0;
+          w.done[m]=0;
+          if ((dt>=0.0 && w.htry[m]>dt) || (dt<0.0 && w.htry[m]<dt)) {
+            w.htry[m]=dt;
+            w.final_step[m]=1;
+          }
+        }
+
+        ret=stepper.step(na,nv,&w.x[0],&w.htry[0],&w.y[0],&w.dydx[0],
+                         &w.yout[0],&w.yerr[0],&w.dydx_out[0],w.work,
+                         derivs);
+
+        if (ret!=0) {
+
+          // The derivative function failed, so try again with a
+          // smaller stepsize for every trajectory in this call
+          for(size_t m=0;m<na;m++) {
+            double h_new=w.htry[m]*0.5;
+            if (fabs(h_new)<fabs(w.htry[m]) && w.x[m]+h_new!=w.x[m]) {
+              w.h[m]=h_new;
+              nfailed[w.index[m]]++;
+            } else {
+              w.h[m]=h_new;
+              status[w.index[m]]=ret;
+              w.done[m]=1;
+            }
+          }
+
+        } else {
+
+          for(size_t m=0;m<na;m++) {
+
+            size_t j=w.index[m];
+            double h_old=w.htry[m];
+
+            // Compute the ratio of the observed to the desired error
+            double rmax=DBL_MIN;
+            for(size_t i=0;i<nv;i++) {
+              double D0=eps_rel*(a_y*fabs(w.yout[i*na+m])+
+                                 a_dydt*fabs(h_old*w.dydx_out[i*na+m]))+
+                eps_abs;
+              double r=fabs(w.yerr[i*na+m])/fabs(D0);
+              if (r>rmax) rmax=r;
+            }
+
+            if (rmax>1.1) {
+
+              // Reject the step and decrease the stepsize
+              double r=S/pow(rmax,1.0/stepper.get_order());
+              if (r<0.2) r=0.2;
+              double h_new=r*h_old;
+              w.h[m]=h_new;
+              if (fabs(h_new)<fabs(h_old) && w.x[m]+h_new!=w.x[m]) {
+                nfailed[j]++;
+              } else {
+                status[j]=gsl_failure;
+                w.done[m]=1;
+              }
+
+            } else {
+
+              // Accept the step
+              nsteps[j]++;
+              if (w.final_step[m]) {
+                w.x[m]=w.xend[m];
+                w.done[m]=1;
+              } else {
+                w.x[m]+=h_old;
+                // Possibly increase the stepsize, which is not done
+                // after the final step
+                if (rmax<0.5) {
+                  double r=S/pow(rmax,1.0/(stepper.get_order()+1.0));
+                  if (r>5.0) r=5.0;
+                  if (r<1.0) r=1.0;
+                  w.h[m]=r*h_old;
+                } else {
+                  w.h[m]=h_old;
+                }
+                if (nsteps[j]>=ntrial) {
+                  status[j]=exc_emaxiter;
+                  w.done[m]=1;
+                }
+              }
+              for(size_t i=0;i<nv;i++) {
+                w.y[i*na+m]=w.yout[i*na+m];
+                w.dydx[i*na+m]=w.dydx_out[i*na+m];
+              }
+
+            }
+          }
+
+        }
+
+        // Store the finished trajectories and remove them from the
+        // block
+        size_t nb=0;
+        for(size_t m=0;m<na;m++) {
+          if (w.done[m]) {
+            size_t j=w.index[m];
+            for(size_t i=0;i<nv;i++) yend[i*nt+j]=w.y[i*na+m];
+            h[j]=w.h[m];
+          } else {
+            nb++;
+          }
+        }
+
+        if (nb<na) {
+          size_t k=0;
+          for(size_t m=0;m<na;m++) {
+            if (!w.done[m]) {
+              for(size_t i=0;i<nv;i++) {
+                w.yout[i*nb+k]=w.y[i*na+m];
+                w.dydx_out[i*nb+k]=w.dydx[i*na+m];
+              }
+              w.index[k]=w.index[m];
+              w.x[k]=w.x[m];
+              w.xend[k]=w.xend[m];
+              w.h[k]=w.h[m];
+              k++;
+            }
+          }
+          std::swap(w.y,w.yout);
+          std::swap(w.dydx,w.dydx_out);
+          na=nb;
+        }
+
+      }
+
+      return;
+    }
+
+#endif
+
+  public:
+
+    ode_iv_ensemble() {
+      verbose=0;
+      ntrial=1000;
+      block_size=64;
+      n_threads=1;
+      exit_on_fail=true;
+      err_nonconv=true;
+      eps_abs=1.0e-6;
+      eps_rel=0.0;
+      a_y=1.0;
+      a_dydt=0.0;
+    }
+
+    virtual ~ode_iv_ensemble() {
+    }
+
+    /// Set output level
+    int verbose;
+
+    /** \brief Maximum number of adaptive steps for each trajectory
+        (default 1000)
+    */
+    size_t ntrial;
+
+    /** \brief Number of trajectories which are advanced together
+        (default 64)
+    */
+    size_t block_size;
+
+    /** \brief Number of OpenMP threads (default 1)
+     */
+    size_t n_threads;
+
+    /** \brief If true, call the error handler if a trajectory
+        requires more than \ref ntrial steps (default true)
+    */
+    bool err_nonconv;
+
+    /** \brief If true, call the error handler if the stepper fails
+        for any trajectory (default true)
+    */
+    bool exit_on_fail;
+
+    /// \name Stepsize control (see \ref ode_control_gsl)
+    //@{
+    /// Absolute precision (default \f$ 10^{-6} \f$)
+    double eps_abs;
+    /// Relative precision (default 0)
+    double eps_rel;
+    /// Function scaling factor (default 1)
+    double a_y;
+    /// Derivative scaling factor (default 0)
+    double a_dydt;
+    //@}
+
+    /// The stepper (default is Cash-Karp)
+    ode_ensemble_rk stepper;
+
+    /// \name Results for each trajectory from the last solution
+    //@{
+    /// The number of accepted steps
+    std::vector<size_t> nsteps;
+    /// The number of rejected steps
+    std::vector<size_t> nfailed;
+    /// The final status
+    std::vector<int> status;
+    //@}
+
+    /** \brief Solve the initial-value problem for \c nt trajectories
+        to get the final values
+
+        Given the initial values of the \c nv functions for \c nt
+        trajectories in \c ystart, this function integrates trajectory
+        \c j from <tt>x0[j]</tt> to <tt>x1[j]</tt> with an initial
+        stepsize of <tt>h[j]</tt>. The final values of the functions
+        are given in \c yend, and on exit \c h contains the last
+        stepsize suggested by the stepsize control for each
+        trajectory (excluding the final step). Both \c ystart and \c
+        yend must have at least <tt>nv*nt</tt> elements, and variable
+        \c i of trajectory \c j is stored in element <tt>i*nt+j</tt>.
+        The initial values of \c yend are ignored.
+
+        The return value is the first non-zero value of \ref status,
+        or zero if all of the trajectories were successful.
+    */
+    int solve_final_value(size_t nt, size_t nv, const vec_t &x0,
+                          const vec_t &x1, vec_t &h, const vec_t &ystart,
+                          vec_t &yend, func_t &derivs) {
+
+      for(size_t j=0;j<nt;j++) {
+        if ((x1[j]>x0[j] && h[j]<=0.0) || (x0[j]>x1[j] && h[j]>=0.0)) {
+          std::string str="Interval direction (x1-x0="+
+            o2scl::dtos(x1[j]-x0[j])+") does not match step direction "+
+            "(h="+o2scl::dtos(h[j])+") for trajectory "+o2scl::szttos(j)+
+            " in ode_iv_ensemble::solve_final_value().";
+          O2SCL_ERR(str.c_str(),exc_einval);
+          return exc_einval;
+        }
+      }
+      if (block_size==0) {
+        O2SCL_ERR2("Block size is zero in ",
+                   "ode_iv_ensemble::solve_final_value().",exc_einval);
+        return exc_einval;
+      }
+
+      nsteps.resize(nt);
+      nfailed.resize(nt);
+      status.resize(nt);
+
+      size_t nthr=n_threads;
+      if (nthr==0) nthr=1;
+#ifdef O2SCL_OPENMP
+      omp_set_num_threads(nthr);
+#else
+      if (nthr>1) {
+        if (verbose>0) {
+          std::cout << "ode_iv_ensemble::solve_final_value(): "
+                    << nthr << " threads were requested but the "
+                    << "-DO2SCL_OPENMP flag was not used during "
+                    << "compilation. Using one thread." << std::endl;
+        }
+        nthr=1;
+      }
+#endif
+      if (ws.size()<nthr) ws.resize(nthr);
+
+      size_t n_blocks=(nt+block_size-1)/block_size;
+
+      // Exceptions cannot leave the parallel region, so the first
+      // error from the derivative function is stored here and the
+      // error handler is called after the loop
+      int err_ret=0;
+      size_t err_block=0;
+      std::string err_reason;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic)
+#endif
+      for(size_t ib=0;ib<n_blocks;ib++) {
+        size_t it=0;
+#ifdef O2SCL_OPENMP
+        it=omp_get_thread_num();
+#endif
+        size_t jend=(ib+1)*block_size;
+        if (jend>nt) jend=nt;
+        try {
+          solve_block(nt,nv,ib*block_size,jend,x0,x1,h,ystart,yend,
+                      derivs,ws[it]);
+        } catch (const std::exception &e) {
+          int ret=err_hnd->get_errno();
+          if (ret==0) ret=exc_efailed;
+          for(size_t j=ib*block_size;j<jend;j++) status[j]=ret;
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_ode_iv_ensemble_err)
+#endif
+          {
+            if (err_ret==0) {
+              err_ret=ret;
+              err_block=ib;
+              err_reason=e.what();
+            }
+          }
+        }
+      }
+
+      if (err_ret!=0) {
+        std::string str="Derivative function failed in block "+
+          o2scl::szttos(err_block)+
+          " in ode_iv_ensemble::solve_final_value(): "+err_reason;
+        O2SCL_ERR(str.c_str(),err_ret);
+        return err_ret;
+      }
+
+      int ret=0;
+      size_t jfail=0;
+      for(size_t j=0;j<nt;j++) {
+        if (status[j]!=0 && ret==0) {
+          ret=status[j];
+          jfail=j;
+        }
+      }
+
+      if (verbose>0) {
+        size_t tot_steps=0, tot_failed=0;
+        for(size_t j=0;j<nt;j++) {
+          tot_steps+=nsteps[j];
+          tot_failed+=nfailed[j];
+        }
+        std::cout << "ode_iv_ensemble::solve_final_value(): "
+                  << nt << " trajectories, " << tot_steps
+                  << " steps, " << tot_failed << " failed steps."
+                  << std::endl;
+      }
+
+      if (ret==exc_emaxiter) {
+        std::string str="Too many steps required (ntrial="+
+          o2scl::szttos(ntrial)+") for trajectory "+o2scl::szttos(jfail)+
+          " in ode_iv_ensemble::solve_final_value().";
+        O2SCL_CONV_RET(str.c_str(),exc_emaxiter,err_nonconv);
+      } else if (ret!=0 && exit_on_fail) {
+        std::string str="Adaptive stepper failed for trajectory "+
+          o2scl::szttos(jfail)+" in ode_iv_ensemble::solve_final_value().";
+        O2SCL_ERR(str.c_str(),ret);
+      }
+
+      return ret;
+    }
+
+    /// Return the type, \c "ode_iv_ensemble".
+    virtual const char *type() { return "ode_iv_ensemble"; }
+
+  };
+
+}
+
+#endif
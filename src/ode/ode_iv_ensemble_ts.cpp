@@ -0,0 +1,194 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/ode_iv_ensemble.h>
+#include <o2scl/ode_iv_solve.h>
+#include <o2scl/ode_rk8pd_gsl.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+
+// The frequency of trajectory j
+double omega(size_t j) {
+  return 1.0+0.01*((double)j);
+}
+
+/* Harmonic oscillators with different frequencies. Since the
+   trajectories in each call vary, the frequency is stored as a third
+   variable with a vanishing derivative.
+*/
+int derivs_ens(size_t nt, const double *x, size_t nv,
+               const double *y, double *dydx) {
+  for(size_t j=0;j<nt;j++) {
+    dydx[j]=y[nt+j];
+    dydx[nt+j]=-y[2*nt+j]*y[2*nt+j]*y[j];
+    dydx[2*nt+j]=0.0;
+  }
+  return 0;
+}
+
+// Calls the error handler for the trajectories with the largest
+// frequencies
+int derivs_ens_err(size_t nt, const double *x, size_t nv,
+                   const double *y, double *dydx) {
+  for(size_t j=0;j<nt;j++) {
+    if (y[2*nt+j]>2.9) {
+      O2SCL_ERR("Frequency too large in derivs_ens_err().",
+                exc_efailed);
+    }
+  }
+  return derivs_ens(nt,x,nv,y,dydx);
+}
+
+int derivs(double x, size_t nv, const ubvector &y, ubvector &dydx) {
+  dydx[0]=y[1];
+  dydx[1]=-y[2]*y[2]*y[0];
+  dydx[2]=0.0;
+  return 0;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  const size_t nt=200, nv=3;
+
+  ode_ensemble_funct oef=derivs_ens;
+  ode_iv_ensemble<> oie;
+  oie.eps_abs=1.0e-10;
+
+  std::vector<double> x0(nt), x1(nt), h(nt), ystart(nv*nt), yend(nv*nt);
+
+  // Initialize the trajectories, some of which are integrated
+  // backwards
+  for(size_t j=0;j<nt;j++) {
+    x0[j]=0.0;
+    if (j%3==0) {
+      x1[j]=-2.0;
+      h[j]=-0.1;
+    } else {
+      x1[j]=2.0+0.01*((double)j);
+      h[j]=0.1;
+    }
+    ystart[j]=1.0+0.001*((double)j);
+    ystart[nt+j]=0.5;
+    ystart[2*nt+j]=omega(j);
+  }
+
+  for(size_t k=0;k<2;k++) {
+
+    if (k==0) {
+      cout << "Cash-Karp:" << endl;
+    } else {
+      cout << "Prince-Dormand:" << endl;
+      oie.stepper.set_rk8pd();
+    }
+
+    // Compare with the exact solution
+    std::vector<double> h1=h;
+    oie.solve_final_value(nt,nv,x0,x1,h1,ystart,yend,oef);
+    size_t tot_steps=0;
+    for(size_t j=0;j<nt;j++) {
+      double w=omega(j);
+      double ex=ystart[j]*cos(w*x1[j])+ystart[nt+j]/w*sin(w*x1[j]);
+      double ev=-ystart[j]*w*sin(w*x1[j])+ystart[nt+j]*cos(w*x1[j]);
+      t.test_abs(yend[j],ex,1.0e-7,"position");
+      t.test_abs(yend[nt+j],ev,1.0e-7,"velocity");
+      t.test_gen(oie.status[j]==0,"status");
+      tot_steps+=oie.nsteps[j];
+    }
+    cout << "Total steps: " << tot_steps << endl;
+
+    // The results should not depend on the block size or the
+    // number of threads
+    std::vector<double> h2=h, yend2(nv*nt);
+    oie.block_size=7;
+    oie.n_threads=2;
+    oie.solve_final_value(nt,nv,x0,x1,h2,ystart,yend2,oef);
+    oie.block_size=64;
+    oie.n_threads=1;
+    bool same=true;
+    for(size_t i=0;i<nv*nt;i++) {
+      if (yend[i]!=yend2[i]) same=false;
+    }
+    for(size_t j=0;j<nt;j++) {
+      if (h1[j]!=h2[j]) same=false;
+    }
+    t.test_gen(same,"block size and threads");
+
+    // Compare with ode_iv_solve for a few trajectories
+    ode_iv_solve<> ivs;
+    ode_funct od=derivs;
+    ode_rk8pd_gsl<> rk8pd;
+    ivs.gsl_astp.con.eps_abs=1.0e-10;
+    if (k==1) ivs.gsl_astp.set_step(rk8pd);
+    ubvector y(3), ye(3);
+    for(size_t j=0;j<nt;j+=37) {
+      for(size_t i=0;i<nv;i++) y[i]=ystart[i*nt+j];
+      ivs.solve_final_value(x0[j],x1[j],h[j],nv,y,ye,od);
+      t.test_rel(yend[j],ye[0],1.0e-8,"ode_iv_solve position");
+      t.test_rel(yend[nt+j],ye[1],1.0e-8,"ode_iv_solve velocity");
+      cout << j << " " << oie.nsteps[j] << " " << ivs.nsteps << endl;
+    }
+    cout << endl;
+  }
+
+  // A derivative function which calls the error handler should
+  // give an error in the calling thread
+  {
+    ode_ensemble_funct oef_err=derivs_ens_err;
+    oie.block_size=7;
+    oie.n_threads=2;
+    std::vector<double> h3=h;
+    bool caught=false;
+    try {
+      oie.solve_final_value(nt,nv,x0,x1,h3,ystart,yend,oef_err);
+    } catch (std::exception &e) {
+      caught=true;
+    }
+    oie.block_size=64;
+    oie.n_threads=1;
+    t.test_gen(caught,"derivative error");
+    t.test_gen(oie.status[nt-1]!=0,"derivative error status");
+    t.test_gen(oie.status[0]==0,"derivative error status 2");
+  }
+
+  // Too many steps
+  {
+    oie.ntrial=5;
+    oie.err_nonconv=false;
+    std::vector<double> h3=h;
+    int ret=oie.solve_final_value(nt,nv,x0,x1,h3,ystart,yend,oef);
+    t.test_gen(ret==exc_emaxiter,"ntrial");
+    t.test_gen(oie.status[1]==exc_emaxiter,"ntrial 2");
+    t.test_gen(oie.nsteps[1]==5,"ntrial 3");
+  }
+
+  t.report();
+  return 0;
+}
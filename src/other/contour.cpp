@@ -34,6 +34,7 @@ contour::contour() {
   lev_adjust=1.0e-8;
   verbose=0;
   debug_next_point=false;
+  n_threads=1;
 }
 
 contour::~contour() {
@@ -560,8 +561,9 @@ int contour::find_next_point_x_direct(int j, int k, int &jnext, int &knext,
 }
 
 void contour::find_intersections(size_t ilev, double &level,
+				 const ubvector &lev_ref,
 				 edge_crossings &xedges, 
-				 edge_crossings &yedges) {
+				 edge_crossings &yedges, size_t nthr) {
   
   // Adjust the specified contour level to ensure none of the data
   // points is exactly on a contour
@@ -569,14 +571,18 @@ void contour::find_intersections(size_t ilev, double &level,
   do {
     
     // Look for a match
-    level_corner=false;
+    int n_corner=0;
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) reduction(+:n_corner) num_threads(nthr)
+#endif
     for(int k=0;k<ny;k++) {
       for(int j=0;j<nx;j++) {
 	if (data(j,k)==level) {
-	  level_corner=true;
+	  n_corner++;
 	}
       }
     }
+    level_corner=(n_corner>0);
 
     // If we found a match, adjust the level
     if (level_corner==true) {
@@ -595,28 +601,32 @@ void contour::find_intersections(size_t ilev, double &level,
 	double diff;
 	int iclosest=0;
 	if (ilev==0) {
-	  diff=fabs(level-levels[1]);
+	  diff=fabs(level-lev_ref[1]);
 	  iclosest=1;
 	} else {
-	  diff=fabs(level-levels[0]);
+	  diff=fabs(level-lev_ref[0]);
 	  iclosest=0;
 	}
 	for(int ik=0;ik<nlev;ik++) {
 	  if (ik!=((int)ilev)) {
-	    if (fabs(level-levels[ik])<diff) {
+	    if (fabs(level-lev_ref[ik])<diff) {
 	      iclosest=ik;
-	      diff=fabs(level-levels[ik]);
+	      diff=fabs(level-lev_ref[ik]);
 	    }
 	  }
 	}
-	level+=fabs(level-levels[iclosest])*lev_adjust;
+	level+=fabs(level-lev_ref[iclosest])*lev_adjust;
       }
       if (verbose>0) cout << level << endl;
     }
 
   } while (level_corner==true);
   
-  // Find all level crossings
+  // Find all level crossings. Each value of k writes to separate
+  // elements of the edge matrices, so the stripes are independent.
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) num_threads(nthr)
+#endif
   for(int k=0;k<ny;k++) {
     for(int j=0;j<nx;j++) {
       if (j<nx-1) {
@@ -647,35 +657,27 @@ void contour::find_intersections(size_t ilev, double &level,
   return;
 }
 
-void contour::edges_in_y_direct(double level, interp<ubvector> &si,
-				edge_crossings &yedges) {
+void contour::edges_in_y_direct(double level, edge_crossings &yedges,
+				size_t nthr) {
 
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) num_threads(nthr)
+#endif
   for(int k=0;k<ny-1;k++) {
     for(int j=0;j<nx;j++) {
       
-      // For each iright edge
+      // For each right edge
       if (yedges.status(j,k)==edge) {
 		
-	// Find two points for linear interpolation
-	int ileft=k;
-	if (ileft==ny-1) ileft--;
-	int nint=2;
-	
-	ubvector xi(nint), yi(nint);
-	
-	xi[0]=data(j,k);
-	xi[1]=data(j,k+1);
-	yi[0]=yfun[ileft];
-	yi[1]=yfun[ileft+1];
-	
-	// Do the interpolation and set the edge appropriately
-	yedges.values(j,k)=si.eval(level,nint,xi,yi);
+	// Linear interpolation between the two grid points
+	double d0=data(j,k), d1=data(j,k+1);
+	yedges.values(j,k)=yfun[k]+(level-d0)/(d1-d0)*(yfun[k+1]-yfun[k]);
 	
 	if (verbose>1) {
 	  cout << "Horizontal edge: (" << k << "," << j << ") -> ("
 	       << k+1 << "," << j << ")" << endl;
-	  cout << " coords: " << yfun[ileft] << " "
-	       << yedges.values(j,k) << " " << yfun[ileft+1] << endl;
+	  cout << " coords: " << yfun[k] << " "
+	       << yedges.values(j,k) << " " << yfun[k+1] << endl;
 	  cout << "   data: " << data(j,k) << " "
 	       << level << " " << data(j,k+1) << endl;
 	}
@@ -688,35 +690,27 @@ void contour::edges_in_y_direct(double level, interp<ubvector> &si,
   return;
 }
 
-void contour::edges_in_x_direct(double level, interp<ubvector> &si,
-				edge_crossings &xedges) {
+void contour::edges_in_x_direct(double level, edge_crossings &xedges,
+				size_t nthr) {
 
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) num_threads(nthr)
+#endif
   for(int k=0;k<ny;k++) {
     for(int j=0;j<nx-1;j++) {
       
       // For each bottom edge
       if (xedges.status(j,k)==edge) {
 	
-	// Find two points for linear interpolation
-	int ileft=j;
-	if (ileft==nx-1) ileft--;
-	int nint=2;
-	
-	ubvector xi(nint), yi(nint);
-	
-	xi[0]=data(j,k);
-	xi[1]=data(j+1,k);
-	yi[0]=xfun[ileft];
-	yi[1]=xfun[ileft+1];
-
-	// Do the interpolation and set the edge appropriately
-	xedges.values(j,k)=si.eval(level,nint,xi,yi);
+	// Linear interpolation between the two grid points
+	double d0=data(j,k), d1=data(j+1,k);
+	xedges.values(j,k)=xfun[j]+(level-d0)/(d1-d0)*(xfun[j+1]-xfun[j]);
 	
 	if (verbose>1) {
 	  cout << "Vertical edge:   (" << k << "," << j << ") -> ("
 	       << k+1 << "," << j << ")" << endl;
-	  cout << " coords: " << xfun[ileft] << " "
-	       << xedges.values(j,k) << " " << xfun[ileft+1] << endl;
+	  cout << " coords: " << xfun[j] << " "
+	       << xedges.values(j,k) << " " << xfun[j+1] << endl;
 	  cout << "   data: " << data(j,k) << " "
 	       << level << " " << data(j+1,k) << endl;
 	}
@@ -857,6 +851,105 @@ void contour::process_line(int j, int k, int dir, std::vector<double> &x,
   return;
 }
 
+void contour::calc_level(size_t i, double &level, const ubvector &lev_ref,
+			 std::vector<contour_line> &lines,
+			 edge_crossings &xedges, edge_crossings &yedges,
+			 size_t nthr) {
+
+  // Make space for the edges
+  xedges.status.resize(nx-1,ny);
+  xedges.values.resize(nx-1,ny);
+  yedges.status.resize(nx,ny-1);
+  yedges.values.resize(nx,ny-1);
+  
+  if (verbose>1) {
+    std::cout << "\nLooking for edges for level: " 
+	      << level << std::endl;
+  }
+  
+  // Examine the each of the rows for an intersection
+  find_intersections(i,level,lev_ref,xedges,yedges,nthr);
+  
+  if (verbose>1) {
+    std::cout << "\nInterpolating edge intersections for level: " 
+	      << level << std::endl;
+  }
+  
+  // Process the edges in the x direction
+  edges_in_x_direct(level,xedges,nthr);
+  
+  // Process the edges in the y direction
+  edges_in_y_direct(level,yedges,nthr);
+  
+  if (verbose>1) {
+    std::cout << "\nPiecing together contour lines for level: " 
+	      << level << std::endl;
+  }
+
+  // Now go through and one side of the line
+  bool foundline=true;
+  while(foundline==true) {
+    for(int j=0;j<nx;j++) {
+      for(int k=0;k<ny;k++) {
+	foundline=false;
+
+	contour_line c;
+	c.level=level;
+
+	// A line beginning with a right edge
+	if (k<ny-1 && yedges.status(j,k)==edge) {
+	  if (verbose>0) {
+	    std::cout << "Starting contour line for level "
+		      << level << ":" << std::endl;
+	    std::cout << "(" << xfun[j] << ", " << yedges.values(j,k) 
+		      << ")" << std::endl;
+	  }
+	  c.x.push_back(xfun[j]);
+	  c.y.push_back(yedges.values(j,k));
+	  yedges.status(j,k)++;
+
+	  // Go through both sides
+	  process_line(j,k,dydir,c.x,c.y,true,xedges,yedges);
+	  if (verbose>0) {
+	    std::cout << "Computing other side of line." << std::endl;
+	  }
+	  process_line(j,k,dydir,c.x,c.y,false,xedges,yedges);
+	  foundline=true;
+	}
+
+	// A line beginning with a bottom edge
+	if (j<nx-1 && foundline==false && xedges.status(j,k)==edge) {
+	  if (verbose>0) {
+	    std::cout << "Starting contour line for level "
+		      << level << ":" << std::endl;
+	    std::cout << "(" << xedges.values(j,k) << ", " << yfun[k] 
+		      << ")" << std::endl;
+	  }
+	  c.x.push_back(xedges.values(j,k));
+	  c.y.push_back(yfun[k]);
+	  xedges.status(j,k)++;
+
+	  // Go through both sides
+	  process_line(j,k,dxdir,c.x,c.y,true,xedges,yedges);
+	  if (verbose>0) {
+	    std::cout << "Computing other side of line." << std::endl;
+	  }
+	  process_line(j,k,dxdir,c.x,c.y,false,xedges,yedges);
+	  foundline=true;
+	}
+
+	// Add line to list
+	if (foundline==true) {
+	  lines.push_back(c);
+	}
+      }
+    }
+
+  }
+
+  return;
+}
+
 void contour::calc_contours(std::vector<contour_line> &clines) {
 
   // Check that we're ready
@@ -872,116 +965,76 @@ void contour::calc_contours(std::vector<contour_line> &clines) {
   // Clear edge storage
   yed.clear();
   xed.clear();
+  yed.resize(nlev);
+  xed.resize(nlev);
 
   // Clear contour lines object
   clines.clear();
-  
-  // The interpolation object (only works with linear interpolation
-  // at the moment)
-  interp<ubvector> oi(itp_linear);
-  
-  // For each level
-  for(int i=0;i<nlev;i++) {
-
-    // Make space for the edges
-    edge_crossings xedges, yedges;
-    xedges.status.resize(nx-1,ny);
-    xedges.values.resize(nx-1,ny);
-    yedges.status.resize(nx,ny-1);
-    yedges.values.resize(nx,ny-1);
-
-    if (verbose>1) {
-      std::cout << "\nLooking for edges for level: " 
-		<< levels[i] << std::endl;
-    }
 
-    // Examine the each of the rows for an intersection
-    find_intersections(i,levels[i],xedges,yedges);
-	
-    if (verbose>1) {
-      std::cout << "\nInterpolating edge intersections for level: " 
-		<< levels[i] << std::endl;
-    }
+  size_t nthr=n_threads;
+  if (nthr<1 || verbose>0) nthr=1;
+#ifndef O2SCL_OPENMP
+  nthr=1;
+#endif
 
-    // Process the edges in the x direction
-    edges_in_x_direct(levels[i],oi,xedges);
+  if (nthr==1 || nlev<((int)nthr)) {
 
-    // Process the edges in the y direction
-    edges_in_y_direct(levels[i],oi,yedges);
-    
-    if (verbose>1) {
-      std::cout << "\nPiecing together contour lines for level: " 
-		<< levels[i] << std::endl;
+    // For each level, with the edge search divided into stripes
+    for(int i=0;i<nlev;i++) {
+      calc_level(i,levels[i],levels,clines,xed[i],yed[i],nthr);
+      if (verbose>0) {
+	std::cout << "Processing next level." << std::endl;
+      }
     }
 
-    // Now go through and one side of the line
-    bool foundline=true;
-    while(foundline==true) {
-      for(int j=0;j<nx;j++) {
-	for(int k=0;k<ny;k++) {
-	  foundline=false;
-
-	  contour_line c;
-	  c.level=levels[i];
-	      
-	  // A line beginning with a right edge
-	  if (k<ny-1 && yedges.status(j,k)==edge) {
-	    if (verbose>0) {
-	      std::cout << "Starting contour line for level "
-			<< levels[i] << ":" << std::endl;
-	      std::cout << "(" << xfun[j] << ", " << yedges.values(j,k) 
-			<< ")" << std::endl;
-	    }
-	    c.x.push_back(xfun[j]);
-	    c.y.push_back(yedges.values(j,k));
-	    yedges.status(j,k)++;
-	    
-	    // Go through both sides
-	    process_line(j,k,dydir,c.x,c.y,true,xedges,yedges);
-	    if (verbose>0) {
-	      std::cout << "Computing other side of line." << std::endl;
-	    }
-	    process_line(j,k,dydir,c.x,c.y,false,xedges,yedges);
-	    foundline=true;
-	  }
-
-	  // A line beginning with a bottom edge
-	  if (j<nx-1 && foundline==false && xedges.status(j,k)==edge) {
-	    if (verbose>0) {
-	      std::cout << "Starting contour line for level "
-			<< levels[i] << ":" << std::endl;
-	      std::cout << "(" << xedges.values(j,k) << ", " << yfun[k] 
-			<< ")" << std::endl;
-	    }
-	    c.x.push_back(xedges.values(j,k));
-	    c.y.push_back(yfun[k]);
-	    xedges.status(j,k)++;
-	    
-	    // Go through both sides
-	    process_line(j,k,dxdir,c.x,c.y,true,xedges,yedges);
-	    if (verbose>0) {
-	      std::cout << "Computing other side of line." << std::endl;
-	    }
-	    process_line(j,k,dxdir,c.x,c.y,false,xedges,yedges);
-	    foundline=true;
-	  }
+  } else {
 
-	  // Add line to list
-	  if (foundline==true) {
-	    clines.push_back(c);
+    // Compute the levels in parallel, using the unadjusted levels
+    // for the adjustments and storing the lines separately for each
+    // level so that the order does not depend on the number of
+    // threads
+    ubvector lev_ref=levels;
+    std::vector<std::vector<contour_line> > lev_lines(nlev);
+
+    // Exceptions cannot leave the parallel region, so the first
+    // error is stored here and the error handler is called after
+    // the loop
+    int err_ret=0;
+    int err_lev=0;
+    std::string err_reason;
+    
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for default(shared) schedule(dynamic,1) num_threads(nthr)
+#endif
+    for(int i=0;i<nlev;i++) {
+      try {
+	calc_level(i,levels[i],lev_ref,lev_lines[i],xed[i],yed[i],1);
+      } catch (const std::exception &e) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_contour_err)
+#endif
+	{
+	  if (err_ret==0) {
+	    err_ret=err_hnd->get_errno();
+	    if (err_ret==0) err_ret=exc_efailed;
+	    err_lev=i;
+	    err_reason=e.what();
 	  }
 	}
       }
-
     }
 
-    // Store edge information from this level
-    xed.push_back(xedges);
-    yed.push_back(yedges);
+    if (err_ret!=0) {
+      std::string str="Failed to compute level "+o2scl::itos(err_lev)+
+	" in calc_contours(): "+err_reason;
+      O2SCL_ERR(str.c_str(),err_ret);
+      return;
+    }
 
-    if (verbose>0) {
-      std::cout << "Processing next level." << std::endl;
+    for(int i=0;i<nlev;i++) {
+      clines.insert(clines.end(),lev_lines[i].begin(),lev_lines[i].end());
     }
+    
   }
   
   return;
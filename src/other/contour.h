@@ -433,6 +433,24 @@ namespace o2scl {
 
     /// (default \f$ 10^{-8} \f$)
     double lev_adjust;
+
+    /** \brief Number of OpenMP threads (default 1)
+
+	If there are at least as many contour levels as threads, then
+	the levels are distributed over the threads. Otherwise, the
+	levels are computed one at a time and the search for edge
+	crossings is divided into stripes over the second (y) index.
+	The contour lines are always returned in the same order as
+	they would be with one thread. When several levels are
+	computed at once, the adjustment of a level which passes
+	through a grid point (see \ref lev_adjust) is based on the
+	unadjusted values of the other levels. If \ref verbose is
+	greater than zero, then only one thread is used. If the error
+	handler is called while the levels are computed in parallel,
+	it is called again with the same error value after all of the
+	threads have finished.
+    */
+    size_t n_threads;
     
     /** \brief If true, debug the functions which determine the
 	next point functions (default false)p
@@ -494,17 +512,32 @@ namespace o2scl {
 				 edge_crossings &xedges,
 				 edge_crossings &yedges);
     
-    /// Find all of the intersections of the edges with the contour level
+    /** \brief Find all of the intersections of the edges with the
+	contour level using \c nthr threads
+
+	The values in \c lev_ref are used to adjust the level if it
+	passes through a grid point.
+    */
     void find_intersections(size_t ilev, double &level,
-			    edge_crossings &xedges, edge_crossings &yedges);
+			    const ubvector &lev_ref,
+			    edge_crossings &xedges, edge_crossings &yedges,
+			    size_t nthr=1);
 
     /// Interpolate all right edge crossings 
-    void edges_in_y_direct(double level, interp<ubvector> &si,
-			   edge_crossings &yedges);
+    void edges_in_y_direct(double level, edge_crossings &yedges,
+			   size_t nthr=1);
     
     /// Interpolate all bottom edge crossings
-    void edges_in_x_direct(double level, interp<ubvector> &si,
-			   edge_crossings &xedges);
+    void edges_in_x_direct(double level, edge_crossings &xedges,
+			   size_t nthr=1);
+
+    /** \brief Compute the edges and the contour lines for level
+	with index \c ilev
+    */
+    void calc_level(size_t ilev, double &level, const ubvector &lev_ref,
+		    std::vector<contour_line> &lines,
+		    edge_crossings &xedges, edge_crossings &yedges,
+		    size_t nthr);
 
     /// Create a contour line from a starting edge
     void process_line(int j, int k, int dir, std::vector<double> &x, 
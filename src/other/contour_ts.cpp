@@ -336,6 +336,47 @@ int main(void) {
   
   // ------------------------------------------------------------
 
+  // The results should not depend on the number of threads,
+  // for either parallel levels or parallel stripes
+  {
+    cout << "Threads:" << endl;
+    
+    size_t fnx=200, fny=150;
+    ubvector fx(fnx), fy(fny);
+    ubmatrix fd(fnx,fny);
+    for(size_t ii=0;ii<fnx;ii++) fx[ii]=((double)ii)/2.0;
+    for(size_t ii=0;ii<fny;ii++) fy[ii]=((double)ii)/15.0;
+    for(size_t ii=0;ii<fnx;ii++) {
+      for(size_t jj=0;jj<fny;jj++) {
+	fd(ii,jj)=fun(fx[ii],fy[jj]);
+      }
+    }
+
+    for(size_t nl=1;nl<=7;nl+=6) {
+      vector<contour_line> c1, c2;
+      contour cp;
+      cp.set_data(fnx,fny,fx,fy,fd);
+      cp.set_levels(nl,levels);
+      cp.calc_contours(c1);
+      cp.n_threads=4;
+      cp.set_levels(nl,levels);
+      cp.calc_contours(c2);
+      bool same=(c1.size()==c2.size());
+      for(size_t ii=0;same && ii<c1.size();ii++) {
+	if (c1[ii].level!=c2[ii].level || c1[ii].x!=c2[ii].x ||
+	    c1[ii].y!=c2[ii].y) {
+	  same=false;
+	}
+      }
+      cout << nl << " " << c1.size() << " " << c2.size() << endl;
+      t.test_gen(c1.size()>0,"threads nonempty");
+      t.test_gen(same,"threads");
+    }
+    cout << endl;
+  }
+
+  // ------------------------------------------------------------
+
   if (false) {
   
     cout << "Stress test:" << endl;
@@ -153,6 +153,31 @@ namespace o2scl {
      */
     void allocate(size_t n);
 
+    /** \brief Add the first \c nv entries of an increasing vector
+        of data to the histogram, with weights given in \c sw (or
+        with unit weights if \c sw is zero)
+
+        Because the data is sorted, consecutive entries usually
+        fall in the same bin, so \ref get_bin_index() is only called
+        when an entry is not strictly inside the current bin and not
+        equal to the previous entry. This ensures the bin assignments
+        are the same as those from \ref update().
+    */
+    template<class vec_t>
+      void update_sorted(size_t nv, const vec_t &sv,
+                         const std::vector<double> *sw=0) {
+      size_t loc=0;
+      for(size_t i=0;i<nv;i++) {
+        double x=sv[i];
+        if (i==0 || (x!=sv[i-1] && !(x>ubin[loc] && x<ubin[loc+1]))) {
+          loc=get_bin_index(x);
+        }
+        if (sw==0) uwgt[loc]+=1.0;
+        else uwgt[loc]+=(*sw)[i];
+      }
+      return;
+    }
+
   public:
 
     /// Create an empty histogram
@@ -174,6 +199,9 @@ namespace o2scl {
 	\c v . The values of \ref extend_lhs and \ref extend_rhs are
 	set to true, so the first and last bin are guaranteed to be at
 	least 1.
+
+	The data is copied and sorted with \ref vector_sort_radix()
+	so that the bins can be filled in a single sweep.
     */
     template<class vec_t> hist(size_t nv, const vec_t &v, size_t n_bins) {
 			       
@@ -183,14 +211,19 @@ namespace o2scl {
       extend_lhs=true;
       extend_rhs=true;
       
-      double min, max;
-      o2scl::vector_minmax_value(nv,v,min,max);
-      uniform_grid<double> ug=uniform_grid_end<double>(min,max,n_bins);
+      if (nv==0) {
+	O2SCL_ERR("No data specified in hist::hist().",exc_einval);
+      }
+      std::vector<double> sv(nv);
+      for(size_t i=0;i<nv;i++) sv[i]=v[i];
+      vector_sort_radix(nv,sv);
+      
+      uniform_grid<double> ug=uniform_grid_end<double>
+	(sv[0],sv[nv-1],n_bins);
       set_bin_edges(ug);
 
-      for(size_t i=0;i<nv;i++) {
-	update(v[i]);
-      }
+      update_sorted(nv,sv);
+      
       return;
     }
     
@@ -202,6 +235,10 @@ namespace o2scl {
 	\c v . The values of \ref extend_lhs and \ref extend_rhs are
 	set to true, so the first and last bin are guaranteed to be at
 	least 1.
+
+	The data and weights are sorted using the permutation from
+	\ref vector_sort_index_radix() so that the bins can be
+	filled in a single sweep.
     */
     template<class vec_t, class vec2_t>
       hist(size_t nv, const vec_t &v, const vec2_t &w, size_t n_bins) {
@@ -212,14 +249,23 @@ namespace o2scl {
       extend_lhs=true;
       extend_rhs=true;
       
-      double min, max;
-      o2scl::vector_minmax_value(nv,v,min,max);
-      uniform_grid<double> ug=uniform_grid_end<double>(min,max,n_bins);
-      set_bin_edges(ug);
-
+      if (nv==0) {
+	O2SCL_ERR("No data specified in hist::hist().",exc_einval);
+      }
+      std::vector<size_t> order(nv);
+      vector_sort_index_radix(nv,v,order);
+      std::vector<double> sv(nv), sw(nv);
       for(size_t i=0;i<nv;i++) {
-	update(v[i],w[i]);
+	sv[i]=v[order[i]];
+	sw[i]=w[order[i]];
       }
+      
+      uniform_grid<double> ug=uniform_grid_end<double>
+	(sv[0],sv[nv-1],n_bins);
+      set_bin_edges(ug);
+
+      update_sorted(nv,sv,&sw);
+      
       return;
     }
     
@@ -231,10 +277,8 @@ namespace o2scl {
 	set to true, so the first and last bin are guaranteed to be at
 	least 1.
     */
-    template<class vec_t> hist(const vec_t &v, size_t n_bins) {
-      size_t nv=v.size();
-      hist(nv,v,n_bins);
-      return;
+    template<class vec_t> hist(const vec_t &v, size_t n_bins) :
+      hist(v.size(),v,n_bins) {
     }
 
     /** \brief Create a histogram from a vector of data and a vector
@@ -247,11 +291,8 @@ namespace o2scl {
 	least 1.
     */
     template<class vec_t, class vec2_t> hist
-      (const vec_t &v, const vec2_t &w, size_t n_bins) {
-					     
-      size_t nv=v.size();
-      hist(nv,v,w,n_bins);
-      return;
+      (const vec_t &v, const vec2_t &w, size_t n_bins) :
+      hist(v.size(),v,w,n_bins) {
     }
 
     /** \brief Create a histogram from a column in a \ref o2scl::table
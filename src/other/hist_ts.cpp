@@ -72,6 +72,25 @@ int main(void) {
     cout << i << " " << h2.get_rep_i(i) << " " << h2[i] << endl;
   }
   cout << h2.sum_wgts() << endl;
+
+  // Compare with a histogram filled with update() and test the
+  // weighted and vector-only constructors
+  hist h3;
+  h3.set_bin_edges(uniform_grid_end<double>(vector_min_value<vector<double>,
+                                            double>(x),
+                                            vector_max_value<vector<double>,
+                                            double>(x),10));
+  h3.extend_lhs=true;
+  h3.extend_rhs=true;
+  for(size_t i=0;i<x.size();i++) h3.update(x[i],2.0);
+  hist h4(x,10);
+  vector<double> w(x.size(),2.0);
+  hist h5(x,w,10);
+  for(size_t i=0;i<10;i++) {
+    t.test_rel(h2[i],h3[i]/2.0,1.0e-12,"constructor vs. update()");
+    t.test_rel(h4[i],h2[i],1.0e-12,"vector constructor");
+    t.test_rel(h5[i],h3[i],1.0e-12,"weighted constructor");
+  }
   
   t.report();
   return 0;
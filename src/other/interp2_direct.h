@@ -53,6 +53,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -135,6 +136,8 @@ namespace o2scl {
 
       svx.set_vec(n_x,x_grid);
       svy.set_vec(n_y,y_grid);
+
+      coeffs.clear();
   
       if (interp_type==itp_cspline || interp_type==itp_cspline_peri) {
     
@@ -179,6 +182,138 @@ namespace o2scl {
       return;
     }
     
+    /** \brief Compute and store the polynomial coefficients for
+	every cell of the grid
+
+	This stores 16 numbers for each cell, so it requires about 16
+	times the memory of the data. Afterwards, all of the
+	evaluation and derivative functions use the stored
+	coefficients instead of recomputing them. The stored
+	coefficients are removed by the next call to set_data().
+    */
+    void compute_coeffs() {
+      if (!data_set) {
+	O2SCL_ERR("Data not set in interp2_direct::compute_coeffs().",
+		  exc_einval);
+      }
+      std::vector<double> c((this->nx-1)*(this->ny-1)*16);
+      for(size_t xi=0;xi<this->nx-1;xi++) {
+	for(size_t yi=0;yi<this->ny-1;yi++) {
+	  cell_coeffs(xi,yi,&c[(xi*(this->ny-1)+yi)*16]);
+	}
+      }
+      std::swap(coeffs,c);
+      return;
+    }
+
+    /** \brief Perform the 2-d interpolation at the \c n points
+	specified in \c x and \c y, storing the results in \c z
+
+	The points are sorted by grid cell so that the coefficients
+	for each cell are computed (or loaded) only once.
+    */
+    template<class vec2_t, class vec3_t>
+    void eval_batch(size_t n, const vec2_t &x, const vec2_t &y,
+		    vec3_t &z) const {
+      
+      if (!data_set) {
+	O2SCL_ERR("Data not set in interp2_direct::eval_batch().",
+		  exc_einval);
+      }
+      if (n==0) return;
+
+      // Find the cell for each point
+      std::vector<std::pair<size_t,size_t> > cells(n);
+      size_t xcache=0, ycache=0;
+      for(size_t k=0;k<n;k++) {
+	size_t xi=svx.find_const(x[k],xcache);
+	size_t yi=svy.find_const(y[k],ycache);
+	cells[k].first=xi*(this->ny-1)+yi;
+	cells[k].second=k;
+      }
+      std::sort(cells.begin(),cells.end());
+
+      double a[16];
+      const double *ap=a;
+      for(size_t k=0;k<n;k++) {
+	size_t cell=cells[k].first;
+	size_t xi=cell/(this->ny-1);
+	size_t yi=cell%(this->ny-1);
+	if (k==0 || cell!=cells[k-1].first) {
+	  if (coeffs.size()>0) {
+	    ap=&coeffs[cell*16];
+	  } else {
+	    cell_coeffs(xi,yi,a);
+	  }
+	}
+	size_t ik=cells[k].second;
+	double t=(x[ik]-(*this->xfun)[xi])/
+	  ((*this->xfun)[xi+1]-(*this->xfun)[xi]);
+	double u=(y[ik]-(*this->yfun)[yi])/
+	  ((*this->yfun)[yi+1]-(*this->yfun)[yi]);
+	z[ik]=eval_poly(ap,t,u,0,0);
+      }
+
+      return;
+    }
+
+    /** \brief Perform the 2-d interpolation on the grid specified
+	by \c xo and \c yo, storing the results in <tt>zo(i,j)</tt>
+
+	The cell coefficients are recomputed only when the cell
+	changes, so the time required is linear in the number of
+	output points.
+    */
+    template<class vec2_t, class mat2_t>
+    void eval_grid(size_t nxo, const vec2_t &xo, size_t nyo,
+		   const vec2_t &yo, mat2_t &zo) const {
+      
+      if (!data_set) {
+	O2SCL_ERR("Data not set in interp2_direct::eval_grid().",
+		  exc_einval);
+      }
+      if (nxo==0 || nyo==0) return;
+
+      // Find the cells and the local coordinates once for each
+      // direction
+      std::vector<size_t> xis(nxo), yis(nyo);
+      std::vector<double> ts(nxo), us(nyo);
+      size_t cache=0;
+      for(size_t i=0;i<nxo;i++) {
+	xis[i]=svx.find_const(xo[i],cache);
+	ts[i]=(xo[i]-(*this->xfun)[xis[i]])/
+	  ((*this->xfun)[xis[i]+1]-(*this->xfun)[xis[i]]);
+      }
+      cache=0;
+      for(size_t j=0;j<nyo;j++) {
+	yis[j]=svy.find_const(yo[j],cache);
+	us[j]=(yo[j]-(*this->yfun)[yis[j]])/
+	  ((*this->yfun)[yis[j]+1]-(*this->yfun)[yis[j]]);
+      }
+
+      double a[16];
+      const double *ap=a;
+      size_t last=0;
+      bool first=true;
+      for(size_t i=0;i<nxo;i++) {
+	for(size_t j=0;j<nyo;j++) {
+	  size_t cell=xis[i]*(this->ny-1)+yis[j];
+	  if (first || cell!=last) {
+	    if (coeffs.size()>0) {
+	      ap=&coeffs[cell*16];
+	    } else {
+	      cell_coeffs(xis[i],yis[j],a);
+	    }
+	    last=cell;
+	    first=false;
+	  }
+	  zo(i,j)=eval_poly(ap,ts[i],us[j],0,0);
+	}
+      }
+
+      return;
+    }
+
     /** \brief Perform the 2-d interpolation 
      */
     virtual double eval(double x, double y) const {
@@ -187,6 +322,8 @@ namespace o2scl {
 	O2SCL_ERR("Data not set in interp2_direct::eval().",exc_einval);
       }
 
+      if (coeffs.size()>0) return eval_stored(x,y,0,0);
+
       size_t cache=0;
       size_t xi=svx.find_const(x,cache);
       cache=0;
@@ -292,6 +429,8 @@ namespace o2scl {
 	O2SCL_ERR("Data not set in interp2_direct::deriv_x().",exc_einval);
       }
 
+      if (coeffs.size()>0) return eval_stored(x,y,1,0);
+
       size_t cache=0;
       size_t xi=svx.find_const(x,cache);
       cache=0;
@@ -389,6 +528,8 @@ namespace o2scl {
 	O2SCL_ERR("Data not set in interp2_direct::deriv_xx().",exc_einval);
       }
 
+      if (coeffs.size()>0) return eval_stored(x,y,2,0);
+
       if (itype==itp_linear) {
 	return 0.0;
       }
@@ -478,6 +619,8 @@ namespace o2scl {
 	O2SCL_ERR("Data not set in interp2_direct::deriv_y().",exc_einval);
       }
 
+      if (coeffs.size()>0) return eval_stored(x,y,0,1);
+
       size_t cache=0;
       size_t xi=svx.find_const(x,cache);
       cache=0;
@@ -575,6 +718,8 @@ namespace o2scl {
 	O2SCL_ERR("Data not set in interp2_direct::deriv_yy().",exc_einval);
       }
 
+      if (coeffs.size()>0) return eval_stored(x,y,0,2);
+
       if (itype==itp_linear) {
 	return 0.0;
       }
@@ -665,6 +810,8 @@ namespace o2scl {
 	O2SCL_ERR("Data not set in interp2_direct::deriv_xy().",exc_einval);
       }
 
+      if (coeffs.size()>0) return eval_stored(x,y,1,1);
+
       size_t cache=0;
       size_t xi=svx.find_const(x,cache);
       cache=0;
@@ -770,6 +917,123 @@ namespace o2scl {
 
   protected:
 
+    /** \brief The polynomial coefficients for each cell, if
+	computed by compute_coeffs()
+    */
+    std::vector<double> coeffs;
+
+    /** \brief Compute the coefficients <tt>a[4*m+n]</tt> of 
+	\f$ t^m u^n \f$ for the cell with lower-left corner at
+	<tt>(xi,yi)</tt>
+    */
+    void cell_coeffs(size_t xi, size_t yi, double *a) const {
+      
+      double dx=(*this->xfun)[xi+1]-(*this->xfun)[xi];
+      double dy=(*this->yfun)[yi+1]-(*this->yfun)[yi];
+      double dt=1.0/dx;
+      double du=1.0/dy;
+
+      double zminmin=(*this->datap)(xi,yi);
+      double zminmax=(*this->datap)(xi,yi+1);
+      double zmaxmin=(*this->datap)(xi+1,yi);
+      double zmaxmax=(*this->datap)(xi+1,yi+1);
+
+      if (itype==itp_linear) {
+	for(size_t k=0;k<16;k++) a[k]=0.0;
+	a[0]=zminmin;
+	a[1]=zminmax-zminmin;
+	a[4]=zmaxmin-zminmin;
+	a[5]=zminmin-zmaxmin-zminmax+zmaxmax;
+	return;
+      }
+
+      double zxminmin=zx(xi,yi)/dt;
+      double zxminmax=zx(xi,yi+1)/dt;
+      double zxmaxmin=zx(xi+1,yi)/dt;
+      double zxmaxmax=zx(xi+1,yi+1)/dt;
+
+      double zyminmin=zy(xi,yi)/du;
+      double zyminmax=zy(xi,yi+1)/du;
+      double zymaxmin=zy(xi+1,yi)/du;
+      double zymaxmax=zy(xi+1,yi+1)/du;
+
+      double zxyminmin=zxy(xi,yi)/du/dt;
+      double zxyminmax=zxy(xi,yi+1)/du/dt;
+      double zxymaxmin=zxy(xi+1,yi)/du/dt;
+      double zxymaxmax=zxy(xi+1,yi+1)/du/dt;
+
+      a[0]=zminmin;
+      a[1]=zyminmin;
+      a[2]=-3*zminmin+3*zminmax-2*zyminmin-zyminmax;
+      a[3]=2*zminmin-2*zminmax+zyminmin+zyminmax;
+      a[4]=zxminmin;
+      a[5]=zxyminmin;
+      a[6]=-3*zxminmin+3*zxminmax-2*zxyminmin-zxyminmax;
+      a[7]=2*zxminmin-2*zxminmax+zxyminmin+zxyminmax;
+      a[8]=-3*zminmin+3*zmaxmin-2*zxminmin-zxmaxmin;
+      a[9]=-3*zyminmin+3*zymaxmin-2*zxyminmin-zxymaxmin;
+      a[10]=9*zminmin-9*zmaxmin+9*zmaxmax-9*zminmax+6*zxminmin+
+	3*zxmaxmin-3*zxmaxmax-6*zxminmax+6*zyminmin-6*zymaxmin-
+	3*zymaxmax+3*zyminmax+4*zxyminmin+2*zxymaxmin+zxymaxmax+
+	2*zxyminmax;
+      a[11]=-6*zminmin+6*zmaxmin-6*zmaxmax+6*zminmax-4*zxminmin-
+	2*zxmaxmin+2*zxmaxmax+4*zxminmax-3*zyminmin+3*zymaxmin+
+	3*zymaxmax-3*zyminmax-2*zxyminmin-zxymaxmin-zxymaxmax-
+	2*zxyminmax;
+      a[12]=2*zminmin-2*zmaxmin+zxminmin+zxmaxmin;
+      a[13]=2*zyminmin-2*zymaxmin+zxyminmin+zxymaxmin;
+      a[14]=-6*zminmin+6*zmaxmin-6*zmaxmax+6*zminmax-3*zxminmin-
+	3*zxmaxmin+3*zxmaxmax+3*zxminmax-4*zyminmin+4*zymaxmin+
+	2*zymaxmax-2*zyminmax-2*zxyminmin-2*zxymaxmin-zxymaxmax-
+	zxyminmax;
+      a[15]=4*zminmin-4*zmaxmin+4*zmaxmax-4*zminmax+2*zxminmin+
+	2*zxmaxmin-2*zxmaxmax-2*zxminmax+2*zyminmin-2*zymaxmin-
+	2*zymaxmax+2*zyminmax+zxyminmin+zxymaxmin+zxymaxmax+zxyminmax;
+      
+      return;
+    }
+
+    /** \brief Evaluate the derivative of order \c px in \f$ t \f$
+	and \c qy in \f$ u \f$ of the polynomial with coefficients
+	\c a
+    */
+    double eval_poly(const double *a, double t, double u,
+		     int px, int qy) const {
+      // Horner's method in u for each power of t, including the
+      // factors from the derivatives
+      double z=0.0;
+      for(int m=3;m>=px;m--) {
+	double fm=1.0;
+	for(int k=0;k<px;k++) fm*=m-k;
+	double zu=0.0;
+	for(int n=3;n>=qy;n--) {
+	  double fn=1.0;
+	  for(int k=0;k<qy;k++) fn*=n-k;
+	  zu=zu*u+fn*a[4*m+n];
+	}
+	z=z*t+fm*zu;
+      }
+      return z;
+    }
+
+    /** \brief Evaluate a derivative at <tt>(x,y)</tt> using the
+	stored coefficients
+    */
+    double eval_stored(double x, double y, int px, int qy) const {
+      size_t cache=0;
+      size_t xi=svx.find_const(x,cache);
+      cache=0;
+      size_t yi=svy.find_const(y,cache);
+      double dx=(*this->xfun)[xi+1]-(*this->xfun)[xi];
+      double dy=(*this->yfun)[yi+1]-(*this->yfun)[yi];
+      double t=(x-(*this->xfun)[xi])/dx;
+      double u=(y-(*this->yfun)[yi])/dy;
+      double z=eval_poly(&coeffs[(xi*(this->ny-1)+yi)*16],t,u,px,qy);
+      for(int k=0;k<px;k++) z/=dx;
+      for(int k=0;k<qy;k++) z/=dy;
+      return z;
+    }
+
     /// True if the data has been specified by the user
     bool data_set;
 
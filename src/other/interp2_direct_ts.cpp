@@ -307,6 +307,105 @@ int main(void) {
 
   }
 
+  {
+    // Stored coefficients, batch, and grid evaluation
+
+    size_t M=40;
+    size_t N=30;
+    ubvector x2(M), y2(N);
+    ubmatrix data2(M,N);
+    for(size_t ii=0;ii<M;ii++) {
+      x2[ii]=((double)ii)/10.0;
+    }
+    for(size_t jj=0;jj<N;jj++) {
+      y2[jj]=((double)jj)/20.0;
+    }
+    for(size_t ii=0;ii<M;ii++) {
+      for(size_t jj=0;jj<N;jj++) {
+	data2(ii,jj)=f(x2[ii],y2[jj]);
+      }
+    }
+
+    // A set of points in random order, some of which share values
+    // of y
+    size_t np=200;
+    ubvector xp(np), yp(np), zp(np);
+    for(size_t k=0;k<np;k++) {
+      xp[k]=3.9*fabs(sin(1.7*((double)k)));
+      yp[k]=1.45*fabs(cos(0.3*((double)(k/4))));
+    }
+
+    // An output grid
+    size_t nxo=57, nyo=43;
+    ubvector xo(nxo), yo(nyo);
+    ubmatrix zo(nxo,nyo);
+    for(size_t i=0;i<nxo;i++) xo[i]=3.9*((double)i)/((double)(nxo-1));
+    for(size_t j=0;j<nyo;j++) yo[j]=1.45*((double)j)/((double)(nyo-1));
+
+    for(size_t k=0;k<2;k++) {
+
+      size_t itype=itp_cspline;
+      if (k==1) itype=itp_linear;
+      it2.set_data(M,N,x2,y2,data2,itype);
+      it.set_data(M,N,x2,y2,data2,itype);
+      
+      it2.eval_batch(np,xp,yp,zp);
+      for(size_t ik=0;ik<np;ik++) {
+	t.test_rel(zp[ik],it2.eval(xp[ik],yp[ik]),1.0e-12,"direct batch");
+      }
+      it2.eval_grid(nxo,xo,nyo,yo,zo);
+      for(size_t i=0;i<nxo;i+=7) {
+	for(size_t j=0;j<nyo;j+=5) {
+	  t.test_rel(zo(i,j),it2.eval(xo[i],yo[j]),1.0e-12,"direct grid");
+	}
+      }
+
+      it.eval_batch(np,xp,yp,zp);
+      for(size_t ik=0;ik<np;ik++) {
+	t.test_rel(zp[ik],it.eval(xp[ik],yp[ik]),1.0e-12,"seq batch");
+      }
+      it.eval_grid(nxo,xo,nyo,yo,zo);
+      for(size_t i=0;i<nxo;i+=7) {
+	for(size_t j=0;j<nyo;j+=5) {
+	  t.test_rel(zo(i,j),it.eval(xo[i],yo[j]),1.0e-12,"seq grid");
+	}
+      }
+
+      // Compare the stored coefficients with the direct computation
+      ubvector zs(np), zsx(np), zsy(np), zsxy(np), zsxx(np), zsyy(np);
+      for(size_t ik=0;ik<np;ik++) {
+	zs[ik]=it2.eval(xp[ik],yp[ik]);
+	zsx[ik]=it2.deriv_x(xp[ik],yp[ik]);
+	zsy[ik]=it2.deriv_y(xp[ik],yp[ik]);
+	zsxy[ik]=it2.deriv_xy(xp[ik],yp[ik]);
+	zsxx[ik]=it2.deriv_xx(xp[ik],yp[ik]);
+	zsyy[ik]=it2.deriv_yy(xp[ik],yp[ik]);
+      }
+      it2.compute_coeffs();
+      for(size_t ik=0;ik<np;ik++) {
+	t.test_rel(it2.eval(xp[ik],yp[ik]),zs[ik],1.0e-12,"coeffs");
+	t.test_abs(it2.deriv_x(xp[ik],yp[ik]),zsx[ik],1.0e-10,"coeffs x");
+	t.test_abs(it2.deriv_y(xp[ik],yp[ik]),zsy[ik],1.0e-10,"coeffs y");
+	t.test_abs(it2.deriv_xy(xp[ik],yp[ik]),zsxy[ik],1.0e-10,
+		   "coeffs xy");
+	if (k==0) {
+	  t.test_abs(it2.deriv_xx(xp[ik],yp[ik]),zsxx[ik],1.0e-10,
+		     "coeffs xx");
+	  t.test_abs(it2.deriv_yy(xp[ik],yp[ik]),zsyy[ik],1.0e-10,
+		     "coeffs yy");
+	} else {
+	  t.test_abs(it2.deriv_xx(xp[ik],yp[ik]),0.0,1.0e-14,"coeffs xx");
+	  t.test_abs(it2.deriv_yy(xp[ik],yp[ik]),0.0,1.0e-14,"coeffs yy");
+	}
+      }
+      it2.eval_batch(np,xp,yp,zp);
+      for(size_t ik=0;ik<np;ik++) {
+	t.test_rel(zp[ik],zs[ik],1.0e-12,"coeffs batch");
+      }
+    }
+
+  }
+
   {
     // Show how to slice a tensor
     tensor_grid3<> tg(3,2,1);
@@ -30,11 +30,231 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <boost/numeric/ublas/vector.hpp>
 
 #include <o2scl/err_hnd.h>
 
 namespace o2scl {
 
+  /** \brief A grid of buckets for finding the closest points in a 
+      two-dimensional scattered data set
+
+      This class divides the bounding box of the data into a uniform
+      grid of cells with about two points per cell and stores the
+      indices of the points in each cell contiguously. The closest
+      points to a query point are found by searching rings of cells
+      of increasing size around the cell containing the query point
+      until no unsearched cell can contain a point closer than the
+      ones found so far. For data which is not strongly clustered,
+      this requires \f$ {\cal O}(1) \f$ operations per query, after
+      \f$ {\cal O}(N) \f$ operations to construct the grid.
+
+      Distances are computed in the scaled coordinates
+      \f$ x/\Delta x \f$ and \f$ y/\Delta y \f$ as in 
+      \ref o2scl::interp2_neigh and \ref o2scl::interp2_planar .
+      Ties are broken by choosing the point with the smallest index,
+      so the results are the same as those of a brute-force search.
+
+      This class is used internally by \ref o2scl::interp2_neigh
+      and \ref o2scl::interp2_planar .
+  */
+  class interp2_bucket_index {
+    
+  protected:
+
+    /// The number of cells in the x direction
+    size_t nx;
+    /// The number of cells in the y direction
+    size_t ny;
+    /// The lower-left corner of the grid in scaled coordinates
+    double u0, v0;
+    /// The size of each cell in scaled coordinates
+    double hu, hv;
+    /// The x and y scales
+    double sx, sy;
+    /// The index of the first point in each cell (size <tt>nx*ny+1</tt>)
+    std::vector<size_t> start;
+    /// The point indices sorted by cell
+    std::vector<size_t> pts;
+
+    /// Return the cell index in one direction, clamped to the grid
+    size_t cell(double u, double u_0, double h, size_t n) const {
+      double c=floor((u-u_0)/h);
+      if (!(c>0.0)) return 0;
+      if (c>=((double)n)) return n-1;
+      return ((size_t)c);
+    }
+    
+  public:
+
+    interp2_bucket_index() {
+      nx=0;
+      ny=0;
+    }
+
+    /// Return true if the grid has been constructed
+    bool is_built() const {
+      return nx>0;
+    }
+
+    /// Remove the grid
+    void clear() {
+      nx=0;
+      ny=0;
+      start.clear();
+      pts.clear();
+      return;
+    }
+    
+    /** \brief Construct the grid for the first \c n points in 
+	\c x and \c y using scales \c dx and \c dy
+    */
+    template<class vec_t>
+    void build(size_t n, const vec_t &x, const vec_t &y, double dx,
+	       double dy) {
+
+      sx=dx;
+      sy=dy;
+      
+      double umin=x[0]/dx, umax=umin, vmin=y[0]/dy, vmax=vmin;
+      for(size_t i=1;i<n;i++) {
+	double u=x[i]/dx, v=y[i]/dy;
+	if (u<umin) umin=u;
+	if (u>umax) umax=u;
+	if (v<vmin) vmin=v;
+	if (v>vmax) vmax=v;
+      }
+      double wu=umax-umin, wv=vmax-vmin;
+      if (wu<=0.0) wu=1.0;
+      if (wv<=0.0) wv=1.0;
+
+      // Choose about two points per cell with cells which are
+      // approximately square in the scaled coordinates
+      double ncell=((double)n)/2.0;
+      if (ncell<1.0) ncell=1.0;
+      double fx=sqrt(ncell*wu/wv);
+      double fy=sqrt(ncell*wv/wu);
+      nx=((size_t)(fx+0.5));
+      ny=((size_t)(fy+0.5));
+      if (nx<1) nx=1;
+      if (ny<1) ny=1;
+      if (nx>n) nx=n;
+      if (ny>n) ny=n;
+      u0=umin;
+      v0=vmin;
+      hu=wu/((double)nx);
+      hv=wv/((double)ny);
+
+      // Count the points in each cell and then fill the list
+      // of points with a counting sort
+      std::vector<size_t> cix(n);
+      start.assign(nx*ny+1,0);
+      for(size_t i=0;i<n;i++) {
+	size_t ic=cell(x[i]/dx,u0,hu,nx)*ny+cell(y[i]/dy,v0,hv,ny);
+	cix[i]=ic;
+	start[ic+1]++;
+      }
+      for(size_t ic=0;ic<nx*ny;ic++) {
+	start[ic+1]+=start[ic];
+      }
+      std::vector<size_t> next(start.begin(),start.end()-1);
+      pts.resize(n);
+      for(size_t i=0;i<n;i++) {
+	pts[next[cix[i]]++]=i;
+      }
+      
+      return;
+    }
+
+    /** \brief Find the \c k closest points to <tt>(x0,y0)</tt>
+
+	The indices of the closest points are stored in \c ix and the
+	squares of the scaled distances are stored in \c d2, both
+	sorted by increasing distance. The vectors \c x and \c y
+	must be the same as those given to \ref build(). 
+    */
+    template<class vec_t>
+    void nearest(double x0, double y0, size_t k, const vec_t &x,
+		 const vec_t &y, std::vector<size_t> &ix,
+		 std::vector<double> &d2) const {
+
+      if (nx==0) {
+	O2SCL_ERR("Grid not built in interp2_bucket_index::nearest().",
+		  exc_einval);
+      }
+      
+      ix.clear();
+      d2.clear();
+      
+      double u=x0/sx, v=y0/sy;
+      size_t ci=cell(u,u0,hu,nx), cj=cell(v,v0,hv,ny);
+
+      for(size_t r=0;;r++) {
+
+	// The range of cells in the ring of size r
+	size_t ilo=(ci>=r) ? ci-r : 0;
+	size_t ihi=(ci+r<nx) ? ci+r : nx-1;
+	size_t jlo=(cj>=r) ? cj-r : 0;
+	size_t jhi=(cj+r<ny) ? cj+r : ny-1;
+	
+	for(size_t i=ilo;i<=ihi;i++) {
+	  bool edge_i=(i+r==ci || i==ci+r);
+	  for(size_t j=jlo;j<=jhi;j++) {
+	    // Only the cells on the boundary of the ring
+	    if (!edge_i && j+r!=cj && j!=cj+r) continue;
+	    size_t ic=i*ny+j;
+	    for(size_t m=start[ic];m<start[ic+1];m++) {
+	      size_t ip=pts[m];
+	      double du=(x0-x[ip])/sx, dv=(y0-y[ip])/sy;
+	      double dist=du*du+dv*dv;
+	      // Insert into the sorted list of the closest points
+	      if (ix.size()==k &&
+		  (dist>d2[k-1] || (dist==d2[k-1] && ip>ix[k-1]))) {
+		continue;
+	      }
+	      if (ix.size()<k) {
+		ix.push_back(ip);
+		d2.push_back(dist);
+	      } else {
+		ix[k-1]=ip;
+		d2[k-1]=dist;
+	      }
+	      for(size_t q=ix.size()-1;q>0 &&
+		    (d2[q]<d2[q-1] || (d2[q]==d2[q-1] && ix[q]<ix[q-1]));
+		  q--) {
+		std::swap(d2[q],d2[q-1]);
+		std::swap(ix[q],ix[q-1]);
+	      }
+	    }
+	  }
+	}
+
+	// Stop if the entire grid has been searched
+	bool left=(ci>=r+1), right=(ci+r+1<nx);
+	bool down=(cj>=r+1), up=(cj+r+1<ny);
+	if (!left && !right && !down && !up) return;
+
+	// Otherwise, stop if no point in the remaining cells
+	// can be closer than the points found so far
+	if (ix.size()==k) {
+	  double bound=std::numeric_limits<double>::max();
+	  if (left) bound=std::min(bound,u-(u0+hu*(ci-r)));
+	  if (right) bound=std::min(bound,u0+hu*(ci+r+1)-u);
+	  if (down) bound=std::min(bound,v-(v0+hv*(cj-r)));
+	  if (up) bound=std::min(bound,v0+hv*(cj+r+1)-v);
+	  if (bound>0.0 && bound*bound>d2[k-1]) return;
+	}
+      }
+      
+      return;
+    }
+    
+  };
+
   /** \brief Nearest-neighbor interpolation in two dimensions
 
       This class performs nearest-neighbor interpolation when the data
@@ -60,8 +280,21 @@ namespace o2scl {
       The vector type can be any type with a suitably defined \c
       operator[].
       
-      \note This class operates by performing a \f$ {\cal O}(N) \f$
-      brute-force search to find the closest points. 
+      If \ref use_index is true (the default), the closest point is
+      found using an \ref o2scl::interp2_bucket_index object which is
+      constructed in \ref compute_scale(), giving \f$ {\cal O}(1) \f$
+      operations per interpolation for most data sets. Otherwise, a
+      \f$ {\cal O}(N) \f$ brute-force search is performed. The
+      function values may be modified after \ref set_data() is
+      called, but if the x- or y-values are modified, then
+      \ref compute_scale() must be called again.
+
+      The functions \ref eval_batch() and \ref eval_grid() 
+      interpolate at many points at once, e.g. to regrid scattered
+      data onto a \ref o2scl::table3d slice. If OpenMP is enabled,
+      these functions use multiple threads. If the error handler is called
+      for any of the points, it is called again with the same error
+      value after all of the points have been computed.
 
       \future Make a parent class for this and \ref o2scl::interp2_planar.
 
@@ -90,15 +323,23 @@ namespace o2scl {
       y_scale=-1.0;
       dx=0.0;
       dy=0.0;
+      use_index=true;
     }
 
+    /** \brief If true, use a grid of buckets to find the closest
+	point (default true)
+    */
+    bool use_index;
+
     /// The user-specified x scale (default -1)
     double x_scale;
 
     /// The user-specified y scale (default -1)
     double y_scale;
 
-    /// Find scaling
+    /** \brief Find scaling and construct the grid used to find 
+	the closest point
+    */
     void compute_scale() {
       if (x_scale<0.0) {
 	double minx=(*ux)[0], maxx=(*ux)[0];
@@ -125,6 +366,12 @@ namespace o2scl {
 	O2SCL_ERR("No scale in interp2_planar::set_data().",exc_einval);
       }
 
+      if (use_index) {
+	index.build(np,*ux,*uy,dx,dy);
+      } else {
+	index.clear();
+      }
+
       return;
     }
 
@@ -185,21 +432,136 @@ namespace o2scl {
 		  exc_einval);
       }
 
-      // Exhaustively search the data
-      i1=0;
-      double dist_min=pow((x-(*ux)[i1])/dx,2.0)+pow((y-(*uy)[i1])/dy,2.0);
-      for(size_t index=1;index<np;index++) {
-	double dist=pow((x-(*ux)[index])/dx,2.0)+pow((y-(*uy)[index])/dy,2.0);
-	if (dist<dist_min) {
-	  i1=index;
-	  dist_min=dist;
+      if (index.is_built()) {
+
+	// Use the grid of buckets
+	std::vector<size_t> ix;
+	std::vector<double> d2;
+	index.nearest(x,y,1,*ux,*uy,ix,d2);
+	i1=ix[0];
+	
+      } else {
+	
+	// Exhaustively search the data
+	i1=0;
+	double dist_min=pow((x-(*ux)[i1])/dx,2.0)+
+	  pow((y-(*uy)[i1])/dy,2.0);
+	for(size_t j=1;j<np;j++) {
+	  double dist=pow((x-(*ux)[j])/dx,2.0)+
+	    pow((y-(*uy)[j])/dy,2.0);
+	  if (dist<dist_min) {
+	    i1=j;
+	    dist_min=dist;
+	  }
 	}
+
       }
 
       // Return the function value
 
       f=(*uf)[i1];
+      x1=(*ux)[i1];
+      y1=(*uy)[i1];
+
+      return;
+    }
+
+    /** \brief Interpolate at the \c n points in \c x and \c y,
+	storing the results in \c f
+    */
+    template<class vec2_t, class vec3_t>
+    void eval_batch(size_t n, const vec2_t &x, const vec2_t &y,
+		    vec3_t &f) const {
+
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interp2_neigh::eval_batch().",
+		  exc_einval);
+	return;
+      }
+
+      // Exceptions cannot leave the parallel region, so the first
+      // error is stored here and the error handler is called after
+      // the loop
+      int err_ret=0;
+      std::string err_reason;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<n;i++) {
+	try {
+	  f[i]=eval(x[i],y[i]);
+	} catch (const std::exception &e) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_interp2_neigh_err)
+#endif
+	  {
+	    if (err_ret==0) {
+	      err_ret=err_hnd->get_errno();
+	      if (err_ret==0) err_ret=exc_efailed;
+	      err_reason=e.what();
+	    }
+	  }
+	}
+      }
+
+      if (err_ret!=0) {
+	std::string str="Interpolation failed in interp2_neigh::eval_batch(): "+
+	  err_reason;
+	O2SCL_ERR(str.c_str(),err_ret);
+      }
+      
+      return;
+    }
+
+    /** \brief Interpolate onto the grid specified by \c xg and
+	\c yg, storing the results in \c m
+
+	The value at <tt>(xg[i],yg[j])</tt> is stored in
+	<tt>m(i,j)</tt>, so that, for example, the matrix may be
+	a slice from \ref o2scl::table3d::get_slice() .
+    */
+    template<class vec2_t, class mat_t>
+    void eval_grid(size_t nx, const vec2_t &xg, size_t ny,
+		   const vec2_t &yg, mat_t &m) const {
+
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interp2_neigh::eval_grid().",
+		  exc_einval);
+	return;
+      }
 
+      int err_ret=0;
+      std::string err_reason;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<nx;i++) {
+	try {
+	  for(size_t j=0;j<ny;j++) {
+	    m(i,j)=eval(xg[i],yg[j]);
+	  }
+	} catch (const std::exception &e) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_interp2_neigh_err)
+#endif
+	  {
+	    if (err_ret==0) {
+	      err_ret=err_hnd->get_errno();
+	      if (err_ret==0) err_ret=exc_efailed;
+	      err_reason=e.what();
+	    }
+	  }
+	}
+      }
+
+      if (err_ret!=0) {
+	std::string str="Interpolation failed in interp2_neigh::eval_grid(): "+
+	  err_reason;
+	O2SCL_ERR(str.c_str(),err_ret);
+      }
+      
       return;
     }
     
@@ -217,6 +579,8 @@ namespace o2scl {
     vec_t *uf;
     /// True if the data has been specified
     bool data_set;
+    /// The grid used to find the closest point
+    interp2_bucket_index index;
     
 #endif
 
@@ -35,6 +35,7 @@
 
 #include <o2scl/err_hnd.h>
 #include <o2scl/vector.h>
+#include <o2scl/interp2_neigh.h>
 
 namespace o2scl {
 
@@ -82,8 +83,18 @@ namespace o2scl {
       \ref set_data() will call the error handler if the
       first argument is less than three.
       
-      \note This class operates by performing a \f$ {\cal O}(N) \f$
-      brute-force search to find the three closest points. If the
+      If \ref use_index is true (the default), the three closest
+      points are found using an \ref o2scl::interp2_bucket_index
+      object which is constructed in \ref compute_scale(), giving
+      \f$ {\cal O}(1) \f$ operations per interpolation for most data
+      sets. Otherwise, a \f$ {\cal O}(N) \f$ brute-force search is
+      performed. The functions \ref eval_batch() and \ref eval_grid()
+      interpolate at many points at once, using multiple threads if
+      OpenMP is enabled. If the error handler is called for any of
+      the points, it is called again with the same error value after
+      all of the points have been computed.
+
+      \note If the
       three closest points are colinear, then the data are sorted
       by distance [ \f$ {\cal O}(N \log N) \f$ ], and the closest
       triplets are enumerated until a non-colinear triplet is found.
@@ -117,8 +128,14 @@ namespace o2scl {
       y_scale=-1.0;
       dx=0.0;
       dy=0.0;
+      use_index=true;
     }
 
+    /** \brief If true, use a grid of buckets to find the closest
+	points (default true)
+    */
+    bool use_index;
+
     /// Threshold for colinearity (default \f$ 10^{-12} \f$)
     double thresh;
 
@@ -147,7 +164,9 @@ namespace o2scl {
       return;
     }
 
-    /// Find scaling
+    /** \brief Find scaling and construct the grid used to find 
+	the closest points
+    */
     void compute_scale() {
       if (x_scale<0.0) {
 	double minx=(*ux)[0], maxx=(*ux)[0];
@@ -174,6 +193,12 @@ namespace o2scl {
 	O2SCL_ERR("No scale in interp2_planar::set_data().",exc_einval);
       }
 
+      if (use_index) {
+	index.build(np,*ux,*uy,dx,dy);
+      } else {
+	index.clear();
+      }
+
       return;
     }
     
@@ -215,54 +240,72 @@ namespace o2scl {
 		  exc_einval);
       }
 
-      // First, we just find the three closest points by
-      // exhaustively searching the data
-      
-      // Put in initial points
-      i1=0; i2=1; i3=2;
-      double c1=sqrt(pow((x-(*ux)[0])/dx,2.0)+pow((y-(*uy)[0])/dy,2.0));
-      double c2=sqrt(pow((x-(*ux)[1])/dx,2.0)+pow((y-(*uy)[1])/dy,2.0));
-      double c3=sqrt(pow((x-(*ux)[2])/dx,2.0)+pow((y-(*uy)[2])/dy,2.0));
-
-      // Sort initial points
-      if (c2<c1) {
-	if (c3<c2) {
-	  // 321
-	  swap(i1,c1,i3,c3);
-	} else if (c3<c1) {
-	  // 231
-	  swap(i1,c1,i2,c2);
-	  swap(i2,c2,i3,c3);
-	} else {
-	  // 213
-	  swap(i1,c1,i2,c2);
-	}
+      if (index.is_built()) {
+
+	// Find the three closest points using the grid of buckets
+	std::vector<size_t> ix;
+	std::vector<double> d2;
+	index.nearest(x,y,3,*ux,*uy,ix,d2);
+	i1=ix[0];
+	i2=ix[1];
+	i3=ix[2];
+
       } else {
-	if (c3<c1) {
-	  // 312
-	  swap(i1,c1,i3,c3);
-	  swap(i2,c2,i3,c3);
-	} else if (c3<c2) {
-	  // 132
-	  swap(i3,c3,i2,c2);
+
+	// Find the three closest points by exhaustively searching
+	// the data
+
+	// Put in initial points
+	i1=0; i2=1; i3=2;
+	double c1=sqrt(pow((x-(*ux)[0])/dx,2.0)+
+			pow((y-(*uy)[0])/dy,2.0));
+	double c2=sqrt(pow((x-(*ux)[1])/dx,2.0)+
+			pow((y-(*uy)[1])/dy,2.0));
+	double c3=sqrt(pow((x-(*ux)[2])/dx,2.0)+
+			pow((y-(*uy)[2])/dy,2.0));
+
+	// Sort initial points
+	if (c2<c1) {
+	  if (c3<c2) {
+	    // 321
+	    swap(i1,c1,i3,c3);
+	  } else if (c3<c1) {
+	    // 231
+	    swap(i1,c1,i2,c2);
+	    swap(i2,c2,i3,c3);
+	  } else {
+	    // 213
+	    swap(i1,c1,i2,c2);
+	  }
+	} else {
+	  if (c3<c1) {
+	    // 312
+	    swap(i1,c1,i3,c3);
+	    swap(i2,c2,i3,c3);
+	  } else if (c3<c2) {
+	    // 132
+	    swap(i3,c3,i2,c2);
+	  }
+	  // 123
 	}
-	// 123
-      }
 
-      // Go through remaining points and sort accordingly
-      for(size_t j=3;j<np;j++) {
-	size_t i4=j;
-	double c4=sqrt(pow((x-(*ux)[i4])/dx,2.0)+pow((y-(*uy)[i4])/dy,2.0));
-	if (c4<c1) {
-	  swap(i4,c4,i3,c3);
-	  swap(i3,c3,i2,c2);
-	  swap(i2,c2,i1,c1);
-	} else if (c4<c2) {
-	  swap(i4,c4,i3,c3);
-	  swap(i3,c3,i2,c2);
-	} else if (c4<c3) {
-	  swap(i4,c4,i3,c3);
+	// Go through remaining points and sort accordingly
+	for(size_t j=3;j<np;j++) {
+	  size_t i4=j;
+	  double c4=sqrt(pow((x-(*ux)[i4])/dx,2.0)+
+			  pow((y-(*uy)[i4])/dy,2.0));
+	  if (c4<c1) {
+	    swap(i4,c4,i3,c3);
+	    swap(i3,c3,i2,c2);
+	    swap(i2,c2,i1,c1);
+	  } else if (c4<c2) {
+	    swap(i4,c4,i3,c3);
+	    swap(i3,c3,i2,c2);
+	  } else if (c4<c3) {
+	    swap(i4,c4,i3,c3);
+	  }
 	}
+
       }
 
       // Solve for denominator:
@@ -344,6 +387,105 @@ namespace o2scl {
 
       return;
     }
+
+    /** \brief Interpolate at the \c n points in \c x and \c y,
+	storing the results in \c f
+    */
+    template<class vec2_t, class vec3_t>
+    void eval_batch(size_t n, const vec2_t &x, const vec2_t &y,
+		    vec3_t &f) const {
+
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interp2_planar::eval_batch().",
+		  exc_einval);
+	return;
+      }
+
+      // Exceptions cannot leave the parallel region, so the first
+      // error is stored here and the error handler is called after
+      // the loop
+      int err_ret=0;
+      std::string err_reason;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<n;i++) {
+	try {
+	  f[i]=eval(x[i],y[i]);
+	} catch (const std::exception &e) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_interp2_planar_err)
+#endif
+	  {
+	    if (err_ret==0) {
+	      err_ret=err_hnd->get_errno();
+	      if (err_ret==0) err_ret=exc_efailed;
+	      err_reason=e.what();
+	    }
+	  }
+	}
+      }
+
+      if (err_ret!=0) {
+	std::string str="Interpolation failed in interp2_planar::eval_batch(): "+
+	  err_reason;
+	O2SCL_ERR(str.c_str(),err_ret);
+      }
+      
+      return;
+    }
+
+    /** \brief Interpolate onto the grid specified by \c xg and
+	\c yg, storing the results in \c m
+
+	The value at <tt>(xg[i],yg[j])</tt> is stored in
+	<tt>m(i,j)</tt>, so that, for example, the matrix may be
+	a slice from \ref o2scl::table3d::get_slice() .
+    */
+    template<class vec2_t, class mat_t>
+    void eval_grid(size_t nx, const vec2_t &xg, size_t ny,
+		   const vec2_t &yg, mat_t &m) const {
+
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interp2_planar::eval_grid().",
+		  exc_einval);
+	return;
+      }
+
+      int err_ret=0;
+      std::string err_reason;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<nx;i++) {
+	try {
+	  for(size_t j=0;j<ny;j++) {
+	    m(i,j)=eval(xg[i],yg[j]);
+	  }
+	} catch (const std::exception &e) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_interp2_planar_err)
+#endif
+	  {
+	    if (err_ret==0) {
+	      err_ret=err_hnd->get_errno();
+	      if (err_ret==0) err_ret=exc_efailed;
+	      err_reason=e.what();
+	    }
+	  }
+	}
+      }
+
+      if (err_ret!=0) {
+	std::string str="Interpolation failed in interp2_planar::eval_grid(): "+
+	  err_reason;
+	O2SCL_ERR(str.c_str(),err_ret);
+      }
+      
+      return;
+    }
     
 #ifndef DOXYGEN_INTERNAL
 
@@ -359,6 +501,8 @@ namespace o2scl {
     vec_t *uf;
     /// True if the data has been specified
     bool data_set;
+    /// The grid used to find the closest points
+    interp2_bucket_index index;
     
     /// Swap points 1 and 2.
     int swap(size_t &index_1, double &dist_1, size_t &index_2, 
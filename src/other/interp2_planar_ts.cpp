@@ -21,14 +21,17 @@
   -------------------------------------------------------------------
 */
 #include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
 
 #include <o2scl/test_mgr.h>
 #include <o2scl/interp2_planar.h>
+#include <o2scl/rng.h>
 
 using namespace std;
 using namespace o2scl;
 
 typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
 
 int main(void) {
   test_mgr t;
@@ -58,6 +61,92 @@ int main(void) {
   cout << ip.eval(0.4,0.5) << endl;
   cout << ip.eval(0.03,1.0) << endl;
 
+  {
+    // Compare the grid of buckets with a brute-force search for a
+    // data set with a cluster of points and for query points both
+    // inside and outside the data
+    rng<> r;
+    r.set_seed(10);
+    size_t N=2000;
+    ubvector x2(N), y2(N), f2(N);
+    for(size_t i=0;i<N;i++) {
+      if (i%4==0) {
+	x2[i]=0.5+0.01*r.random();
+	y2[i]=2.0+0.02*r.random();
+      } else {
+	x2[i]=r.random();
+	y2[i]=4.0*r.random();
+      }
+      f2[i]=sin(x2[i])+cos(y2[i]);
+    }
+    
+    interp2_planar<ubvector> in2, in3;
+    in2.set_data(N,x2,y2,f2);
+    in3.use_index=false;
+    in3.set_data(N,x2,y2,f2);
+
+    bool match=true;
+    size_t nq=1000;
+    ubvector xq2(nq), yq2(nq), fq2(nq);
+    for(size_t k=0;k<nq;k++) {
+      double xq=1.4*r.random()-0.2;
+      double yq=5.0*r.random()-0.5;
+      xq2[k]=xq;
+      yq2[k]=yq;
+      size_t i1, i2, i3, j1, j2, j3;
+      double f1, f2, x1, y1, x2, y2, x3, y3;
+      in2.eval_points(xq,yq,f1,i1,x1,y1,i2,x2,y2,i3,x3,y3);
+      in3.eval_points(xq,yq,f2,j1,x1,y1,j2,x2,y2,j3,x3,y3);
+      if (i1!=j1 || i2!=j2 || i3!=j3 || f1!=f2) match=false;
+    }
+    t.test_gen(match,"index vs. brute force");
+
+    // Batch and grid evaluation
+    in2.eval_batch(nq,xq2,yq2,fq2);
+    bool batch_ok=true;
+    for(size_t k=0;k<nq;k++) {
+      if (fq2[k]!=in3.eval(xq2[k],yq2[k])) batch_ok=false;
+    }
+    t.test_gen(batch_ok,"eval_batch()");
+    
+    ubvector xg(11), yg(21);
+    for(size_t i=0;i<11;i++) xg[i]=0.1*i;
+    for(size_t j=0;j<21;j++) yg[j]=0.2*j;
+    ubmatrix m(11,21);
+    in2.eval_grid(11,xg,21,yg,m);
+    bool grid_ok=true;
+    for(size_t i=0;i<11;i++) {
+      for(size_t j=0;j<21;j++) {
+	if (m(i,j)!=in3.eval(xg[i],yg[j])) grid_ok=false;
+      }
+    }
+    t.test_gen(grid_ok,"eval_grid()");
+  }
+
+  {
+    // When all of the points are colinear, the error handler should
+    // be called by eval_batch() in the calling thread
+    ubvector x3(5), y3(5), f3(5), xq3(20), yq3(20), fq3(20);
+    for(size_t i=0;i<5;i++) {
+      x3[i]=((double)i);
+      y3[i]=2.0*x3[i];
+      f3[i]=x3[i];
+    }
+    for(size_t k=0;k<20;k++) {
+      xq3[k]=0.2*k;
+      yq3[k]=0.1*k;
+    }
+    interp2_planar<ubvector> in4;
+    in4.set_data(5,x3,y3,f3);
+    bool caught=false;
+    try {
+      in4.eval_batch(20,xq3,yq3,fq3);
+    } catch (std::exception &e) {
+      caught=true;
+    }
+    t.test_gen(caught,"eval_batch() colinear");
+  }
+
   t.report();
   return 0;
 }
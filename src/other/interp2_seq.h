@@ -29,6 +29,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -199,6 +200,71 @@ namespace o2scl {
       return eval(x,y);
     }
     
+    /** \brief Perform the 2-d interpolation at the \c n points
+	specified in \c x and \c y, storing the results in \c z
+
+	The points are sorted by their value of \c y so that the
+	interpolation in the x-direction is constructed only once for
+	each distinct value of \c y.
+    */
+    template<class vec2_t, class vec3_t>
+    void eval_batch(size_t n, const vec2_t &x, const vec2_t &y,
+		    vec3_t &z) const {
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interp2_seq::eval_batch().",exc_efailed);
+      }
+      if (n==0) return;
+
+      std::vector<size_t> order(n);
+      for(size_t k=0;k<n;k++) order[k]=k;
+      std::sort(order.begin(),order.end(),
+		[&y](size_t a, size_t b) { return y[a]<y[b]; });
+
+      ubvector icol(nx);
+      interp_vec<vec_t,ubvector> six;
+      for(size_t k=0;k<n;k++) {
+	size_t ik=order[k];
+	if (k==0 || y[ik]!=y[order[k-1]]) {
+	  for(size_t i=0;i<nx;i++) {
+	    icol[i]=itps[i]->eval(y[ik]);
+	  }
+	  six.set(nx,*xfun,icol,itype);
+	}
+	z[ik]=six.eval(x[ik]);
+      }
+      
+      return;
+    }
+    
+    /** \brief Perform the 2-d interpolation on the grid
+	specified by \c xo and \c yo, storing the results in 
+	<tt>zo(i,j)</tt>
+
+	The interpolation in the x-direction is constructed once
+	for each of the \c nyo values of \c y. 
+    */
+    template<class vec2_t, class mat2_t>
+    void eval_grid(size_t nxo, const vec2_t &xo, size_t nyo,
+		   const vec2_t &yo, mat2_t &zo) const {
+      if (data_set==false) {
+	O2SCL_ERR("Data not set in interp2_seq::eval_grid().",exc_efailed);
+      }
+      
+      ubvector icol(nx);
+      interp_vec<vec_t,ubvector> six;
+      for(size_t j=0;j<nyo;j++) {
+	for(size_t i=0;i<nx;i++) {
+	  icol[i]=itps[i]->eval(yo[j]);
+	}
+	six.set(nx,*xfun,icol,itype);
+	for(size_t i=0;i<nxo;i++) {
+	  zo(i,j)=six.eval(xo[i]);
+	}
+      }
+      
+      return;
+    }
+    
     /** \brief Compute the partial derivative in the x-direction
      */
     double deriv_x(double x, double y) const {
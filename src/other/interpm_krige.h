@@ -207,12 +207,17 @@ namespace o2scl {
       size_t n_covar=fcovar.size();
 
       inv_KXX.resize(n_out);
+      chol_KXX.clear();
+      noise_save.resize(noise_var.size());
+      for(size_t i=0;i<noise_var.size();i++) {
+        noise_save[i]=noise_var[i];
+      }
       
       // Loop over all output functions
       for(size_t iout=0;iout<n_out;iout++) {
 
         size_t icovar=iout % n_covar;
-        size_t inoise=iout & noise_var.size();
+        size_t inoise=iout % noise_var.size();
 
         // Select the row of the data matrix
         mat_y_row_t yiout(*y,iout);
@@ -305,6 +310,244 @@ namespace o2scl {
          noise_vec,rescale,err_on_fail);
     }
 
+    /** \brief Add \c n_new training points, updating the
+        decomposition of the covariance matrix
+
+        The matrices \c user_x and \c user_y should contain the
+        previous points (as passed to \ref set_data_noise() or the
+        most recent call to this function) followed by the \c n_new
+        new points. If the data was rescaled, then the new points are
+        rescaled in place using the same mean and standard deviation
+        as the original data. The covariance functions in \c fcovar
+        must be the same as those given to \ref set_data_noise(), and
+        the noise variances given there are used for the new points.
+
+        The first call to this function or \ref remove_points()
+        computes and stores the Cholesky decomposition of the
+        covariance matrix for each output. Subsequent calls extend this
+        decomposition with \ref o2scl_linalg::cholesky_decomp_append()
+        and update \ref Kinvf (and the inverse covariance matrix, if
+        \ref keep_matrix is true) in \f$ {\cal O}(n^2 k) \f$
+        operations, where \f$ n \f$ is the number of points and \f$ k
+        \f$ is the number of new points.
+
+        If the new covariance matrix is not positive definite, then
+        the error handler is called if \c err_on_fail is true and
+        otherwise a non-zero value is returned and the object is
+        left unchanged.
+    */
+    template<class func_vec_t>
+    int add_points(size_t n_new, mat_x_t &user_x, mat_y_t &user_y,
+                   func_vec_t &fcovar, bool err_on_fail=true) {
+      
+      if (data_set==false) {
+        O2SCL_ERR("Data not set in interpm_krige::add_points().",
+                  exc_einval);
+      }
+      if (user_x.size1()!=np+n_new || user_x.size2()!=nd_in) {
+        O2SCL_ERR2("Size of x not correct in ",
+                   "interpm_krige::add_points().",o2scl::exc_efailed);
+      }
+      if (user_y.size2()!=np+n_new || user_y.size1()!=nd_out) {
+        O2SCL_ERR2("Size of y not correct in ",
+                   "interpm_krige::add_points().",o2scl::exc_efailed);
+      }
+      if (n_new==0) return 0;
+
+      // Store the previous data so it can be restored on failure
+      mat_x_t *x_prev=x;
+      mat_y_t *y_prev=y;
+      x=&user_x;
+      y=&user_y;
+
+      // This uses only the previous points, so it is done before
+      // the new points are rescaled
+      if (chol_KXX.size()!=nd_out) {
+        int ret=chol_init(np,fcovar,err_on_fail);
+        if (ret!=0) {
+          x=x_prev;
+          y=y_prev;
+          return ret;
+        }
+      }
+      
+      if (rescaled) {
+        for(size_t i=np;i<np+n_new;i++) {
+          for(size_t j=0;j<nd_in;j++) {
+            user_x(i,j)=(user_x(i,j)-mean_x[j])/std_x[j];
+          }
+          for(size_t j=0;j<nd_out;j++) {
+            user_y(j,i)=(user_y(j,i)-mean_y[j])/std_y[j];
+          }
+        }
+      }
+      
+      size_t n2=np+n_new;
+      size_t n_covar=fcovar.size();
+      std::vector<mat_inv_kxx_t> chol_new(nd_out);
+
+      // The updated inverses are stored separately and only replace
+      // inv_KXX after all outputs have succeeded
+      bool update_inv=(keep_matrix && inv_KXX.size()==nd_out);
+      std::vector<mat_inv_kxx_t> inv_new;
+      if (update_inv) inv_new.resize(nd_out);
+      
+      for(size_t iout=0;iout<nd_out;iout++) {
+        
+        size_t icovar=iout % n_covar;
+        double noise=noise_save[iout % noise_save.size()];
+
+        // Copy the previous decomposition and fill the new rows
+        // of the covariance matrix
+        mat_inv_kxx_t &L=chol_new[iout];
+        L.resize(n2,n2);
+        for(size_t i=0;i<np;i++) {
+          for(size_t j=0;j<np;j++) {
+            L(i,j)=chol_KXX[iout](i,j);
+          }
+        }
+        for(size_t i=np;i<n2;i++) {
+          mat_x_row_t xrow(*x,i);
+          for(size_t j=0;j<=i;j++) {
+            mat_x_row_t xcol(*x,j);
+            L(i,j)=fcovar[icovar](xrow,xcol);
+          }
+          L(i,i)+=noise;
+        }
+
+        // The new rows of the covariance matrix are needed
+        // below to update the inverse
+        mat_inv_kxx_t B;
+        if (update_inv) {
+          B.resize(n2,n_new);
+          for(size_t i=0;i<n2;i++) {
+            for(size_t j=0;j<n_new;j++) {
+              if (i<np+j) B(i,j)=L(np+j,i);
+              else B(i,j)=L(i,np+j);
+            }
+          }
+        }
+        
+        int ret=o2scl_linalg::cholesky_decomp_append
+          (np,n_new,L,err_on_fail);
+        if (ret!=0) {
+          // Undo the rescaling of the new points so the user's
+          // data is unchanged on failure
+          if (rescaled) {
+            for(size_t i=np;i<n2;i++) {
+              for(size_t j=0;j<nd_in;j++) {
+                user_x(i,j)=user_x(i,j)*std_x[j]+mean_x[j];
+              }
+              for(size_t j=0;j<nd_out;j++) {
+                user_y(j,i)=user_y(j,i)*std_y[j]+mean_y[j];
+              }
+            }
+          }
+          x=x_prev;
+          y=y_prev;
+          return ret;
+        }
+
+        if (update_inv) {
+          inv_append(iout,n_new,B,inv_new[iout]);
+        }
+      }
+
+      std::swap(chol_KXX,chol_new);
+      if (update_inv) std::swap(inv_KXX,inv_new);
+      np=n2;
+      chol_Kinvf();
+      
+      return 0;
+    }
+
+    /** \brief Remove the first \c n_rem training points, updating the
+        decomposition of the covariance matrix
+
+        The matrices \c user_x and \c user_y should contain the
+        remaining points, i.e. the previous points with the first \c
+        n_rem rows removed, in the same order and with the same
+        scaling. This is intended for a moving window of training
+        points where the oldest points are evicted.
+
+        If the covariance matrix is \f$ K = L L^{T} \f$ with \f$ L =
+        \left( L_{11}, 0; L_{21}, L_{22} \right) \f$, then the
+        covariance matrix of the remaining points is \f$ L_{22}
+        L_{22}^{T} + L_{21} L_{21}^{T} \f$, so its decomposition is
+        obtained from \f$ L_{22} \f$ with \c n_rem applications of
+        \ref o2scl_linalg::cholesky_update_rank1(). This requires
+        \f$ {\cal O}(n^2 k) \f$ operations. If no decomposition has
+        been computed yet, the remaining points are decomposed
+        directly using \c fcovar.
+    */
+    template<class func_vec_t>
+    int remove_points(size_t n_rem, mat_x_t &user_x, mat_y_t &user_y,
+                      func_vec_t &fcovar, bool err_on_fail=true) {
+
+      if (data_set==false) {
+        O2SCL_ERR("Data not set in interpm_krige::remove_points().",
+                  exc_einval);
+      }
+      if (n_rem+2>np) {
+        O2SCL_ERR2("Must keep at least two points in ",
+                   "interpm_krige::remove_points().",o2scl::exc_einval);
+      }
+      if (user_x.size1()!=np-n_rem || user_x.size2()!=nd_in) {
+        O2SCL_ERR2("Size of x not correct in ",
+                   "interpm_krige::remove_points().",o2scl::exc_efailed);
+      }
+      if (user_y.size2()!=np-n_rem || user_y.size1()!=nd_out) {
+        O2SCL_ERR2("Size of y not correct in ",
+                   "interpm_krige::remove_points().",o2scl::exc_efailed);
+      }
+      if (n_rem==0) return 0;
+
+      x=&user_x;
+      y=&user_y;
+      size_t n2=np-n_rem;
+      
+      if (chol_KXX.size()!=nd_out) {
+        
+        int ret=chol_init(n2,fcovar,err_on_fail);
+        if (ret!=0) return ret;
+        if (keep_matrix) {
+          inv_KXX=chol_KXX;
+          for(size_t iout=0;iout<nd_out;iout++) {
+            o2scl_linalg::cholesky_invert<mat_inv_kxx_t>(n2,inv_KXX[iout]);
+          }
+        }
+        
+      } else {
+      
+        for(size_t iout=0;iout<nd_out;iout++) {
+
+          mat_inv_kxx_t L(n2,n2);
+          for(size_t i=0;i<n2;i++) {
+            for(size_t j=0;j<n2;j++) {
+              L(i,j)=chol_KXX[iout](i+n_rem,j+n_rem);
+            }
+          }
+          ubvector v(n2);
+          for(size_t k=0;k<n_rem;k++) {
+            for(size_t i=0;i<n2;i++) {
+              v[i]=chol_KXX[iout](i+n_rem,k);
+            }
+            o2scl_linalg::cholesky_update_rank1(n2,L,v);
+          }
+          std::swap(chol_KXX[iout],L);
+
+          if (keep_matrix && inv_KXX.size()==nd_out) {
+            inv_remove(iout,n_rem);
+          }
+        }
+      }
+
+      np=n2;
+      chol_Kinvf();
+      
+      return 0;
+    }
+    
     /** \brief Given covariance function \c fcovar and input vector \c x
         store the result of the interpolation in \c y
     */
@@ -389,7 +632,168 @@ namespace o2scl {
     ubvector std_y;
     /// True if the data needs to be rescaled
     bool rescaled;
-  
+
+    /// The noise variance for each output (from set_data_noise())
+    std::vector<double> noise_save;
+    
+    /** \brief The Cholesky decomposition of the covariance matrix for
+        each output quantity (used by \ref add_points() and \ref
+        remove_points())
+    */
+    std::vector<mat_inv_kxx_t> chol_KXX;
+
+    /** \brief Compute the Cholesky decomposition of the covariance
+        matrix for the first \c n points
+    */
+    template<class func_vec_t>
+    int chol_init(size_t n, func_vec_t &fcovar, bool err_on_fail) {
+      
+      size_t n_covar=fcovar.size();
+      std::vector<mat_inv_kxx_t> chol_new(nd_out);
+      
+      for(size_t iout=0;iout<nd_out;iout++) {
+        size_t icovar=iout % n_covar;
+        mat_inv_kxx_t &L=chol_new[iout];
+        L.resize(n,n);
+        for(size_t i=0;i<n;i++) {
+          mat_x_row_t xrow(*x,i);
+          for(size_t j=0;j<=i;j++) {
+            mat_x_row_t xcol(*x,j);
+            L(i,j)=fcovar[icovar](xrow,xcol);
+          }
+          L(i,i)+=noise_save[iout % noise_save.size()];
+        }
+        int ret=o2scl_linalg::cholesky_decomp(n,L,err_on_fail);
+        if (ret!=0) return ret;
+      }
+      
+      std::swap(chol_KXX,chol_new);
+      return 0;
+    }
+
+    /** \brief Compute \ref Kinvf from the Cholesky decompositions
+     */
+    void chol_Kinvf() {
+      for(size_t iout=0;iout<nd_out;iout++) {
+        Kinvf[iout].resize(np);
+        for(size_t i=0;i<np;i++) {
+          Kinvf[iout][i]=(*y)(iout,i);
+        }
+        o2scl_linalg::cholesky_svx(np,chol_KXX[iout],Kinvf[iout]);
+      }
+      return;
+    }
+
+    /** \brief Compute the inverse covariance matrix for output \c iout
+        after adding \c n_new points and store it in \c inv_new
+
+        The matrix \c B contains the last \c n_new columns of the new
+        covariance matrix. If \f$ K^{-1} \f$ is the previous inverse,
+        \f$ B = ( B_1; C ) \f$, \f$ W = K^{-1} B_1 \f$ and \f$ S = C -
+        B_1^{T} W \f$, then the new inverse is \f$ ( K^{-1} + W
+        S^{-1} W^{T}, -W S^{-1}; -S^{-1} W^{T}, S^{-1} ) \f$.
+    */
+    void inv_append(size_t iout, size_t n_new, const mat_inv_kxx_t &B,
+                    mat_inv_kxx_t &inv_new) {
+
+      size_t n2=np+n_new;
+      const mat_inv_kxx_t &Kinv=inv_KXX[iout];
+
+      // W = K^{-1} B_1
+      mat_inv_kxx_t W(np,n_new);
+      for(size_t i=0;i<np;i++) {
+        for(size_t j=0;j<n_new;j++) {
+          double sum=0.0;
+          for(size_t k=0;k<np;k++) sum+=Kinv(i,k)*B(k,j);
+          W(i,j)=sum;
+        }
+      }
+
+      // The inverse of the Schur complement S = C - B_1^T W
+      mat_inv_kxx_t S(n_new,n_new);
+      for(size_t i=0;i<n_new;i++) {
+        for(size_t j=0;j<n_new;j++) {
+          double sum=0.0;
+          for(size_t k=0;k<np;k++) sum+=B(k,i)*W(k,j);
+          S(i,j)=B(np+i,j)-sum;
+        }
+      }
+      o2scl_linalg::cholesky_decomp(n_new,S);
+      o2scl_linalg::cholesky_invert<mat_inv_kxx_t>(n_new,S);
+
+      // V = W S^{-1}
+      mat_inv_kxx_t V(np,n_new);
+      for(size_t i=0;i<np;i++) {
+        for(size_t j=0;j<n_new;j++) {
+          double sum=0.0;
+          for(size_t k=0;k<n_new;k++) sum+=W(i,k)*S(k,j);
+          V(i,j)=sum;
+        }
+      }
+
+      inv_new.resize(n2,n2);
+      for(size_t i=0;i<np;i++) {
+        for(size_t j=0;j<np;j++) {
+          double sum=0.0;
+          for(size_t k=0;k<n_new;k++) sum+=V(i,k)*W(j,k);
+          inv_new(i,j)=Kinv(i,j)+sum;
+        }
+        for(size_t j=0;j<n_new;j++) {
+          inv_new(i,np+j)=-V(i,j);
+          inv_new(np+j,i)=-V(i,j);
+        }
+      }
+      for(size_t i=0;i<n_new;i++) {
+        for(size_t j=0;j<n_new;j++) {
+          inv_new(np+i,np+j)=S(i,j);
+        }
+      }
+      
+      return;
+    }
+
+    /** \brief Update the inverse covariance matrix for output \c iout
+        after removing the first \c n_rem points
+
+        If the previous inverse is \f$ ( S, Q^{T}; Q, P ) \f$, then
+        the inverse of the covariance matrix of the remaining points
+        is \f$ P - Q S^{-1} Q^{T} \f$.
+    */
+    void inv_remove(size_t iout, size_t n_rem) {
+
+      size_t n2=np-n_rem;
+      const mat_inv_kxx_t &Kinv=inv_KXX[iout];
+
+      mat_inv_kxx_t S(n_rem,n_rem);
+      for(size_t i=0;i<n_rem;i++) {
+        for(size_t j=0;j<n_rem;j++) {
+          S(i,j)=Kinv(i,j);
+        }
+      }
+      o2scl_linalg::cholesky_decomp(n_rem,S);
+
+      // T = Q S^{-1}, computed one row at a time
+      mat_inv_kxx_t T(n2,n_rem);
+      ubvector row(n_rem);
+      for(size_t i=0;i<n2;i++) {
+        for(size_t j=0;j<n_rem;j++) row[j]=Kinv(n_rem+i,j);
+        o2scl_linalg::cholesky_svx(n_rem,S,row);
+        for(size_t j=0;j<n_rem;j++) T(i,j)=row[j];
+      }
+
+      mat_inv_kxx_t inv_new(n2,n2);
+      for(size_t i=0;i<n2;i++) {
+        for(size_t j=0;j<n2;j++) {
+          double sum=0.0;
+          for(size_t k=0;k<n_rem;k++) sum+=T(i,k)*Kinv(n_rem+j,k);
+          inv_new(i,j)=Kinv(n_rem+i,n_rem+j)-sum;
+        }
+      }
+      std::swap(inv_KXX[iout],inv_new);
+      
+      return;
+    }
+
 #endif
   
   };
@@ -58,6 +58,39 @@ double ft(double x, double y) {
   return 3.0-2.0*x*x+7.0*y;
 }
 
+/* A child class which provides access to the inverse covariance
+   matrices for testing
+*/
+template<class vec_t, class mat_x_t, class mat_x_row_t, class mat_x_col_t,
+         class mat_y_t, class mat_y_row_t, class mat_inv_kxx_t>
+class interpm_krige_inv :
+  public interpm_krige<vec_t,mat_x_t,mat_x_row_t,mat_x_col_t,mat_y_t,
+                       mat_y_row_t,mat_inv_kxx_t> {
+  
+public:
+  
+  const mat_inv_kxx_t &get_inv(size_t iout) {
+    return this->inv_KXX[iout];
+  }
+  
+};
+
+/* The maximum absolute difference between two matrices relative to
+   the largest element of the first, or 1 if the sizes differ
+*/
+template<class mat_t>
+double inv_diff(const mat_t &m1, const mat_t &m2) {
+  if (m1.size1()!=m2.size1() || m1.size2()!=m2.size2()) return 1.0;
+  double dmax=0.0, mmax=0.0;
+  for(size_t i=0;i<m1.size1();i++) {
+    for(size_t j=0;j<m1.size2();j++) {
+      dmax=std::max(dmax,fabs(m1(i,j)-m2(i,j)));
+      mmax=std::max(mmax,fabs(m1(i,j)));
+    }
+  }
+  return dmax/mmax;
+}
+
 int main(void) {
   test_mgr t;
   t.set_output_level(1);
@@ -163,6 +196,165 @@ int main(void) {
     
   }
 
+  {
+    cout << "interpm_krige, adding and removing points" << endl;
+
+    typedef boost::numeric::ublas::vector<double> ubvector;
+    typedef boost::numeric::ublas::matrix<double> ubmatrix;
+    typedef o2scl::matrix_view_table<> mat_x_t;
+    typedef const matrix_row_gen<mat_x_t> mat_x_row_t;
+    typedef const matrix_column_gen<mat_x_t> mat_x_col_t;
+    typedef o2scl::matrix_view_table_transpose<> mat_y_t;
+    typedef const matrix_row_gen<mat_y_t> mat_y_row_t;
+    typedef vector<function<double(mat_x_row_t &, mat_x_row_t &) > > f1_t;
+    typedef vector<function<double(mat_x_row_t &, const ubvector &) > > f2_t;
+    
+    f1_t fa1={std::bind(&covar<mat_x_row_t,mat_x_row_t>,
+                        std::placeholders::_1,std::placeholders::_2,0.3)};
+    f2_t fa2={std::bind(&covar<mat_x_row_t,ubvector>,
+                        std::placeholders::_1,std::placeholders::_2,0.3)};
+    vector<string> col_list_x={"x","y"};
+    vector<string> col_list_y={"z"};
+    ubvector noise(1);
+    noise[0]=1.0e-6;
+
+    // Twelve points, the first eight in tab1
+    table<> tab1, tab2;
+    tab1.line_of_names("x y z");
+    for(size_t i=0;i<12;i++) {
+      double xx=fmod(i*0.618034,1.0);
+      double yy=fmod(i*0.414214+0.1,1.0);
+      if (i==8) tab2=tab1;
+      tab1.line_of_data(3,vector<double>({xx,yy,ft(xx,yy)}));
+    }
+    
+    // Set the first eight points and then add four more
+    interpm_krige_inv<ubvector,mat_x_t,mat_x_row_t,mat_x_col_t,
+                      mat_y_t,mat_y_row_t,ubmatrix> ik, ik2;
+    table<> tab=tab2, tab_full=tab1;
+    matrix_view_table<> mx(tab,col_list_x);
+    matrix_view_table_transpose<> my(tab,col_list_y);
+    ik.set_data_noise(2,1,8,mx,my,fa1,noise);
+    for(size_t i=8;i<12;i++) {
+      tab.line_of_data(3,vector<double>({tab1.get("x",i),tab1.get("y",i),
+                                         tab1.get("z",i)}));
+    }
+    matrix_view_table<> mx2(tab,col_list_x);
+    matrix_view_table_transpose<> my2(tab,col_list_y);
+    ik.add_points(4,mx2,my2,fa1);
+    
+    // Compare with the result from all twelve points at once
+    matrix_view_table<> mx3(tab_full,col_list_x);
+    matrix_view_table_transpose<> my3(tab_full,col_list_y);
+    ik2.set_data_noise(2,1,12,mx3,my3,fa1,noise);
+      
+    ubvector point(2), out(1), out2(1);
+    point[0]=0.4;
+    point[1]=0.5;
+    ik.eval(point,out,fa2);
+    ik2.eval(point,out2,fa2);
+    t.test_rel(out[0],out2[0],1.0e-8,"add points");
+    t.test_abs(inv_diff(ik2.get_inv(0),ik.get_inv(0)),0.0,1.0e-8,
+               "add points inverse");
+    
+    // Remove the first five points and compare with the result from
+    // the remaining seven at once
+    tab.delete_rows_ends(0,4);
+    tab_full=tab1;
+    tab_full.delete_rows_ends(0,4);
+    matrix_view_table<> mx4(tab,col_list_x);
+    matrix_view_table_transpose<> my4(tab,col_list_y);
+    ik.remove_points(5,mx4,my4,fa1);
+    matrix_view_table<> mx5(tab_full,col_list_x);
+    matrix_view_table_transpose<> my5(tab_full,col_list_y);
+    ik2.set_data_noise(2,1,7,mx5,my5,fa1,noise);
+    point[0]=0.7;
+    point[1]=0.2;
+    ik.eval(point,out,fa2);
+    ik2.eval(point,out2,fa2);
+    t.test_rel(out[0],out2[0],1.0e-8,"remove points");
+    t.test_abs(inv_diff(ik2.get_inv(0),ik.get_inv(0)),0.0,1.0e-8,
+               "remove points inverse");
+
+    // Two outputs, where the covariance function for the second
+    // output is made invalid for the last new point, so that the
+    // update of the first output succeeds but the second fails. The
+    // object, including the inverse of the first output, should
+    // be unchanged.
+    bool invalid=false;
+    double x_last=tab1.get("x",11);
+    f1_t fa3={fa1[0],[&invalid,x_last](mat_x_row_t &xr, mat_x_row_t &xc) {
+      if (invalid && xr[0]==x_last && xc[0]==x_last) return -1.0;
+      return covar<mat_x_row_t,mat_x_row_t>(xr,xc,0.3);
+    }};
+    vector<string> col_list_y2={"z","w"};
+    table<> tab4=tab2;
+    tab4.function_column("z","w");
+    matrix_view_table<> mx8(tab4,col_list_x);
+    matrix_view_table_transpose<> my8(tab4,col_list_y2);
+    interpm_krige_inv<ubvector,mat_x_t,mat_x_row_t,mat_x_col_t,
+                      mat_y_t,mat_y_row_t,ubmatrix> ik4;
+    ik4.set_data_noise(2,2,8,mx8,my8,fa3,noise);
+    ubmatrix inv0=ik4.get_inv(0), inv1=ik4.get_inv(1);
+    point[0]=0.4;
+    point[1]=0.5;
+    ubvector out3(2), out4(2);
+    ik4.eval(point,out3,fa2);
+    for(size_t i=8;i<12;i++) {
+      tab4.line_of_data(4,vector<double>({tab1.get("x",i),tab1.get("y",i),
+                                          tab1.get("z",i),
+                                          tab1.get("z",i)}));
+    }
+    matrix_view_table<> mx9(tab4,col_list_x);
+    matrix_view_table_transpose<> my9(tab4,col_list_y2);
+    invalid=true;
+    int ret=ik4.add_points(4,mx9,my9,fa3,false);
+    t.test_gen(ret!=0,"add points failure");
+    t.test_gen(inv_diff(inv0,ik4.get_inv(0))==0.0,
+               "add points failure inverse 0");
+    t.test_gen(inv_diff(inv1,ik4.get_inv(1))==0.0,
+               "add points failure inverse 1");
+    ik4.eval(point,out4,fa2);
+    t.test_rel(out4[0],out3[0],1.0e-14,"add points failure eval");
+    
+    // With the valid covariance function, the update now succeeds
+    // and both inverses are updated
+    invalid=false;
+    ret=ik4.add_points(4,mx9,my9,fa3,false);
+    t.test_gen(ret==0,"add points after failure");
+    matrix_view_table<> mx10(tab1,col_list_x);
+    matrix_view_table_transpose<> my10(tab1,col_list_y);
+    ik2.set_data_noise(2,1,12,mx10,my10,fa1,noise);
+    t.test_abs(inv_diff(ik2.get_inv(0),ik4.get_inv(0)),0.0,1.0e-8,
+               "add points after failure inverse 0");
+    t.test_abs(inv_diff(ik2.get_inv(0),ik4.get_inv(1)),0.0,1.0e-8,
+               "add points after failure inverse 1");
+
+    // With rescaling, the new points use the original scaling, so
+    // just check that the new points are reproduced
+    interpm_krige<ubvector,mat_x_t,mat_x_row_t,mat_x_col_t,
+                  mat_y_t,mat_y_row_t,ubmatrix> ik3;
+    table<> tab3=tab2;
+    matrix_view_table<> mx6(tab3,col_list_x);
+    matrix_view_table_transpose<> my6(tab3,col_list_y);
+    ik3.set_data_noise(2,1,8,mx6,my6,fa1,noise,true);
+    for(size_t i=8;i<12;i++) {
+      tab3.line_of_data(3,vector<double>({tab1.get("x",i),tab1.get("y",i),
+                                          tab1.get("z",i)}));
+    }
+    matrix_view_table<> mx7(tab3,col_list_x);
+    matrix_view_table_transpose<> my7(tab3,col_list_y);
+    ik3.add_points(4,mx7,my7,fa1);
+    point[0]=tab1.get("x",10);
+    point[1]=tab1.get("y",10);
+    ik3.eval(point,out,fa2);
+    t.test_rel(out[0],tab1.get("z",10),1.0e-4,"add points rescaled");
+    ik3.unscale();
+    t.test_rel(tab3.get("z",10),tab1.get("z",10),1.0e-12,
+               "add points unscale");
+    cout << endl;
+  }
+
 #ifdef O2SCL_NEVER_DEFINED
   
   {
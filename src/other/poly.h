@@ -3337,6 +3337,399 @@ namespace o2scl {
     
   };
 
+  /** \brief Solve many cubic polynomials with real coefficients
+      at once
+
+      This class solves \f$ a_3 x^3 + b_3 x^2 + c_3 x + d_3 = 0 \f$
+      for arrays of coefficients. The polynomials are processed in
+      blocks of \ref blk. Within each block, the polynomials are
+      first sorted into those with three real roots, which are
+      solved with the trigonometric form, and those with one real
+      root, which are solved with Cardano's formula. Each form is
+      then evaluated in a separate loop without data-dependent
+      branches, which the compiler can vectorize.
+
+      When \ref polish is true (the default), each real root is
+      improved with one Newton step which is accepted only if it
+      reduces the residual. When there is only one real root, the
+      complex pair is then recomputed from the polished real root
+      using the relations between the roots and the coefficients.
+
+      The results are stored in three output arrays and the number
+      of real roots (either 1 or 3) is stored in \c n_real. If there
+      are three real roots, they are stored in ascending order in
+      \c x1, \c x2, and \c x3. If there is one real root, it is
+      stored in \c x1, and the complex roots are \c x2 \f$ \pm i \f$
+      \c x3 with \c x3 non-negative.
+  */
+  template<class fp_t=double> class cubic_real_batch {
+
+  protected:
+    
+    /// The block size
+    static const size_t blk=64;
+    
+  public:
+
+    cubic_real_batch() {
+      polish=true;
+    }
+
+    /// If true, polish the roots with a Newton step (default true)
+    bool polish;
+
+    /** \brief Solve the \c n cubics 
+        \f$ x^3 + b_3 x^2 + c_3 x + d_3 = 0 \f$ 
+        with leading coefficient 1
+    */
+    void solve_monic(size_t n, const fp_t *b3, const fp_t *c3,
+                     const fp_t *d3, fp_t *x1, fp_t *x2, fp_t *x3,
+                     int *n_real) {
+      
+      using std::sqrt;
+      using std::cbrt;
+      using std::acos;
+      using std::cos;
+      using std::fabs;
+      
+      fp_t one=1;
+      fp_t root3half=sqrt(one*3)/2;
+      fp_t Q[blk], R[blk];
+      size_t ix3[blk], ix1[blk];
+      
+      for(size_t j=0;j<n;j+=blk) {
+        size_t m=(n-j<blk ? n-j : blk);
+
+        // Compute Q and R and then sort the polynomials by the
+        // number of real roots, so that the two loops below
+        // evaluate only the form which is needed
+        for(size_t i=0;i<m;i++) {
+          fp_t a=b3[j+i];
+          Q[i]=(a*a-3*c3[j+i])/9;
+          R[i]=(a*(2*a*a-9*c3[j+i])+27*d3[j+i])/54;
+        }
+        size_t n3=0, n1=0;
+        for(size_t i=0;i<m;i++) {
+          if (R[i]*R[i]<Q[i]*Q[i]*Q[i]) {
+            ix3[n3++]=i;
+          } else {
+            ix1[n1++]=i;
+          }
+        }
+
+        // Trigonometric form for three real roots. We use 
+        // cos(theta +/- 2 pi/3) = -cos(theta)/2 -/+ sqrt(3)/2
+        // sin(theta) to avoid two additional calls to cos().
+        for(size_t k=0;k<n3;k++) {
+          size_t i=ix3[k];
+          fp_t a3=b3[j+i]/3;
+          fp_t sqrtQ=sqrt(Q[i]);
+          fp_t ct=R[i]/(sqrtQ*sqrtQ*sqrtQ);
+          ct=(ct>1 ? one : (ct<-1 ? -one : ct));
+          fp_t cth=cos(acos(ct)/3);
+          fp_t sth2=1-cth*cth;
+          fp_t sth=sqrt(sth2>0 ? sth2 : 0);
+          fp_t norm=-2*sqrtQ;
+          x1[j+i]=norm*cth-a3;
+          x2[j+i]=norm*(-cth/2+root3half*sth)-a3;
+          x3[j+i]=norm*(-cth/2-root3half*sth)-a3;
+          n_real[j+i]=3;
+        }
+        
+        // Cardano form for one real root
+        for(size_t k=0;k<n1;k++) {
+          size_t i=ix1[k];
+          fp_t a3=b3[j+i]/3;
+          fp_t diff=R[i]*R[i]-Q[i]*Q[i]*Q[i];
+          fp_t A=cbrt(fabs(R[i])+sqrt(diff>0 ? diff : 0));
+          A=(R[i]>=0 ? -A : A);
+          fp_t B=(A!=0 ? Q[i]/A : 0);
+          x1[j+i]=A+B-a3;
+          x2[j+i]=-(A+B)/2-a3;
+          x3[j+i]=root3half*fabs(A-B);
+          n_real[j+i]=1;
+        }
+      }
+
+      if (polish) {
+        for(size_t i=0;i<n;i++) {
+          fp_t a=b3[i], c=c3[i], d=d3[i];
+          bool three=(n_real[i]==3);
+          x1[i]=newton(a,c,d,x1[i]);
+          fp_t r2=newton(a,c,d,x2[i]);
+          fp_t r3=newton(a,c,d,x3[i]);
+          // The complex pair from the relations between the roots
+          // and the coefficients. The modulus squared of the pair
+          // is either -d/x1 or c-2 re x1, and the first is used
+          // only when the real root is the larger in magnitude,
+          // since it loses precision when x1 is small (e.g. d=0).
+          fp_t re=-(a+x1[i])/2;
+          fp_t prod=c-2*re*x1[i];
+          prod=(x1[i]*x1[i]>fabs(prod) ? -d/x1[i] : prod);
+          fp_t im2=prod-re*re;
+          x2[i]=(three ? r2 : re);
+          x3[i]=(three ? r3 : sqrt(im2>0 ? im2 : 0));
+        }
+      }
+      
+      return;
+    }
+
+    /** \brief Solve the \c n cubics 
+        \f$ a_3 x^3 + b_3 x^2 + c_3 x + d_3 = 0 \f$ 
+    */
+    int solve_r(size_t n, const fp_t *a3, const fp_t *b3, const fp_t *c3,
+                const fp_t *d3, fp_t *x1, fp_t *x2, fp_t *x3,
+                int *n_real) {
+
+      for(size_t i=0;i<n;i++) {
+        if (a3[i]==0) {
+          O2SCL_ERR2("Leading coefficient zero in ",
+                     "cubic_real_batch::solve_r().",exc_einval);
+          return exc_einval;
+        }
+      }
+      
+      fp_t b[blk], c[blk], d[blk];
+      for(size_t j=0;j<n;j+=blk) {
+        size_t m=(n-j<blk ? n-j : blk);
+        for(size_t i=0;i<m;i++) {
+          b[i]=b3[j+i]/a3[j+i];
+          c[i]=c3[j+i]/a3[j+i];
+          d[i]=d3[j+i]/a3[j+i];
+        }
+        solve_monic(m,b,c,d,x1+j,x2+j,x3+j,n_real+j);
+      }
+      
+      return success;
+    }
+    
+    /// Return a string denoting the type ("cubic_real_batch")
+    const char *type() { return "cubic_real_batch"; }
+
+  protected:
+
+    /** \brief Take one Newton step for \f$ x^3+a x^2+c x+d \f$,
+        keeping it only if it reduces the residual
+    */
+    fp_t newton(const fp_t &a, const fp_t &c, const fp_t &d,
+                const fp_t &x) {
+      using std::fabs;
+      fp_t f=((x+a)*x+c)*x+d;
+      fp_t df=(3*x+2*a)*x+c;
+      fp_t xn=(df!=0 ? x-f/df : x);
+      fp_t fn=((xn+a)*xn+c)*xn+d;
+      return (fabs(fn)<fabs(f) ? xn : x);
+    }
+    
+  };
+
+  /** \brief Solve many quartic polynomials with real coefficients
+      at once
+
+      This class solves 
+      \f$ a_4 x^4 + b_4 x^3 + c_4 x^2 + d_4 x + e_4 = 0 \f$
+      for arrays of coefficients using Ferrari's method. The
+      largest root of the resolvent cubic is obtained from
+      \ref cubic_real_batch::solve_monic() (always with polishing),
+      and the quartic is then factored into two quadratics. The
+      constant terms of the quadratics are computed from their sum
+      and product rather than by dividing by the square root of the
+      resolvent root, so that biquadratic equations do not require
+      a separate branch. As in \ref cubic_real_batch, the
+      polynomials are processed in blocks, and the loops which
+      factor the quartic and polish the roots contain no
+      data-dependent branches.
+
+      When \ref polish is true (the default), each real root is
+      improved with one Newton step which is accepted only if it
+      reduces the residual, and when there are exactly two real
+      roots the complex pair is recomputed from the polished real
+      roots.
+
+      The number of real roots (0, 2, or 4) is stored in \c n_real.
+      The real roots are stored first, in ascending order. Each
+      complex conjugate pair \f$ u \pm i v \f$ then takes two
+      consecutive slots, \f$ u \f$ followed by \f$ v \ge 0 \f$. Thus
+      if there are two real roots, they are in \c x1 and \c x2 and
+      the complex roots are \c x3 \f$ \pm i \f$ \c x4.
+  */
+  template<class fp_t=double> class quartic_real_batch {
+
+  protected:
+    
+    /// The block size
+    static const size_t blk=64;
+
+    /// The solver for the resolvent cubic
+    cubic_real_batch<fp_t> cub;
+    
+  public:
+
+    quartic_real_batch() {
+      polish=true;
+    }
+
+    /// If true, polish the roots with a Newton step (default true)
+    bool polish;
+
+    /** \brief Solve the \c n quartics 
+        \f$ a_4 x^4 + b_4 x^3 + c_4 x^2 + d_4 x + e_4 = 0 \f$ 
+    */
+    int solve_r(size_t n, const fp_t *a4, const fp_t *b4, const fp_t *c4,
+                const fp_t *d4, const fp_t *e4, fp_t *x1, fp_t *x2,
+                fp_t *x3, fp_t *x4, int *n_real) {
+      
+      using std::sqrt;
+      using std::fabs;
+      
+      for(size_t i=0;i<n;i++) {
+        if (a4[i]==0) {
+          O2SCL_ERR2("Leading coefficient zero in ",
+                     "quartic_real_batch::solve_r().",exc_einval);
+          return exc_einval;
+        }
+      }
+
+      // Monic coefficients
+      fp_t b[blk], c[blk], d[blk], e[blk];
+      // Depressed quartic y^4+p y^2+q y+r with x=y-b/4
+      fp_t p[blk], q[blk], r[blk];
+      // Resolvent cubic and its roots
+      fp_t rb[blk], rc[blk], rd[blk], m1[blk], m2[blk], m3[blk];
+      int nr[blk];
+
+      cub.polish=true;
+      
+      for(size_t j=0;j<n;j+=blk) {
+        size_t m=(n-j<blk ? n-j : blk);
+        
+        for(size_t i=0;i<m;i++) {
+          b[i]=b4[j+i]/a4[j+i];
+          c[i]=c4[j+i]/a4[j+i];
+          d[i]=d4[j+i]/a4[j+i];
+          e[i]=e4[j+i]/a4[j+i];
+          fp_t s=b[i]/4;
+          fp_t s2=s*s;
+          p[i]=c[i]-6*s2;
+          q[i]=d[i]-2*s*c[i]+8*s2*s;
+          r[i]=e[i]-s*d[i]+s2*c[i]-3*s2*s2;
+          rb[i]=p[i];
+          rc[i]=p[i]*p[i]/4-r[i];
+          rd[i]=-q[i]*q[i]/8;
+        }
+
+        cub.solve_monic(m,rb,rc,rd,m1,m2,m3,nr);
+        
+        for(size_t i=0;i<m;i++) {
+          
+          // The largest root of the resolvent, which is never
+          // negative
+          fp_t mu=(nr[i]==3 ? m3[i] : m1[i]);
+          mu=(mu>0 ? mu : 0);
+
+          // Factor into (y^2+s y+ca)*(y^2-s y+cb) with
+          // ca+cb=p+2 mu, ca*cb=r, and cb-ca=q/s
+          fp_t s=sqrt(2*mu);
+          fp_t h=p[i]/2+mu;
+          fp_t g2=h*h-r[i];
+          fp_t g=sqrt(g2>0 ? g2 : 0);
+          g=(q[i]>=0 ? g : -g);
+          fp_t ca=h-g;
+          fp_t cb=h+g;
+          bool abig=(fabs(ca)>=fabs(cb));
+          fp_t big=(abig ? ca : cb);
+          fp_t small=(big!=0 ? r[i]/big : 0);
+          ca=(abig ? ca : small);
+          cb=(abig ? small : cb);
+
+          // The roots of the two quadratics
+          fp_t shift=b[i]/4;
+          fp_t Da=s*s/4-ca;
+          fp_t Db=s*s/4-cb;
+          bool reala=(Da>=0);
+          bool realb=(Db>=0);
+          fp_t sDa=sqrt(fabs(Da));
+          fp_t sDb=sqrt(fabs(Db));
+          fp_t ya1=-s/2-sDa;
+          fp_t ya2=(ya1!=0 ? ca/ya1 : 0);
+          fp_t yb1=s/2+sDb;
+          fp_t yb2=(yb1!=0 ? cb/yb1 : 0);
+          fp_t ra1=(ya1<ya2 ? ya1 : ya2)-shift;
+          fp_t ra2=(ya1<ya2 ? ya2 : ya1)-shift;
+          fp_t rb1=(yb1<yb2 ? yb1 : yb2)-shift;
+          fp_t rb2=(yb1<yb2 ? yb2 : yb1)-shift;
+          fp_t rea=-s/2-shift;
+          fp_t reb=s/2-shift;
+
+          // Sort the four real roots: ra1<=ra2 and rb1<=rb2 already
+          fp_t lo=(ra1<rb1 ? ra1 : rb1);
+          fp_t hi=(ra2<rb2 ? rb2 : ra2);
+          fp_t mida=(ra1<rb1 ? rb1 : ra1);
+          fp_t midb=(ra2<rb2 ? ra2 : rb2);
+          fp_t mid1=(mida<midb ? mida : midb);
+          fp_t mid2=(mida<midb ? midb : mida);
+
+          bool four=(reala && realb);
+          x1[j+i]=(four ? lo : (reala ? ra1 : (realb ? rb1 : rea)));
+          x2[j+i]=(four ? mid1 : (reala ? ra2 : (realb ? rb2 : sDa)));
+          x3[j+i]=(four ? mid2 : (realb && !reala ? rea : reb));
+          x4[j+i]=(four ? hi : (realb && !reala ? sDa : sDb));
+          nr[i]=(four ? 4 : (reala || realb ? 2 : 0));
+          n_real[j+i]=nr[i];
+        }
+
+        if (polish) {
+          for(size_t i=0;i<m;i++) {
+            size_t k=j+i;
+            bool four=(nr[i]==4), two=(nr[i]==2);
+            fp_t r1=newton(b[i],c[i],d[i],e[i],x1[k]);
+            fp_t r2=newton(b[i],c[i],d[i],e[i],x2[k]);
+            fp_t r3=newton(b[i],c[i],d[i],e[i],x3[k]);
+            fp_t r4=newton(b[i],c[i],d[i],e[i],x4[k]);
+            // For two real roots, recompute the complex pair from
+            // the quadratic factor x^2+u x+v. The constant v is
+            // either e/P or c+S u-P, and the first is used only
+            // when |P|>|v|, since it loses precision when the real
+            // roots are small (e.g. e=0).
+            fp_t S=r1+r2;
+            fp_t P=r1*r2;
+            fp_t u=b[i]+S;
+            fp_t v=c[i]+S*u-P;
+            v=(fabs(P)>fabs(v) ? e[i]/P : v);
+            fp_t im2=v-u*u/4;
+            x1[k]=(nr[i]>0 ? r1 : x1[k]);
+            x2[k]=(nr[i]>0 ? r2 : x2[k]);
+            x3[k]=(four ? r3 : (two ? -u/2 : x3[k]));
+            x4[k]=(four ? r4 : (two ? sqrt(im2>0 ? im2 : 0) : x4[k]));
+          }
+        }
+        
+      }
+      
+      return success;
+    }
+    
+    /// Return a string denoting the type ("quartic_real_batch")
+    const char *type() { return "quartic_real_batch"; }
+
+  protected:
+
+    /** \brief Take one Newton step for \f$ x^4+b x^3+c x^2+d x+e \f$,
+        keeping it only if it reduces the residual
+    */
+    fp_t newton(const fp_t &b, const fp_t &c, const fp_t &d,
+                const fp_t &e, const fp_t &x) {
+      using std::fabs;
+      fp_t f=(((x+b)*x+c)*x+d)*x+e;
+      fp_t df=((4*x+3*b)*x+2*c)*x+d;
+      fp_t xn=(df!=0 ? x-f/df : x);
+      fp_t fn=(((xn+b)*xn+c)*xn+d)*xn+e;
+      return (fabs(fn)<fabs(f) ? xn : x);
+    }
+    
+  };
+
 }
 
 #endif
@@ -22,6 +22,7 @@
 */
 #include <string>
 #include <ctime>
+#include <algorithm>
 #include <o2scl/test_mgr.h>
 #include <o2scl/misc.h>
 #include <o2scl/poly.h>
@@ -504,6 +505,182 @@ void test_quartic_complex_boost(quartic_complex<fp_t,cx_t> *po,
   return;
 }
 
+/** \brief Test the batch solvers on polynomials constructed 
+    from known roots
+*/
+template<class fp_t=double>
+void test_batch(string str, fp_t tol) {
+
+  size_t n=1000;
+  std::vector<fp_t> a(n), b(n), c(n), d(n), e(n);
+  std::vector<fp_t> x1(n), x2(n), x3(n), x4(n);
+  std::vector<fp_t> y1(n), y2(n), y3(n), y4(n);
+  std::vector<int> nr(n), nr_exp(n);
+  
+  // Cubics with three real roots or one real root and a complex 
+  // pair, r2 +/- i r3
+  for(size_t i=0;i<n;i++) {
+    fp_t fi=i;
+    fp_t r[3]={2*sin(fi*1.1+0.3),2*sin(fi*2.3+1.7),2*sin(fi*0.7+2.9)};
+    a[i]=1+sin(fi*0.37)/2;
+    if (i%2==0) {
+      std::sort(r,r+3);
+      b[i]=-a[i]*(r[0]+r[1]+r[2]);
+      c[i]=a[i]*(r[0]*r[1]+r[0]*r[2]+r[1]*r[2]);
+      d[i]=-a[i]*r[0]*r[1]*r[2];
+      nr_exp[i]=3;
+    } else {
+      // Include some cubics with d=0, for which the real root
+      // is zero
+      if (i%7==1) r[0]=0;
+      r[2]=fabs(r[2])+1/((fp_t)10);
+      fp_t mod2=r[1]*r[1]+r[2]*r[2];
+      b[i]=-a[i]*(r[0]+2*r[1]);
+      c[i]=a[i]*(2*r[0]*r[1]+mod2);
+      d[i]=-a[i]*r[0]*mod2;
+      nr_exp[i]=1;
+    }
+    y1[i]=r[0];
+    y2[i]=r[1];
+    y3[i]=r[2];
+  }
+
+  cubic_real_batch<fp_t> cb;
+  cb.solve_r(n,&a[0],&b[0],&c[0],&d[0],&x1[0],&x2[0],&x3[0],&nr[0]);
+
+  fp_t max_err=0;
+  size_t n_wrong=0;
+  for(size_t i=0;i<n;i++) {
+    // Skip the nearly degenerate cases
+    if (nr_exp[i]==3 && (y2[i]-y1[i]<1/((fp_t)20) ||
+                         y3[i]-y2[i]<1/((fp_t)20))) continue;
+    if (nr[i]!=nr_exp[i]) {
+      n_wrong++;
+    } else {
+      fp_t err=fabs(x1[i]-y1[i])+fabs(x2[i]-y2[i])+fabs(x3[i]-y3[i]);
+      if (err>max_err) max_err=err;
+    }
+  }
+  tst.test_gen(n_wrong==0,((string)"cubic batch n_real ")+str);
+  tst.test_abs<fp_t>(max_err,0.0,tol,
+                     ((string)"cubic batch roots ")+str);
+  cout.width(wid);
+  cout << str.c_str() << ": cubic " << max_err << endl;
+
+  // x^3+2x^2+5x, with roots 0 and -1 +/- 2i
+  {
+    fp_t b1=2, c1=5, d1=0;
+    int nr1;
+    cb.solve_monic(1,&b1,&c1,&d1,&x1[0],&x2[0],&x3[0],&nr1);
+    tst.test_gen(nr1==1,((string)"cubic batch d=0 n_real ")+str);
+    tst.test_abs<fp_t>(x1[0],0.0,tol,((string)"cubic batch d=0 x1 ")+str);
+    tst.test_rel<fp_t>(x2[0],-1.0,tol,((string)"cubic batch d=0 x2 ")+str);
+    tst.test_rel<fp_t>(x3[0],2.0,tol,((string)"cubic batch d=0 x3 ")+str);
+  }
+
+  // Quartics formed from two quadratic factors x^2+p x+q, giving
+  // four, two, or zero real roots
+  for(size_t i=0;i<n;i++) {
+    fp_t fi=i;
+    fp_t r[4]={2*sin(fi*1.1+0.3),2*sin(fi*2.3+1.7),
+               2*sin(fi*0.7+2.9),2*sin(fi*1.9+0.1)};
+    // Make every fifth quartic biquadratic
+    if (i%5==0) {
+      r[1]=-r[0];
+      r[3]=-r[2];
+    }
+    fp_t p1, q1, p2, q2;
+    if (i%3==0) {
+      p1=-(r[0]+r[1]);
+      q1=r[0]*r[1];
+      p2=-(r[2]+r[3]);
+      q2=r[2]*r[3];
+      std::sort(r,r+4);
+      nr_exp[i]=4;
+    } else if (i%3==1) {
+      // Include some quartics with e=0, for which one real root
+      // is zero
+      if (i%7==1) r[0]=0;
+      if (r[0]>r[1]) std::swap(r[0],r[1]);
+      r[3]=fabs(r[3])+1/((fp_t)10);
+      p1=-(r[0]+r[1]);
+      q1=r[0]*r[1];
+      p2=-2*r[2];
+      q2=r[2]*r[2]+r[3]*r[3];
+      nr_exp[i]=2;
+    } else {
+      r[1]=fabs(r[1])+1/((fp_t)10);
+      r[3]=fabs(r[3])+1/((fp_t)10);
+      p1=-2*r[0];
+      q1=r[0]*r[0]+r[1]*r[1];
+      p2=-2*r[2];
+      q2=r[2]*r[2]+r[3]*r[3];
+      nr_exp[i]=0;
+    }
+    a[i]=1+sin(fi*0.37)/2;
+    b[i]=a[i]*(p1+p2);
+    c[i]=a[i]*(q1+q2+p1*p2);
+    d[i]=a[i]*(p1*q2+p2*q1);
+    e[i]=a[i]*q1*q2;
+    y1[i]=r[0];
+    y2[i]=r[1];
+    y3[i]=r[2];
+    y4[i]=r[3];
+  }
+
+  quartic_real_batch<fp_t> qb;
+  qb.solve_r(n,&a[0],&b[0],&c[0],&d[0],&e[0],&x1[0],&x2[0],&x3[0],
+             &x4[0],&nr[0]);
+
+  max_err=0;
+  n_wrong=0;
+  for(size_t i=0;i<n;i++) {
+    // Skip the nearly degenerate cases
+    fp_t sep=1;
+    for(int k=0;k<nr_exp[i]-1;k++) {
+      fp_t yk[4]={y1[i],y2[i],y3[i],y4[i]};
+      if (yk[k+1]-yk[k]<sep) sep=yk[k+1]-yk[k];
+    }
+    if (sep<1/((fp_t)20)) continue;
+    if (nr[i]!=nr_exp[i]) {
+      n_wrong++;
+    } else {
+      fp_t err=fabs(x1[i]-y1[i])+fabs(x2[i]-y2[i])+
+        fabs(x3[i]-y3[i])+fabs(x4[i]-y4[i]);
+      // The two complex pairs may appear in either order
+      if (nr[i]==0) {
+        fp_t err2=fabs(x1[i]-y3[i])+fabs(x2[i]-y4[i])+
+          fabs(x3[i]-y1[i])+fabs(x4[i]-y2[i]);
+        if (err2<err) err=err2;
+      }
+      if (err>max_err) max_err=err;
+    }
+  }
+  tst.test_gen(n_wrong==0,((string)"quartic batch n_real ")+str);
+  tst.test_abs<fp_t>(max_err,0.0,tol,
+                     ((string)"quartic batch roots ")+str);
+  cout.width(wid);
+  cout << str.c_str() << ": quartic " << max_err << endl;
+
+  // x (x-5) (x^2+x/5+1), with roots 0, 5, and -1/10 +/- i sqrt(99)/10
+  {
+    fp_t a1=1, b1=-(fp_t)24/5, c1=0, d1=-5, e1=0;
+    int nr1;
+    qb.solve_r(1,&a1,&b1,&c1,&d1,&e1,&x1[0],&x2[0],&x3[0],&x4[0],&nr1);
+    tst.test_gen(nr1==2,((string)"quartic batch e=0 n_real ")+str);
+    tst.test_abs<fp_t>(x1[0],0.0,tol,
+                       ((string)"quartic batch e=0 x1 ")+str);
+    tst.test_rel<fp_t>(x2[0],5.0,tol,
+                       ((string)"quartic batch e=0 x2 ")+str);
+    tst.test_rel<fp_t>(x3[0],-0.1,tol,
+                       ((string)"quartic batch e=0 x3 ")+str);
+    tst.test_rel<fp_t>(x4[0],sqrt((fp_t)99)/10,tol,
+                       ((string)"quartic batch e=0 x4 ")+str);
+  }
+  
+  return;
+}
+
 int main(void) {
   tst.set_output_level(1);
   
@@ -803,6 +980,11 @@ int main(void) {
     (&q5_cdf50,"quartic_c_std_50",
      1.0e-2,1.0e-2,1.0e1,1.0e2);
   cout << endl;
+
+  cout << "Batch cubic and quartic solvers:" << endl;
+  test_batch<double>("batch",1.0e-10);
+  test_batch<long double>("batch_ld",1.0e-13);
+  cout << endl;
   
   tst.report();
 
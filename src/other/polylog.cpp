@@ -30,4 +30,548 @@ using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
 
+namespace {
 
+  /* Coefficients for fermi_dirac_integ_fast. The three rows are
+     the orders -1/2, 1/2, and 3/2. The Chebyshev series are
+     sum_k c[k] T_k(s) (with the full c[0]).
+  */
+  // y<=0, in s=2e^y-1
+  const double fd_cheb_a[3][21]={
+    {5.27482009810703589e-01,-1.52331860603611868e-01,2.30419287918511850e-02,
+     -3.57807622143940362e-03,5.65161961691081050e-04,-9.03439454394181998e-05,
+     1.45711673385660080e-05,-2.36637593857102734e-06,3.86421199608669614e-07,
+     -6.33852232268921842e-08,1.04360958754198143e-08,-1.72369478036410553e-09,
+     2.85468554361756613e-10,-4.73886010076591149e-11,7.88269285916778958e-12,
+     -1.31349262097624473e-12,2.19128884056606129e-13,-3.65325200729313052e-14,
+     6.03584980846419006e-15,-9.51228257860428768e-16,1.18991161015346717e-16},
+    {2.87209487606632952e-01,-5.84579297984878510e-02,6.87390420606688243e-03,
+     -8.75611810976430422e-04,1.17410435875580382e-04,-1.63189027074949988e-05,
+     2.32930154349838409e-06,-3.39373814075140788e-07,5.02611980062246792e-08,
+     -7.54365096925638084e-09,1.14485514214947429e-09,-1.75385627727791466e-10,
+     2.70849449435645331e-11,-4.21197491302151787e-12,6.59000742968523281e-13,
+     -1.03656677203929362e-13,1.63775846067949809e-14,-2.59437326129447794e-15,
+     4.09005129526703280e-16,-6.19939912582307097e-17,7.59565085428075655e-18},
+    {1.52774906752558892e-01,-2.17772780015182549e-02,1.98940252058476055e-03,
+     -2.08094065295702117e-04,2.37240398132362668e-05,-2.87163343210513066e-06,
+     3.63307443429067641e-07,-4.75568379666886442e-08,6.39608826567756144e-09,
+     -8.79433379635999372e-10,1.23157630223968411e-10,-1.75167523530447087e-11,
+     2.52471875736850132e-12,-3.68102165027830532e-13,5.42116190306634231e-14,
+     -8.05482789758836500e-15,1.20599227737416079e-15,-1.81594533444056278e-16,
+     2.73128332517360929e-17,-3.97402033885577968e-18,4.73542383071465355e-19}
+  };
+  // 0<y<=2, in s=y-1
+  const double fd_cheb_b[3][21]={
+    {1.82662683414896132e+00,7.68556135449349753e-01,6.69680867742708606e-03,
+     -7.01854643005821177e-03,4.65904138245029143e-04,8.25909804479337445e-05,
+     -1.51042204691994184e-05,-3.34548232322003208e-07,3.18562861207631827e-07,
+     -1.95429998297947396e-08,-4.72419608032648053e-09,7.83896392537271269e-10,
+     3.06260746151177249e-11,-1.85636516447108792e-11,9.23159373459730447e-13,
+     3.06123953600064934e-13,-4.48815460416507322e-14,-2.60139766106682478e-15,
+     1.15803305982806860e-15,-4.33454363293547788e-17,-2.16296778080860851e-17},
+    {1.49376940153868976e+00,9.11639214905123896e-01,9.69468352349259904e-02,
+     5.19242044931838035e-04,-4.43821088156634070e-04,2.40504179357114277e-05,
+     3.45523036167732258e-06,-5.50813690371680372e-07,-9.84391351538151371e-09,
+     8.98019603577661825e-09,-5.08172405558300566e-10,-1.08064139885035852e-10,
+     1.67179175871253584e-11,5.71209908493618554e-13,-3.36960278542044602e-13,
+     1.61340153303705669e-14,4.82383378795488071e-15,-6.77050633349847359e-16,
+     -3.55150826115920417e-17,1.55809562688731728e-17,-3.75635270155299522e-19},
+    {3.00326289444758254e+00,2.16794397588184040e+00,3.41669989822572018e-01,
+     2.43476640807706590e-02,9.28484300617737391e-05,-6.70914477777467106e-05,
+     3.07515395326038846e-06,3.71257958056361157e-07,-5.24806768506990923e-08,
+     -7.77978425818598459e-10,6.81619513174619473e-10,-3.57879765780889953e-11,
+     -6.78970936211000029e-12,9.83935261506006217e-13,2.97362085179367271e-14,
+     -1.70892055284494204e-14,7.88018679301782146e-16,2.14384024183558580e-16,
+     -2.88567096391510137e-17,-1.37639222231771160e-18,5.98725568290054810e-19}
+  };
+  // 2<y<=10, in s=(y-6)/4
+  const double fd_cheb_c[3][35]={
+    {-8.89043914436753679e-01,-2.81032236567555459e-02,9.78823459059582068e-02,
+     -7.02140184413499735e-02,2.85472331558787665e-02,-6.56603709720152227e-03,
+     -1.23019563885817565e-05,7.77934771229784228e-04,-4.15700367964052641e-04,
+     1.41317738148861332e-04,-3.42016607778859670e-05,4.77301159454768494e-06,
+     5.86989851246434898e-07,-7.13138917803976602e-07,3.09224241756677922e-07,
+     -9.40309206726557081e-08,2.04846175833568829e-08,-2.12501224960788680e-09,
+     -7.12047308326415250e-10,5.38386868870370261e-10,-2.05008206399471403e-10,
+     5.41932547615161465e-11,-8.53195830872311045e-12,-7.45299351876163358e-13,
+     1.21867295095269354e-12,-5.76624248679985694e-13,1.91328056610395502e-13,
+     -4.79150665401423050e-14,7.98269558777641265e-15,-3.88376714392114744e-17,
+     -5.91817379002190843e-16,2.65447074933119967e-16,-6.08211293021362107e-17,
+     1.64042481233023143e-17,1.93363099479676336e-17},
+    {8.55000729019373407e-01,-2.97518470451596725e-02,2.50847310604784867e-03,
+     5.96585207959713162e-03,-5.06396044453471909e-03,2.55070990242719630e-03,
+     -9.62618372985038192e-04,2.90260029145686979e-04,-7.05129829239977199e-05,
+     1.30452544494148747e-05,-1.34512874260018522e-06,-1.96385849118562726e-07,
+     1.49210460883832345e-07,-4.19592533258030804e-08,4.09471615774835725e-09,
+     2.77152189570432922e-09,-2.15923280898904974e-09,1.00018017885575085e-09,
+     -3.75283683376281884e-10,1.24648532553043429e-10,-3.85864123656189838e-11,
+     1.16876136271212257e-11,-3.64989970766611388e-12,1.22410968726551464e-12,
+     -4.43511863221345378e-13,1.68864650511595440e-13,-6.52319846855717239e-14,
+     2.49656831927108724e-14,-9.37305475369228502e-15,3.45111520696476501e-15,
+     -1.25257588340310225e-15,4.49962618384969447e-16,-1.69447034600114514e-16,
+     4.10204573202969710e-17,-4.31642244053150299e-17},
+    {2.41884634726996595e+00,6.17936716691538448e-02,-2.86585899189193312e-02,
+     1.02737933290599995e-02,-2.70257566810508951e-03,3.54521029179106996e-04,
+     1.25774902083958712e-04,-1.26636782780627981e-04,6.71569986341203219e-05,
+     -2.89611687435025824e-05,1.13016090960458383e-05,-4.19568660669445630e-06,
+     1.52602206149861162e-06,-5.53443050452707516e-07,2.01976060442072412e-07,
+     -7.43868634703254555e-08,2.76217356938189566e-08,-1.03145404129402439e-08,
+     3.86325706170551768e-09,-1.44854737873226138e-09,5.43174314124732367e-10,
+     -2.03626514158622755e-10,7.63252187327481635e-11,-2.86132942004594022e-11,
+     1.07315020751653522e-11,-4.02746398861976805e-12,1.51257171059697009e-12,
+     -5.68468425143203624e-13,2.13781955268096140e-13,-8.04396835770668693e-14,
+     3.02825494339318799e-14,-1.13798893396601545e-14,4.42785288018968696e-15,
+     -1.24561014453265051e-15,1.12862646346216517e-15}
+  };
+  // 10<y<=50, in s=(y-30)/20
+  const double fd_cheb_d[3][33]={
+    {-8.33353811871159755e-01,1.51651045339950535e-02,-8.84616691110369155e-03,
+     4.78362365557718182e-03,-2.48424731440253762e-03,1.25542515873158594e-03,
+     -6.18833677288808752e-04,2.96291595882758893e-04,-1.36567564842568181e-04,
+     5.97871831753195258e-05,-2.43614114476117051e-05,8.91962974843361737e-06,
+     -2.70826717185524154e-06,4.97729777410632609e-07,1.29160291264790119e-07,
+     -2.12105933112623223e-07,1.54362759353243407e-07,-8.83215186454549747e-08,
+     4.40189163749705521e-08,-1.98044362313778656e-08,8.16023594964188693e-09,
+     -3.09168270351008949e-09,1.07246631997572562e-09,-3.35369748698963932e-10,
+     9.08467543737775625e-11,-1.88748083135554371e-11,1.25937346005247121e-12,
+     1.52643684500620271e-12,-1.18891547252332528e-12,6.10904989794049622e-13,
+     -2.83037992328160161e-13,7.05919296083193130e-14,-8.26924908575241461e-14},
+    {8.24509236694740744e-01,-2.78726848684468032e-03,1.57612549586674529e-03,
+     -8.20679512162626919e-04,4.09103903847321169e-04,-1.98808875879725110e-04,
+     9.50096394112908397e-05,-4.47955715360084892e-05,2.08259916789369911e-05,
+     -9.51582936386489551e-06,4.25041700331846570e-06,-1.84297250376076928e-06,
+     7.69004716374869279e-07,-3.05333964035736401e-07,1.13500457070496032e-07,
+     -3.84146316948465856e-08,1.11394558667047407e-08,-2.26136738733789267e-09,
+     -1.16751767802977595e-10,4.79929035422671673e-10,-3.60168727313985667e-10,
+     2.03491149049935702e-10,-1.00122991841221939e-10,4.50379733205021982e-11,
+     -1.89455550170316806e-11,7.54816636565990593e-12,-2.87163109972018695e-12,
+     1.04932388782736727e-12,-3.69992514421759079e-13,1.26171012045013086e-13,
+     -4.30234636194987709e-14,1.07883693140571376e-14,-7.75738254167084307e-15},
+    {2.46544241645187823e+00,2.63601626465728451e-03,-1.45796227028545562e-03,
+     7.37546305081490943e-04,-3.54993909140183988e-04,1.65713086105030716e-04,
+     -7.58331461437431750e-05,3.42391846914049330e-05,-1.53109275982184555e-05,
+     6.79397222511582585e-06,-2.99273720840379123e-06,1.30762807841458915e-06,
+     -5.65727606002432171e-07,2.41761048379239843e-07,-1.01765142430704009e-07,
+     4.20677814113528055e-08,-1.70267159002303843e-08,6.72738514272804262e-09,
+     -2.58694391170450534e-09,9.65069545970084540e-10,-3.47968017523774564e-10,
+     1.20677159412510227e-10,-3.99714088065332447e-11,1.24992784714475177e-11,
+     -3.61104818210421384e-12,9.18250455177557822e-13,-1.76828370397685021e-13,
+     4.73440427436460547e-15,2.00140410147216713e-14,-1.47848755743551864e-14,
+     8.90709649116099081e-15,-1.80065137321527589e-15,3.97741446484888429e-15}
+  };
+  // y>50, coefficients of y^(-2k) in the Sommerfeld expansion
+  const double fd_asym[3][11]={
+    {-8.22467033424113092e-01,-3.55137311061467109e+00,-5.82091113297547551e+01,
+     -2.10353041727121126e+03,-1.34477839781717019e+05,-1.34238075320175420e+07,
+     -1.93002262458177519e+09,-3.77819155261384583e+11,-9.66283528112442656e+13,
+     -3.12835186542333800e+16,-1.25055955235533476e+19},
+    {8.22467033424113092e-01,7.10274622122934240e-01,6.46767903663941723e+00,
+     1.61810032097785495e+02,7.91046116363041256e+03,6.39228930096073425e+05,
+     7.72009049832710028e+07,1.30282467331511917e+10,2.92813190337103857e+12,
+     8.45500504168469750e+14,3.05014524964715776e+17},
+    {2.46740110027233950e+00,-7.10274622122934240e-01,-2.77186244427403583e+00,
+     -4.41300087539414960e+01,-1.58209223272608256e+03,-1.00930883699380021e+05,
+     -1.00696832586875223e+07,-1.44758297035013247e+09,-2.83367603552036011e+11,
+     -7.24714717858688281e+13,-2.34626557665166000e+16}
+  };
+  /* Coefficients for bessel_K_exp_integ_fast. The rational
+     function R_n(s) for x>2 is a ratio of two Chebyshev series in
+     s=4/x-1.
+  */
+  // Numerator for K_0
+  const double bk_p0[1][7]={
+    {-1.04536192827345276e-01,-1.26139445141065371e-01,-3.42553948564884025e-02,
+     -4.42971393154471468e-03,-2.54572832154879728e-04,-4.94956510506798197e-06,
+     -7.39614499449312324e-09}
+  };
+  // Denominator for K_0
+  const double bk_q0[1][7]={
+    {1.00000000000000000e+00,1.24891966934950349e+00,3.67468533121910357e-01,
+     5.46769238785231176e-02,4.03397909693163029e-03,1.30758451309130716e-04,
+     1.31365587168929480e-06}
+  };
+  // Numerator for K_1
+  const double bk_p1[1][7]={
+    {3.39390743581158949e-01,4.06806537559517456e-01,1.09513860062968607e-01,
+     1.40975519536586536e-02,8.19514412797641258e-04,1.71378269906799315e-05,
+     5.65677993313741314e-08}
+  };
+  // Denominator for K_1
+  const double bk_q1[1][7]={
+    {1.00000000000000000e+00,1.22325101791127966e+00,3.45153273329288635e-01,
+     4.82533775473790102e-02,3.24962282220975099e-03,9.13496594001702314e-05,
+     7.08392064887746408e-07}
+  };
+
+  /// Block size for the array functions
+  const size_t fast_block=64;
+
+  /** \brief Sum the three Chebyshev series in \c c at the \c m
+      points \c s using Clenshaw's recurrence
+  */
+  template<size_t nc>
+  void cheb3(size_t m, const double *s, const double (&c)[3][nc],
+             double *r0, double *r1, double *r2) {
+    double b1[3][fast_block], b2[3][fast_block];
+    for(size_t j=0;j<m;j++) {
+      b1[0][j]=0.0;
+      b1[1][j]=0.0;
+      b1[2][j]=0.0;
+      b2[0][j]=0.0;
+      b2[1][j]=0.0;
+      b2[2][j]=0.0;
+    }
+    for(size_t k=nc-1;k>=1;k--) {
+      for(size_t o=0;o<3;o++) {
+        double ck=c[o][k];
+        for(size_t j=0;j<m;j++) {
+          double b0=ck+2.0*s[j]*b1[o][j]-b2[o][j];
+          b2[o][j]=b1[o][j];
+          b1[o][j]=b0;
+        }
+      }
+    }
+    for(size_t j=0;j<m;j++) {
+      r0[j]=c[0][0]+s[j]*b1[0][j]-b2[0][j];
+      r1[j]=c[1][0]+s[j]*b1[1][j]-b2[1][j];
+      r2[j]=c[2][0]+s[j]*b1[2][j]-b2[2][j];
+    }
+    return;
+  }
+
+  /** \brief Sum the Chebyshev series in \c c at the \c m points
+      \c s using Clenshaw's recurrence
+  */
+  template<size_t nc>
+  void cheb1(size_t m, const double *s, const double (&c)[1][nc],
+             double *r) {
+    double b1[fast_block], b2[fast_block];
+    for(size_t j=0;j<m;j++) {
+      b1[j]=0.0;
+      b2[j]=0.0;
+    }
+    for(size_t k=nc-1;k>=1;k--) {
+      double ck=c[0][k];
+      for(size_t j=0;j<m;j++) {
+        double b0=ck+2.0*s[j]*b1[j]-b2[j];
+        b2[j]=b1[j];
+        b1[j]=b0;
+      }
+    }
+    for(size_t j=0;j<m;j++) {
+      r[j]=c[0][0]+s[j]*b1[j]-b2[j];
+    }
+    return;
+  }
+
+  /** \brief Sum the Chebyshev series in \c c at the point \c s
+      using Clenshaw's recurrence
+  */
+  template<size_t nc>
+  double cheb_scalar(double s, const double (&c)[nc]) {
+    double b1=0.0, b2=0.0;
+    for(size_t k=nc-1;k>=1;k--) {
+      double b0=c[k]+2.0*s*b1-b2;
+      b2=b1;
+      b1=b0;
+    }
+    return c[0]+s*b1-b2;
+  }
+
+}
+
+double fermi_dirac_integ_fast::calc_order(size_t o, double y) {
+
+  const double rpi=o2scl_const::root_pi;
+  // Gamma(a+1) and 1/(a+1) for the three orders
+  const double gam[3]={rpi,rpi/2.0,rpi*0.75};
+  const double lead[3]={2.0,2.0/3.0,0.4};
+  
+  if (y<=0.0) {
+    double t=exp(y);
+    return gam[o]*t*(1.0-t*cheb_scalar(2.0*t-1.0,fd_cheb_a[o]));
+  } else if (y<=2.0) {
+    return cheb_scalar(y-1.0,fd_cheb_b[o]);
+  }
+
+  double w=1.0/y/y;
+  double r;
+  if (y<=10.0) {
+    r=cheb_scalar((y-6.0)/4.0,fd_cheb_c[o]);
+  } else if (y<=50.0) {
+    r=cheb_scalar((y-30.0)/20.0,fd_cheb_d[o]);
+  } else {
+    const size_t na=11;
+    r=fd_asym[o][na-1];
+    for(size_t k=na-1;k>=1;k--) {
+      r=fd_asym[o][k-1]+w*r;
+    }
+  }
+  double ypow=sqrt(y);
+  for(size_t k=0;k<o;k++) ypow*=y;
+  return ypow*(lead[o]+w*r);
+}
+
+void fermi_dirac_integ_fast::calc_all(size_t n, const double *y,
+                                      double *fm1o2, double *f1o2,
+                                      double *f3o2) {
+
+  const double rpi=o2scl_const::root_pi;
+
+  // Indices of the arguments in each region
+  size_t idx[5][fast_block];
+  // Work space
+  double s[fast_block], u[fast_block];
+  double r0[fast_block], r1[fast_block], r2[fast_block];
+
+  for(size_t i0=0;i0<n;i0+=fast_block) {
+
+    size_t nb=n-i0;
+    if (nb>fast_block) nb=fast_block;
+
+    size_t cnt[5]={0,0,0,0,0};
+    for(size_t j=0;j<nb;j++) {
+      double yy=y[i0+j];
+      size_t r;
+      if (yy<=0.0) r=0;
+      else if (yy<=2.0) r=1;
+      else if (yy<=10.0) r=2;
+      else if (yy<=50.0) r=3;
+      else r=4;
+      idx[r][cnt[r]]=i0+j;
+      cnt[r]++;
+    }
+
+    // y<=0
+    size_t m=cnt[0];
+    if (m>0) {
+      for(size_t j=0;j<m;j++) {
+        u[j]=exp(y[idx[0][j]]);
+        s[j]=2.0*u[j]-1.0;
+      }
+      cheb3(m,s,fd_cheb_a,r0,r1,r2);
+      for(size_t j=0;j<m;j++) {
+        size_t i=idx[0][j];
+        double t=u[j];
+        fm1o2[i]=rpi*t*(1.0-t*r0[j]);
+        f1o2[i]=rpi/2.0*t*(1.0-t*r1[j]);
+        f3o2[i]=rpi*0.75*t*(1.0-t*r2[j]);
+      }
+    }
+
+    // 0<y<=2
+    m=cnt[1];
+    if (m>0) {
+      for(size_t j=0;j<m;j++) {
+        s[j]=y[idx[1][j]]-1.0;
+      }
+      cheb3(m,s,fd_cheb_b,r0,r1,r2);
+      for(size_t j=0;j<m;j++) {
+        size_t i=idx[1][j];
+        fm1o2[i]=r0[j];
+        f1o2[i]=r1[j];
+        f3o2[i]=r2[j];
+      }
+    }
+
+    // 2<y<=50 in two pieces
+    for(size_t r=2;r<4;r++) {
+      m=cnt[r];
+      if (m>0) {
+        for(size_t j=0;j<m;j++) {
+          if (r==2) s[j]=(y[idx[r][j]]-6.0)/4.0;
+          else s[j]=(y[idx[r][j]]-30.0)/20.0;
+        }
+        if (r==2) cheb3(m,s,fd_cheb_c,r0,r1,r2);
+        else cheb3(m,s,fd_cheb_d,r0,r1,r2);
+        for(size_t j=0;j<m;j++) {
+          size_t i=idx[r][j];
+          double yy=y[i];
+          double w=1.0/yy/yy;
+          double sq=sqrt(yy);
+          fm1o2[i]=sq*(2.0+w*r0[j]);
+          f1o2[i]=yy*sq*(2.0/3.0+w*r1[j]);
+          f3o2[i]=yy*yy*sq*(0.4+w*r2[j]);
+        }
+      }
+    }
+
+    // y>50
+    m=cnt[4];
+    if (m>0) {
+      const size_t na=11;
+      for(size_t j=0;j<m;j++) {
+        size_t i=idx[4][j];
+        double yy=y[i];
+        double w=1.0/yy/yy;
+        double sq=sqrt(yy);
+        double a0=fd_asym[0][na-1], a1=fd_asym[1][na-1];
+        double a2=fd_asym[2][na-1];
+        for(size_t k=na-1;k>=1;k--) {
+          a0=fd_asym[0][k-1]+w*a0;
+          a1=fd_asym[1][k-1]+w*a1;
+          a2=fd_asym[2][k-1]+w*a2;
+        }
+        fm1o2[i]=sq*(2.0+w*a0);
+        f1o2[i]=yy*sq*(2.0/3.0+w*a1);
+        f3o2[i]=yy*yy*sq*(0.4+w*a2);
+      }
+    }
+
+  }
+
+  return;
+}
+
+bessel_K_exp_integ_fast::bessel_K_exp_integ_fast() {
+  double fk=1.0, fk1=1.0;
+  double psi1=-boost::math::constants::euler<double>(), psi2;
+  for(size_t k=0;k<n_series;k++) {
+    // fk=k!, fk1=(k+1)!, psi1=psi(k+1), psi2=psi(k+2)
+    fk1=fk*((double)(k+1));
+    psi2=psi1+1.0/((double)(k+1));
+    c_i0[k]=1.0/fk/fk;
+    c_s0[k]=psi1/fk/fk;
+    c_i1[k]=1.0/fk/fk1;
+    c_s1[k]=(psi1+psi2)/fk/fk1;
+    fk=fk1;
+    psi1=psi2;
+  }
+}
+
+double bessel_K_exp_integ_fast::K1exp(double x) {
+
+  if (!(x>0.0)) {
+    O2SCL_ERR2("Argument not positive in ",
+               "bessel_K_exp_integ_fast::K1exp().",exc_edom);
+  }
+
+  if (x<=2.0) {
+    double z=x*x/4.0;
+    double i1s=c_i1[n_series-1], s1s=c_s1[n_series-1];
+    for(size_t k=n_series-1;k>=1;k--) {
+      i1s=c_i1[k-1]+z*i1s;
+      s1s=c_s1[k-1]+z*s1s;
+    }
+    double lx=log(x/2.0);
+    return (1.0/x+lx*x/2.0*i1s-x/4.0*s1s)*exp(x);
+  }
+  
+  double w=1.0/x;
+  double s=4.0*w-1.0;
+  return sqrt(o2scl_const::pi/2.0)*sqrt(w)*
+    (1.0+w*cheb_scalar(s,bk_p1[0])/cheb_scalar(s,bk_q1[0]));
+}
+
+void bessel_K_exp_integ_fast::K01exp(double x, double &K0e,
+                                     double &K1e) {
+
+  if (!(x>0.0)) {
+    O2SCL_ERR2("Argument not positive in ",
+               "bessel_K_exp_integ_fast::K01exp().",exc_edom);
+  }
+
+  if (x<=2.0) {
+    double z=x*x/4.0;
+    double i0s=c_i0[n_series-1], s0s=c_s0[n_series-1];
+    double i1s=c_i1[n_series-1], s1s=c_s1[n_series-1];
+    for(size_t k=n_series-1;k>=1;k--) {
+      i0s=c_i0[k-1]+z*i0s;
+      s0s=c_s0[k-1]+z*s0s;
+      i1s=c_i1[k-1]+z*i1s;
+      s1s=c_s1[k-1]+z*s1s;
+    }
+    double lx=log(x/2.0);
+    double ex=exp(x);
+    K0e=(-lx*i0s+s0s)*ex;
+    K1e=(1.0/x+lx*x/2.0*i1s-x/4.0*s1s)*ex;
+    return;
+  }
+  
+  double w=1.0/x;
+  double s=4.0*w-1.0;
+  double pre=sqrt(o2scl_const::pi/2.0)*sqrt(w);
+  K0e=pre*(1.0+w*cheb_scalar(s,bk_p0[0])/cheb_scalar(s,bk_q0[0]));
+  K1e=pre*(1.0+w*cheb_scalar(s,bk_p1[0])/cheb_scalar(s,bk_q1[0]));
+  return;
+}
+
+void bessel_K_exp_integ_fast::K123exp(size_t n, const double *x,
+                                      double *K1e, double *K2e,
+                                      double *K3e) {
+
+  const double rpio2=sqrt(o2scl_const::pi/2.0);
+
+  size_t idx[2][fast_block];
+  double s[fast_block], p0[fast_block], q0[fast_block];
+  double p1[fast_block], q1[fast_block];
+
+  for(size_t i0=0;i0<n;i0+=fast_block) {
+
+    size_t nb=n-i0;
+    if (nb>fast_block) nb=fast_block;
+
+    size_t cnt[2]={0,0};
+    for(size_t j=0;j<nb;j++) {
+      double xx=x[i0+j];
+      if (!(xx>0.0)) {
+        O2SCL_ERR2("Argument not positive in ",
+                   "bessel_K_exp_integ_fast::K123exp().",exc_edom);
+      }
+      size_t r=(xx<=2.0) ? 0 : 1;
+      idx[r][cnt[r]]=i0+j;
+      cnt[r]++;
+    }
+
+    // Power series for x<=2
+    size_t m=cnt[0];
+    for(size_t j=0;j<m;j++) {
+      size_t i=idx[0][j];
+      double xx=x[i];
+      double z=xx*xx/4.0;
+      double i0s=c_i0[n_series-1], s0s=c_s0[n_series-1];
+      double i1s=c_i1[n_series-1], s1s=c_s1[n_series-1];
+      for(size_t k=n_series-1;k>=1;k--) {
+        i0s=c_i0[k-1]+z*i0s;
+        s0s=c_s0[k-1]+z*s0s;
+        i1s=c_i1[k-1]+z*i1s;
+        s1s=c_s1[k-1]+z*s1s;
+      }
+      double lx=log(xx/2.0);
+      double ex=exp(xx);
+      double K0=-lx*i0s+s0s;
+      double K1=1.0/xx+lx*xx/2.0*i1s-xx/4.0*s1s;
+      double K2=K0+2.0/xx*K1;
+      K1e[i]=K1*ex;
+      K2e[i]=K2*ex;
+      K3e[i]=(K1+4.0/xx*K2)*ex;
+    }
+
+    // Rational approximation for x>2
+    m=cnt[1];
+    if (m>0) {
+      for(size_t j=0;j<m;j++) {
+        s[j]=4.0/x[idx[1][j]]-1.0;
+      }
+      cheb1(m,s,bk_p0,p0);
+      cheb1(m,s,bk_q0,q0);
+      cheb1(m,s,bk_p1,p1);
+      cheb1(m,s,bk_q1,q1);
+      for(size_t j=0;j<m;j++) {
+        size_t i=idx[1][j];
+        double xx=x[i];
+        double w=1.0/xx;
+        double sw=sqrt(w);
+        double K0e=rpio2*sw*(1.0+w*p0[j]/q0[j]);
+        double K1ee=rpio2*sw*(1.0+w*p1[j]/q1[j]);
+        double K2ee=K0e+2.0*w*K1ee;
+        K1e[i]=K1ee;
+        K2e[i]=K2ee;
+        K3e[i]=K1ee+4.0*w*K2ee;
+      }
+    }
+
+  }
+
+  return;
+}
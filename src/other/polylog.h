@@ -25,8 +25,10 @@
     o2scl::fermi_dirac_integ_tl, \ref o2scl::fermi_dirac_integ_gsl,
     \ref o2scl::fermi_dirac_integ_direct, \ref
     o2scl::bose_einstein_integ_tl, \ref o2scl::bessel_K_exp_integ_tl,
-    \ref o2scl::bessel_K_exp_integ_gsl, and \ref
-    o2scl::bessel_K_exp_integ_direct .
+    \ref o2scl::bessel_K_exp_integ_gsl, \ref
+    o2scl::bessel_K_exp_integ_direct, \ref
+    o2scl::fermi_dirac_integ_fast, and \ref
+    o2scl::bessel_K_exp_integ_fast .
 */
 #ifndef O2SCL_POLYLOG_H
 #define O2SCL_POLYLOG_H
@@ -356,6 +358,227 @@ namespace o2scl {
     
   };
   
+  /** \brief Compute the Fermi-Dirac integrals of order \f$ -1/2 \f$,
+      \f$ 1/2 \f$, and \f$ 3/2 \f$ together using piecewise
+      approximations
+
+      This class computes the Fermi-Dirac integrals
+      \f[
+      F_{a}(y) = \int_0^{\infty} \frac{x^a}{1+e^{x-y}} \, .
+      \f]
+      for \f$ a \in [-1/2,1/2,3/2] \f$ with the same normalization
+      as \ref o2scl::fermi_dirac_integ_gsl. The single argument
+      functions evaluate only the requested order, and the function
+      \ref calc_all() computes all three orders together for an
+      entire array of arguments.
+
+      The real line is split into five regions which are shared by
+      all three orders:
+      - \f$ y \leq 0 \f$: \f$ F_a = \Gamma(a+1)\, t\, [1 - t\,
+      h_a(t)] \f$ with \f$ t=e^y \f$ and \f$ h_a \f$ a Chebyshev
+      series of degree 20 in \f$ 2t-1 \f$,
+      - \f$ 0 < y \leq 2 \f$: a Chebyshev series of degree 20
+      in \f$ y-1 \f$,
+      - \f$ 2 < y \leq 10 \f$ and \f$ 10 < y \leq 50 \f$: \f$ F_a
+      = y^{a+1} [1/(a+1) + R_a(y)/y^2] \f$, with \f$ R_a \f$ a
+      Chebyshev series of degree 34 and 32, respectively, and
+      - \f$ y > 50 \f$: the Sommerfeld expansion with 11 terms,
+      which is a polynomial in \f$ 1/y^2 \f$ times \f$ y^{a+1}
+      \f$.
+
+      The coefficients were obtained from Lawson-weighted minimax
+      fits to 50-digit values of the integrals. The maximum
+      relative error of the fits is less than \f$ 3 \times
+      10^{-17} \f$. Compared with a quadruple precision quadrature
+      for \f$ -60 \leq y \leq 1000 \f$, the maximum relative
+      error in double precision is less than \f$ 4 \times
+      10^{-16} \f$.
+
+      For an array of arguments, the arguments are sorted into the
+      five regions in blocks, and the Chebyshev series for all three
+      orders are summed together in loops over the arguments in each
+      region with no branches, so the compiler can vectorize them.
+
+      The functions \ref calc_2() and \ref calc_3() are provided
+      so that this class can be used in place of \ref
+      o2scl::fermi_dirac_integ_gsl, and they call the GSL
+      functions.
+  */
+  class fermi_dirac_integ_fast {
+
+  public:
+
+    /// \name Single argument interface
+    //@{
+    /** \brief Fermi-Dirac integral of order \f$ 1/2 \f$
+     */
+    double calc_1o2(double y) {
+      return calc_order(1,y);
+    }
+
+    /** \brief Fermi-Dirac integral of order \f$ -1/2 \f$
+     */
+    double calc_m1o2(double y) {
+      return calc_order(0,y);
+    }
+
+    /** \brief Fermi-Dirac integral of order \f$ 3/2 \f$
+     */
+    double calc_3o2(double y) {
+      return calc_order(2,y);
+    }
+
+    /** \brief Fermi-Dirac integral of order \f$ 2 \f$ (from GSL)
+     */
+    double calc_2(double y) {
+      return fd_gsl.calc_2(y);
+    }
+
+    /** \brief Fermi-Dirac integral of order \f$ 3 \f$ (from GSL)
+     */
+    double calc_3(double y) {
+      return fd_gsl.calc_3(y);
+    }
+
+    /** \brief Compute the Fermi-Dirac integrals of order \f$ -1/2
+        \f$, \f$ 1/2 \f$, and \f$ 3/2 \f$ at \c y
+    */
+    void calc_all(double y, double &fm1o2, double &f1o2, double &f3o2) {
+      calc_all(1,&y,&fm1o2,&f1o2,&f3o2);
+      return;
+    }
+    //@}
+
+    /** \brief Compute the Fermi-Dirac integrals of order \f$ -1/2
+        \f$, \f$ 1/2 \f$, and \f$ 3/2 \f$ for the \c n arguments
+        in \c y
+
+        The output arrays must have space for \c n elements.
+    */
+    void calc_all(size_t n, const double *y, double *fm1o2,
+                  double *f1o2, double *f3o2);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// For the integer orders
+    fermi_dirac_integ_gsl fd_gsl;
+
+    /** \brief Compute the Fermi-Dirac integral of order \f$ -1/2
+        \f$ (for \c o=0), \f$ 1/2 \f$ (for \c o=1), or \f$ 3/2
+        \f$ (for \c o=2) at a single argument
+    */
+    double calc_order(size_t o, double y);
+
+#endif
+
+  };
+
+  /** \brief Compute exponentially scaled modified Bessel functions
+      of the second kind of order 1, 2, and 3 together using
+      rational approximations
+
+      This class computes \f$ K_n(x) e^x\f$ for \f$ n=1,2,3 \f$
+      and can be used in place of \ref
+      o2scl::bessel_K_exp_integ_gsl. The function \ref K1exp()
+      needs only \f$ K_1 \f$, the functions \ref K2exp() and
+      \ref K3exp() need \f$ K_0 \f$ and \f$ K_1 \f$, and the
+      functions K123exp() compute all three orders together
+      for one argument or for an entire array of arguments.
+
+      The functions \f$ K_0 \f$ and \f$ K_1 \f$ are computed first,
+      and \f$ K_2 \f$ and \f$ K_3 \f$ are obtained from the
+      (stable) upward recurrence \f$ K_{n+1}(x) = K_{n-1}(x) + 2 n
+      K_n(x)/x \f$. For \f$ x \leq 2 \f$, \f$ K_0 \f$ and \f$ K_1
+      \f$ are computed from their power series (A&S 9.6.11) with 15
+      terms. For \f$ x > 2 \f$,
+      \f[
+      K_n(x) e^x \sqrt{x} = \sqrt{\frac{\pi}{2}} \left[
+      1 + \frac{1}{x} R_n\left(\frac{4}{x}-1\right) \right]
+      \f]
+      where \f$ R_n \f$ is a ratio of two Chebyshev series of
+      degree 6 from a Lawson-weighted minimax fit to 50-digit
+      values. The maximum relative error of the fit is less than
+      \f$ 10^{-16} \f$. Compared with a quadruple precision
+      quadrature for \f$ 10^{-3} \leq x \leq 700 \f$, the maximum
+      relative error in double precision is less than \f$ 7 \times
+      10^{-16} \f$.
+
+      Unlike the GSL functions, large arguments present no
+      difficulty.
+  */
+  class bessel_K_exp_integ_fast {
+
+  public:
+
+    bessel_K_exp_integ_fast();
+
+    /// \name Single argument interface
+    //@{
+    /** \brief Compute \f$ K_1(x) e^x \f$
+     */
+    double K1exp(double x);
+
+    /** \brief Compute \f$ K_2(x) e^x \f$
+     */
+    double K2exp(double x) {
+      double K0e, K1e;
+      K01exp(x,K0e,K1e);
+      return K0e+2.0/x*K1e;
+    }
+
+    /** \brief Compute \f$ K_3(x) e^x \f$
+     */
+    double K3exp(double x) {
+      double K0e, K1e;
+      K01exp(x,K0e,K1e);
+      return K1e+4.0/x*(K0e+2.0/x*K1e);
+    }
+
+    /** \brief Compute \f$ K_n(x) e^x \f$ for \f$ n=1,2,3 \f$
+     */
+    void K123exp(double x, double &K1e, double &K2e, double &K3e) {
+      double K0e;
+      K01exp(x,K0e,K1e);
+      K2e=K0e+2.0/x*K1e;
+      K3e=K1e+4.0/x*K2e;
+      return;
+    }
+    //@}
+
+    /** \brief Compute \f$ K_n(x) e^x \f$ for \f$ n=1,2,3 \f$ for
+        the \c n arguments in \c x
+
+        The arguments must be positive. The output arrays must have
+        space for \c n elements.
+    */
+    void K123exp(size_t n, const double *x, double *K1e, double *K2e,
+                 double *K3e);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// Number of terms in the series for small arguments
+    static const size_t n_series=15;
+
+    /// Compute \f$ K_0(x) e^x \f$ and \f$ K_1(x) e^x \f$
+    void K01exp(double x, double &K0e, double &K1e);
+
+    /// \f$ 1/(k!)^2 \f$
+    double c_i0[n_series];
+    /// \f$ \psi(k+1)/(k!)^2 \f$
+    double c_s0[n_series];
+    /// \f$ 1/(k! (k+1)!) \f$
+    double c_i1[n_series];
+    /// \f$ [\psi(k+1)+\psi(k+2)]/(k! (k+1)!) \f$
+    double c_s1[n_series];
+
+#endif
+
+  };
+
   /** \brief Compute exponentially scaled modified bessel function of
       the second kind using Boost
 
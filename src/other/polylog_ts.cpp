@@ -104,6 +104,52 @@ int main(void) {
   t.test_rel(be_gsl.K2exp(2.0),be_d_ld.K2exp(2.0),1.0e-15,"be_d_ld 2");
   t.test_rel(be_gsl.K3exp(2.0),be_d_ld.K3exp(2.0),1.0e-15,"be_d_ld 3");
 
+  // Compare the fused approximations with GSL, and compare the
+  // array and single argument interfaces
+  fermi_dirac_integ_fast fd_fast;
+  bessel_K_exp_integ_fast be_fast;
+  {
+    vector<double> yv, fm(200), f1(200), f3(200);
+    for(size_t i=0;i<200;i++) yv.push_back(-40.0+0.53*i);
+    fd_fast.calc_all(200,&(yv[0]),&(fm[0]),&(f1[0]),&(f3[0]));
+    double max_m=0.0, max_1=0.0, max_3=0.0;
+    // The single argument functions evaluate one order at a time,
+    // so they agree with the array version only up to rounding
+    double max_diff=0.0;
+    for(size_t i=0;i<200;i++) {
+      max_m=std::max(max_m,fabs(fm[i]/fd_gsl.calc_m1o2(yv[i])-1.0));
+      max_1=std::max(max_1,fabs(f1[i]/fd_gsl.calc_1o2(yv[i])-1.0));
+      max_3=std::max(max_3,fabs(f3[i]/fd_gsl.calc_3o2(yv[i])-1.0));
+      max_diff=std::max(max_diff,fabs(fd_fast.calc_m1o2(yv[i])/fm[i]-1.0));
+      max_diff=std::max(max_diff,fabs(fd_fast.calc_1o2(yv[i])/f1[i]-1.0));
+      max_diff=std::max(max_diff,fabs(fd_fast.calc_3o2(yv[i])/f3[i]-1.0));
+    }
+    t.test_abs(max_m,0.0,1.0e-14,"fd_fast -1/2");
+    t.test_abs(max_1,0.0,1.0e-14,"fd_fast 1/2");
+    t.test_abs(max_3,0.0,1.0e-14,"fd_fast 3/2");
+    t.test_abs(max_diff,0.0,1.0e-15,"fd_fast array");
+
+    vector<double> xv, k1(200), k2(200), k3(200);
+    for(size_t i=0;i<200;i++) xv.push_back(1.0e-3*pow(1.06,i));
+    be_fast.K123exp(200,&(xv[0]),&(k1[0]),&(k2[0]),&(k3[0]));
+    max_1=0.0;
+    double max_2=0.0;
+    max_3=0.0;
+    max_diff=0.0;
+    for(size_t i=0;i<200;i++) {
+      max_1=std::max(max_1,fabs(k1[i]/be_gsl.K1exp(xv[i])-1.0));
+      max_2=std::max(max_2,fabs(k2[i]/be_gsl.K2exp(xv[i])-1.0));
+      max_3=std::max(max_3,fabs(k3[i]/be_gsl.K3exp(xv[i])-1.0));
+      max_diff=std::max(max_diff,fabs(be_fast.K1exp(xv[i])/k1[i]-1.0));
+      max_diff=std::max(max_diff,fabs(be_fast.K2exp(xv[i])/k2[i]-1.0));
+      max_diff=std::max(max_diff,fabs(be_fast.K3exp(xv[i])/k3[i]-1.0));
+    }
+    t.test_abs(max_1,0.0,1.0e-14,"be_fast K1");
+    t.test_abs(max_2,0.0,1.0e-14,"be_fast K2");
+    t.test_abs(max_3,0.0,1.0e-14,"be_fast K3");
+    t.test_abs(max_diff,0.0,1.0e-15,"be_fast array");
+  }
+
   // Typically,
   // type              digits10 max_digits10 max          log_prec
   // --------------------------------------------------------------
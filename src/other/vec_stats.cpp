@@ -24,7 +24,10 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <o2scl/vec_stats.h>
+#include <o2scl/constants.h>
 
 using namespace std;
 using namespace o2scl;
@@ -40,3 +43,436 @@ double o2scl::kl_div_gaussian(double mean_prior, double mean_post,
   
   return div;
 }
+
+moments_online::moments_online() {
+  clear();
+}
+
+void moments_online::clear() {
+  n=0;
+  mu=0.0;
+  m2=0.0;
+  m3=0.0;
+  m4=0.0;
+  vmin=0.0;
+  vmax=0.0;
+  return;
+}
+
+void moments_online::add(double x) {
+
+  if (n==0) {
+    vmin=x;
+    vmax=x;
+  } else {
+    if (x<vmin) vmin=x;
+    if (x>vmax) vmax=x;
+  }
+  
+  double n1=((double)n);
+  n++;
+  double dn=((double)n);
+  double delta=x-mu;
+  double delta_n=delta/dn;
+  double delta_n2=delta_n*delta_n;
+  double term1=delta*delta_n*n1;
+  mu+=delta_n;
+  m4+=term1*delta_n2*(dn*dn-3.0*dn+3.0)+6.0*delta_n2*m2-
+    4.0*delta_n*m3;
+  m3+=term1*delta_n*(dn-2.0)-3.0*delta_n*m2;
+  m2+=term1;
+  
+  return;
+}
+
+void moments_online::merge(const moments_online &mo) {
+
+  if (mo.n==0) return;
+  if (n==0) {
+    *this=mo;
+    return;
+  }
+  
+  double na=((double)n);
+  double nb=((double)mo.n);
+  double nt=na+nb;
+  double delta=mo.mu-mu;
+  double delta2=delta*delta;
+  double delta3=delta2*delta;
+  double delta4=delta2*delta2;
+
+  double m4_new=m4+mo.m4+delta4*na*nb*(na*na-na*nb+nb*nb)/nt/nt/nt+
+    6.0*delta2*(na*na*mo.m2+nb*nb*m2)/nt/nt+
+    4.0*delta*(na*mo.m3-nb*m3)/nt;
+  double m3_new=m3+mo.m3+delta3*na*nb*(na-nb)/nt/nt+
+    3.0*delta*(na*mo.m2-nb*m2)/nt;
+  m2+=mo.m2+delta2*na*nb/nt;
+  m3=m3_new;
+  m4=m4_new;
+  mu+=delta*nb/nt;
+  n+=mo.n;
+  if (mo.vmin<vmin) vmin=mo.vmin;
+  if (mo.vmax>vmax) vmax=mo.vmax;
+  
+  return;
+}
+
+double moments_online::variance() const {
+  if (n<2) return 0.0;
+  return m2/((double)(n-1));
+}
+
+double moments_online::stddev() const {
+  return sqrt(variance());
+}
+
+double moments_online::skew() const {
+  if (n<2) return 0.0;
+  double sd=stddev();
+  return m3/((double)n)/sd/sd/sd;
+}
+
+double moments_online::kurtosis() const {
+  if (n<2) return 0.0;
+  double var=variance();
+  return m4/((double)n)/var/var-3.0;
+}
+
+void moments_online::get_data(std::vector<double> &v) const {
+  v.resize(7);
+  v[0]=((double)n);
+  v[1]=mu;
+  v[2]=m2;
+  v[3]=m3;
+  v[4]=m4;
+  v[5]=vmin;
+  v[6]=vmax;
+  return;
+}
+
+void moments_online::set_data(const std::vector<double> &v) {
+  if (v.size()!=7) {
+    O2SCL_ERR("Vector has wrong size in moments_online::set_data().",
+              o2scl::exc_einval);
+  }
+  n=((size_t)(v[0]+0.5));
+  mu=v[1];
+  m2=v[2];
+  m3=v[3];
+  m4=v[4];
+  vmin=v[5];
+  vmax=v[6];
+  return;
+}
+
+wmoments_online::wmoments_online() {
+  clear();
+}
+
+void wmoments_online::clear() {
+  sw=0.0;
+  sw2=0.0;
+  mu=0.0;
+  s=0.0;
+  return;
+}
+
+void wmoments_online::add(double x, double w) {
+  if (w>0.0) {
+    sw+=w;
+    sw2+=w*w;
+    double delta=x-mu;
+    mu+=delta*w/sw;
+    s+=w*delta*(x-mu);
+  }
+  return;
+}
+
+void wmoments_online::merge(const wmoments_online &wmo) {
+
+  if (wmo.sw==0.0) return;
+  if (sw==0.0) {
+    *this=wmo;
+    return;
+  }
+
+  double swt=sw+wmo.sw;
+  double delta=wmo.mu-mu;
+  s+=wmo.s+delta*delta*sw*wmo.sw/swt;
+  mu+=delta*wmo.sw/swt;
+  sw=swt;
+  sw2+=wmo.sw2;
+  
+  return;
+}
+
+double wmoments_online::variance() const {
+  if (sw==0.0 || sw*sw==sw2) return 0.0;
+  return s*sw/(sw*sw-sw2);
+}
+
+double wmoments_online::stddev() const {
+  return sqrt(variance());
+}
+
+void wmoments_online::get_data(std::vector<double> &v) const {
+  v.resize(4);
+  v[0]=sw;
+  v[1]=sw2;
+  v[2]=mu;
+  v[3]=s;
+  return;
+}
+
+void wmoments_online::set_data(const std::vector<double> &v) {
+  if (v.size()!=4) {
+    O2SCL_ERR("Vector has wrong size in wmoments_online::set_data().",
+              o2scl::exc_einval);
+  }
+  sw=v[0];
+  sw2=v[1];
+  mu=v[2];
+  s=v[3];
+  return;
+}
+
+quantile_sketch::quantile_sketch() {
+  compression=100.0;
+  clear();
+}
+
+void quantile_sketch::clear() {
+  c_mean.clear();
+  c_wgt.clear();
+  buf_x.clear();
+  buf_w.clear();
+  wtot=0.0;
+  vmin=0.0;
+  vmax=0.0;
+  unit_wgts=true;
+  return;
+}
+
+double quantile_sketch::scale_k(double q) const {
+  return compression/2.0/o2scl_const::pi*asin(2.0*q-1.0);
+}
+
+double quantile_sketch::scale_k_inv(double k) const {
+  double arg=2.0*o2scl_const::pi*k/compression;
+  if (arg>o2scl_const::pi/2.0) return 1.0;
+  return (sin(arg)+1.0)/2.0;
+}
+
+void quantile_sketch::add(double x, double w) {
+
+  if (w<=0.0) return;
+  
+  if (c_wgt.size()==0 && buf_x.size()==0) {
+    vmin=x;
+    vmax=x;
+  } else {
+    if (x<vmin) vmin=x;
+    if (x>vmax) vmax=x;
+  }
+  if (w!=1.0) unit_wgts=false;
+  
+  buf_x.push_back(x);
+  buf_w.push_back(w);
+  if (buf_x.size()>=((size_t)(5.0*compression))) {
+    compress_buffer();
+  }
+  return;
+}
+
+void quantile_sketch::compress_buffer() {
+
+  if (buf_x.size()==0) return;
+
+  // Combine the centroids and the buffer and sort by the mean
+  size_t nt=c_mean.size()+buf_x.size();
+  std::vector<std::pair<double,double> > all(nt);
+  for(size_t i=0;i<c_mean.size();i++) {
+    all[i].first=c_mean[i];
+    all[i].second=c_wgt[i];
+  }
+  for(size_t i=0;i<buf_x.size();i++) {
+    all[c_mean.size()+i].first=buf_x[i];
+    all[c_mean.size()+i].second=buf_w[i];
+    wtot+=buf_w[i];
+  }
+  buf_x.clear();
+  buf_w.clear();
+  std::sort(all.begin(),all.end());
+
+  c_mean.clear();
+  c_wgt.clear();
+
+  // Merge neighboring points as long as the combined centroid
+  // spans less than one unit of the scale function
+  double cur_mean=all[0].first, cur_wgt=all[0].second;
+  double w_before=0.0;
+  double q_limit=scale_k_inv(scale_k(0.0)+1.0);
+  for(size_t i=1;i<nt;i++) {
+    if ((w_before+cur_wgt+all[i].second)/wtot<=q_limit) {
+      cur_wgt+=all[i].second;
+      cur_mean+=(all[i].first-cur_mean)*all[i].second/cur_wgt;
+    } else {
+      c_mean.push_back(cur_mean);
+      c_wgt.push_back(cur_wgt);
+      w_before+=cur_wgt;
+      q_limit=scale_k_inv(scale_k(w_before/wtot)+1.0);
+      cur_mean=all[i].first;
+      cur_wgt=all[i].second;
+    }
+  }
+  c_mean.push_back(cur_mean);
+  c_wgt.push_back(cur_wgt);
+  
+  return;
+}
+
+void quantile_sketch::merge(const quantile_sketch &qs) {
+
+  if (qs.c_wgt.size()==0 && qs.buf_x.size()==0) return;
+  
+  double min2=qs.vmin, max2=qs.vmax;
+  if (c_wgt.size()>0 || buf_x.size()>0) {
+    if (vmin<min2) min2=vmin;
+    if (vmax>max2) max2=vmax;
+  }
+  if (qs.unit_wgts==false) unit_wgts=false;
+
+  // Add the centroids and buffer from the other sketch to the buffer
+  // and merge everything at once
+  buf_x.insert(buf_x.end(),qs.c_mean.begin(),qs.c_mean.end());
+  buf_w.insert(buf_w.end(),qs.c_wgt.begin(),qs.c_wgt.end());
+  buf_x.insert(buf_x.end(),qs.buf_x.begin(),qs.buf_x.end());
+  buf_w.insert(buf_w.end(),qs.buf_w.begin(),qs.buf_w.end());
+  vmin=min2;
+  vmax=max2;
+  
+  compress_buffer();
+  
+  return;
+}
+
+double quantile_sketch::sum_weights() const {
+  double sum=wtot;
+  for(size_t i=0;i<buf_w.size();i++) sum+=buf_w[i];
+  return sum;
+}
+
+size_t quantile_sketch::n_centroids() {
+  compress_buffer();
+  return c_mean.size();
+}
+
+double quantile_sketch::quantile(double f) {
+
+  if (f<0.0 || f>1.0) {
+    O2SCL_ERR("Invalid fraction in quantile_sketch::quantile().",
+              o2scl::exc_einval);
+  }
+  
+  compress_buffer();
+
+  size_t nc=c_mean.size();
+  if (nc==0) return 0.0;
+  if (nc==1) return c_mean[0];
+
+  // If no centroids have been merged, then use the exact
+  // result for sorted data
+  if (unit_wgts && ((double)nc)==wtot) {
+    return vector_sorted_quantile(nc,c_mean,f);
+  }
+
+  // Otherwise, interpolate linearly between the centroid means,
+  // using the minimum and maximum for the outer half of the first
+  // and last centroids
+  double target=f*wtot;
+  if (target<c_wgt[0]/2.0) {
+    return vmin+(c_mean[0]-vmin)*target/(c_wgt[0]/2.0);
+  }
+  if (target>wtot-c_wgt[nc-1]/2.0) {
+    return vmax-(vmax-c_mean[nc-1])*(wtot-target)/(c_wgt[nc-1]/2.0);
+  }
+  double cum=c_wgt[0]/2.0;
+  for(size_t i=0;i<nc-1;i++) {
+    double dw=(c_wgt[i]+c_wgt[i+1])/2.0;
+    if (target<=cum+dw) {
+      return c_mean[i]+(c_mean[i+1]-c_mean[i])*(target-cum)/dw;
+    }
+    cum+=dw;
+  }
+  
+  return c_mean[nc-1];
+}
+
+double quantile_sketch::cdf(double x) {
+  
+  compress_buffer();
+
+  size_t nc=c_mean.size();
+  if (nc==0) return 0.0;
+  if (x<vmin) return 0.0;
+  if (x>=vmax) return 1.0;
+
+  if (x<c_mean[0]) {
+    return (x-vmin)/(c_mean[0]-vmin)*c_wgt[0]/2.0/wtot;
+  }
+  if (x>=c_mean[nc-1]) {
+    return 1.0-(vmax-x)/(vmax-c_mean[nc-1])*c_wgt[nc-1]/2.0/wtot;
+  }
+  double cum=c_wgt[0]/2.0;
+  for(size_t i=0;i<nc-1;i++) {
+    double dw=(c_wgt[i]+c_wgt[i+1])/2.0;
+    if (x<c_mean[i+1]) {
+      return (cum+dw*(x-c_mean[i])/(c_mean[i+1]-c_mean[i]))/wtot;
+    }
+    cum+=dw;
+  }
+  
+  return 1.0;
+}
+
+void quantile_sketch::get_data(std::vector<double> &v) {
+  compress_buffer();
+  size_t nc=c_mean.size();
+  v.resize(5+2*nc);
+  v[0]=compression;
+  v[1]=vmin;
+  v[2]=vmax;
+  if (unit_wgts) v[3]=1.0;
+  else v[3]=0.0;
+  v[4]=((double)nc);
+  for(size_t i=0;i<nc;i++) {
+    v[5+i]=c_mean[i];
+    v[5+nc+i]=c_wgt[i];
+  }
+  return;
+}
+
+void quantile_sketch::set_data(const std::vector<double> &v) {
+  if (v.size()<5) {
+    O2SCL_ERR("Vector too small in quantile_sketch::set_data().",
+              o2scl::exc_einval);
+  }
+  size_t nc=((size_t)(v[4]+0.5));
+  if (v.size()!=5+2*nc) {
+    O2SCL_ERR("Vector has wrong size in quantile_sketch::set_data().",
+              o2scl::exc_einval);
+  }
+  clear();
+  compression=v[0];
+  vmin=v[1];
+  vmax=v[2];
+  unit_wgts=(v[3]>0.5);
+  c_mean.resize(nc);
+  c_wgt.resize(nc);
+  for(size_t i=0;i<nc;i++) {
+    c_mean[i]=v[5+i];
+    c_wgt[i]=v[5+nc+i];
+    wtot+=c_wgt[i];
+  }
+  return;
+}
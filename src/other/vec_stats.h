@@ -33,6 +33,8 @@
     
     No additional range checking is done on the vectors.
 */
+#include <vector>
+
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 
@@ -1057,7 +1059,7 @@ namespace o2scl {
   */
   template<class vec_t> double vector_bin_size_freedman
     (size_t n, vec_t &v) {
-    vector_sort<vec_t,double>(n,v);
+    vector_sort_radix(n,v);
     double ret=2.0*(vector_sorted_quantile(n,v,0.75)-
 		    vector_sorted_quantile(n,v,0.25))/cbrt(((double)n));
     return ret;
@@ -2464,6 +2466,315 @@ namespace o2scl {
   */
   double kl_div_gaussian(double mean_prior, double mean_post,
                          double covar_prior, double covar_post);
+
+  /** \brief Online mean, variance, skewness, and kurtosis
+
+      This class accumulates the first four central moments of a
+      stream of data one value at a time, so the data need not be
+      stored. The moments are updated using the method in Welford
+      (1962) generalized to higher moments by Terriberry (2007). The
+      results of \ref variance(), \ref stddev(), \ref skew(), and
+      \ref kurtosis() are the same as those from \ref
+      vector_variance(), \ref vector_stddev(), \ref vector_skew(),
+      and \ref vector_kurtosis() up to rounding.
+
+      Two accumulators can be combined with \ref merge() using the
+      pairwise formulas in Chan et al. (1979) and Pebay (2008), so
+      separate objects can be used for each OpenMP thread or each
+      MPI rank and then combined. For MPI, the state can be packed
+      into a vector with \ref get_data() and unpacked with \ref
+      set_data().
+  */
+  class moments_online {
+
+  protected:
+
+    /// The number of values
+    size_t n;
+    
+    /// The mean
+    double mu;
+    
+    /// The sum of the squared deviations from the mean
+    double m2;
+    
+    /// The sum of the cubed deviations from the mean
+    double m3;
+    
+    /// The sum of the fourth power of the deviations from the mean
+    double m4;
+    
+    /// The minimum value
+    double vmin;
+    
+    /// The maximum value
+    double vmax;
+
+  public:
+
+    moments_online();
+
+    /// Remove all data
+    void clear();
+
+    /// Add the value \c x
+    void add(double x);
+
+    /// Add the first \c nv values in the vector \c v
+    template<class vec_t> void add_vector(size_t nv, const vec_t &v) {
+      for(size_t i=0;i<nv;i++) add(v[i]);
+      return;
+    }
+
+    /// Combine the data from \c mo with the current data
+    void merge(const moments_online &mo);
+
+    /// The number of values
+    size_t count() const {
+      return n;
+    }
+
+    /// The minimum value (or zero if there are no values)
+    double min() const {
+      return vmin;
+    }
+
+    /// The maximum value (or zero if there are no values)
+    double max() const {
+      return vmax;
+    }
+
+    /// The mean (or zero if there are no values)
+    double mean() const {
+      return mu;
+    }
+    
+    /** \brief The sample variance (or zero if there are fewer
+	than two values)
+    */
+    double variance() const;
+    
+    /// The sample standard deviation
+    double stddev() const;
+    
+    /// The skewness
+    double skew() const;
+    
+    /// The kurtosis
+    double kurtosis() const;
+
+    /// Copy the state to a vector of 7 numbers
+    void get_data(std::vector<double> &v) const;
+
+    /// Set the state from a vector created by \ref get_data()
+    void set_data(const std::vector<double> &v);
+    
+  };
+
+  /** \brief Online weighted mean and variance
+
+      This class accumulates the weighted mean and variance of a
+      stream of data, using the weighted generalization of Welford's
+      method from West (1979). Values with non-positive weights are
+      ignored, as in \ref wvector_mean() and \ref wvector_variance().
+      The results of \ref variance() and \ref stddev() are the same
+      as those from \ref wvector_variance() and \ref wvector_stddev()
+      up to rounding.
+
+      Two accumulators can be combined with \ref merge(), and
+      the state can be packed into a vector with \ref get_data() 
+      for communication between MPI ranks.
+  */
+  class wmoments_online {
+
+  protected:
+
+    /// The sum of the weights
+    double sw;
+    
+    /// The sum of the squared weights
+    double sw2;
+    
+    /// The weighted mean
+    double mu;
+    
+    /// The weighted sum of the squared deviations from the mean
+    double s;
+
+  public:
+
+    wmoments_online();
+
+    /// Remove all data
+    void clear();
+
+    /// Add the value \c x with weight \c w
+    void add(double x, double w);
+
+    /** \brief Add the first \c nv values in the vector \c v
+	with the weights in \c w
+    */
+    template<class vec_t, class vec2_t>
+    void add_vector(size_t nv, const vec_t &v, const vec2_t &w) {
+      for(size_t i=0;i<nv;i++) add(v[i],w[i]);
+      return;
+    }
+
+    /// Combine the data from \c wmo with the current data
+    void merge(const wmoments_online &wmo);
+
+    /// The sum of the weights
+    double sum_weights() const {
+      return sw;
+    }
+
+    /// The weighted mean (or zero if there are no values)
+    double mean() const {
+      return mu;
+    }
+    
+    /// The weighted variance
+    double variance() const;
+    
+    /// The weighted standard deviation
+    double stddev() const;
+    
+    /// Copy the state to a vector of 4 numbers
+    void get_data(std::vector<double> &v) const;
+
+    /// Set the state from a vector created by \ref get_data()
+    void set_data(const std::vector<double> &v);
+    
+  };
+
+  /** \brief A mergeable sketch for approximate quantiles
+
+      This class implements the merging version of the t-digest
+      from Dunning and Ertl (2019). Values are added to a buffer, and
+      when the buffer is full, the buffer and the current list of
+      centroids are sorted and merged into a new list of centroids,
+      using the \f$ k_1 \f$ scale function so that centroids near the
+      tails contain fewer points. The memory required is of order \ref
+      compression, independent of the number of values, and
+      quantiles near 0 and 1 are more accurate than those near the
+      median.
+
+      If fewer than about \ref compression/3 values with unit weight
+      have been added, no centroids are merged and \ref quantile()
+      gives the same result as \ref vector_sorted_quantile() applied
+      to the sorted data. Otherwise, the quantile is obtained by
+      linear interpolation between centroids. The error in the
+      cumulative fraction for a quantile \f$ q \f$ is typically
+      smaller than \f$ \pi \sqrt{q(1-q)}/\delta \f$, where \f$
+      \delta \f$ is the value of \ref compression.
+
+      Two sketches can be combined with \ref merge(), which allows
+      separate sketches for each OpenMP thread or each MPI rank. The
+      state can be packed into a vector with \ref get_data() 
+      and unpacked with \ref set_data().
+  */
+  class quantile_sketch {
+
+  protected:
+
+    /// The centroid means
+    std::vector<double> c_mean;
+
+    /// The centroid weights
+    std::vector<double> c_wgt;
+
+    /// The values not yet merged into centroids
+    std::vector<double> buf_x;
+
+    /// The weights of the values not yet merged into centroids
+    std::vector<double> buf_w;
+
+    /// The total weight in \ref c_wgt
+    double wtot;
+
+    /// The minimum value
+    double vmin;
+
+    /// The maximum value
+    double vmax;
+
+    /// True if all of the weights are unity
+    bool unit_wgts;
+
+    /// The \f$ k_1 \f$ scale function
+    double scale_k(double q) const;
+
+    /// The inverse of the \f$ k_1 \f$ scale function
+    double scale_k_inv(double k) const;
+
+    /** \brief Merge the buffer into the centroids
+     */
+    void compress_buffer();
+    
+  public:
+
+    quantile_sketch();
+
+    /** \brief The compression parameter (default 100)
+
+	Larger values give more accurate quantiles at the cost of
+	more memory. This should not be changed after data has been
+	added.
+    */
+    double compression;
+
+    /// Remove all data
+    void clear();
+
+    /// Add the value \c x with weight \c w
+    void add(double x, double w=1.0);
+
+    /// Add the first \c nv values in the vector \c v
+    template<class vec_t> void add_vector(size_t nv, const vec_t &v) {
+      for(size_t i=0;i<nv;i++) add(v[i]);
+      return;
+    }
+
+    /// Combine the data from \c qs with the current data
+    void merge(const quantile_sketch &qs);
+
+    /// The total weight
+    double sum_weights() const;
+
+    /// The minimum value (or zero if there are no values)
+    double min() const {
+      return vmin;
+    }
+
+    /// The maximum value (or zero if there are no values)
+    double max() const {
+      return vmax;
+    }
+
+    /** \brief Obtain the quantile for the fraction \c f
+
+	If <tt>f</tt> is less than 0 or greater than 1, the error
+	handler is called. If no data has been added, this function
+	returns zero without calling the error handler.
+    */
+    double quantile(double f);
+
+    /** \brief Obtain the fraction of the total weight which
+	is less than or equal to \c x
+    */
+    double cdf(double x);
+
+    /// Obtain the number of centroids after merging the buffer
+    size_t n_centroids();
+
+    /// Copy the state to a vector
+    void get_data(std::vector<double> &v);
+
+    /// Set the state from a vector created by \ref get_data()
+    void set_data(const std::vector<double> &v);
+    
+  };
+  
   
 }
 
@@ -25,11 +25,15 @@
 #include <fftw3.h>
 #endif
 
+#include <algorithm>
+
 #include <gsl/gsl_statistics.h>
 #include <o2scl/test_mgr.h>
 #include <o2scl/vec_stats.h>
 #include <o2scl/prob_dens_func.h>
 #include <o2scl/invert.h>
+#include <o2scl/rng.h>
+#include <o2scl/constants.h>
 
 using namespace std;
 using namespace o2scl;
@@ -253,6 +257,82 @@ int main(void) {
                              covar_prior(0,0),covar_post(0,0));
   t.test_rel(kl1,kl2,1.0e-12,"KL div");
   
+  // Online moments, with data split into two accumulators and merged
+  {
+    rng<> r;
+    r.set_seed(10);
+    size_t nd=1000;
+    std::vector<double> dat(nd), wgt(nd);
+    for(size_t i=0;i<nd;i++) {
+      dat[i]=r.random()*r.random()*5.0+1.0;
+      wgt[i]=r.random();
+    }
+    moments_online mo1, mo2;
+    mo1.add_vector(300,dat);
+    for(size_t i=300;i<nd;i++) mo2.add(dat[i]);
+    mo1.merge(mo2);
+    t.test_gen(mo1.count()==nd,"online count");
+    t.test_rel(mo1.mean(),vector_mean(dat),1.0e-12,"online mean");
+    t.test_rel(mo1.variance(),vector_variance(dat),1.0e-12,
+               "online variance");
+    t.test_rel(mo1.skew(),vector_skew(dat),1.0e-10,"online skew");
+    t.test_rel(mo1.kurtosis(),vector_kurtosis(dat),1.0e-10,
+               "online kurtosis");
+    t.test_rel(mo1.max(),vector_max_value<std::vector<double>,double>(dat),
+               1.0e-15,"online max");
+    std::vector<double> mv;
+    mo1.get_data(mv);
+    moments_online mo3;
+    mo3.set_data(mv);
+    t.test_rel(mo3.stddev(),vector_stddev(dat),1.0e-12,"online data");
+    
+    wmoments_online wmo1, wmo2;
+    wmo1.add_vector(500,dat,wgt);
+    for(size_t i=500;i<nd;i++) wmo2.add(dat[i],wgt[i]);
+    wmo1.merge(wmo2);
+    t.test_rel(wmo1.mean(),wvector_mean(dat,wgt),1.0e-12,"online wmean");
+    t.test_rel(wmo1.variance(),wvector_variance(nd,dat,wgt),1.0e-12,
+               "online wvariance");
+
+    // With only a few values, the quantile is exact
+    quantile_sketch qs;
+    qs.add_vector(N,x2);
+    std::vector<double> x2s(x2,x2+N);
+    vector_sort<std::vector<double>,double>(N,x2s);
+    t.test_rel(qs.quantile(0.3),vector_sorted_quantile(N,x2s,0.3),
+               1.0e-14,"sketch exact");
+    t.test_rel(qs.quantile(1.0),9.0,1.0e-14,"sketch max");
+    
+    // Larger data set split over four sketches
+    size_t nq=100000;
+    std::vector<double> dq(nq);
+    quantile_sketch qs4[4];
+    for(size_t i=0;i<nq;i++) {
+      dq[i]=r.random()*r.random();
+      qs4[i%4].add(dq[i]);
+    }
+    std::vector<double> qv;
+    qs4[1].get_data(qv);
+    qs.set_data(qv);
+    qs.merge(qs4[0]);
+    qs.merge(qs4[2]);
+    qs.merge(qs4[3]);
+    cout << "Centroids: " << qs.n_centroids() << endl;
+    t.test_rel(qs.sum_weights(),((double)nq),1.0e-14,"sketch weights");
+    vector_sort<std::vector<double>,double>(nq,dq);
+    double fv[5]={0.001,0.1,0.5,0.9,0.999};
+    for(size_t k=0;k<5;k++) {
+      // Compare in terms of the cumulative fraction
+      double qk=qs.quantile(fv[k]);
+      double fk=((double)(std::lower_bound(dq.begin(),dq.end(),qk)-
+                               dq.begin()))/((double)nq);
+      double tol=o2scl_const::pi*sqrt(fv[k]*(1.0-fv[k]))/qs.compression;
+      t.test_abs(fk,fv[k],tol,"sketch quantile");
+      t.test_abs(qs.cdf(vector_sorted_quantile(nq,dq,fv[k])),fv[k],
+                 tol,"sketch cdf");
+    }
+  }
+  
   t.report();
   
   return 0;
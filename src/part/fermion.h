@@ -945,9 +945,11 @@ namespace o2scl {
       fp_t dj=((fp_t)j);
       fp_t jot=dj/tt;
 
-      double K2j=be_integ.K2exp(jot);
+      // K1j is used only without antiparticles and K3j only with
+      // antiparticles
+      fp_t K1j, K2j, K3j;
+      ndeg_bessel(be_integ,jot,inc_antip,K1j,K2j,K3j);
       if (inc_antip==false) {
-        double K1j=be_integ.K1exp(jot);
         pterm=exp(jot*xx)/jot/jot*K2j;
         if (j%2==0) pterm=-pterm;
         nterm=pterm*jot/m;
@@ -963,7 +965,6 @@ namespace o2scl {
         edterm=(K1j*dj+3.0*K2j*tt)/jot/dj*exp(xx*jot);
         if (j%2==0) edterm=-edterm;
       } else {
-        double K3j=be_integ.K3exp(jot);
         // AWS 9/27/20: should this be cosh(jot*(xx+1.0))??
         pterm=exp(-jot)*2.0*cosh(jot*(xx+1.0)/tt)/jot/jot*K2j;
         if (j%2==0) pterm*=-1.0;
@@ -987,6 +988,32 @@ namespace o2scl {
     
   protected:
     
+    /** \brief Compute the Bessel functions for \ref ndeg_terms(),
+        \f$ K_2(x) e^x \f$ and either \f$ K_1(x) e^x \f$ or, if
+        \c inc_antip is true, \f$ K_3(x) e^x \f$
+    */
+    template<class be_t>
+    void ndeg_bessel(be_t &be, fp_t x, bool inc_antip, fp_t &K1e,
+                     fp_t &K2e, fp_t &K3e) {
+      K2e=be.K2exp(x);
+      if (inc_antip) K3e=be.K3exp(x);
+      else K1e=be.K1exp(x);
+      return;
+    }
+    
+    /** \brief Compute the Bessel functions for \ref ndeg_terms()
+        with a single call to \ref bessel_K_exp_integ_fast::K123exp()
+    */
+    void ndeg_bessel(bessel_K_exp_integ_fast &be, fp_t x, bool inc_antip,
+                     fp_t &K1e, fp_t &K2e, fp_t &K3e) {
+      double K1d, K2d, K3d;
+      be.K123exp(static_cast<double>(x),K1d,K2d,K3d);
+      K1e=K1d;
+      K2e=K2d;
+      K3e=K3d;
+      return;
+    }
+    
     /// A pointer to the solver for massless fermions
     root<func_t,func_t,fp_t> *massless_root;
     
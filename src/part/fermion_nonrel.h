@@ -28,6 +28,7 @@
 */
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <fstream>
 #include <cmath>
@@ -471,6 +472,167 @@ namespace o2scl {
 
   typedef fermion_nonrel_tl<> fermion_nonrel;
 
+  /** \brief Nonrelativistic fermions for arrays of densities,
+      effective masses, and temperatures
+
+      This class computes the same quantities as \ref
+      fermion_nonrel_tl::calc_density() for an entire array of
+      points at once, given in structure-of-arrays form, without
+      using \ref fermion objects. It is intended for batch
+      evaluation of equations of state on large grids, e.g. \ref
+      eos_had_skyrme::calc_temp_e_batch().
+
+      At finite temperature, the degeneracy parameter \f$ \eta =
+      \nu/T \f$ is obtained from Newton's method applied to \f$
+      \log F_{1/2}(\eta) \f$, which is concave so the iteration
+      converges from any starting point. The Fermi-Dirac integrals
+      for all points are evaluated together in each iteration
+      using \ref fermi_dirac_integ_fast::calc_all(), so no root
+      solver object is used and the loops can be vectorized.
+
+      At zero density and finite temperature, the chemical
+      potential is set to the mass (or zero if \c inc_rest_mass is
+      false) and the energy density, pressure, and entropy are set
+      to zero, as in \ref eos_had_skyrme::calc_temp_e() . At zero
+      temperature, the results are the same as \ref
+      fermion_nonrel_tl::calc_density_zerot().
+
+      This class holds no state other than its parameters, so one
+      object may be used by several threads at once.
+  */
+  class fermion_nonrel_batch {
+
+  public:
+
+    fermion_nonrel_batch() {
+      tol=1.0e-14;
+      max_iter=40;
+    }
+
+    /// Relative tolerance for \f$ \eta \f$ (default \f$ 10^{-14} \f$)
+    double tol;
+
+    /// Maximum number of Newton iterations (default 40)
+    size_t max_iter;
+
+    /** \brief Compute the thermodynamics of the \c n_pts points
+        with densities \c n, effective masses \c ms and
+        temperatures \c T
+
+        The mass \c m, the degeneracy \c g, and \c inc_rest_mass
+        are the same for all points. If \c T is zero, then all of
+        the points are computed at zero temperature. The output
+        arrays \c nu, \c ed, \c pr, and \c en must have space for
+        \c n_pts elements. The densities must be non-negative and
+        the effective masses positive. If the Newton iteration does
+        not converge, the value \ref o2scl::exc_emaxiter is returned
+        and the results for all points are still stored.
+    */
+    int calc_density(size_t n_pts, const double *n, const double *ms,
+                     const double *T, double m, double g,
+                     bool inc_rest_mass, double *nu, double *ed,
+                     double *pr, double *en) {
+
+      const double pi2=o2scl_const::pi2;
+      const double gam32=o2scl_const::root_pi/2.0;
+
+      // Indices of the points which need the finite temperature
+      // integrals
+      std::vector<size_t> ix;
+      ix.reserve(n_pts);
+
+      for(size_t i=0;i<n_pts;i++) {
+        if (T==0 || T[i]<=0.0) {
+          // Zero temperature
+          double kf=cbrt(6.0*pi2*n[i]/g);
+          nu[i]=kf*kf/2.0/ms[i];
+          ed[i]=g*pow(kf,5.0)/20.0/pi2/ms[i];
+          pr[i]=2.0*ed[i]/3.0;
+          en[i]=0.0;
+        } else if (n[i]==0.0) {
+          nu[i]=0.0;
+          ed[i]=0.0;
+          pr[i]=0.0;
+          en[i]=0.0;
+        } else {
+          ix.push_back(i);
+        }
+      }
+      
+      size_t nf=ix.size();
+      int ret=0;
+      
+      if (nf>0) {
+        
+        std::vector<double> eta(nf), lu(nf), fm(nf), f1(nf), f3(nf);
+        
+        // Initial guesses from the nondegenerate and degenerate limits
+        for(size_t j=0;j<nf;j++) {
+          size_t i=ix[j];
+          double msT2=2.0*ms[i]*T[i];
+          double u=n[i]/(g*msT2*sqrt(msT2)/4.0/pi2);
+          lu[j]=log(u);
+          double z=u/gam32;
+          if (z<2.0) {
+            eta[j]=log(z)+z/2.0/sqrt(2.0);
+          } else {
+            eta[j]=pow(1.5*u,2.0/3.0);
+          }
+        }
+        
+        // Newton iterations for all points together
+        bool done=false;
+        for(size_t it=0;it<max_iter && done==false;it++) {
+          fd.calc_all(nf,&(eta[0]),&(fm[0]),&(f1[0]),&(f3[0]));
+          done=true;
+          for(size_t j=0;j<nf;j++) {
+            // Below about -708, F_{1/2} underflows, but the
+            // nondegenerate initial guess is exact
+            if (f1[j]>0.0) {
+              double step=(log(f1[j])-lu[j])*2.0*f1[j]/fm[j];
+              eta[j]-=step;
+              if (fabs(step)>tol*(1.0+fabs(eta[j]))) done=false;
+            }
+          }
+        }
+        if (done==false) ret=exc_emaxiter;
+        
+        fd.calc_all(nf,&(eta[0]),&(fm[0]),&(f1[0]),&(f3[0]));
+        for(size_t j=0;j<nf;j++) {
+          size_t i=ix[j];
+          nu[i]=eta[j]*T[i];
+          if (f1[j]>0.0) {
+            ed[i]=n[i]*T[i]*f3[j]/f1[j];
+          } else {
+            ed[i]=1.5*n[i]*T[i];
+          }
+          pr[i]=2.0*ed[i]/3.0;
+          en[i]=(5.0*ed[i]/3.0-nu[i]*n[i])/T[i];
+        }
+        
+      }
+
+      if (inc_rest_mass) {
+        for(size_t i=0;i<n_pts;i++) {
+          nu[i]+=m;
+          ed[i]+=n[i]*m;
+        }
+      }
+
+      return ret;
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The Fermi-Dirac integrals
+    fermi_dirac_integ_fast fd;
+
+#endif
+
+  };
+
 }
 
 #endif
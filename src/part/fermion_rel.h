@@ -276,7 +276,13 @@ namespace o2scl {
     
   };
   
-  /** \brief Default integrator for \ref o2scl::fermion_rel_tl
+  /** \brief Multiprecision integrator for \ref o2scl::fermion_rel_tl
+
+      Each integral is first attempted with the double-double type
+      \ref o2scl::dd_real, which is much faster than the decimal
+      types, and then with 25, 35, and 50 digit decimal types
+      until the tolerance is achieved. The double-double tier
+      can be disabled by setting \ref use_dd to false.
    */
   template<class fp_t> class fermion_rel_integ_multip :
     public fermion_rel_integ_base {
@@ -290,21 +296,34 @@ namespace o2scl {
     typedef boost::multiprecision::number<
       boost::multiprecision::cpp_dec_float<50> > cpp_dec_float_50;
     
+    typedef dd_real fp0_t;
     typedef cpp_dec_float_25 fp1_t;
     typedef cpp_dec_float_35 fp2_t;
     typedef cpp_dec_float_50 fp3_t;
   
+    /** \brief If true, try the double-double integrators before
+        the decimal floating point integrators (default true)
+    */
+    bool use_dd;
+    
     // The non-degenerate integrators
+    inte_tanh_sinh_boost<funct_dd,30,dd_real> nitdd;
     inte_tanh_sinh_boost<funct_cdf25,30,cpp_dec_float_25> nit25;
     inte_tanh_sinh_boost<funct_cdf35,30,cpp_dec_float_35> nit35;
     inte_tanh_sinh_boost<funct_cdf50,30,cpp_dec_float_50> nit50;
     
     // The degenerate integrators
+    inte_tanh_sinh_boost<funct_dd,30,dd_real> ditdd;
     inte_tanh_sinh_boost<funct_cdf25,30,cpp_dec_float_25> dit25;
     inte_tanh_sinh_boost<funct_cdf35,30,cpp_dec_float_35> dit35;
     inte_tanh_sinh_boost<funct_cdf50,30,cpp_dec_float_50> dit50;
       
     fermion_rel_integ_multip() {
+      use_dd=true;
+      nitdd.tol_rel=1.0e-15;
+      ditdd.tol_rel=1.0e-15;
+      nitdd.err_nonconv=false;
+      ditdd.err_nonconv=false;
       nit25.tol_rel=1.0e-15;
       nit35.tol_rel=1.0e-15;
       nit50.tol_rel=1.0e-15;
@@ -323,6 +342,11 @@ namespace o2scl {
      */
     int eval_density(fp_t y, fp_t eta, fp_t &res, fp_t &err) {
       
+      funct_dd mfddd=std::bind(std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t)>
+                               (&fermion_rel_integ_base::density_fun<fp0_t>),
+                               this,std::placeholders::_1,
+                               static_cast<fp0_t>(y),
+                               static_cast<fp0_t>(eta));
       funct_cdf25 mfd25=std::bind(std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t)>
                                   (&fermion_rel_integ_base::density_fun<fp1_t>),
                                   this,std::placeholders::_1,
@@ -338,10 +362,20 @@ namespace o2scl {
                                   this,std::placeholders::_1,
                                   static_cast<fp3_t>(y),
                                   static_cast<fp3_t>(eta));
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
-      int iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=nitdd.integ_iu_err(mfddd,0.0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -370,6 +404,14 @@ namespace o2scl {
     int eval_deg_density(fp_t T, fp_t y, fp_t eta, fp_t mot,
                          fp_t ul, fp_t &res, fp_t &err) {
       
+      funct_dd mfddd=std::bind
+        (std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t,fp0_t,fp0_t)>
+         (&fermion_rel_integ_base::deg_density_fun<fp0_t>),
+         this,std::placeholders::_1,
+         static_cast<fp0_t>(T),
+         static_cast<fp0_t>(y),
+         static_cast<fp0_t>(eta),
+         static_cast<fp0_t>(mot));
       funct_cdf25 mfd25=std::bind
         (std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t,fp1_t,fp1_t)>
          (&fermion_rel_integ_base::deg_density_fun<fp1_t>),
@@ -395,14 +437,25 @@ namespace o2scl {
          static_cast<fp3_t>(eta),
          static_cast<fp3_t>(mot));
       
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
+      fp0_t ul0=static_cast<fp0_t>(ul);
       fp1_t ul1=static_cast<fp1_t>(ul);
       fp2_t ul2=static_cast<fp2_t>(ul);
       fp3_t ul3=static_cast<fp3_t>(ul);
       
-      int iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=ditdd.integ_err(mfddd,0.0,ul0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -430,6 +483,11 @@ namespace o2scl {
      */
     int eval_energy(fp_t y, fp_t eta, fp_t &res, fp_t &err) {
       
+      funct_dd mfddd=std::bind(std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t)>
+                               (&fermion_rel_integ_base::energy_fun<fp0_t>),
+                               this,std::placeholders::_1,
+                               static_cast<fp0_t>(y),
+                               static_cast<fp0_t>(eta));
       funct_cdf25 mfd25=std::bind(std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t)>
                                   (&fermion_rel_integ_base::energy_fun<fp1_t>),
                                   this,std::placeholders::_1,
@@ -445,10 +503,20 @@ namespace o2scl {
                                   this,std::placeholders::_1,
                                   static_cast<fp3_t>(y),
                                   static_cast<fp3_t>(eta));
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
-      int iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=nitdd.integ_iu_err(mfddd,0.0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -478,6 +546,14 @@ namespace o2scl {
     int eval_deg_energy(fp_t T, fp_t y, fp_t eta, fp_t mot,
                         fp_t ul, fp_t &res, fp_t &err) {
 
+      funct_dd mfddd=std::bind
+        (std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t,fp0_t,fp0_t)>
+         (&fermion_rel_integ_base::deg_energy_fun<fp0_t>),
+         this,std::placeholders::_1,
+         static_cast<fp0_t>(T),
+         static_cast<fp0_t>(y),
+         static_cast<fp0_t>(eta),
+         static_cast<fp0_t>(mot));
       funct_cdf25 mfd25=std::bind
         (std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t,fp1_t,fp1_t)>
          (&fermion_rel_integ_base::deg_energy_fun<fp1_t>),
@@ -503,14 +579,25 @@ namespace o2scl {
          static_cast<fp3_t>(eta),
          static_cast<fp3_t>(mot));
       
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
+      fp0_t ul0=static_cast<fp0_t>(ul);
       fp1_t ul1=static_cast<fp1_t>(ul);
       fp2_t ul2=static_cast<fp2_t>(ul);
       fp3_t ul3=static_cast<fp3_t>(ul);
       
-      int iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=ditdd.integ_err(mfddd,0.0,ul0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -539,6 +626,11 @@ namespace o2scl {
      */
     int eval_entropy(fp_t y, fp_t eta, fp_t &res, fp_t &err) {
       
+      funct_dd mfddd=std::bind(std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t)>
+                               (&fermion_rel_integ_base::entropy_fun<fp0_t>),
+                               this,std::placeholders::_1,
+                               static_cast<fp0_t>(y),
+                               static_cast<fp0_t>(eta));
       funct_cdf25 mfd25=std::bind(std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t)>
                                   (&fermion_rel_integ_base::entropy_fun<fp1_t>),
                                   this,std::placeholders::_1,
@@ -554,10 +646,20 @@ namespace o2scl {
                                   this,std::placeholders::_1,
                                   static_cast<fp3_t>(y),
                                   static_cast<fp3_t>(eta));
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
-      int iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=nitdd.integ_iu_err(mfddd,0.0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -587,6 +689,14 @@ namespace o2scl {
     int eval_deg_entropy(fp_t T, fp_t y, fp_t eta, fp_t mot,
                          fp_t ll, fp_t ul, fp_t &res, fp_t &err) {
 
+      funct_dd mfddd=std::bind
+        (std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t,fp0_t,fp0_t)>
+         (&fermion_rel_integ_base::deg_entropy_fun<fp0_t>),
+         this,std::placeholders::_1,
+         static_cast<fp0_t>(T),
+         static_cast<fp0_t>(y),
+         static_cast<fp0_t>(eta),
+         static_cast<fp0_t>(mot));
       funct_cdf25 mfd25=std::bind
         (std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t,fp1_t,fp1_t)>
          (&fermion_rel_integ_base::deg_entropy_fun<fp1_t>),
@@ -612,14 +722,25 @@ namespace o2scl {
          static_cast<fp3_t>(eta),
          static_cast<fp3_t>(mot));
       
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
+      fp0_t ul0=static_cast<fp0_t>(ul);
       fp1_t ul1=static_cast<fp1_t>(ul);
       fp2_t ul2=static_cast<fp2_t>(ul);
       fp3_t ul3=static_cast<fp3_t>(ul);
       
-      int iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=ditdd.integ_err(mfddd,0.0,ul0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -648,6 +769,11 @@ namespace o2scl {
      */
     int eval_pressure(fp_t y, fp_t eta, fp_t &res, fp_t &err) {
       
+      funct_dd mfddd=std::bind(std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t)>
+                               (&fermion_rel_integ_base::pressure_fun<fp0_t>),
+                               this,std::placeholders::_1,
+                               static_cast<fp0_t>(y),
+                               static_cast<fp0_t>(eta));
       funct_cdf25 mfd25=std::bind
         (std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t)>
          (&fermion_rel_integ_base::pressure_fun<fp1_t>),
@@ -664,10 +790,20 @@ namespace o2scl {
          this,std::placeholders::_1,
          static_cast<fp3_t>(y),static_cast<fp3_t>(eta));
          
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
-      int iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=nitdd.integ_iu_err(mfddd,0.0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=nit25.integ_iu_err(mfd25,0.0,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -697,6 +833,14 @@ namespace o2scl {
     int eval_deg_pressure(fp_t T, fp_t y, fp_t eta, fp_t mot,
                           fp_t ul, fp_t &res, fp_t &err) {
 
+      funct_dd mfddd=std::bind
+        (std::mem_fn<fp0_t(fp0_t,fp0_t,fp0_t,fp0_t,fp0_t)>
+         (&fermion_rel_integ_base::deg_pressure_fun<fp0_t>),
+         this,std::placeholders::_1,
+         static_cast<fp0_t>(T),
+         static_cast<fp0_t>(y),
+         static_cast<fp0_t>(eta),
+         static_cast<fp0_t>(mot));
       funct_cdf25 mfd25=std::bind
         (std::mem_fn<fp1_t(fp1_t,fp1_t,fp1_t,fp1_t,fp1_t)>
          (&fermion_rel_integ_base::deg_pressure_fun<fp1_t>),
@@ -722,14 +866,25 @@ namespace o2scl {
          static_cast<fp3_t>(eta),
          static_cast<fp3_t>(mot));
       
+      fp0_t res0, err0;
       fp1_t res1, err1;
       fp2_t res2, err2;
       fp3_t res3, err3;
+      fp0_t ul0=static_cast<fp0_t>(ul);
       fp1_t ul1=static_cast<fp1_t>(ul);
       fp2_t ul2=static_cast<fp2_t>(ul);
       fp3_t ul3=static_cast<fp3_t>(ul);
 
-      int iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
+      int iret;
+      if (use_dd) {
+        iret=ditdd.integ_err(mfddd,0.0,ul0,res0,err0);
+        if (iret==0) {
+          res=static_cast<fp_t>(res0);
+          err=static_cast<fp_t>(err0);
+          return iret;
+        }
+      }
+      iret=dit25.integ_err(mfd25,0.0,ul1,res1,err1);
       if (iret==0) {
         res=static_cast<fp_t>(res1);
         err=static_cast<fp_t>(err1);
@@ -2058,8 +2213,80 @@ namespace o2scl {
     }
     //@}
 
+    /** \name Reentrant versions
+
+        These functions do not modify this object, so several
+        threads may call them simultaneously on the same object as
+        long as each thread provides its own workspace \c ws. The
+        workspace is another object of the same type which holds the
+        integrators, solvers, and other scratch space. Before each
+        call, the numerical parameters of this object (\ref
+        err_nonconv, \ref min_psi, \ref deg_limit, \ref exp_limit,
+        \ref upper_limit_fac, \ref deg_entropy_fac, \ref verbose,
+        \ref use_expansions, \ref tol_expan, \ref verify_ti, and
+        the tolerances of \ref density_root) are copied into the
+        workspace. The uncertainties and the method used are stored
+        in <tt>ws.unc</tt> and <tt>ws.last_method</tt>. Integrator
+        tolerances in \ref fri are not copied, and must be set in
+        the workspace if the defaults are not used.
+    */
+    //@{
+    /** \brief Calculate properties as function of chemical potential
+        using workspace \c ws
+    */
+    int calc_mu(fermion_t &f, fp_t temper, fermion_rel_tl &ws) const {
+      copy_params(ws);
+      return ws.calc_mu(f,temper);
+    }
+
+    /** \brief Calculate properties as function of density
+        using workspace \c ws
+    */
+    int calc_density(fermion_t &f, fp_t temper, fermion_rel_tl &ws) const {
+      copy_params(ws);
+      return ws.calc_density(f,temper);
+    }
+
+    /** \brief Calculate properties with antiparticles as function of
+	chemical potential using workspace \c ws
+    */
+    void pair_mu(fermion_t &f, fp_t temper, fermion_rel_tl &ws) const {
+      copy_params(ws);
+      ws.pair_mu(f,temper);
+      return;
+    }
+
+    /** \brief Calculate properties with antiparticles as function of
+	density using workspace \c ws
+    */
+    int pair_density(fermion_t &f, fp_t temper, fermion_rel_tl &ws) const {
+      copy_params(ws);
+      return ws.pair_density(f,temper);
+    }
+    //@}
+
 #ifndef DOXYGEN_INTERNAL
 
+    /** \brief Copy the numerical parameters of this object into the
+        workspace \c ws
+    */
+    void copy_params(fermion_rel_tl &ws) const {
+      ws.err_nonconv=err_nonconv;
+      ws.min_psi=min_psi;
+      ws.deg_limit=deg_limit;
+      ws.exp_limit=exp_limit;
+      ws.upper_limit_fac=upper_limit_fac;
+      ws.deg_entropy_fac=deg_entropy_fac;
+      ws.verbose=verbose;
+      ws.use_expansions=use_expansions;
+      ws.tol_expan=tol_expan;
+      ws.verify_ti=verify_ti;
+      ws.def_density_root.tol_rel=density_root->tol_rel;
+      ws.def_density_root.tol_abs=density_root->tol_abs;
+      ws.density_root=&ws.def_density_root;
+      return;
+    }
+
     /// Solve for the chemical potential given the density
     fp_t solve_fun(fp_t x, fermion_t &f, fp_t T) {
 
@@ -2559,6 +2786,8 @@ namespace o2scl {
       this->def_massless_root.tol_abs=1.0e-18;
 
       // Integrator tolerances
+      fri.nitdd.tol_rel=1.0e-16;
+      fri.ditdd.tol_rel=1.0e-16;
       fri.nit25.tol_rel=1.0e-16;
       fri.nit35.tol_rel=1.0e-16;
       fri.nit50.tol_rel=1.0e-16;
@@ -28,6 +28,10 @@
 
 #include <boost/multiprecision/cpp_dec_float.hpp>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -149,6 +153,105 @@ int main(void) {
     f2.m=1.0;
   }
   
+  cout << "----------------------------------------------------" << endl;
+  cout << "Test reentrant functions." << endl;
+  cout << "----------------------------------------------------" << endl;
+  cout << endl;
+
+  if (true) {
+
+    // Compare results from a const object with workspaces to those
+    // from the object itself, over a range of degeneracies which
+    // uses each of the methods in calc_mu()
+    
+    const fermion_rel &frc=fr;
+    fermion_rel ws1, ws2;
+    double mu_arr[4]={0.5,1.1,1.5,5.0}, temper=0.1;
+    for(size_t i=0;i<4;i++) {
+      fermion f3(1.0,2.0), f4(1.0,2.0);
+      f.mu=mu_arr[i];
+      fr.calc_mu(f,temper);
+      f3.mu=mu_arr[i];
+      frc.calc_mu(f3,temper,ws1);
+      t.test_rel(f3.n,f.n,1.0e-14,"reentrant calc_mu n");
+      t.test_rel(f3.ed,f.ed,1.0e-14,"reentrant calc_mu ed");
+      t.test_gen(ws1.last_method==fr.last_method,"reentrant last_method");
+      f4.n=f.n;
+      f4.mu=f.mu*1.01;
+      frc.calc_density(f4,temper,ws2);
+      t.test_rel(f4.mu,f.mu,1.0e-5,"reentrant calc_density mu");
+      f.mu=mu_arr[i];
+      fr.pair_mu(f,temper);
+      f3.mu=mu_arr[i];
+      frc.pair_mu(f3,temper,ws1);
+      t.test_rel(f3.n,f.n,1.0e-14,"reentrant pair_mu n");
+    }
+
+#ifdef O2SCL_OPENMP
+    
+    // Several threads share the const object, each with its own
+    // workspace
+    double n_ser[4], pn_ser[4], n_par[16], pn_par[16];
+    for(size_t i=0;i<4;i++) {
+      f.mu=mu_arr[i];
+      fr.calc_mu(f,temper);
+      n_ser[i]=f.n;
+      f.mu=mu_arr[i];
+      fr.pair_mu(f,temper);
+      pn_ser[i]=f.n;
+    }
+    fermion_rel ws_arr[4];
+#pragma omp parallel for num_threads(4) schedule(static,1)
+    for(int k=0;k<16;k++) {
+      int it=omp_get_thread_num();
+      fermion fk(1.0,2.0);
+      fk.mu=mu_arr[k%4];
+      frc.calc_mu(fk,temper,ws_arr[it]);
+      n_par[k]=fk.n;
+      fk.mu=mu_arr[k%4];
+      frc.pair_mu(fk,temper,ws_arr[it]);
+      pn_par[k]=fk.n;
+    }
+    for(size_t k=0;k<16;k++) {
+      t.test_rel(n_par[k],n_ser[k%4],1.0e-14,"parallel calc_mu n");
+      t.test_rel(pn_par[k],pn_ser[k%4],1.0e-14,"parallel pair_mu n");
+    }
+    
+#endif
+    
+  }
+  
+  cout << "----------------------------------------------------" << endl;
+  cout << "Test fast Fermi-Dirac and Bessel integrators." << endl;
+  cout << "----------------------------------------------------" << endl;
+  cout << endl;
+
+  if (true) {
+
+    // Compare with the GSL integrators in the nondegenerate
+    // regime, where the Bessel functions are used in the
+    // nondegenerate expansion
+    fermion_rel fr_gsl;
+    fermion_rel_tl<fermion,fermi_dirac_integ_fast,
+                   bessel_K_exp_integ_fast> fr_fast;
+    double mu_arr[3]={0.5,0.7,-0.5}, temper=0.1;
+    for(size_t i=0;i<3;i++) {
+      fermion f3(1.0,2.0), f4(1.0,2.0);
+      f3.mu=mu_arr[i];
+      f4.mu=mu_arr[i];
+      fr_gsl.calc_mu(f3,temper);
+      fr_fast.calc_mu(f4,temper);
+      t.test_rel(f4.n,f3.n,1.0e-12,"fast calc_mu n");
+      t.test_rel(f4.en,f3.en,1.0e-12,"fast calc_mu en");
+      f3.mu=mu_arr[i];
+      f4.mu=mu_arr[i];
+      fr_gsl.pair_mu(f3,temper);
+      fr_fast.pair_mu(f4,temper);
+      t.test_rel(f4.n,f3.n,1.0e-12,"fast pair_mu n");
+      t.test_rel(f4.en,f3.en,1.0e-12,"fast pair_mu en");
+    }
+  }
+  
   cout << "----------------------------------------------------" << endl;
   cout << "Function calibrate()." << endl;
   cout << "----------------------------------------------------" << endl;
@@ -214,6 +317,7 @@ int main(void) {
   fld.mu=30;
   fld.mu/=2;
   std::cout << "Here4." << endl;
+  frld3.fri.ditdd.verbose=1;
   frld3.fri.dit25.verbose=1;
   frld3.fri.dit35.verbose=1;
   frld3.fri.dit50.verbose=1;
@@ -223,6 +327,21 @@ int main(void) {
   cout << dtos(fld.pr,0) << " " << dtos(fld.en,0) << endl;
   cout << dtos(-fld.ed+fld.n*fld.mu+Tld*fld.en,0) << endl;
   cout << endl;
+
+  // Compare with the results using only the decimal floating point
+  // types in the integrators
+  fermion_ld fld2;
+  fermion_rel_ld3 frld3b;
+  frld3b.fri.use_dd=false;
+  fld2.m=fld.m;
+  fld2.g=fld.g;
+  fld2.mu=fld.mu;
+  frld3b.calc_mu(fld2,Tld);
+  t.test_rel<long double>(fld.n,fld2.n,1.0e-14,"dd vs. cdf n");
+  t.test_rel<long double>(fld.ed,fld2.ed,1.0e-14,"dd vs. cdf ed");
+  t.test_rel<long double>(fld.pr,fld2.pr,1.0e-14,"dd vs. cdf pr");
+  t.test_rel<long double>(fld.en,fld2.en,1.0e-14,"dd vs. cdf en");
+  cout << endl;
   
   // AWS, 11/1/21: taking the multiprecision types out while I
   // develop new fermion integrators.
@@ -24,6 +24,7 @@
 #include <o2scl/fermion.h>
 #include <o2scl/fermion_eff.h>
 #include <o2scl/fermion_rel.h>
+#include <o2scl/dual.h>
 
 using namespace std;
 using namespace o2scl;
@@ -214,6 +215,22 @@ int main(void) {
 
   }
 
+  // Zero temperature fermions with dual numbers: the derivative of
+  // the energy density with respect to the density is the chemical
+  // potential and the derivative of the pressure with respect to
+  // the chemical potential is the density
+  {
+    fermion_zerot_tl<dual> fzd;
+    fermion_tl<dual> fd(1.1,2.0);
+    fd.n=dual(0.3,1.0);
+    fzd.calc_density_zerot(fd);
+    t.test_rel(fd.ed.der,fd.nu.val,1.0e-14,"dual zerot dedn");
+    double n0=fd.n.val;
+    fd.mu=dual(fd.mu.val,1.0);
+    fzd.calc_mu_zerot(fd);
+    t.test_rel(fd.pr.der,n0,1.0e-14,"dual zerot dPdmu");
+  }
+
   t.report();
 
   return 0;
@@ -0,0 +1,345 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/hrg.h>
+
+#include <gsl/gsl_sf_bessel.h>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace o2scl;
+
+hrg_calc::hrg_calc() {
+  n_terms=20;
+  tol_series=1.0e-14;
+  err_nonconv=true;
+  n_threads=1;
+}
+
+void hrg_calc::clear() {
+  id.clear();
+  mass.clear();
+  g.clear();
+  eta.clear();
+  B.clear();
+  Q.clear();
+  S.clear();
+  tab.T=0.0;
+  return;
+}
+
+void hrg_calc::add_species(int pdg_id, double m, double dof, double stat,
+                           double b, double q, double s) {
+  if (m<=0.0) {
+    O2SCL_ERR("Mass must be positive in hrg_calc::add_species().",
+              exc_einval);
+  }
+  if (stat!=1.0 && stat!=-1.0) {
+    O2SCL_ERR("Statistics must be +1 or -1 in hrg_calc::add_species().",
+              exc_einval);
+  }
+  id.push_back(pdg_id);
+  mass.push_back(m);
+  g.push_back(dof);
+  eta.push_back(stat);
+  B.push_back(b);
+  Q.push_back(q);
+  S.push_back(s);
+  tab.T=0.0;
+  return;
+}
+
+bool hrg_calc::pdg_quantum_numbers(int pdg_id, int &b, int &s,
+                                   int &dof, bool &self_conj,
+                                   bool &heavy) {
+
+  int n=abs(pdg_id);
+  int nJ=n%10;
+  int nq3=(n/10)%10;
+  int nq2=(n/100)%10;
+  int nq1=(n/1000)%10;
+
+  // Quarks, leptons, gauge bosons, diquarks, and the K0S and K0L
+  if (nJ==0 || nq3==0 || nq2==0) return false;
+
+  dof=nJ;
+  heavy=(nq1>=4 || nq2>=4 || nq3>=4);
+
+  if (nq1==0) {
+
+    // Mesons. The heavier quark, nq2, is a quark if it is up-type
+    // and an antiquark if it is down-type.
+    b=0;
+    s=0;
+    if (nq2==nq3) {
+      self_conj=true;
+      return true;
+    }
+    self_conj=false;
+    int sign2=(nq2%2==0) ? 1 : -1;
+    if (nq2==3) s-=sign2;
+    if (nq3==3) s+=sign2;
+
+  } else {
+
+    // Baryons
+    b=1;
+    s=0;
+    if (nq1==3) s--;
+    if (nq2==3) s--;
+    if (nq3==3) s--;
+    self_conj=false;
+
+  }
+
+  if (pdg_id<0) {
+    b=-b;
+    s=-s;
+  }
+
+  return true;
+}
+
+void hrg_calc::load_pdg(const part_pdg_db &pdb, double mass_max,
+                        bool heavy) {
+
+  const std::vector<part_pdg_db::pdg_entry> &list=pdb.get_list();
+
+  for(size_t i=0;i<list.size();i++) {
+
+    const part_pdg_db::pdg_entry &e=list[i];
+    if (e.mass<=0.0 || e.mass>mass_max) continue;
+    if (e.charge%3!=0) continue;
+
+    int b, s, dof;
+    bool self_conj, hv;
+    if (!pdg_quantum_numbers(e.id,b,s,dof,self_conj,hv)) continue;
+    if (hv && !heavy) continue;
+
+    int q=e.charge/3;
+    double stat=(b==0) ? 1.0 : -1.0;
+    add_species(e.id,e.mass,dof,stat,b,q,s);
+    if (!self_conj) {
+      add_species(-e.id,e.mass,dof,stat,-b,-q,-s);
+    }
+  }
+
+  return;
+}
+
+void hrg_calc::fill_table(table_t &t, double T) {
+
+  size_t N=mass.size();
+  t.nk=n_terms;
+  if (t.nk==0) t.nk=1;
+  t.K1e.resize(t.nk*N);
+  t.K2e.resize(t.nk*N);
+  t.w.resize(N);
+  t.wk.resize(N);
+  t.sp.resize(N);
+  t.sn.resize(N);
+  t.se.resize(N);
+  t.sx.resize(N);
+
+  for(size_t k=1;k<=t.nk;k++) {
+    size_t off=(k-1)*N;
+    for(size_t i=0;i<N;i++) {
+      double x=((double)k)*mass[i]/T;
+      t.K1e[off+i]=gsl_sf_bessel_K1_scaled(x);
+      t.K2e[off+i]=gsl_sf_bessel_Kn_scaled(2,x);
+    }
+  }
+  t.T=T;
+
+  return;
+}
+
+int hrg_calc::calc_table(table_t &t, double T, double muB, double muQ,
+                         double muS, hrg_thermo &th) {
+
+  if (T<=0.0) return exc_einval;
+
+  size_t N=mass.size();
+  if (t.T!=T || t.nk==0 || t.K2e.size()!=t.nk*N) {
+    fill_table(t,T);
+  }
+
+  // Per-species fugacity factors. The term k in the series is
+  // proportional to eta_i^(k+1) exp(k (mu_i-m_i)/T), which is
+  // computed as eta_i times the k-th power of w_i.
+  double amax=-std::numeric_limits<double>::infinity();
+  for(size_t i=0;i<N;i++) {
+    double a=(B[i]*muB+Q[i]*muQ+S[i]*muS-mass[i])/T;
+    if (a>amax) amax=a;
+    t.w[i]=eta[i]*exp(a);
+    t.wk[i]=1.0;
+    t.sp[i]=0.0;
+    t.sn[i]=0.0;
+    t.se[i]=0.0;
+    t.sx[i]=0.0;
+  }
+  if (N>0 && amax>=0.0) return exc_einval;
+
+  double lntol=log(tol_series);
+  for(size_t k=1;k<=t.nk;k++) {
+    size_t off=(k-1)*N;
+    double rk=1.0/((double)k);
+    double rk2=rk*rk;
+    const double *K1e=&(t.K1e[off]);
+    const double *K2e=&(t.K2e[off]);
+    for(size_t i=0;i<N;i++) {
+      double wk=t.wk[i]*t.w[i];
+      double c=K2e[i]*wk;
+      t.wk[i]=wk;
+      t.sp[i]+=c*rk2;
+      t.sn[i]+=c*rk;
+      t.sx[i]+=c;
+      t.se[i]+=3.0*T*c*rk2+mass[i]*K1e[i]*wk*rk;
+    }
+    // Stop when the largest fugacity factor for the next term
+    // is negligible
+    if (((double)(k+1))*amax<lntol) break;
+  }
+
+  double pr=0.0, ed=0.0, nB=0.0, nQ=0.0, nS=0.0;
+  double xBB=0.0, xQQ=0.0, xSS=0.0, xBQ=0.0, xBS=0.0, xQS=0.0;
+  for(size_t i=0;i<N;i++) {
+    double pre=eta[i]*g[i]*mass[i]*mass[i];
+    pr+=pre*t.sp[i];
+    ed+=pre*t.se[i];
+    double dn=pre*t.sn[i];
+    nB+=B[i]*dn;
+    nQ+=Q[i]*dn;
+    nS+=S[i]*dn;
+    double dx=pre*t.sx[i];
+    xBB+=B[i]*B[i]*dx;
+    xQQ+=Q[i]*Q[i]*dx;
+    xSS+=S[i]*S[i]*dx;
+    xBQ+=B[i]*Q[i]*dx;
+    xBS+=B[i]*S[i]*dx;
+    xQS+=Q[i]*S[i]*dx;
+  }
+
+  double fact=1.0/2.0/o2scl_const::pi2;
+  th.pr=fact*T*T*pr;
+  th.ed=fact*T*ed;
+  th.nB=fact*T*nB;
+  th.nQ=fact*T*nQ;
+  th.nS=fact*T*nS;
+  double T2=T*T;
+  th.chi_BB=fact*xBB/T2;
+  th.chi_QQ=fact*xQQ/T2;
+  th.chi_SS=fact*xSS/T2;
+  th.chi_BQ=fact*xBQ/T2;
+  th.chi_BS=fact*xBS/T2;
+  th.chi_QS=fact*xQS/T2;
+  th.en=(th.ed+th.pr-muB*th.nB-muQ*th.nQ-muS*th.nS)/T;
+
+  return 0;
+}
+
+int hrg_calc::calc(double T, double muB, double muQ, double muS,
+                   hrg_thermo &th) {
+  int ret=calc_table(tab,T,muB,muQ,muS,th);
+  if (ret!=0 && err_nonconv) {
+    O2SCL_ERR2("Temperature not positive or series diverges ",
+               "in hrg_calc::calc().",ret);
+  }
+  return ret;
+}
+
+int hrg_calc::calc_batch(size_t n, const double *T, const double *muB,
+                         const double *muQ, const double *muS,
+                         hrg_thermo *th) {
+
+  std::vector<int> rets(n,0);
+
+#ifdef O2SCL_OPENMP
+  size_t nthr=n_threads;
+  if (nthr<1) nthr=1;
+  if (nthr>n) nthr=n;
+  if (nthr>1) {
+    
+    // Exceptions cannot leave the parallel region, so the first
+    // error is stored here and the error handler is called after
+    // the loop
+    int err_ret=0;
+    size_t err_point=0;
+    std::string err_reason;
+    
+    // One table for each thread, and a static schedule so that
+    // each thread gets a contiguous block of points
+    std::vector<table_t> tabs(nthr);
+#pragma omp parallel for default(shared) schedule(static) num_threads(nthr)
+    for(size_t j=0;j<n;j++) {
+      size_t it=omp_get_thread_num();
+      try {
+        rets[j]=calc_table(tabs[it],T[j],muB[j],muQ[j],muS[j],th[j]);
+      } catch (const std::exception &e) {
+        rets[j]=err_hnd->get_errno();
+        if (rets[j]==0) rets[j]=exc_efailed;
+        // The table may be only partially filled
+        tabs[it].nk=0;
+#pragma omp critical (o2scl_hrg_calc_err)
+        {
+          if (err_ret==0) {
+            err_ret=rets[j];
+            err_point=j;
+            err_reason=e.what();
+          }
+        }
+      }
+    }
+    
+    if (err_ret!=0) {
+      std::string str="Point "+o2scl::szttos(err_point)+
+        " failed in hrg_calc::calc_batch(): "+err_reason;
+      O2SCL_ERR(str.c_str(),err_ret);
+      return err_ret;
+    }
+    
+  } else {
+    for(size_t j=0;j<n;j++) {
+      rets[j]=calc_table(tab,T[j],muB[j],muQ[j],muS[j],th[j]);
+    }
+  }
+#else
+  for(size_t j=0;j<n;j++) {
+    rets[j]=calc_table(tab,T[j],muB[j],muQ[j],muS[j],th[j]);
+  }
+#endif
+
+  for(size_t j=0;j<n;j++) {
+    if (rets[j]!=0) {
+      if (err_nonconv) {
+        O2SCL_ERR2("Temperature not positive or series diverges ",
+                   "in hrg_calc::calc_batch().",rets[j]);
+      }
+      return rets[j];
+    }
+  }
+
+  return 0;
+}
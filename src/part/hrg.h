@@ -0,0 +1,295 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_HRG_H
+#define O2SCL_HRG_H
+
+/** \file hrg.h
+    \brief File defining \ref o2scl::hrg_calc and \ref o2scl::hrg_thermo
+*/
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <limits>
+
+#include <o2scl/err_hnd.h>
+#include <o2scl/part_pdg.h>
+
+namespace o2scl {
+
+  /** \brief Thermodynamic quantities of a hadron resonance gas
+
+      The pressure and energy density are in units of \f$
+      \mathrm{GeV}^4 \f$, the entropy and the conserved charge
+      densities are in units of \f$ \mathrm{GeV}^3 \f$, and the
+      susceptibilities are the dimensionless derivatives
+      \f[
+      \chi_{ab} = \frac{\partial^2 (P/T^4)}
+      {\partial (\mu_a/T) \partial (\mu_b/T)}
+      \f]
+      for \f$ a,b \in \{B,Q,S\} \f$.
+  */
+  class hrg_thermo {
+
+  public:
+
+    /// Pressure
+    double pr;
+    /// Energy density
+    double ed;
+    /// Entropy density
+    double en;
+    /// Baryon number density
+    double nB;
+    /// Electric charge density
+    double nQ;
+    /// Strangeness density
+    double nS;
+    /// Baryon number susceptibility
+    double chi_BB;
+    /// Electric charge susceptibility
+    double chi_QQ;
+    /// Strangeness susceptibility
+    double chi_SS;
+    /// Baryon-electric charge correlator
+    double chi_BQ;
+    /// Baryon-strangeness correlator
+    double chi_BS;
+    /// Electric charge-strangeness correlator
+    double chi_QS;
+
+  };
+
+  /** \brief Ideal hadron resonance gas over a list of species
+
+      This class computes the thermodynamics of a non-interacting
+      gas of hadrons, each with mass \f$ m_i \f$, degeneracy \f$ g_i
+      \f$ and conserved charges \f$ (B_i,Q_i,S_i) \f$, at temperature
+      \f$ T \f$ and chemical potentials \f$ (\mu_B,\mu_Q,\mu_S) \f$.
+      Each species has chemical potential \f$ \mu_i = B_i \mu_B + Q_i
+      \mu_Q + S_i \mu_S \f$ and contributes
+      \f[
+      P_i = \frac{g_i m_i^2 T^2}{2 \pi^2} \sum_{k=1}^{\infty}
+      \frac{\eta_i^{k+1}}{k^2} K_2\left(\frac{k m_i}{T}\right)
+      e^{k \mu_i/T}
+      \f]
+      to the pressure, where \f$ \eta_i = 1 \f$ for bosons and \f$
+      \eta_i = -1 \f$ for fermions. All masses, temperatures and
+      chemical potentials are in GeV, as in \ref o2scl::part_pdg_db.
+
+      The species are stored as a structure of arrays. The
+      exponentially scaled Bessel functions \f$ K_1(k m_i/T) e^{k
+      m_i/T} \f$ and \f$ K_2(k m_i/T) e^{k m_i/T} \f$ depend only on
+      the temperature, so they are tabulated for all species and all
+      terms in the series whenever the temperature changes. After
+      that, a point at new chemical potentials requires one
+      exponential per species, and the series is summed with
+      branch-free loops over contiguous arrays. Points which share
+      a temperature, as in a table which is ordered by temperature,
+      therefore cost very little beyond the first.
+
+      The series is truncated after \ref n_terms terms or when
+      the largest remaining fugacity factor falls below \ref
+      tol_series. The series diverges when \f$ \mu_i \geq m_i \f$
+      for any species, in which case \ref calc() returns \ref
+      exc_einval (or calls the error handler if \ref err_nonconv
+      is true).
+
+      The function \ref calc_batch() computes a list of points,
+      split over \ref n_threads OpenMP threads if OpenMP support
+      is enabled. Each thread holds its own Bessel function table,
+      and consecutive points are given to the same thread so that
+      points with the same temperature reuse the table.
+
+      \note The quantum numbers of the species read from \ref
+      o2scl::part_pdg_db by \ref load_pdg() are obtained from the
+      Monte Carlo particle numbering scheme: the spin degeneracy is
+      the last digit of the ID, and the baryon number and
+      strangeness follow from the quark content. Widths are
+      ignored.
+  */
+  class hrg_calc {
+
+  public:
+
+    hrg_calc();
+
+    /// \name Species data (structure of arrays)
+    //@{
+    /// PDG Monte Carlo ID (negative for antiparticles)
+    std::vector<int> id;
+    /// Mass (in GeV)
+    std::vector<double> mass;
+    /// Degeneracy
+    std::vector<double> g;
+    /// Statistics, \f$ +1 \f$ for bosons and \f$ -1 \f$ for fermions
+    std::vector<double> eta;
+    /// Baryon number
+    std::vector<double> B;
+    /// Electric charge
+    std::vector<double> Q;
+    /// Strangeness
+    std::vector<double> S;
+    //@}
+
+    /// \name Settings
+    //@{
+    /** \brief Maximum number of terms in the Bessel series
+        (default 20)
+    */
+    size_t n_terms;
+
+    /** \brief Tolerance for truncating the series (default
+        \f$ 10^{-14} \f$)
+    */
+    double tol_series;
+
+    /// If true, call the error handler if the series diverges
+    bool err_nonconv;
+
+    /// Number of OpenMP threads for \ref calc_batch() (default 1)
+    size_t n_threads;
+    //@}
+
+    /// \name Species list
+    //@{
+    /// Remove all species
+    void clear();
+
+    /// The number of species
+    size_t n_species() const {
+      return mass.size();
+    }
+
+    /** \brief Add one species with mass \c m (in GeV), degeneracy
+        \c dof, statistics \c stat (\f$ +1 \f$ for bosons and
+        \f$ -1 \f$ for fermions), and conserved charges
+        \c b, \c q, and \c s
+
+        The antiparticle is not automatically added.
+    */
+    void add_species(int pdg_id, double m, double dof, double stat,
+                     double b, double q, double s);
+
+    /** \brief Add the hadrons in \c pdb with masses less than or
+        equal to \c mass_max (in GeV), together with their
+        antiparticles
+
+        Hadrons with unknown masses, the \f$ K^0_S \f$ and
+        \f$ K^0_L \f$ entries (which duplicate the \f$ K^0 \f$) are
+        skipped. Hadrons containing charm or heavier quarks are
+        included only if \c heavy is true.
+    */
+    void load_pdg(const part_pdg_db &pdb, double mass_max=2.6,
+                  bool heavy=false);
+
+    /** \brief Determine the baryon number, strangeness, spin
+        degeneracy, and whether or not the hadron with Monte Carlo
+        ID \c pdg_id is its own antiparticle
+
+        The value of \c heavy is set to true if the hadron contains
+        charm or heavier quarks. This function returns false if \c
+        pdg_id does not refer to a meson or a baryon.
+    */
+    static bool pdg_quantum_numbers(int pdg_id, int &b, int &s,
+                                    int &dof, bool &self_conj,
+                                    bool &heavy);
+    //@}
+
+    /// \name Thermodynamics
+    //@{
+    /** \brief Compute the thermodynamics at temperature \c T
+        and chemical potentials \c muB, \c muQ, and \c muS
+    */
+    int calc(double T, double muB, double muQ, double muS,
+             hrg_thermo &th);
+
+    /** \brief Compute the thermodynamics at the \c n points
+        specified in \c T, \c muB, \c muQ, and \c muS, storing
+        the results in \c th
+
+        If any point fails, the return value is that of the first
+        failed point and the results at that point are unspecified.
+        If the error handler is called while the points are computed
+        with several threads, it is called again with the same error
+        value after all of the threads have finished.
+    */
+    int calc_batch(size_t n, const double *T, const double *muB,
+                   const double *muQ, const double *muS,
+                   hrg_thermo *th);
+    //@}
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief Tabulated Bessel functions and scratch space for
+        one temperature
+    */
+    class table_t {
+
+    public:
+
+      /// The temperature of the table (zero if empty)
+      double T;
+      /// The number of terms tabulated
+      size_t nk;
+      /** \brief The value of \f$ K_2(k m_i/T) e^{k m_i/T} \f$
+          stored with index \f$ (k-1) N + i \f$
+      */
+      std::vector<double> K2e;
+      /// The value of \f$ K_1(k m_i/T) e^{k m_i/T} \f$
+      std::vector<double> K1e;
+      /// \f$ \eta_i e^{(\mu_i-m_i)/T} \f$ for each species
+      std::vector<double> w;
+      /// Running value of \f$ (\eta_i e^{(\mu_i-m_i)/T})^k \f$
+      std::vector<double> wk;
+      /// Partial sums for pressure and density
+      std::vector<double> sp, sn;
+      /// Partial sums for energy density and susceptibility
+      std::vector<double> se, sx;
+
+      table_t() {
+        T=0.0;
+        nk=0;
+      }
+
+    };
+
+    /// The table for \ref calc()
+    table_t tab;
+
+    /// Fill the Bessel table \c t for temperature \c T
+    void fill_table(table_t &t, double T);
+
+    /// Compute one point using the table \c t
+    int calc_table(table_t &t, double T, double muB, double muQ,
+                   double muS, hrg_thermo &th);
+
+#endif
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2022, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+
+#include <o2scl/hrg.h>
+#include <o2scl/test_mgr.h>
+
+using namespace std;
+using namespace o2scl;
+using namespace o2scl_const;
+
+/* Pressure of an ideal gas from a direct integration over momentum
+   with the trapezoidal rule
+ */
+double pr_direct(double m, double g, double eta, double T, double mu) {
+  size_t n=200000;
+  double kmax=m+60.0*T;
+  double h=kmax/n, sum=0.0;
+  for(size_t j=1;j<n;j++) {
+    double k=h*j;
+    double E=sqrt(k*k+m*m);
+    sum+=k*k*log1p(-eta*exp(-(E-mu)/T));
+  }
+  return -eta*g*T*sum*h/2.0/pi2;
+}
+
+int main(void) {
+  test_mgr t;
+  t.set_output_level(2);
+
+  cout.setf(ios::scientific);
+
+  hrg_calc h;
+  hrg_thermo th, th2, th3;
+
+  // A pion and a nucleon with their antiparticles
+  h.add_species(211,0.13957,1.0,1.0,0.0,1.0,0.0);
+  h.add_species(-211,0.13957,1.0,1.0,0.0,-1.0,0.0);
+  h.add_species(2212,0.93827,2.0,-1.0,1.0,1.0,0.0);
+  h.add_species(-2212,0.93827,2.0,-1.0,-1.0,-1.0,0.0);
+
+  double T=0.15, muB=0.3, muQ=0.05, muS=0.0;
+  h.calc(T,muB,muQ,muS,th);
+
+  double pr_exact=pr_direct(0.13957,1.0,1.0,T,muQ)+
+    pr_direct(0.13957,1.0,1.0,T,-muQ)+
+    pr_direct(0.93827,2.0,-1.0,T,muB+muQ)+
+    pr_direct(0.93827,2.0,-1.0,T,-muB-muQ);
+  t.test_rel(th.pr,pr_exact,1.0e-8,"pressure vs. direct");
+
+  // Thermodynamic identities from finite differences
+  double eps=1.0e-5;
+  h.calc(T,muB+eps,muQ,muS,th2);
+  h.calc(T,muB-eps,muQ,muS,th3);
+  t.test_rel(th.nB,(th2.pr-th3.pr)/2.0/eps,1.0e-7,"nB");
+  t.test_rel(th.chi_BB,(th2.nB-th3.nB)/2.0/eps/T/T,1.0e-6,"chi_BB");
+  t.test_rel(th.chi_BQ,(th2.nQ-th3.nQ)/2.0/eps/T/T,1.0e-6,"chi_BQ");
+  h.calc(T,muB,muQ+eps,muS,th2);
+  h.calc(T,muB,muQ-eps,muS,th3);
+  t.test_rel(th.nQ,(th2.pr-th3.pr)/2.0/eps,1.0e-7,"nQ");
+  t.test_rel(th.chi_QQ,(th2.nQ-th3.nQ)/2.0/eps/T/T,1.0e-6,"chi_QQ");
+  h.calc(T+eps,muB,muQ,muS,th2);
+  h.calc(T-eps,muB,muQ,muS,th3);
+  t.test_rel(th.en,(th2.pr-th3.pr)/2.0/eps,1.0e-7,"entropy");
+
+  // The full list of hadrons
+  part_pdg_db pdb;
+  h.clear();
+  h.load_pdg(pdb);
+  cout << "Number of species: " << h.n_species() << endl;
+  t.test_gen(h.n_species()>300,"n_species");
+
+  // Check the quantum numbers of a few well-known hadrons
+  for(size_t i=0;i<h.n_species();i++) {
+    if (h.id[i]==211) {
+      t.test_gen(h.Q[i]==1.0 && h.B[i]==0.0 && h.S[i]==0.0 &&
+                 h.g[i]==1.0 && h.eta[i]==1.0,"pi+");
+    } else if (h.id[i]==-2212) {
+      t.test_gen(h.Q[i]==-1.0 && h.B[i]==-1.0 && h.S[i]==0.0 &&
+                 h.g[i]==2.0 && h.eta[i]==-1.0,"antiproton");
+    } else if (h.id[i]==321) {
+      t.test_gen(h.Q[i]==1.0 && h.S[i]==1.0,"K+");
+    } else if (h.id[i]==311) {
+      t.test_gen(h.Q[i]==0.0 && h.S[i]==1.0,"K0");
+    } else if (h.id[i]==3122) {
+      t.test_gen(h.Q[i]==0.0 && h.B[i]==1.0 && h.S[i]==-1.0,"Lambda");
+    } else if (h.id[i]==3334) {
+      t.test_gen(h.Q[i]==-1.0 && h.S[i]==-3.0 && h.g[i]==4.0,"Omega");
+    } else if (h.id[i]==2224) {
+      t.test_gen(h.Q[i]==2.0 && h.g[i]==4.0,"Delta++");
+    }
+  }
+
+  // Particle-antiparticle symmetry at zero chemical potential
+  h.calc(0.155,0.0,0.0,0.0,th);
+  cout << th.pr/pow(0.155,4.0) << " " << th.chi_BB << " "
+       << th.chi_QQ << " " << th.chi_SS << endl;
+  t.test_abs(th.nB,0.0,1.0e-14,"nB zero");
+  t.test_abs(th.nQ,0.0,1.0e-14,"nQ zero");
+  t.test_abs(th.nS,0.0,1.0e-14,"nS zero");
+  t.test_gen(th.chi_BB>0.0 && th.chi_QQ>0.0 && th.chi_SS>0.0,
+             "chi positive");
+  t.test_gen(th.chi_BS<0.0,"chi_BS negative");
+
+  // Batch evaluation over a grid ordered by temperature
+  size_t nT=8, nmu=10, n=nT*nmu;
+  vector<double> Tv(n), mBv(n), mQv(n), mSv(n);
+  for(size_t i=0;i<nT;i++) {
+    for(size_t j=0;j<nmu;j++) {
+      Tv[i*nmu+j]=0.08+0.01*i;
+      mBv[i*nmu+j]=0.05*j;
+      mQv[i*nmu+j]=-0.01;
+      mSv[i*nmu+j]=0.01*j;
+    }
+  }
+  vector<hrg_thermo> res(n), res2(n);
+  h.calc_batch(n,&Tv[0],&mBv[0],&mQv[0],&mSv[0],&res[0]);
+  h.n_threads=4;
+  h.calc_batch(n,&Tv[0],&mBv[0],&mQv[0],&mSv[0],&res2[0]);
+  bool batch_ok=true, thread_ok=true;
+  for(size_t j=0;j<n;j++) {
+    h.calc(Tv[j],mBv[j],mQv[j],mSv[j],th);
+    if (fabs(th.pr-res[j].pr)>1.0e-15*fabs(th.pr) ||
+        fabs(th.nB-res[j].nB)>1.0e-15*fabs(th.nB) ||
+        fabs(th.chi_SS-res[j].chi_SS)>1.0e-15*fabs(th.chi_SS)) {
+      batch_ok=false;
+    }
+    if (res[j].pr!=res2[j].pr || res[j].ed!=res2[j].ed ||
+        res[j].nS!=res2[j].nS || res[j].chi_BQ!=res2[j].chi_BQ) {
+      thread_ok=false;
+    }
+  }
+  t.test_gen(batch_ok,"batch");
+  t.test_gen(thread_ok,"threads");
+
+  // Divergent series
+  h.err_nonconv=false;
+  int ret=h.calc(0.15,1.0,0.0,0.0,th);
+  t.test_gen(ret==exc_einval,"divergent");
+
+  t.report();
+  return 0;
+}
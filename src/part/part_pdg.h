@@ -57,6 +57,11 @@ namespace o2scl {
 
     void output_text();
 
+    /// Get the list of particles
+    const std::vector<pdg_entry> &get_list() const {
+      return db;
+    }
+
   protected:
     
     std::vector<pdg_entry> db;